@@ -0,0 +1 @@
+"""Reproducible benchmarks of rdkit-cli's hot commands (run with `python -m benchmarks`)."""
@@ -0,0 +1,377 @@
+"""
+Benchmark runner.
+
+Usage:
+    python -m benchmarks [--sizes 10k,100k] [--workers 1,2,4,8] [--case PATTERN ...]
+                         [--output results.json] [--baseline old.json]
+
+Each case runs `python -m rdkit_cli` as a subprocess on a generated dataset
+for every size and worker count, recording wall time, throughput and the
+peak RSS of the largest process of the run (the CLI or one of its workers).
+Results are written as JSON with the machine and version details needed to
+compare them later; with --baseline, throughput regressions beyond the
+tolerance are reported and the exit code is 1.
+"""
+
+import argparse
+import json
+import os
+import platform
+import subprocess
+import sys
+import tempfile
+import time
+from datetime import datetime, timezone
+from pathlib import Path
+from typing import Any, Optional
+
+from benchmarks.cases import Case, case_argv, select_cases
+from benchmarks.datasets import dataset_path, parse_size, query_path, size_label
+
+DEFAULT_DATA_DIR = Path.home() / ".cache" / "rdkit-cli-bench"
+DEFAULT_SIZES = "10k"
+DEFAULT_TOLERANCE = 0.15
+
+
+def build_parser() -> argparse.ArgumentParser:
+    parser = argparse.ArgumentParser(
+        prog="python -m benchmarks",
+        description="Benchmark rdkit-cli commands on generated datasets.",
+    )
+    parser.add_argument(
+        "--sizes",
+        default=DEFAULT_SIZES,
+        metavar="LIST",
+        help=f"Comma-separated dataset sizes, e.g. 10k,100k,1m (default: {DEFAULT_SIZES})",
+    )
+    parser.add_argument(
+        "--workers",
+        default=None,
+        metavar="LIST",
+        help="Comma-separated worker counts (default: 1 and powers of two up to the CPU count)",
+    )
+    parser.add_argument(
+        "--case",
+        action="append",
+        default=None,
+        metavar="PATTERN",
+        help="Run only cases matching a name, prefix or glob (repeatable; default: all)",
+    )
+    parser.add_argument(
+        "--list",
+        action="store_true",
+        help="List benchmark cases and exit",
+    )
+    parser.add_argument(
+        "--repeat",
+        type=int,
+        default=1,
+        metavar="N",
+        help="Runs per measurement; the fastest is kept (default: 1)",
+    )
+    parser.add_argument(
+        "--seed",
+        type=int,
+        default=42,
+        help="Dataset generation seed (default: 42)",
+    )
+    parser.add_argument(
+        "--data-dir",
+        type=Path,
+        default=DEFAULT_DATA_DIR,
+        metavar="DIR",
+        help=f"Dataset cache directory (default: {DEFAULT_DATA_DIR})",
+    )
+    parser.add_argument(
+        "-o", "--output",
+        type=Path,
+        default=None,
+        metavar="FILE",
+        help="Write results as JSON (default: benchmark-<timestamp>.json)",
+    )
+    parser.add_argument(
+        "--baseline",
+        type=Path,
+        default=None,
+        metavar="FILE",
+        help="Compare throughput with a previous results file",
+    )
+    parser.add_argument(
+        "--tolerance",
+        type=float,
+        default=DEFAULT_TOLERANCE,
+        metavar="F",
+        help=f"Throughput loss vs. baseline reported as a regression (default: {DEFAULT_TOLERANCE})",
+    )
+    parser.add_argument(
+        "--profile",
+        action="store_true",
+        help="Also write an rdkit-cli --profile report per run, next to the results",
+    )
+    parser.add_argument(
+        "--timeout",
+        type=float,
+        default=3600.0,
+        metavar="SECONDS",
+        help="Give up on a run after this long (default: 3600)",
+    )
+    return parser
+
+
+def default_workers() -> list[int]:
+    """1 and powers of two up to the CPU count (plus the CPU count itself)."""
+    n_cpus = os.cpu_count() or 1
+    workers = [1]
+    while workers[-1] * 2 <= n_cpus:
+        workers.append(workers[-1] * 2)
+    if workers[-1] != n_cpus:
+        workers.append(n_cpus)
+    return workers
+
+
+def _git_commit() -> Optional[str]:
+    try:
+        result = subprocess.run(
+            ["git", "rev-parse", "HEAD"],
+            capture_output=True, text=True, check=True, cwd=Path(__file__).parent,
+        )
+    except (OSError, subprocess.CalledProcessError):
+        return None
+    return result.stdout.strip() or None
+
+
+def machine_info() -> dict[str, Any]:
+    """Machine and version details stored with the results."""
+    info: dict[str, Any] = {
+        "timestamp": datetime.now(timezone.utc).isoformat(timespec="seconds"),
+        "git_commit": _git_commit(),
+        "python": platform.python_version(),
+        "platform": platform.platform(),
+        "processor": platform.processor() or platform.machine(),
+        "cpu_count": os.cpu_count(),
+    }
+    for module in ("rdkit_cli", "rdkit", "numpy", "pyarrow"):
+        try:
+            info[f"{module}_version"] = __import__(module).__version__
+        except (ImportError, AttributeError):
+            info[f"{module}_version"] = None
+    return info
+
+
+def _peak_rss_mb(rusage) -> float:
+    # ru_maxrss is in kilobytes on Linux, bytes on macOS
+    scale = 1 if sys.platform == "darwin" else 1024
+    return rusage.ru_maxrss * scale / (1024 * 1024)
+
+
+def run_command(argv: list[str], timeout: float) -> tuple[float, float, int, str]:
+    """
+    Run rdkit-cli once.
+
+    Returns:
+        Tuple of (wall seconds, peak RSS in MB, exit code, stderr tail)
+    """
+    stderr = tempfile.TemporaryFile()
+    start = time.perf_counter()
+    process = subprocess.Popen(
+        [sys.executable, "-m", "rdkit_cli", *argv],
+        stdout=subprocess.DEVNULL,
+        stderr=stderr,
+    )
+    deadline = start + timeout
+    while True:
+        pid, status, rusage = os.wait4(process.pid, os.WNOHANG)
+        if pid:
+            break
+        if time.perf_counter() > deadline:
+            process.kill()
+            _, status, rusage = os.wait4(process.pid, 0)
+            break
+        time.sleep(0.01)
+    elapsed = time.perf_counter() - start
+    # wait4 reaped the process; keep Popen from waiting on it again
+    process.returncode = os.waitstatus_to_exitcode(status)
+
+    # The max RSS reported for the child is the largest of it and the
+    # descendants it reaped, i.e. the CLI or its biggest worker
+    peak = _peak_rss_mb(rusage)
+    stderr.seek(0)
+    tail = stderr.read()[-2000:].decode(errors="replace")
+    stderr.close()
+    return elapsed, peak, process.returncode, tail
+
+
+def measure(
+    case: Case,
+    size: int,
+    workers: int,
+    data_dir: Path,
+    seed: int,
+    repeat: int,
+    timeout: float,
+    profile_dir: Optional[Path],
+) -> dict[str, Any]:
+    """Run one case at one size and worker count, keeping the fastest of `repeat` runs."""
+    input_path = dataset_path(data_dir, size, case.input_format, seed)
+    queries = query_path(data_dir)
+
+    result: dict[str, Any] = {
+        "case": case.name,
+        "size": size,
+        "workers": workers,
+    }
+    best: Optional[tuple[float, float]] = None
+
+    with tempfile.TemporaryDirectory(prefix="rdkit-cli-bench-") as tmp:
+        output_path = Path(tmp) / f"out.{case.output_format}"
+        argv = case_argv(case, str(input_path), str(output_path), str(queries), workers)
+        if profile_dir is not None:
+            profile_path = profile_dir / f"{case.name}-{size_label(size)}-w{workers}.json"
+            argv = ["--profile", str(profile_path), *argv]
+            result["profile"] = str(profile_path)
+
+        for _ in range(max(1, repeat)):
+            output_path.unlink(missing_ok=True)
+            elapsed, peak, code, stderr = run_command(argv, timeout)
+            if code != 0:
+                result.update(status="failed", exit_code=code, stderr=stderr.strip())
+                return result
+            if best is None or elapsed < best[0]:
+                best = (elapsed, peak)
+
+        result["output_bytes"] = output_path.stat().st_size if output_path.exists() else 0
+
+    elapsed, peak = best
+    result.update(
+        status="ok",
+        seconds=round(elapsed, 4),
+        rows_per_second=round(size / elapsed, 2),
+        peak_rss_mb=round(peak, 1),
+    )
+    return result
+
+
+def add_scaling(results: list[dict[str, Any]]):
+    """Add speedup and efficiency relative to the 1-worker run of each case and size."""
+    single = {
+        (r["case"], r["size"]): r["seconds"]
+        for r in results
+        if r["status"] == "ok" and r["workers"] == 1
+    }
+    for r in results:
+        base = single.get((r["case"], r["size"]))
+        if r["status"] != "ok" or base is None:
+            continue
+        speedup = base / r["seconds"]
+        r["speedup"] = round(speedup, 3)
+        r["efficiency"] = round(speedup / r["workers"], 3)
+
+
+def compare(results: list[dict[str, Any]], baseline: dict[str, Any], tolerance: float) -> list[str]:
+    """
+    Compare throughput with a baseline results file.
+
+    Returns:
+        One message per measurement slower than the baseline by more than tolerance
+    """
+    previous = {
+        (r["case"], r["size"], r["workers"]): r
+        for r in baseline.get("results", [])
+        if r.get("status") == "ok"
+    }
+    regressions = []
+    for r in results:
+        old = previous.get((r["case"], r["size"], r["workers"]))
+        if r["status"] != "ok" or old is None:
+            continue
+        ratio = r["rows_per_second"] / old["rows_per_second"]
+        r["vs_baseline"] = round(ratio, 3)
+        if ratio < 1.0 - tolerance:
+            regressions.append(
+                f"{r['case']} size={size_label(r['size'])} workers={r['workers']}: "
+                f"{r['rows_per_second']:.0f} rows/s vs {old['rows_per_second']:.0f} "
+                f"({(1.0 - ratio) * 100:.0f}% slower)"
+            )
+    return regressions
+
+
+def format_row(r: dict[str, Any]) -> str:
+    label = f"{r['case']:<28} {size_label(r['size']):>6} w={r['workers']:<3}"
+    if r["status"] != "ok":
+        return f"{label} FAILED (exit {r['exit_code']})"
+    line = (
+        f"{label} {r['seconds']:>9.2f}s {r['rows_per_second']:>11.0f} rows/s "
+        f"{r['peak_rss_mb']:>8.1f} MB"
+    )
+    if "speedup" in r:
+        line += f"  x{r['speedup']:.2f} ({r['efficiency'] * 100:.0f}%)"
+    return line
+
+
+def main(argv: Optional[list[str]] = None) -> int:
+    args = build_parser().parse_args(argv)
+
+    try:
+        cases = select_cases(args.case)
+        sizes = [parse_size(s) for s in args.sizes.split(",") if s.strip()]
+        workers = (
+            [int(w) for w in args.workers.split(",") if w.strip()]
+            if args.workers else default_workers()
+        )
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+
+    if args.list:
+        for case in cases:
+            limit = f" (max {size_label(case.max_size)})" if case.max_size else ""
+            print(f"{case.name}{limit}: rdkit-cli {' '.join(case.args)}")
+        return 0
+
+    output = args.output or Path(f"benchmark-{datetime.now():%Y%m%d-%H%M%S}.json")
+    profile_dir = output.with_suffix("") if args.profile else None
+    if profile_dir is not None:
+        profile_dir.mkdir(parents=True, exist_ok=True)
+
+    results = []
+    for case in cases:
+        for size in sizes:
+            if case.max_size is not None and size > case.max_size:
+                continue
+            for n in workers:
+                r = measure(case, size, n, args.data_dir, args.seed, args.repeat, args.timeout, profile_dir)
+                results.append(r)
+                print(format_row(r), file=sys.stderr)
+
+    add_scaling(results)
+
+    regressions: list[str] = []
+    if args.baseline is not None:
+        baseline = json.loads(args.baseline.read_text())
+        regressions = compare(results, baseline, args.tolerance)
+
+    report = {
+        "machine": machine_info(),
+        "settings": {
+            "sizes": sizes,
+            "workers": workers,
+            "repeat": args.repeat,
+            "seed": args.seed,
+        },
+        "results": results,
+    }
+    if args.baseline is not None:
+        report["baseline"] = str(args.baseline)
+        report["regressions"] = regressions
+    output.write_text(json.dumps(report, indent=2) + "\n")
+    print(f"Results written to {output}", file=sys.stderr)
+
+    for message in regressions:
+        print(f"Regression: {message}", file=sys.stderr)
+
+    failed = [r for r in results if r["status"] != "ok"]
+    return 1 if failed or regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
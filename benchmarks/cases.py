@@ -0,0 +1,82 @@
+"""
+Benchmark cases: one rdkit-cli invocation each.
+
+Arguments are templates filled in by the runner:
+
+    {input}    dataset in the case's input format
+    {output}   output path in the case's output format
+    {queries}  small query set (CSV)
+    {workers}  worker count of the run
+"""
+
+from typing import NamedTuple, Optional
+
+from benchmarks.datasets import FORMATS
+
+
+class Case(NamedTuple):
+    """One benchmarked command."""
+
+    name: str
+    args: tuple[str, ...]
+    input_format: str = "csv"
+    output_format: str = "csv"
+    # Largest dataset the case runs on (quadratic or very slow commands)
+    max_size: Optional[int] = None
+
+
+COMMAND_CASES = [
+    Case("descriptors-compute", ("descriptors", "compute", "-d", "MolWt,MolLogP,TPSA,NumHDonors,NumHAcceptors")),
+    Case("descriptors-compute-all", ("descriptors", "compute", "--all"), max_size=100_000),
+    Case("fingerprints-morgan", ("fingerprints", "compute", "-t", "morgan")),
+    Case("fingerprints-fpdb", ("fingerprints", "compute", "-t", "morgan"), output_format="fpdb"),
+    Case("similarity-search", ("similarity", "search", "--queries", "{queries}", "-t", "0.5")),
+    Case("similarity-matrix", ("similarity", "matrix"), output_format="npy", max_size=10_000),
+    Case("similarity-cluster", ("similarity", "cluster", "-c", "0.4"), max_size=100_000),
+    Case("standardize", ("standardize", "--cleanup", "--fragment-parent", "--uncharge")),
+    Case("deduplicate", ("deduplicate", "-b", "smiles")),
+    Case("conformers-generate", ("conformers", "generate", "--num", "5"), output_format="sdf", max_size=10_000),
+]
+
+# Every reader/writer pair, through convert
+FORMAT_CASES = [
+    Case(f"convert-{source}-{target}", ("convert",), input_format=source, output_format=target)
+    for source in FORMATS
+    for target in FORMATS
+]
+
+CASES = COMMAND_CASES + FORMAT_CASES
+
+
+def select_cases(patterns: Optional[list[str]]) -> list[Case]:
+    """
+    Select cases by name prefix or glob pattern.
+
+    Args:
+        patterns: Names, prefixes or globs (e.g. "convert-*"), or None for all
+
+    Returns:
+        Matching cases in definition order
+
+    Raises:
+        ValueError: If a pattern matches nothing
+    """
+    if not patterns:
+        return list(CASES)
+
+    from fnmatch import fnmatch
+
+    selected = []
+    for pattern in patterns:
+        matches = [c for c in CASES if fnmatch(c.name, pattern) or c.name.startswith(pattern)]
+        if not matches:
+            raise ValueError(f"No benchmark case matches '{pattern}'")
+        selected.extend(c for c in matches if c not in selected)
+    return [c for c in CASES if c in selected]
+
+
+def case_argv(case: Case, input_path: str, output_path: str, queries_path: str, workers: int) -> list[str]:
+    """Build the rdkit-cli arguments of a case run."""
+    values = {"input": input_path, "output": output_path, "queries": queries_path, "workers": str(workers)}
+    args = [arg.format(**values) for arg in case.args]
+    return args + ["-i", input_path, "-o", output_path, "-n", str(workers), "--name-column", "name", "-q"]
@@ -0,0 +1,147 @@
+"""
+Deterministic benchmark datasets.
+
+Molecules are assembled from SMILES building blocks (ring cores with a
+substituent slot, linkers, substituents), so any size can be generated
+offline in seconds, and the same seed always gives the same file. About
+5% of rows repeat an earlier molecule, so deduplication has work to do.
+
+Every generated dataset is written once as CSV; the other formats are
+converted from it with `rdkit-cli convert` and cached next to it.
+"""
+
+import random
+import subprocess
+import sys
+from pathlib import Path
+
+# Cores use ring labels 1-2; the substituent goes in the {} branch, and a
+# tail may be appended after the last atom
+CORES = [
+    "c1ccc({})cc1",
+    "c1cc({})ncc1",
+    "c1cnc({})nc1",
+    "c1cc({})sc1",
+    "c1ccc2[nH]c({})cc2c1",
+    "c1ccc2nc({})ccc2c1",
+    "C1CCN({})CC1",
+    "C1CCC({})CC1",
+    "C1CC(=O)NC({})C1",
+    "C1COCC({})C1",
+]
+
+# Substituent rings use label 7, which is closed before any other use
+SUBSTITUENTS = [
+    "C", "CC", "CCC", "C(C)C", "O", "OC", "N", "NC", "N(C)C", "F", "Cl", "Br",
+    "C(F)(F)F", "C#N", "C(=O)O", "C(=O)OC", "C(=O)N", "S(=O)(=O)N", "N7CCOCC7",
+    "c7ccccc7", "C7CC7", "OCC(=O)O", "NC(=O)C", "CO",
+]
+
+LINKERS = ["", "C", "CC", "C(=O)N", "NC(=O)", "O", "S", "CN", "OC"]
+
+# Second cores use ring labels 3-4
+_RELABEL = str.maketrans("12", "34")
+
+DUPLICATE_FRACTION = 0.05
+
+FORMATS = ("csv", "tsv", "smi", "sdf", "parquet")
+
+
+def parse_size(text: str) -> int:
+    """Parse a dataset size such as 10000, 10k or 1m."""
+    text = text.strip().lower()
+    scale = {"k": 1_000, "m": 1_000_000}.get(text[-1:], 1)
+    number = text[:-1] if scale > 1 else text
+    size = int(float(number) * scale)
+    if size < 1:
+        raise ValueError(f"Dataset size must be positive, got '{text}'")
+    return size
+
+
+def size_label(size: int) -> str:
+    """Short label of a size (10k, 1m, 2500)."""
+    for suffix, scale in (("m", 1_000_000), ("k", 1_000)):
+        if size % scale == 0:
+            return f"{size // scale}{suffix}"
+    return str(size)
+
+
+def _random_molecule(rng: random.Random) -> str:
+    smiles = rng.choice(CORES).format(rng.choice(SUBSTITUENTS))
+    roll = rng.random()
+    if roll < 0.3:
+        smiles += rng.choice(SUBSTITUENTS)
+    elif roll < 0.9:
+        second = rng.choice(CORES).translate(_RELABEL).format(rng.choice(SUBSTITUENTS))
+        smiles += rng.choice(LINKERS) + second
+        if rng.random() < 0.5:
+            smiles += rng.choice(SUBSTITUENTS)
+    return smiles
+
+
+def generate_smiles(size: int, seed: int = 42) -> list[str]:
+    """Generate `size` SMILES, about DUPLICATE_FRACTION of them repeats."""
+    rng = random.Random(seed)
+    smiles: list[str] = []
+    for _ in range(size):
+        if smiles and rng.random() < DUPLICATE_FRACTION:
+            smiles.append(rng.choice(smiles))
+        else:
+            smiles.append(_random_molecule(rng))
+    return smiles
+
+
+def write_csv(path: Path, size: int, seed: int = 42):
+    """Write a dataset CSV with smiles, name and score columns."""
+    rng = random.Random(seed + 1)
+    tmp = path.with_suffix(".tmp")
+    with open(tmp, "w") as f:
+        f.write("smiles,name,score\n")
+        for i, smi in enumerate(generate_smiles(size, seed)):
+            f.write(f"{smi},mol{i},{rng.random():.4f}\n")
+    tmp.replace(path)
+
+
+def dataset_path(data_dir: Path, size: int, fmt: str = "csv", seed: int = 42) -> Path:
+    """
+    Path of a dataset in a given format, generating (or converting) it if missing.
+
+    Args:
+        data_dir: Cache directory
+        size: Number of molecules
+        fmt: One of FORMATS
+        seed: Generation seed
+
+    Returns:
+        Path of the dataset file
+    """
+    if fmt not in FORMATS:
+        raise ValueError(f"Unknown dataset format: {fmt}")
+
+    data_dir.mkdir(parents=True, exist_ok=True)
+    stem = f"molecules-{size_label(size)}-s{seed}"
+    csv_path = data_dir / f"{stem}.csv"
+    if not csv_path.exists():
+        write_csv(csv_path, size, seed)
+    if fmt == "csv":
+        return csv_path
+
+    path = data_dir / f"{stem}.{fmt}"
+    if not path.exists():
+        tmp = data_dir / f"{stem}.tmp.{fmt}"
+        subprocess.run(
+            [sys.executable, "-m", "rdkit_cli", "convert", "-i", str(csv_path), "-o", str(tmp),
+             "--name-column", "name", "-n", "-1", "-q"],
+            check=True,
+        )
+        tmp.replace(path)
+    return path
+
+
+def query_path(data_dir: Path, n_queries: int = 100, seed: int = 7) -> Path:
+    """Path of a small query set for similarity search benchmarks."""
+    data_dir.mkdir(parents=True, exist_ok=True)
+    path = data_dir / f"queries-{n_queries}-s{seed}.csv"
+    if not path.exists():
+        write_csv(path, n_queries, seed)
+    return path
@@ -3,15 +3,112 @@
 import argparse
 import sys
 from difflib import get_close_matches
+from importlib import import_module
 from typing import Optional
 
-from rich_argparse import RichHelpFormatter
-
 from rdkit_cli import __version__
 
+# Every command, with its one-line help (alphabetical order). Each is
+# implemented by rdkit_cli.commands.<name>, whose register_parser() builds
+# the full subparser; only the command being run is imported, the others get
+# a placeholder carrying this help for the command list and suggestions.
+COMMANDS = {
+    "align": "Align 3D molecules to a reference",
+    "client": "Submit jobs to a running 'rdkit-cli serve'",
+    "concat": "Concatenate output files (e.g. --shard outputs)",
+    "conformers": "Generate and optimize 3D conformers",
+    "convert": "Convert between molecular file formats",
+    "deduplicate": "Remove duplicate molecules",
+    "depict": "Generate molecular depictions",
+    "descriptors": "Compute molecular descriptors",
+    "diversity": "Analyze and select diverse molecules",
+    "energy": "Force field energy calculations",
+    "enumerate": "Enumerate molecular variants",
+    "filter": "Filter molecules by various criteria",
+    "fingerprints": "Compute molecular fingerprints",
+    "fragment": "Fragment molecules",
+    "info": "Display quick molecule information",
+    "mcs": "Find Maximum Common Substructure",
+    "merge": "Merge multiple molecule files",
+    "mmp": "Matched Molecular Pairs analysis",
+    "pharmacophore": "Pharmacophore feature analysis",
+    "props": "Property column operations",
+    "protonate": "Enumerate protonation states",
+    "reactions": "Apply chemical reactions and transformations",
+    "rgroup": "R-group decomposition",
+    "rings": "Analyze ring systems",
+    "rmsd": "Calculate RMSD between 3D structures",
+    "sample": "Randomly sample molecules",
+    "sascorer": "Calculate synthetic accessibility score",
+    "scaffold": "Analyze molecular scaffolds",
+    "serve": "Serve jobs from a warm worker pool (for many small requests)",
+    "similarity": "Compute molecular similarity",
+    "split": "Split files into smaller chunks",
+    "standardize": "Standardize and canonicalize molecules",
+    "stats": "Calculate dataset statistics",
+    "stereo": "Analyze and manipulate stereochemistry",
+    "validate": "Validate molecular structures",
+}
+
+
+class RdkitHelpFormatter(argparse.HelpFormatter):
+    """
+    Help formatter of all rdkit-cli parsers.
+
+    Parsers only render help through rich-argparse (see
+    SuggestingArgumentParser), so rich is not imported by runs that never
+    print help or usage. Elsewhere, e.g. argparse's metavar checks in
+    add_argument, this behaves as the plain HelpFormatter.
+    """
+
+
+_rich_formatter_class = None
+
+
+def _rich_help_formatter() -> type:
+    """Build the rich-argparse formatter on first use."""
+    global _rich_formatter_class
+    if _rich_formatter_class is None:
+        from rich_argparse import RichHelpFormatter
+
+        class RichRdkitHelpFormatter(RichHelpFormatter):
+            """Rich formatter with adjusted styles and command-first ordering."""
+
+            styles = {
+                **RichHelpFormatter.styles,
+                "argparse.args": "cyan",
+                "argparse.groups": "bold yellow",
+                "argparse.metavar": "green",
+                "argparse.prog": "bold magenta",
+            }
+
+        _rich_formatter_class = RichRdkitHelpFormatter
+    return _rich_formatter_class
+
 
 class SuggestingArgumentParser(argparse.ArgumentParser):
-    """ArgumentParser with 'did you mean?' suggestions for typos."""
+    """ArgumentParser with 'did you mean?' suggestions for typos and lazily loaded rich help."""
+
+    _rendering = False
+
+    def _get_formatter(self):
+        if self._rendering and self.formatter_class is RdkitHelpFormatter:
+            return _rich_help_formatter()(prog=self.prog)
+        return super()._get_formatter()
+
+    def format_help(self) -> str:
+        self._rendering = True
+        try:
+            return super().format_help()
+        finally:
+            self._rendering = False
+
+    def format_usage(self) -> str:
+        self._rendering = True
+        try:
+            return super().format_usage()
+        finally:
+            self._rendering = False
 
     def error(self, message: str) -> None:
         """Override error to add command suggestions."""
@@ -34,23 +131,35 @@ class SuggestingArgumentParser(argparse.ArgumentParser):
         sys.exit(2)
 
 
-class RdkitHelpFormatter(RichHelpFormatter):
-    """Custom formatter with adjusted styles and command-first ordering."""
+# Defined here to avoid importing io.writers at startup
+PARQUET_COMPRESSIONS = ["snappy", "zstd", "gzip", "lz4", "brotli", "none"]
+
+# Mirrors progress.ninja.PROGRESS_TOTAL_MODES
+PROGRESS_TOTAL_MODES = ["count", "estimate"]
+
 
-    styles = {
-        **RichHelpFormatter.styles,
-        "argparse.args": "cyan",
-        "argparse.groups": "bold yellow",
-        "argparse.metavar": "green",
-        "argparse.prog": "bold magenta",
-    }
+class InputFile(str):
+    """
+    Argparse type for options naming a file whose content affects results.
 
+    Values are plain strings; checkpoint identities record the file's
+    content digest for options of this type (see _result_options).
+    """
 
-def add_common_io_options(parser: argparse.ArgumentParser):
+
+def _shard_spec(text: str) -> tuple[int, int]:
+    """Argparse type for --shard I/N (validated again by parallel.shard.Shard)."""
+    index, sep, count = text.partition("/")
+    if not (sep and index.isdigit() and count.isdigit() and 1 <= int(index) <= int(count)):
+        raise argparse.ArgumentTypeError(f"expected I/N with 1 <= I <= N, got '{text}'")
+    return int(index), int(count)
+
+
+def add_common_io_options(parser: argparse.ArgumentParser, input_required: bool = True):
     """Add common I/O options to a parser."""
     parser.add_argument(
         "-i", "--input",
-        required=True,
+        required=input_required,
         metavar="FILE",
         help="Input file (CSV, TSV, SMI, SDF, or Parquet)",
     )
@@ -60,6 +169,20 @@ def add_common_io_options(parser: argparse.ArgumentParser):
         metavar="FILE",
         help="Output file",
     )
+    parser.add_argument(
+        "--parquet-compression",
+        choices=PARQUET_COMPRESSIONS,
+        default=None,
+        metavar="CODEC",
+        help="Compression for Parquet output: snappy, zstd, gzip, lz4, brotli, none (default: snappy)",
+    )
+    parser.add_argument(
+        "--row-group-size",
+        type=int,
+        default=None,
+        metavar="N",
+        help="Rows per Parquet row group (default: 100000)",
+    )
 
 
 def add_common_processing_options(parser: argparse.ArgumentParser):
@@ -93,6 +216,41 @@ def add_common_processing_options(parser: argparse.ArgumentParser):
         action="store_true",
         help="Suppress progress output",
     )
+    parser.add_argument(
+        "--progress-total",
+        choices=PROGRESS_TOTAL_MODES,
+        default=None,
+        metavar="MODE",
+        help="How to get the progress total: count (scan input) or estimate (from file size) (default: count)",
+    )
+    parser.add_argument(
+        "--cache",
+        default=None,
+        metavar="DIR",
+        help="Reuse results cached in DIR, keyed by canonical SMILES and options; only "
+             "new molecules are computed (descriptors, fingerprints, sascorer)",
+    )
+    parser.add_argument(
+        "--profile",
+        default=None,
+        metavar="FILE",
+        help="Write a JSON report of time per stage (read, parse, dispatch, compute, "
+             "transfer, collect, write), worker utilization, queue depths and the "
+             "slowest molecules",
+    )
+    parser.add_argument(
+        "--profile-metrics",
+        default=None,
+        metavar="FILE",
+        help="With --profile, also append running totals to FILE as JSON lines",
+    )
+    parser.add_argument(
+        "--profile-interval",
+        type=float,
+        default=None,
+        metavar="SECONDS",
+        help="Seconds between --profile-metrics lines (default: 10)",
+    )
     parser.add_argument(
         "--no-warnings",
         action="store_true",
@@ -107,8 +265,59 @@ def add_common_processing_options(parser: argparse.ArgumentParser):
     )
 
 
-def create_parser() -> SuggestingArgumentParser:
-    """Create the main argument parser."""
+def add_shard_options(parser: argparse.ArgumentParser):
+    """
+    Add --shard and --checkpoint options.
+
+    Only for commands that process their input through process_molecules;
+    elsewhere the options would be ignored, so they are not offered.
+    """
+    parser.add_argument(
+        "--shard",
+        type=_shard_spec,
+        default=None,
+        metavar="I/N",
+        help="Process only the I-th of N contiguous row ranges of the input "
+             "(combine shard outputs with 'rdkit-cli concat')",
+    )
+    parser.add_argument(
+        "--checkpoint",
+        default=None,
+        metavar="DIR",
+        help="Record finished segments in DIR and resume from them when the "
+             "same command is rerun after an interruption",
+    )
+    parser.add_argument(
+        "--checkpoint-rows",
+        type=int,
+        default=None,
+        metavar="N",
+        help="Input rows per checkpointed segment (default: 10000)",
+    )
+
+
+def reject_shard_options(args, reason: str) -> bool:
+    """
+    Report --shard/--checkpoint given to a mode that does not support them.
+
+    Returns:
+        True if an error was printed (the command should exit with 1)
+    """
+    for option in ("shard", "checkpoint"):
+        if getattr(args, option, None) is not None:
+            print(f"Error: --{option} is not supported {reason}", file=sys.stderr)
+            return True
+    return False
+
+
+def create_parser(commands: Optional[list[str]] = None) -> SuggestingArgumentParser:
+    """
+    Create the main argument parser.
+
+    Args:
+        commands: Commands whose modules are loaded to build their full
+            subparsers; the others get placeholders (default: all)
+    """
     parser = SuggestingArgumentParser(
         prog="rdkit-cli",
         description="A comprehensive CLI tool for RDKit cheminformatics operations.",
@@ -130,87 +339,34 @@ def create_parser() -> SuggestingArgumentParser:
         metavar="<command>",
     )
 
-    # Register all command modules
-    _register_commands(subparsers)
+    _register_commands(subparsers, COMMANDS if commands is None else commands)
 
     return parser
 
 
-def _register_commands(subparsers):
-    """Register all command subparsers (alphabetical order)."""
-    from rdkit_cli.commands import (
-        align,
-        conformers,
-        convert,
-        deduplicate,
-        depict,
-        descriptors,
-        diversity,
-        energy,
-        enumerate,
-        filter,
-        fingerprints,
-        fragment,
-        info,
-        mcs,
-        merge,
-        mmp,
-        pharmacophore,
-        props,
-        protonate,
-        reactions,
-        rgroup,
-        rings,
-        rmsd,
-        sample,
-        sascorer,
-        scaffold,
-        similarity,
-        split,
-        standardize,
-        stats,
-        stereo,
-        validate,
-    )
-
-    # Each module has a register_parser(subparsers) function
-    align.register_parser(subparsers)
-    conformers.register_parser(subparsers)
-    convert.register_parser(subparsers)
-    deduplicate.register_parser(subparsers)
-    depict.register_parser(subparsers)
-    descriptors.register_parser(subparsers)
-    diversity.register_parser(subparsers)
-    energy.register_parser(subparsers)
-    enumerate.register_parser(subparsers)
-    filter.register_parser(subparsers)
-    fingerprints.register_parser(subparsers)
-    fragment.register_parser(subparsers)
-    info.register_parser(subparsers)
-    mcs.register_parser(subparsers)
-    merge.register_parser(subparsers)
-    mmp.register_parser(subparsers)
-    pharmacophore.register_parser(subparsers)
-    props.register_parser(subparsers)
-    protonate.register_parser(subparsers)
-    reactions.register_parser(subparsers)
-    rgroup.register_parser(subparsers)
-    rings.register_parser(subparsers)
-    rmsd.register_parser(subparsers)
-    sample.register_parser(subparsers)
-    sascorer.register_parser(subparsers)
-    scaffold.register_parser(subparsers)
-    similarity.register_parser(subparsers)
-    split.register_parser(subparsers)
-    standardize.register_parser(subparsers)
-    stats.register_parser(subparsers)
-    stereo.register_parser(subparsers)
-    validate.register_parser(subparsers)
+def _register_commands(subparsers, commands):
+    """Register the full subparsers of the given commands and placeholders for the rest."""
+    for name, help_text in COMMANDS.items():
+        if name in commands:
+            # Each module has a register_parser(subparsers) function
+            import_module(f"rdkit_cli.commands.{name}").register_parser(subparsers)
+        else:
+            subparsers.add_parser(name, help=help_text, add_help=False)
+
+
+def _selected_command(args: list[str]) -> list[str]:
+    """The command named by the first positional argument, if it is one."""
+    for arg in args:
+        if not arg.startswith("-"):
+            return [arg] if arg in COMMANDS else []
+    return []
 
 
 def main(args: Optional[list[str]] = None) -> int:
     """Main entry point."""
-    parser = create_parser()
+    if args is None:
+        args = sys.argv[1:]
+    parser = create_parser(_selected_command(args))
     parsed_args = parser.parse_args(args)
 
     if parsed_args.command is None:
@@ -218,20 +374,81 @@ def main(args: Optional[list[str]] = None) -> int:
         return 1
 
     # Configure logging based on --no-warnings or --log-level
-    from rdkit_cli.utils import configure_all_warnings, set_rdkit_log_level
     no_warnings = getattr(parsed_args, "no_warnings", False)
     log_level = getattr(parsed_args, "log_level", None)
 
     if no_warnings:
         # Suppress both RDKit and application warnings
+        from rdkit_cli.utils import configure_all_warnings
         configure_all_warnings(suppress=True)
     elif log_level is not None:
         # Only control RDKit log level
+        from rdkit_cli.utils import set_rdkit_log_level
         set_rdkit_log_level(log_level)
 
+    # Configure Parquet output options
+    parquet_compression = getattr(parsed_args, "parquet_compression", None)
+    row_group_size = getattr(parsed_args, "row_group_size", None)
+    if parquet_compression is not None or row_group_size is not None:
+        from rdkit_cli.io.writers import configure_parquet
+        try:
+            configure_parquet(compression=parquet_compression, row_group_size=row_group_size)
+        except ValueError as e:
+            sys.stderr.write(f"Error: {e}\n")
+            return 1
+
+    # Configure how progress totals are obtained
+    progress_total = getattr(parsed_args, "progress_total", None)
+    if progress_total is not None:
+        from rdkit_cli.progress import configure_progress
+        configure_progress(total_mode=progress_total)
+
+    # Enable the on-disk result cache
+    cache_dir = getattr(parsed_args, "cache", None)
+    if cache_dir is not None:
+        from rdkit_cli.parallel.cache import configure_cache
+        configure_cache(cache_dir)
+
+    # Restrict processing to one shard of the input
+    shard = getattr(parsed_args, "shard", None)
+    if shard is not None:
+        from rdkit_cli.parallel.shard import Shard, configure_shard
+        configure_shard(Shard(*shard))
+
+    # Checkpoint processing for resume after interruption
+    checkpoint_dir = getattr(parsed_args, "checkpoint", None)
+    if checkpoint_dir is not None:
+        from rdkit_cli.parallel.checkpoint import configure_checkpoint
+        try:
+            configure_checkpoint(
+                checkpoint_dir,
+                rows=getattr(parsed_args, "checkpoint_rows", None),
+                options=_result_options(parsed_args),
+            )
+        except ValueError as e:
+            sys.stderr.write(f"Error: {e}\n")
+            return 1
+
+    # Profile process_molecules stages
+    profile_path = getattr(parsed_args, "profile", None)
+    if profile_path is not None:
+        from rdkit_cli.parallel.profile import configure_profile
+        try:
+            configure_profile(
+                profile_path,
+                metrics_path=getattr(parsed_args, "profile_metrics", None),
+                metrics_interval=getattr(parsed_args, "profile_interval", None),
+            )
+        except ValueError as e:
+            sys.stderr.write(f"Error: {e}\n")
+            return 1
+
     # Each command has a run(args) function via set_defaults(func=...)
     try:
-        return parsed_args.func(parsed_args)
+        exit_code = parsed_args.func(parsed_args)
+        if exit_code == 0:
+            _warn_unapplied(profile_path is not None)
+        return exit_code
     except KeyboardInterrupt:
         sys.stderr.write("\nInterrupted.\n")
         return 130
@@ -243,5 +460,49 @@ def main(args: Optional[list[str]] = None) -> int:
         return 1
 
 
+# Options that do not change a command's results (input identity and shard
+# are recorded separately), left out of checkpoint identities
+_NON_RESULT_OPTIONS = frozenset({
+    "func", "input", "output", "output_dir", "shard", "checkpoint", "checkpoint_rows",
+    "ncpu", "quiet", "progress_total", "cache", "profile", "profile_metrics",
+    "profile_interval", "no_warnings", "log_level",
+})
+
+
+def _result_options(args: argparse.Namespace) -> dict:
+    """
+    Parsed options that determine a command's results, for checkpoint identities.
+
+    Options of type InputFile (--spec, --smarts-file, ...) are recorded with
+    the resolved path and a digest of the file's content, so editing the file
+    counts as changed options; a missing file is recorded by path only.
+    """
+    import hashlib
+    from pathlib import Path
+
+    options = {}
+    for key, value in sorted(vars(args).items()):
+        if key in _NON_RESULT_OPTIONS or callable(value):
+            continue
+        if isinstance(value, InputFile):
+            path = Path(value).resolve()
+            value = {"path": str(path)}
+            if path.is_file():
+                digest = hashlib.blake2b(digest_size=16)
+                with open(path, "rb") as f:
+                    for block in iter(lambda: f.read(1 << 20), b""):
+                        digest.update(block)
+                value["digest"] = digest.hexdigest()
+        options[key] = value
+    return options
+
+
+def _warn_unapplied(profile: bool):
+    """Warn when --profile had no effect on the command run."""
+    if profile:
+        from rdkit_cli.parallel.profile import profile_ignored
+        if profile_ignored():
+            sys.stderr.write("Warning: --profile is not supported by this command; no report was written\n")
+
 if __name__ == "__main__":
     sys.exit(main())
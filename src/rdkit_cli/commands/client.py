@@ -0,0 +1,239 @@
+"""Client command implementation."""
+
+import sys
+
+from rdkit_cli.cli import RdkitHelpFormatter
+
+
+def register_parser(subparsers):
+    """Register the client command."""
+    parser = subparsers.add_parser(
+        "client",
+        help="Submit jobs to a running 'rdkit-cli serve'",
+        description="Send SMILES to a job server and write the results. The client does "
+                    "not import RDKit: input is read as SMILES lines (SMILES [name]) or "
+                    "CSV/TSV columns, and results are written as JSON lines (default, "
+                    "stdout), JSON, CSV or an Arrow IPC stream (.arrow).",
+        formatter_class=RdkitHelpFormatter,
+    )
+
+    parser.add_argument(
+        "job",
+        nargs="?",
+        metavar="JOB",
+        help="Job to run: descriptors, fingerprints, filter, sascorer or standardize",
+    )
+    parser.add_argument(
+        "-i", "--input",
+        default=None,
+        metavar="FILE",
+        help="Input file: .smi/.txt lines 'SMILES [name]', or .csv/.tsv ('-' for stdin lines)",
+    )
+    parser.add_argument(
+        "--smiles",
+        nargs="+",
+        default=None,
+        metavar="SMILES",
+        help="Input SMILES given on the command line",
+    )
+    parser.add_argument(
+        "-o", "--output",
+        default=None,
+        metavar="FILE",
+        help="Output file (.jsonl, .json, .csv or .arrow; default: JSON lines on stdout)",
+    )
+    parser.add_argument(
+        "--options",
+        default=None,
+        metavar="JSON",
+        help="Job options as a JSON object, e.g. '{\"descriptors\": \"MolWt,TPSA\"}'",
+    )
+    parser.add_argument(
+        "--smiles-column",
+        default="smiles",
+        metavar="COL",
+        help="SMILES column of CSV/TSV input (default: smiles)",
+    )
+    parser.add_argument(
+        "--name-column",
+        default=None,
+        metavar="COL",
+        help="Name column of CSV/TSV input",
+    )
+    parser.add_argument(
+        "--batch-size",
+        type=int,
+        default=10000,
+        metavar="N",
+        help="Molecules per request (default: 10000; .arrow output is sent as one request)",
+    )
+    parser.add_argument(
+        "--socket",
+        default=None,
+        metavar="PATH",
+        help="Server Unix socket",
+    )
+    parser.add_argument(
+        "--url",
+        default=None,
+        metavar="URL",
+        help="Server URL (default: http://127.0.0.1:8765)",
+    )
+    parser.add_argument(
+        "--health",
+        action="store_true",
+        help="Print the server status and exit",
+    )
+    parser.add_argument(
+        "--shutdown",
+        action="store_true",
+        help="Stop the server",
+    )
+    parser.add_argument(
+        "-q", "--quiet",
+        action="store_true",
+        help="Don't print the summary",
+    )
+
+    parser.set_defaults(func=run_client)
+
+
+def _read_molecules(args) -> tuple[list[str], list[str]]:
+    """Read (SMILES, names) from --smiles or -i without parsing molecules."""
+    import csv
+    from pathlib import Path
+
+    if args.smiles is not None:
+        return list(args.smiles), [""] * len(args.smiles)
+
+    if args.input == "-":
+        lines = sys.stdin.read().splitlines()
+    else:
+        path = Path(args.input)
+        if not path.exists():
+            raise ValueError(f"Input file not found: {path}")
+        suffix = path.suffix.lower()
+        if suffix in (".csv", ".tsv"):
+            with open(path, newline="") as f:
+                reader = csv.DictReader(f, delimiter="\t" if suffix == ".tsv" else ",")
+                if args.smiles_column not in (reader.fieldnames or []):
+                    raise ValueError(f"SMILES column '{args.smiles_column}' not found in {path}")
+                rows = list(reader)
+            smiles = [row[args.smiles_column] for row in rows]
+            names = [row.get(args.name_column, "") if args.name_column else "" for row in rows]
+            return smiles, names
+        lines = path.read_text().splitlines()
+
+    smiles, names = [], []
+    for line in lines:
+        parts = line.split(None, 1)
+        if not parts or parts[0].startswith("#"):
+            continue
+        smiles.append(parts[0])
+        names.append(parts[1].strip() if len(parts) > 1 else "")
+    return smiles, names
+
+
+def _write_results(output, rows: list):
+    """Write result rows in the format of the output extension."""
+    import json
+    from pathlib import Path
+
+    if output is None:
+        for row in rows:
+            sys.stdout.write(json.dumps(row) + "\n")
+        return
+
+    path = Path(output)
+    suffix = path.suffix.lower()
+    if suffix == ".json":
+        path.write_text(json.dumps({"results": rows}, indent=2) + "\n")
+    elif suffix == ".csv":
+        import csv
+
+        present = [row for row in rows if row is not None]
+        columns: dict[str, None] = {}
+        for row in present:
+            columns.update(dict.fromkeys(row))
+        with open(path, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=list(columns))
+            writer.writeheader()
+            writer.writerows(present)
+    else:
+        with open(path, "w") as f:
+            for row in rows:
+                f.write(json.dumps(row) + "\n")
+
+
+def run_client(args) -> int:
+    """Run the client command."""
+    import json
+    from pathlib import Path
+
+    from rdkit_cli.parallel.client import ServerClient, ServerError, server_url
+
+    try:
+        client = ServerClient(server_url(args.socket, args.url))
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+
+    try:
+        with client:
+            if args.health:
+                print(json.dumps(client.health(), indent=2))
+                return 0
+            if args.shutdown:
+                client.shutdown()
+                if not args.quiet:
+                    print(f"Stopped server at {client.url}", file=sys.stderr)
+                return 0
+
+            if args.job is None:
+                print("Error: JOB is required (or --health / --shutdown)", file=sys.stderr)
+                return 1
+            if (args.input is None) == (args.smiles is None):
+                print("Error: Give exactly one of -i/--input and --smiles", file=sys.stderr)
+                return 1
+
+            options = None
+            if args.options is not None:
+                options = json.loads(args.options)
+                if not isinstance(options, dict):
+                    print("Error: --options must be a JSON object", file=sys.stderr)
+                    return 1
+
+            smiles, names = _read_molecules(args)
+            arrow = args.output is not None and Path(args.output).suffix.lower() == ".arrow"
+            # One Arrow stream per response, so Arrow output is a single request
+            batch_size = max(1, len(smiles)) if arrow else max(1, args.batch_size)
+
+            successful = failed = 0
+            rows: list = []
+            streams: list[bytes] = []
+            for start in range(0, len(smiles), batch_size):
+                chunk = slice(start, start + batch_size)
+                if arrow:
+                    data, counts = client.run_arrow(args.job, smiles[chunk], names[chunk], options)
+                    streams.append(data)
+                else:
+                    counts = client.run(args.job, smiles[chunk], names[chunk], options)
+                    rows.extend(counts["results"])
+                successful += counts["successful"]
+                failed += counts["failed"]
+
+            if arrow:
+                Path(args.output).write_bytes(streams[0] if streams else b"")
+            else:
+                _write_results(args.output, rows)
+    except (ServerError, ValueError) as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+    except OSError as e:
+        print(f"Error: Cannot reach server at {client.url}: {e}", file=sys.stderr)
+        return 1
+
+    if not args.quiet:
+        print(f"Processed {successful + failed} molecules: {successful} successful, {failed} failed",
+              file=sys.stderr)
+    return 0
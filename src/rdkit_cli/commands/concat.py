@@ -0,0 +1,65 @@
+"""Concat command implementation."""
+
+import sys
+from pathlib import Path
+
+from rdkit_cli.cli import RdkitHelpFormatter
+
+
+def register_parser(subparsers):
+    """Register the concat command."""
+    parser = subparsers.add_parser(
+        "concat",
+        help="Concatenate output files (e.g. --shard outputs)",
+        description="Concatenate files of one format in the given order without "
+                    "re-parsing molecules. Combines the outputs of --shard I/N runs "
+                    "into the output of the unsharded run.",
+        formatter_class=RdkitHelpFormatter,
+    )
+
+    parser.add_argument(
+        "-i", "--input",
+        nargs="+",
+        required=True,
+        metavar="FILE",
+        dest="input_files",
+        help="Input files, in shard order (same format as the output)",
+    )
+    parser.add_argument(
+        "-o", "--output",
+        required=True,
+        metavar="FILE",
+        help="Output file",
+    )
+    parser.add_argument(
+        "-q", "--quiet",
+        action="store_true",
+        help="Suppress progress output",
+    )
+
+    parser.set_defaults(func=run_concat)
+
+
+def run_concat(args) -> int:
+    """Run the concat command."""
+    from rdkit_cli.core.concat import concat_files
+
+    input_paths = []
+    for f in args.input_files:
+        path = Path(f)
+        if not path.exists():
+            print(f"Error: Input file not found: {path}", file=sys.stderr)
+            return 1
+        input_paths.append(path)
+
+    output_path = Path(args.output)
+    if any(path.resolve() == output_path.resolve() for path in input_paths):
+        print("Error: Output file must not be one of the inputs", file=sys.stderr)
+        return 1
+
+    n_files = concat_files(input_paths, output_path)
+
+    if not args.quiet:
+        print(f"Concatenated {n_files} files. Wrote to {output_path}", file=sys.stderr)
+
+    return 0
@@ -3,7 +3,13 @@
 import sys
 from pathlib import Path
 
-from rdkit_cli.cli import RdkitHelpFormatter, add_common_io_options, add_common_processing_options
+from rdkit_cli.cli import (
+    InputFile,
+    RdkitHelpFormatter,
+    add_common_io_options,
+    add_common_processing_options,
+    add_shard_options,
+)
 
 
 def register_parser(subparsers):
@@ -29,6 +35,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(gen_parser)
     add_common_processing_options(gen_parser)
+    add_shard_options(gen_parser)
     gen_parser.add_argument(
         "--num",
         type=int,
@@ -106,6 +113,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(opt_parser)
     add_common_processing_options(opt_parser)
+    add_shard_options(opt_parser)
     opt_parser.add_argument(
         "-f", "--force-field",
         choices=["mmff", "uff"],
@@ -131,6 +139,7 @@ def register_parser(subparsers):
     const_parser.add_argument(
         "-r", "--reference",
         required=True,
+        type=InputFile,
         metavar="FILE",
         help="Reference molecule file with 3D coords (SDF, MOL, PDB)",
     )
@@ -195,17 +204,10 @@ def register_parser(subparsers):
 def run_generate(args) -> int:
     """Run conformer generation."""
     # Lazy imports
-    from rdkit_cli.core.conformers import ConformerGenerator
+    from rdkit_cli.core.conformers import ConformerGenerator, conformer_cost
     from rdkit_cli.io import create_reader, create_writer, FileFormat
     from rdkit_cli.parallel.batch import process_molecules
-
-    generator = ConformerGenerator(
-        num_conformers=args.num,
-        method=args.method,
-        optimize=not args.no_optimize,
-        force_field=args.force_field,
-        random_seed=args.seed,
-    )
+    from rdkit_cli.parallel.executor import plan_parallelism
 
     input_path = Path(args.input)
     if not input_path.exists():
@@ -219,6 +221,19 @@ def run_generate(args) -> int:
         has_header=not args.no_header,
     )
 
+    # Embedding parallelizes over conformers: use worker processes across
+    # molecules, and give each molecule the cores left over on small inputs
+    n_workers, num_threads = plan_parallelism(args.ncpu, reader.estimate_len(), args.num)
+
+    generator = ConformerGenerator(
+        num_conformers=args.num,
+        method=args.method,
+        optimize=not args.no_optimize,
+        force_field=args.force_field,
+        random_seed=args.seed,
+        num_threads=num_threads,
+    )
+
     # Force SDF output for 3D structures
     output_path = Path(args.output)
     writer = create_writer(output_path, format_override=FileFormat.SDF)
@@ -228,8 +243,9 @@ def run_generate(args) -> int:
             reader=reader,
             writer=writer,
             processor=generator.generate,
-            n_workers=args.ncpu,
+            n_workers=n_workers,
             quiet=args.quiet,
+            cost=conformer_cost,
         )
 
     if not args.quiet:
@@ -3,7 +3,12 @@
 import sys
 from pathlib import Path
 
-from rdkit_cli.cli import RdkitHelpFormatter, add_common_io_options, add_common_processing_options
+from rdkit_cli.cli import (
+    RdkitHelpFormatter,
+    add_common_io_options,
+    add_common_processing_options,
+    add_shard_options,
+)
 
 # Define formats here to avoid loading io module at startup
 FILE_FORMATS = ["csv", "tsv", "smi", "sdf", "parquet"]
@@ -20,6 +25,7 @@ def register_parser(subparsers):
 
     add_common_io_options(parser)
     add_common_processing_options(parser)
+    add_shard_options(parser)
 
     parser.add_argument(
         "--in-format",
@@ -150,6 +156,7 @@ def run_convert(args) -> int:
             processor=converter.convert,
             n_workers=args.ncpu,
             quiet=args.quiet,
+            join_metadata=True,
         )
 
     if not args.quiet:
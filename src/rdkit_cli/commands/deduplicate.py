@@ -30,6 +30,19 @@ def register_parser(subparsers):
         default="first",
         help="Which duplicate to keep (default: first)",
     )
+    parser.add_argument(
+        "--spill-dir",
+        metavar="DIR",
+        default=None,
+        help="Hash-partition keys into runs under DIR instead of holding them in memory (for inputs larger than RAM)",
+    )
+    parser.add_argument(
+        "--partitions",
+        type=int,
+        default=None,
+        metavar="N",
+        help="Number of hash partitions with --spill-dir (default: 64)",
+    )
     parser.add_argument(
         "--list-keys",
         action="store_true",
@@ -41,8 +54,9 @@ def register_parser(subparsers):
 
 def run_deduplicate(args) -> int:
     """Run the deduplicate command."""
-    from rdkit_cli.core.deduplicate import Deduplicator
+    from rdkit_cli.core.deduplicate import DEFAULT_PARTITIONS, Deduplicator, iter_key_hashes
     from rdkit_cli.io import create_reader, create_writer
+    from rdkit_cli.io.readers import passthrough_row
     from rdkit_cli.progress.ninja import NinjaProgress
 
     # Handle --list-keys
@@ -59,6 +73,10 @@ def run_deduplicate(args) -> int:
         print(f"Error: Input file not found: {input_path}", file=sys.stderr)
         return 1
 
+    if args.partitions is not None and args.partitions < 1:
+        print("Error: --partitions must be positive", file=sys.stderr)
+        return 1
+
     # Create reader
     reader = create_reader(
         input_path,
@@ -67,56 +85,60 @@ def run_deduplicate(args) -> int:
         has_header=not args.no_header,
     )
 
-    # Read all records with progress
-    if not args.quiet:
-        print("Reading molecules...", file=sys.stderr)
-
-    records = []
-    with reader:
-        total = len(reader)
-        progress = NinjaProgress(total=total, quiet=args.quiet)
-        progress.start()
-
-        for record in reader:
-            records.append(record)
-            progress.update(1)
-
-        progress.finish()
-
-    if not records:
-        print("Error: No molecules found in input file", file=sys.stderr)
-        return 1
-
-    if not args.quiet:
-        print(f"Deduplicating {len(records)} molecules by {args.by}...", file=sys.stderr)
-
-    # Create deduplicator
     deduplicator = Deduplicator(
         key_type=args.by,
         keep=args.keep,
+        spill_dir=args.spill_dir,
+        n_partitions=args.partitions or DEFAULT_PARTITIONS,
     )
 
-    # Deduplicate
-    unique_records, n_duplicates = deduplicator.deduplicate(records)
+    if not args.quiet:
+        print(f"Deduplicating by {args.by}...", file=sys.stderr)
 
-    # Write output
     output_path = Path(args.output)
-    writer = create_writer(output_path)
-
-    with writer:
-        for record in unique_records:
-            row = {"smiles": record.smiles}
-            if record.name:
-                row["name"] = record.name
-            for key, value in record.metadata.items():
-                if key not in row and key != "smiles":
-                    row[key] = value
-            writer.write_row(row)
+    n_written = 0
+
+    with reader, create_writer(output_path) as writer:
+        progress = NinjaProgress.for_reader(reader, quiet=args.quiet)
+        progress.start()
+
+        # Keys are hashed in the workers; rows and metadata stay here
+        if reader.supports_raw:
+            items = reader.iter_raw()
+            parse = reader.raw_parser
+        else:
+            items = iter(reader)
+            parse = None
+
+        hashed = iter_key_hashes(items, key_type=args.by, parse=parse, n_workers=args.ncpu)
+
+        def rows():
+            for digest, smiles, name, metadata in hashed:
+                progress.update()
+                yield digest, passthrough_row(smiles, name, metadata)
+
+        buffer = []
+        try:
+            for row in deduplicator.deduplicate_rows(rows()):
+                buffer.append(row)
+                if len(buffer) >= 1000:
+                    writer.write_batch(buffer)
+                    n_written += len(buffer)
+                    buffer = []
+            if buffer:
+                writer.write_batch(buffer)
+                n_written += len(buffer)
+        finally:
+            progress.finish()
+
+    if deduplicator.n_rows == 0:
+        print("Error: No molecules found in input file", file=sys.stderr)
+        return 1
 
     if not args.quiet:
         print(
-            f"Removed {n_duplicates} duplicates. "
-            f"Wrote {len(unique_records)} unique molecules to {output_path}",
+            f"Removed {deduplicator.n_duplicates} duplicates. "
+            f"Wrote {n_written} unique molecules to {output_path}",
             file=sys.stderr,
         )
 
@@ -3,7 +3,7 @@
 import sys
 from pathlib import Path
 
-from rdkit_cli.cli import RdkitHelpFormatter, add_common_processing_options
+from rdkit_cli.cli import RdkitHelpFormatter, add_common_processing_options, add_shard_options
 
 
 def register_parser(subparsers):
@@ -121,6 +121,9 @@ def register_parser(subparsers):
     batch_parser = depict_subparsers.add_parser(
         "batch",
         help="Depict molecules from file to individual images",
+        description="Render one image per molecule on the worker pool. Images are "
+                    "written as they are rendered, into a directory or a single "
+                    ".zip, .tar or .tar.gz archive.",
         formatter_class=RdkitHelpFormatter,
     )
     batch_parser.add_argument(
@@ -133,9 +136,10 @@ def register_parser(subparsers):
         "-o", "--output-dir",
         required=True,
         metavar="DIR",
-        help="Output directory for images",
+        help="Output directory for images, or a .zip/.tar/.tar.gz archive",
     )
     add_common_processing_options(batch_parser)
+    add_shard_options(batch_parser)
     batch_parser.add_argument(
         "-f", "--format",
         choices=["svg", "png"],
@@ -182,7 +186,7 @@ def register_parser(subparsers):
     batch_parser.add_argument(
         "--overwrite",
         action="store_true",
-        help="Overwrite existing files (default: skip)",
+        help="Overwrite existing files in the output directory (default: skip)",
     )
     batch_parser.set_defaults(func=run_batch)
 
@@ -265,7 +269,8 @@ def register_parser(subparsers):
     grid_parser.add_argument(
         "--sort-by",
         metavar="COL",
-        help="Sort molecules by column value",
+        help="Sort molecules by column value (numbers before text); keeps only "
+             "--offset + --max-mols rows in memory",
     )
     grid_parser.add_argument(
         "--sort-desc",
@@ -358,16 +363,26 @@ def run_single(args) -> int:
 
 def run_batch(args) -> int:
     """Run batch depiction."""
-    from rdkit_cli.core.depict import MoleculeDepiction
+    from rdkit_cli.core.depict import ImageWriter, MoleculeDepiction
     from rdkit_cli.io import create_reader
+    from rdkit_cli.parallel.batch import process_molecules
 
     input_path = Path(args.input)
     if not input_path.exists():
         print(f"Error: Input file not found: {input_path}", file=sys.stderr)
         return 1
 
-    output_dir = Path(args.output_dir)
-    output_dir.mkdir(parents=True, exist_ok=True)
+    try:
+        depictor = MoleculeDepiction(
+            width=args.width,
+            height=args.height,
+            image_format=args.format,
+            highlight_smarts=args.highlight,
+            add_legend=args.add_legend,
+        )
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
 
     reader = create_reader(
         input_path,
@@ -376,43 +391,68 @@ def run_batch(args) -> int:
         has_header=not args.no_header,
     )
 
-    depictor = MoleculeDepiction(
-        width=args.width,
-        height=args.height,
+    output_path = Path(args.output_dir)
+    writer = ImageWriter(
+        output_path,
         image_format=args.format,
-    )
+        prefix=args.prefix,
+        suffix=args.suffix,
+        use_index=args.use_index,
+        overwrite=args.overwrite,
+    )
+
+    # Workers keep their drawer options across molecules; images reach
+    # the writer in input order and are written as they arrive
+    with reader, writer:
+        result = process_molecules(
+            reader=reader,
+            writer=writer,
+            processor=depictor.depict_record,
+            n_workers=args.ncpu,
+            quiet=args.quiet,
+        )
 
-    count = 0
-    failed = 0
+    if not args.quiet:
+        skipped = f", {writer.skipped} existing skipped" if writer.skipped else ""
+        print(
+            f"Generated {writer.written} images ({result.failed} failed{skipped}) "
+            f"in {output_path} in {result.elapsed_time:.1f}s",
+            file=sys.stderr,
+        )
 
-    for i, record in enumerate(reader):
-        if record.mol is None:
-            failed += 1
-            continue
+    return 0
 
-        image_data = depictor.depict(record.mol)
-        if image_data is None:
-            failed += 1
-            continue
 
-        # Generate filename
-        name = record.name or f"mol_{i}"
-        # Sanitize filename
-        name = "".join(c for c in name if c.isalnum() or c in "-_")
-        filename = f"{name}.{args.format}"
+def _sort_value(value, descending: bool = False) -> tuple:
+    """Sort key of a column value: numbers (by value) before text, either way."""
+    try:
+        number = float(value)
+    except (TypeError, ValueError):
+        return (1, 0.0, "" if value is None else str(value))
+    return (0, -number if descending else number, "")
 
-        output_path = output_dir / filename
 
-        mode = "w" if args.format == "svg" else "wb"
-        with open(output_path, mode) as f:
-            f.write(image_data)
+def _select_rows(reader, args) -> list:
+    """
+    Pick the grid's input rows without parsing or holding the whole file.
 
-        count += 1
+    Rows are read unparsed; without --sort-by reading stops after the
+    selected window, and with it only the top --offset + --max-mols rows
+    are kept.
+    """
+    import heapq
+    from itertools import islice
 
-    if not args.quiet:
-        print(f"Generated {count} images ({failed} failed) in {output_dir}", file=sys.stderr)
+    rows = reader.iter_passthrough()
+    stop = args.offset + args.max_mols
+    if not args.sort_by:
+        return list(islice(rows, args.offset, stop))
 
-    return 0
+    column = args.sort_by
+    top = heapq.nsmallest(
+        stop, rows, key=lambda raw: _sort_value((raw.metadata or {}).get(column), args.sort_desc)
+    )
+    return top[args.offset:]
 
 
 def run_grid(args) -> int:
@@ -442,21 +482,38 @@ def run_grid(args) -> int:
     if not args.quiet:
         print("Reading molecules...", file=sys.stderr)
 
-    # Read molecules
-    records = list(reader)[:args.max_mols]
+    # Only the selected rows are parsed
+    with reader:
+        rows = _select_rows(reader, args)
+        records = [reader.raw_parser(*raw) for raw in rows]
+
+    if args.sort_by and rows and args.sort_by not in (rows[0].metadata or {}):
+        print(f"Error: Sort column '{args.sort_by}' not found", file=sys.stderr)
+        return 1
+
     mols = [r.mol for r in records]
-    legends = [r.name or "" for r in records]
+    if args.no_legends:
+        legends = None
+    elif args.legend_column:
+        legends = [str(r.metadata.get(args.legend_column, "")) for r in records]
+    else:
+        legends = [r.name or "" for r in records]
 
     if not args.quiet:
         print(f"Generating grid for {len(mols)} molecules...", file=sys.stderr)
 
-    grid_depictor = GridDepiction(
-        mols_per_row=args.mols_per_row,
-        mol_width=args.mol_width,
-        mol_height=args.mol_height,
-        legends=legends,
-        use_svg=(image_format == "svg"),
-    )
+    try:
+        grid_depictor = GridDepiction(
+            mols_per_row=args.mols_per_row,
+            mol_width=args.mol_width,
+            mol_height=args.mol_height,
+            legends=legends,
+            use_svg=(image_format == "svg"),
+            highlight_smarts=args.highlight,
+        )
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
 
     image_data = grid_depictor.depict(mols)
 
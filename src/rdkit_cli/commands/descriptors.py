@@ -3,7 +3,12 @@
 import sys
 from pathlib import Path
 
-from rdkit_cli.cli import RdkitHelpFormatter, add_common_io_options, add_common_processing_options
+from rdkit_cli.cli import (
+    RdkitHelpFormatter,
+    add_common_io_options,
+    add_common_processing_options,
+    add_shard_options,
+)
 
 # Lazy imports - these are only imported when command runs
 # from rdkit_cli.core.descriptors import ...
@@ -64,6 +69,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(compute_parser)
     add_common_processing_options(compute_parser)
+    add_shard_options(compute_parser)
 
     desc_group = compute_parser.add_mutually_exclusive_group()
     desc_group.add_argument(
@@ -291,6 +297,7 @@ def run_compute(args) -> int:
     writer = create_writer(
         output_path,
         columns=calculator.get_column_names(),
+        null_value=args.error_value,
     )
 
     # Process
@@ -301,6 +308,7 @@ def run_compute(args) -> int:
             processor=calculator.compute,
             n_workers=args.ncpu,
             quiet=args.quiet,
+            batch_processor=calculator.compute_batch,
         )
 
     if not args.quiet:
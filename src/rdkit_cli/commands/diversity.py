@@ -29,7 +29,6 @@ def register_parser(subparsers):
     )
     pick_parser.add_argument(
         "-i", "--input",
-        required=True,
         metavar="FILE",
         help="Input file",
     )
@@ -40,6 +39,13 @@ def register_parser(subparsers):
         help="Output file",
     )
     add_common_processing_options(pick_parser)
+    pick_parser.add_argument(
+        "--fp-db",
+        default=None,
+        metavar="FILE",
+        help="Use a fingerprint store (.fpdb from 'fingerprints compute') instead of -i; "
+             "fingerprint parameters come from the store",
+    )
     pick_parser.add_argument(
         "-k", "--num-picks",
         type=int,
@@ -120,28 +126,6 @@ def run_pick(args) -> int:
     from rdkit_cli.core.diversity import DiversityPicker
     from rdkit_cli.io import create_reader, create_writer
 
-    input_path = Path(args.input)
-    if not input_path.exists():
-        print(f"Error: Input file not found: {input_path}", file=sys.stderr)
-        return 1
-
-    reader = create_reader(
-        input_path,
-        smiles_column=args.smiles_column,
-        name_column=args.name_column,
-        has_header=not args.no_header,
-    )
-
-    if not args.quiet:
-        print("Reading molecules...", file=sys.stderr)
-
-    # Read all records
-    records = list(reader)
-    mols = [r.mol for r in records]
-
-    if not args.quiet:
-        print(f"Picking {args.num_picks} diverse molecules from {len(mols)}...", file=sys.stderr)
-
     # Create picker
     picker = DiversityPicker(
         n_picks=args.num_picks,
@@ -151,22 +135,67 @@ def run_pick(args) -> int:
         method=args.method,
     )
 
-    # Pick diverse subset
-    selected_indices = picker.pick(mols)
+    if args.fp_db:
+        from rdkit_cli.core.fpstore import FingerprintStore
+
+        store_path = Path(args.fp_db)
+        if not store_path.exists():
+            print(f"Error: Fingerprint store not found: {store_path}", file=sys.stderr)
+            return 1
+
+        with FingerprintStore(store_path) as store:
+            all_smiles = store.smiles
+            all_names = store.names
+            if not args.quiet:
+                print(
+                    f"Picking {args.num_picks} diverse molecules from {len(store)}...",
+                    file=sys.stderr,
+                )
+            selected_indices = picker.pick_fingerprints(store.bit_vectors())
+    else:
+        if not args.input:
+            print("Error: one of -i/--input or --fp-db is required", file=sys.stderr)
+            return 1
+
+        input_path = Path(args.input)
+        if not input_path.exists():
+            print(f"Error: Input file not found: {input_path}", file=sys.stderr)
+            return 1
+
+        reader = create_reader(
+            input_path,
+            smiles_column=args.smiles_column,
+            name_column=args.name_column,
+            has_header=not args.no_header,
+        )
+
+        if not args.quiet:
+            print("Reading molecules...", file=sys.stderr)
+
+        # Read all records
+        records = list(reader)
+        mols = [r.mol for r in records]
+        all_smiles = [r.smiles for r in records]
+        all_names = [r.name for r in records]
+
+        if not args.quiet:
+            print(f"Picking {args.num_picks} diverse molecules from {len(mols)}...", file=sys.stderr)
+
+        # Pick diverse subset
+        selected_indices = picker.pick(mols)
 
     # Write output
     output_path = Path(args.output)
     writer = create_writer(output_path)
 
     with writer:
-        for idx in selected_indices:
-            record = records[idx]
+        for rank, idx in enumerate(selected_indices):
             result = {
-                "smiles": record.smiles,
-                "diversity_rank": selected_indices.index(idx),
+                "smiles": all_smiles[idx],
+                "diversity_rank": rank,
             }
-            if record.name:
-                result["name"] = record.name
+            if all_names[idx]:
+                result["name"] = all_names[idx]
             writer.write_row(result)
 
     if not args.quiet:
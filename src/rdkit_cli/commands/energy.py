@@ -7,6 +7,7 @@ from rdkit_cli.cli import (
     RdkitHelpFormatter,
     add_common_io_options,
     add_common_processing_options,
+    add_shard_options,
 )
 
 
@@ -33,6 +34,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(compute_parser)
     add_common_processing_options(compute_parser)
+    add_shard_options(compute_parser)
     compute_parser.add_argument(
         "-f", "--force-field",
         choices=["mmff", "uff"],
@@ -49,6 +51,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(minimize_parser)
     add_common_processing_options(minimize_parser)
+    add_shard_options(minimize_parser)
     minimize_parser.add_argument(
         "-f", "--force-field",
         choices=["mmff", "uff"],
@@ -3,7 +3,14 @@
 import sys
 from pathlib import Path
 
-from rdkit_cli.cli import RdkitHelpFormatter, add_common_io_options, add_common_processing_options
+from rdkit_cli.cli import (
+    InputFile,
+    RdkitHelpFormatter,
+    add_common_io_options,
+    add_common_processing_options,
+    add_shard_options,
+    reject_shard_options,
+)
 
 # Define here to avoid loading core at startup
 DRUGLIKE_RULES = ["lipinski", "veber", "ghose", "egan", "muegge"]
@@ -30,14 +37,42 @@ def register_parser(subparsers):
         help="Filter by substructure (SMARTS)",
         formatter_class=RdkitHelpFormatter,
     )
-    add_common_io_options(sub_parser)
+    add_common_io_options(sub_parser, input_required=False)
     add_common_processing_options(sub_parser)
+    add_shard_options(sub_parser)
     sub_parser.add_argument(
         "-s", "--smarts",
-        required=True,
+        default=None,
         metavar="PATTERN",
         help="SMARTS pattern to match",
     )
+    sub_parser.add_argument(
+        "--smarts-file",
+        default=None,
+        type=InputFile,
+        metavar="FILE",
+        help="File of SMARTS patterns (one per line, optional name after whitespace), "
+             "matched in one pass",
+    )
+    sub_parser.add_argument(
+        "--match",
+        choices=["any", "all"],
+        default="any",
+        help="With several patterns, require any or all of them to match (default: any)",
+    )
+    sub_parser.add_argument(
+        "--add-matches",
+        action="store_true",
+        help="Add matched_patterns column with the names of the matching patterns",
+    )
+    sub_parser.add_argument(
+        "--fp-db",
+        default=None,
+        type=InputFile,
+        metavar="FILE",
+        help="Screen a pattern fingerprint store (.fpdb from 'fingerprints compute --type pattern') "
+             "instead of -i; only molecules passing the bit screen are matched",
+    )
     sub_parser.add_argument(
         "--exclude",
         action="store_true",
@@ -82,6 +117,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(prop_parser)
     add_common_processing_options(prop_parser)
+    add_shard_options(prop_parser)
     prop_parser.add_argument(
         "-r", "--rule",
         action="append",
@@ -98,6 +134,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(drug_parser)
     add_common_processing_options(drug_parser)
+    add_shard_options(drug_parser)
     drug_parser.add_argument(
         "-r", "--rule",
         choices=DRUGLIKE_RULES,
@@ -131,6 +168,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(pains_parser)
     add_common_processing_options(pains_parser)
+    add_shard_options(pains_parser)
     pains_parser.add_argument(
         "--keep-pains",
         action="store_true",
@@ -157,6 +195,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(alerts_parser)
     add_common_processing_options(alerts_parser)
+    add_shard_options(alerts_parser)
     alerts_parser.add_argument(
         "--keep-matches",
         action="store_true",
@@ -185,6 +224,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(elem_parser)
     add_common_processing_options(elem_parser)
+    add_shard_options(elem_parser)
     elem_parser.add_argument(
         "--allowed",
         metavar="ELEMS",
@@ -211,6 +251,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(comp_parser)
     add_common_processing_options(comp_parser)
+    add_shard_options(comp_parser)
     comp_parser.add_argument(
         "--min-atoms",
         type=int,
@@ -255,6 +296,39 @@ def register_parser(subparsers):
     )
     comp_parser.set_defaults(func=run_complexity)
 
+    # filter chain
+    chain_parser = filter_subparsers.add_parser(
+        "chain",
+        help="Apply several filters in one pass",
+        description="Apply several filters to each molecule in one pass over the input. "
+                    "Cheap checks run first; a molecule stops at the first filter rejecting it.",
+        formatter_class=RdkitHelpFormatter,
+    )
+    add_common_io_options(chain_parser)
+    add_common_processing_options(chain_parser)
+    add_shard_options(chain_parser)
+    chain_parser.add_argument(
+        "--spec",
+        default=None,
+        type=InputFile,
+        metavar="FILE",
+        help='JSON filter spec: a list of {"filter": KIND, ...options} objects',
+    )
+    chain_parser.add_argument(
+        "--step",
+        action="append",
+        default=[],
+        metavar="STEP",
+        help="Filter step 'KIND key=value ...' (e.g. 'druglike rule=lipinski', "
+             "'elements allowed=C,H,N,O'); repeatable, added after --spec",
+    )
+    chain_parser.add_argument(
+        "--keep-order",
+        action="store_true",
+        help="Run filters in the given order instead of cheapest first",
+    )
+    chain_parser.set_defaults(func=run_chain)
+
     # Set default for main parser
     parser.set_defaults(func=lambda args: parser.print_help() or 1)
 
@@ -263,52 +337,133 @@ def run_substructure(args) -> int:
     """Run the substructure filter."""
     # Lazy imports
     from rdkit_cli.core.filters import SubstructureFilter
-    from rdkit_cli.io import create_reader, create_writer
-    from rdkit_cli.parallel.batch import process_molecules
+
+    if args.smarts is None and args.smarts_file is None:
+        print("Error: one of -s/--smarts or --smarts-file is required", file=sys.stderr)
+        return 1
+    if args.input is None and args.fp_db is None:
+        print("Error: one of -i/--input or --fp-db is required", file=sys.stderr)
+        return 1
+
+    if args.smarts_file is None and args.fp_db is None and not args.add_matches:
+        try:
+            filter_obj = SubstructureFilter(
+                smarts=args.smarts,
+                exclude=args.exclude,
+            )
+        except ValueError as e:
+            print(f"Error: {e}", file=sys.stderr)
+            return 1
+        return _run_filter(args, filter_obj.filter)
+
+    patterns = _read_panel(args)
+    if patterns is None:
+        return 1
+
+    if args.fp_db is not None:
+        if reject_shard_options(args, "with --fp-db"):
+            return 1
+        return _run_substructure_store(args, patterns)
+
+    from rdkit_cli.core.filters import SubstructurePanel
 
     try:
-        filter_obj = SubstructureFilter(
-            smarts=args.smarts,
-            exclude=args.exclude,
-        )
+        panel = _build_panel(args, patterns)
     except ValueError as e:
         print(f"Error: {e}", file=sys.stderr)
         return 1
 
-    return _run_filter(args, filter_obj.filter)
+    return _run_filter(args, panel.filter)
+
+
+def _read_panel(args) -> list | None:
+    """Collect (smarts, name) pairs from -s and --smarts-file."""
+    from rdkit_cli.core.filters import read_smarts_file
+
+    patterns = []
+    if args.smarts is not None:
+        patterns.append((args.smarts, "smarts"))
+    if args.smarts_file is not None:
+        smarts_path = Path(args.smarts_file)
+        if not smarts_path.exists():
+            print(f"Error: SMARTS file not found: {smarts_path}", file=sys.stderr)
+            return None
+        patterns.extend(read_smarts_file(smarts_path))
+    if not patterns:
+        print(f"Error: No SMARTS patterns in {args.smarts_file}", file=sys.stderr)
+        return None
+    return patterns
+
+
+def _build_panel(args, patterns: list, **kwargs):
+    from rdkit_cli.core.filters import SubstructurePanel
+
+    return SubstructurePanel(
+        patterns,
+        mode=args.match,
+        exclude=args.exclude,
+        add_matches=args.add_matches,
+        use_chirality=args.use_chirality,
+        **kwargs,
+    )
+
+
+def _run_substructure_store(args, patterns: list) -> int:
+    """Run a substructure panel against a pattern fingerprint store."""
+    import time
+
+    from rdkit_cli.core.filters import filter_fingerprint_store
+    from rdkit_cli.core.fpstore import FingerprintStore
+    from rdkit_cli.io import create_writer
+
+    store_path = Path(args.fp_db)
+    if not store_path.exists():
+        print(f"Error: Fingerprint store not found: {store_path}", file=sys.stderr)
+        return 1
+
+    start = time.perf_counter()
+    passed = 0
+    try:
+        with FingerprintStore(store_path) as store:
+            total = len(store)
+            panel = _build_panel(args, patterns, screen_bits=store.params.n_bits)
+            with create_writer(Path(args.output)) as writer:
+                buffer = []
+                for result in filter_fingerprint_store(store, panel, n_workers=args.ncpu):
+                    buffer.append(result)
+                    passed += 1
+                    if len(buffer) >= 1000:
+                        writer.write_batch(buffer)
+                        buffer = []
+                if buffer:
+                    writer.write_batch(buffer)
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+
+    if not args.quiet:
+        print(
+            f"Passed: {passed}/{total} molecules in {time.perf_counter() - start:.1f}s",
+            file=sys.stderr,
+        )
+
+    return 0
 
 
 def run_property(args) -> int:
     """Run the property filter."""
     # Lazy imports
-    from rdkit_cli.core.filters import PropertyFilter
+    from rdkit_cli.core.filters import PropertyFilter, parse_property_rules
 
     if not args.rule:
         print("Error: At least one --rule is required", file=sys.stderr)
         return 1
 
-    # Parse rules
-    rules = {}
-    for rule in args.rule:
-        try:
-            if "<=" in rule:
-                prop, val = rule.split("<=")
-                rules[prop.strip()] = (None, float(val.strip()))
-            elif ">=" in rule:
-                prop, val = rule.split(">=")
-                rules[prop.strip()] = (float(val.strip()), None)
-            elif "<" in rule:
-                prop, val = rule.split("<")
-                rules[prop.strip()] = (None, float(val.strip()))
-            elif ">" in rule:
-                prop, val = rule.split(">")
-                rules[prop.strip()] = (float(val.strip()), None)
-            else:
-                print(f"Error: Invalid rule format: {rule}", file=sys.stderr)
-                return 1
-        except ValueError as e:
-            print(f"Error parsing rule '{rule}': {e}", file=sys.stderr)
-            return 1
+    try:
+        rules = parse_property_rules(args.rule)
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
 
     filter_obj = PropertyFilter(rules=rules)
     return _run_filter(args, filter_obj.filter)
@@ -380,8 +535,30 @@ def run_complexity(args) -> int:
     return _run_filter(args, filter_obj.filter)
 
 
-def _run_filter(args, filter_func) -> int:
-    """Common filter execution."""
+def run_chain(args) -> int:
+    """Run several filters in one pass."""
+    # Lazy import
+    from rdkit_cli.core.filters import FilterChain, load_filter_spec, parse_filter_step
+
+    try:
+        spec = []
+        if args.spec is not None:
+            spec_path = Path(args.spec)
+            if not spec_path.exists():
+                print(f"Error: Filter spec not found: {spec_path}", file=sys.stderr)
+                return 1
+            spec.extend(load_filter_spec(spec_path))
+        spec.extend(parse_filter_step(step) for step in args.step)
+        chain = FilterChain(spec, keep_order=args.keep_order)
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+
+    return _run_filter(args, chain.filter, stage_labels=chain.labels)
+
+
+def _run_filter(args, filter_func, stage_labels=None) -> int:
+    """Common filter execution (stage_labels: report rejections per chain stage)."""
     # Lazy imports
     from rdkit_cli.io import create_reader, create_writer
     from rdkit_cli.parallel.batch import process_molecules
@@ -408,6 +585,7 @@ def _run_filter(args, filter_func) -> int:
             processor=filter_func,
             n_workers=args.ncpu,
             quiet=args.quiet,
+            join_metadata=True,
         )
 
     if not args.quiet:
@@ -419,5 +597,7 @@ def _run_filter(args, filter_func) -> int:
             f"(filtered: {filtered}, failed: {result.failed}) in {result.elapsed_time:.1f}s",
             file=sys.stderr,
         )
+        for label in stage_labels or []:
+            print(f"  rejected by {label}: {result.rejected.get(label, 0)}", file=sys.stderr)
 
     return 0
@@ -3,7 +3,12 @@
 import sys
 from pathlib import Path
 
-from rdkit_cli.cli import RdkitHelpFormatter, add_common_io_options, add_common_processing_options
+from rdkit_cli.cli import (
+    RdkitHelpFormatter,
+    add_common_io_options,
+    add_common_processing_options,
+    add_shard_options,
+)
 
 # Fingerprint types defined here to avoid importing core at startup
 FINGERPRINT_TYPES = [
@@ -43,6 +48,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(compute_parser)
     add_common_processing_options(compute_parser)
+    add_shard_options(compute_parser)
 
     compute_parser.add_argument(
         "-t", "--type",
@@ -74,7 +80,7 @@ def register_parser(subparsers):
         choices=["hex", "bitstring", "bits", "numpy"],
         default="hex",
         dest="output_format",
-        help="Output format (default: hex)",
+        help="Output format (default: hex; ignored for .fpdb fingerprint store output)",
     )
     compute_parser.add_argument(
         "--use-chirality",
@@ -125,19 +131,27 @@ def run_compute(args) -> int:
     """Run the compute subcommand."""
     # Lazy imports
     from rdkit_cli.core.fingerprints import FingerprintCalculator, FingerprintType
+    from rdkit_cli.core.fpstore import FingerprintStoreWriter, StoreParams, is_fpdb_path
     from rdkit_cli.io import create_reader, create_writer
     from rdkit_cli.parallel.batch import process_molecules
 
     # Parse fingerprint type
     fp_type = FingerprintType(args.type)
 
+    # A .fpdb output is a packed binary fingerprint store
+    output_path = Path(args.output)
+    to_store = is_fpdb_path(output_path)
+    if to_store and args.counts:
+        print("Error: --counts is not supported for fingerprint stores", file=sys.stderr)
+        return 1
+
     # Create calculator
     calculator = FingerprintCalculator(
         fp_type=fp_type,
         n_bits=args.bits,
         radius=args.radius,
         use_counts=args.counts,
-        output_format=args.output_format,
+        output_format="packed" if to_store else args.output_format,
         include_smiles=True,
         include_name=True,
     )
@@ -156,11 +170,16 @@ def run_compute(args) -> int:
     )
 
     # Create writer
-    output_path = Path(args.output)
-    writer = create_writer(
-        output_path,
-        columns=calculator.get_column_names(),
-    )
+    if to_store:
+        writer = FingerprintStoreWriter(
+            output_path,
+            StoreParams(fp_type=fp_type.value, n_bits=calculator.n_bits, radius=args.radius),
+        )
+    else:
+        writer = create_writer(
+            output_path,
+            columns=calculator.get_column_names(),
+        )
 
     # Process
     with reader, writer:
@@ -170,6 +189,7 @@ def run_compute(args) -> int:
             processor=calculator.compute,
             n_workers=args.ncpu,
             quiet=args.quiet,
+            batch_processor=calculator.compute_batch,
         )
 
     if not args.quiet:
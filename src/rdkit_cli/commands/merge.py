@@ -41,6 +41,19 @@ def register_parser(subparsers):
         default="smiles",
         help="Key for deduplication (default: smiles)",
     )
+    parser.add_argument(
+        "--spill-dir",
+        metavar="DIR",
+        default=None,
+        help="Spool rows and hash-partition dedupe keys under DIR (for inputs larger than RAM)",
+    )
+    parser.add_argument(
+        "--partitions",
+        type=int,
+        default=None,
+        metavar="N",
+        help="Number of hash partitions with --spill-dir (default: 64)",
+    )
     parser.add_argument(
         "--add-source",
         action="store_true",
@@ -52,6 +65,7 @@ def register_parser(subparsers):
 
 def run_merge(args) -> int:
     """Run the merge command."""
+    from rdkit_cli.core.deduplicate import DEFAULT_PARTITIONS
     from rdkit_cli.core.merge import MoleculeMerger
     from rdkit_cli.io import create_writer
 
@@ -64,6 +78,10 @@ def run_merge(args) -> int:
             return 1
         input_paths.append(path)
 
+    if args.partitions is not None and args.partitions < 1:
+        print("Error: --partitions must be positive", file=sys.stderr)
+        return 1
+
     if not args.quiet:
         print(f"Merging {len(input_paths)} files...", file=sys.stderr)
 
@@ -71,12 +89,16 @@ def run_merge(args) -> int:
         deduplicate=args.dedupe,
         dedupe_key=args.dedupe_by,
         add_source=args.add_source,
+        n_workers=args.ncpu,
+        spill_dir=args.spill_dir,
+        n_partitions=args.partitions or DEFAULT_PARTITIONS,
     )
 
     output_path = Path(args.output)
     writer = create_writer(output_path)
 
     total = 0
+    buffer = []
     with writer:
         for record in merger.merge_files(
             input_paths,
@@ -84,8 +106,13 @@ def run_merge(args) -> int:
             name_column=args.name_column,
             has_header=not args.no_header,
         ):
-            writer.write_row(record)
+            buffer.append(record)
+            if len(buffer) >= 1000:
+                writer.write_batch(buffer)
+                buffer = []
             total += 1
+        if buffer:
+            writer.write_batch(buffer)
 
     if not args.quiet:
         stats = merger.get_stats()
@@ -5,6 +5,9 @@ from pathlib import Path
 
 from rdkit_cli.cli import RdkitHelpFormatter, add_common_io_options, add_common_processing_options
 
+# Rows per chunk when counting transformations in mmp analyze
+_ANALYZE_CHUNK_ROWS = 100_000
+
 
 def register_parser(subparsers):
     """Register the mmp command and subcommands."""
@@ -59,6 +62,31 @@ def register_parser(subparsers):
         default=3,
         help="Minimum core size in heavy atoms (default: 3)",
     )
+    find_parser.add_argument(
+        "--max-group-size",
+        type=int,
+        default=None,
+        metavar="N",
+        help="Skip cores shared by more than N molecules (default: no limit)",
+    )
+    find_parser.add_argument(
+        "--aggregate",
+        action="store_true",
+        help="Write transformation counts (transformation,count,percentage) instead of pairs",
+    )
+    find_parser.add_argument(
+        "--spill-dir",
+        metavar="DIR",
+        default=None,
+        help="Directory for the on-disk core index (default: system temporary directory)",
+    )
+    find_parser.add_argument(
+        "--partitions",
+        type=int,
+        default=None,
+        metavar="N",
+        help="Number of core index partitions (default: 64)",
+    )
     find_parser.set_defaults(func=run_find)
 
     # mmp transform
@@ -164,7 +192,7 @@ def run_fragment(args) -> int:
 
 def run_find(args) -> int:
     """Run MMP pair finding."""
-    from rdkit_cli.core.mmp import find_matched_pairs
+    from rdkit_cli.core.mmp import DEFAULT_INDEX_PARTITIONS, MatchedPairFinder, summarize_transformations
     from rdkit_cli.io import create_reader, create_writer
 
     input_path = Path(args.input)
@@ -172,8 +200,13 @@ def run_find(args) -> int:
         print(f"Error: Input file not found: {input_path}", file=sys.stderr)
         return 1
 
+    for option, value in (("--max-group-size", args.max_group_size), ("--partitions", args.partitions)):
+        if value is not None and value < 1:
+            print(f"Error: {option} must be positive", file=sys.stderr)
+            return 1
+
     if not args.quiet:
-        print("Reading molecules...", file=sys.stderr)
+        print("Fragmenting molecules...", file=sys.stderr)
 
     reader = create_reader(
         input_path,
@@ -182,32 +215,54 @@ def run_find(args) -> int:
         has_header=not args.no_header,
     )
 
-    # Read all molecules
-    molecules = []
-    with reader:
-        for record in reader:
-            if record.mol is not None:
-                molecules.append((record.smiles, record.name or "", {}))
-
-    if not args.quiet:
-        print(f"Finding matched pairs in {len(molecules)} molecules...", file=sys.stderr)
+    finder = MatchedPairFinder(
+        max_cuts=args.max_cuts,
+        min_core_size=args.min_core_size,
+        max_group_size=args.max_group_size,
+        n_workers=args.ncpu,
+        spill_dir=args.spill_dir,
+        n_partitions=args.partitions or DEFAULT_INDEX_PARTITIONS,
+    )
 
     output_path = Path(args.output)
     writer = create_writer(output_path)
 
     pair_count = 0
-    with writer:
-        for pair in find_matched_pairs(
-            molecules,
-            max_cuts=args.max_cuts,
-            min_core_size=args.min_core_size,
-        ):
-            writer.write_row(pair)
-            pair_count += 1
+    with reader, writer:
+        # Molecules are parsed and fragmented in the workers
+        if reader.supports_raw:
+            items = ((raw.row_idx, raw.smiles, raw.name) for raw in reader.iter_raw(with_metadata=False))
+            parse = reader.raw_parser
+        else:
+            items = ((record.row_idx, record.smiles, record.name) for record in reader if record.mol is not None)
+            parse = None
+
+        if args.aggregate:
+            counts = finder.transformation_counts(items, parse=parse)
+            pair_count = sum(counts.values())
+            writer.write_batch([
+                {"transformation": trans, "count": count, "percentage": pct}
+                for trans, count, pct in summarize_transformations(counts, top_n=None)
+            ])
+        else:
+            buffer = []
+            for pair in finder.pairs(items, parse=parse):
+                buffer.append(pair)
+                pair_count += 1
+                if len(buffer) >= 1000:
+                    writer.write_batch(buffer)
+                    buffer = []
+            if buffer:
+                writer.write_batch(buffer)
 
     if not args.quiet:
+        skipped = ""
+        if finder.n_skipped_groups:
+            skipped = f" ({finder.n_skipped_groups} cores over --max-group-size skipped)"
+        what = "pair transformations" if args.aggregate else "matched pairs"
         print(
-            f"Found {pair_count} matched pairs. Wrote to {output_path}",
+            f"Found {pair_count} {what} in {finder.n_groups} cores from "
+            f"{finder.n_molecules} molecules{skipped}. Wrote to {output_path}",
             file=sys.stderr,
         )
 
@@ -266,8 +321,10 @@ def run_transform(args) -> int:
 
 def run_analyze(args) -> int:
     """Run transformation frequency analysis."""
+    from collections import Counter
+
     import pandas as pd
-    from rdkit_cli.core.mmp import analyze_transformations
+    from rdkit_cli.core.mmp import summarize_transformations
 
     input_path = Path(args.input)
     if not input_path.exists():
@@ -275,20 +332,22 @@ def run_analyze(args) -> int:
         return 1
 
     header = 0 if not args.no_header else None
-    df = pd.read_csv(input_path, header=header)
 
-    if args.no_header:
-        trans_col = df.columns[0]
-    else:
-        trans_col = args.transformation_column
+    # Count in chunks instead of loading the whole pair table
+    counts = Counter()
+    for chunk in pd.read_csv(input_path, header=header, chunksize=_ANALYZE_CHUNK_ROWS):
+        if args.no_header:
+            trans_col = chunk.columns[0]
+        else:
+            trans_col = args.transformation_column
 
-    if trans_col not in df.columns:
-        print(f"Error: Transformation column '{trans_col}' not found", file=sys.stderr)
-        return 1
+        if trans_col not in chunk.columns:
+            print(f"Error: Transformation column '{trans_col}' not found", file=sys.stderr)
+            return 1
+
+        counts.update(chunk[trans_col].dropna().tolist())
 
-    # Convert to list of dicts
-    pairs = [{"transformation": t} for t in df[trans_col].dropna().tolist()]
-    results = analyze_transformations(pairs, top_n=args.top)
+    results = summarize_transformations(counts, top_n=args.top)
 
     # Output
     output_lines = ["transformation,count,percentage"]
@@ -306,6 +365,6 @@ def run_analyze(args) -> int:
     else:
         print(output_text)
 
-    print(f"\nTotal transformations: {len(pairs)}, Unique: {len(set(p['transformation'] for p in pairs))}", file=sys.stderr)
+    print(f"\nTotal transformations: {sum(counts.values())}, Unique: {len(counts)}", file=sys.stderr)
 
     return 0
@@ -7,6 +7,7 @@ from rdkit_cli.cli import (
     RdkitHelpFormatter,
     add_common_io_options,
     add_common_processing_options,
+    add_shard_options,
 )
 
 
@@ -34,6 +35,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(perceive_parser)
     add_common_processing_options(perceive_parser)
+    add_shard_options(perceive_parser)
     perceive_parser.set_defaults(func=run_perceive)
 
     # pharmacophore search
@@ -44,6 +46,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(search_parser)
     add_common_processing_options(search_parser)
+    add_shard_options(search_parser)
     search_parser.add_argument(
         "--query",
         required=True,
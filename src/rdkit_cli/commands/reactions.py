@@ -3,7 +3,13 @@
 import sys
 from pathlib import Path
 
-from rdkit_cli.cli import RdkitHelpFormatter, add_common_io_options, add_common_processing_options
+from rdkit_cli.cli import (
+    InputFile,
+    RdkitHelpFormatter,
+    add_common_io_options,
+    add_common_processing_options,
+    add_shard_options,
+)
 
 
 def register_parser(subparsers):
@@ -29,6 +35,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(transform_parser)
     add_common_processing_options(transform_parser)
+    add_shard_options(transform_parser)
     transform_parser.add_argument(
         "-s", "--smirks",
         required=True,
@@ -59,6 +66,7 @@ def register_parser(subparsers):
     )
     enum_parser.add_argument(
         "--reactant2",
+        type=InputFile,
         metavar="FILE",
         help="Second reactant file (if reaction has 2 reactants)",
     )
@@ -66,7 +74,32 @@ def register_parser(subparsers):
         "--max-products",
         type=int,
         default=1000,
-        help="Maximum total products (default: 1000)",
+        help="Maximum total products, 0 for no limit (default: 1000)",
+    )
+    enum_parser.add_argument(
+        "--sample",
+        type=int,
+        default=None,
+        metavar="N",
+        help="Enumerate N randomly drawn reactant combinations instead of all",
+    )
+    enum_parser.add_argument(
+        "--seed",
+        type=int,
+        default=42,
+        help="Random seed for --sample (default: 42)",
+    )
+    enum_parser.add_argument(
+        "--spill-dir",
+        metavar="DIR",
+        help="Deduplicate products through on-disk hash partitions in DIR",
+    )
+    enum_parser.add_argument(
+        "--partitions",
+        type=int,
+        default=None,
+        metavar="N",
+        help="Number of hash partitions with --spill-dir (default: 64)",
     )
     enum_parser.set_defaults(func=run_enumerate)
 
@@ -192,8 +225,9 @@ def run_transform(args) -> int:
 def run_enumerate(args) -> int:
     """Run reaction enumeration."""
     # Lazy imports
-    from rdkit_cli.core.reactions import ReactionEnumerator
+    from rdkit_cli.core.reactions import ReactionEnumerator, product_space_size
     from rdkit_cli.io import create_reader, create_writer
+    from rdkit_cli.progress.ninja import NinjaProgress
 
     try:
         enumerator = ReactionEnumerator(
@@ -210,6 +244,11 @@ def run_enumerate(args) -> int:
         print(f"Error: Input file not found: {input_path}", file=sys.stderr)
         return 1
 
+    for option, value in (("--sample", args.sample), ("--partitions", args.partitions)):
+        if value is not None and value < 1:
+            print(f"Error: {option} must be positive", file=sys.stderr)
+            return 1
+
     if not args.quiet:
         print("Reading reactants...", file=sys.stderr)
 
@@ -237,20 +276,46 @@ def run_enumerate(args) -> int:
         print(f"Enumerating products from {len(mols1)} reactant(s)...", file=sys.stderr)
 
     try:
-        products = enumerator.enumerate(reactant_lists)
+        enumerator.check_reactant_lists(reactant_lists)
     except ValueError as e:
         print(f"Error: {e}", file=sys.stderr)
         return 1
 
-    # Write output
+    n_combinations = product_space_size([len(mols) for mols in reactant_lists])
+    if args.sample is not None:
+        n_combinations = min(n_combinations, args.sample)
+
     output_path = Path(args.output)
     writer = create_writer(output_path)
+    progress = NinjaProgress(total=n_combinations, quiet=args.quiet)
 
-    with writer:
-        writer.write_batch(products)
+    # Products stream from the workers into the writer in product order
+    n_products = 0
+    buffer = []
+    progress.start()
+    try:
+        with writer:
+            for product in enumerator.enumerate_stream(
+                reactant_lists,
+                n_workers=args.ncpu,
+                sample=args.sample,
+                seed=args.seed,
+                spill_dir=args.spill_dir,
+                n_partitions=args.partitions,
+                progress=progress,
+            ):
+                buffer.append(product)
+                n_products += 1
+                if len(buffer) >= 1000:
+                    writer.write_batch(buffer)
+                    buffer = []
+            if buffer:
+                writer.write_batch(buffer)
+    finally:
+        progress.finish()
 
     if not args.quiet:
-        print(f"Generated {len(products)} products. Wrote to {output_path}", file=sys.stderr)
+        print(f"Generated {n_products} products. Wrote to {output_path}", file=sys.stderr)
 
     return 0
 
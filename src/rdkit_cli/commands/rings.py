@@ -3,7 +3,12 @@
 import sys
 from pathlib import Path
 
-from rdkit_cli.cli import RdkitHelpFormatter, add_common_io_options, add_common_processing_options
+from rdkit_cli.cli import (
+    RdkitHelpFormatter,
+    add_common_io_options,
+    add_common_processing_options,
+    add_shard_options,
+)
 
 
 def register_parser(subparsers):
@@ -54,6 +59,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(info_parser)
     add_common_processing_options(info_parser)
+    add_shard_options(info_parser)
     info_parser.set_defaults(func=run_info)
 
     # rings analyze
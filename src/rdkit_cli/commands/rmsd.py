@@ -124,6 +124,13 @@ def register_parser(subparsers):
         action="store_true",
         help="Only use heavy atoms",
     )
+    conf_parser.add_argument(
+        "--cluster-threshold",
+        type=float,
+        default=None,
+        metavar="RMSD",
+        help="Also report the number of Butina clusters at this RMSD threshold",
+    )
     conf_parser.set_defaults(func=run_conformers)
 
     # Set default for main parser
@@ -274,15 +281,19 @@ def run_conformers(args) -> int:
     from rdkit import Chem
     from rdkit_cli.core.rmsd import ConformerRMSDAnalyzer
     from rdkit_cli.io import create_writer
+    from rdkit_cli.parallel.executor import get_worker_count
 
     input_path = Path(args.input)
     if not input_path.exists():
         print(f"Error: Input file not found: {input_path}", file=sys.stderr)
         return 1
 
+    # Molecules are analyzed one at a time; -n threads share each RMSD matrix
     analyzer = ConformerRMSDAnalyzer(
         symmetry=not args.no_symmetry,
         heavy_atoms_only=args.heavy_atoms_only,
+        num_threads=get_worker_count(args.ncpu),
+        cluster_threshold=args.cluster_threshold,
     )
 
     # Read molecules (group conformers by name)
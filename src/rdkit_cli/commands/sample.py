@@ -43,10 +43,16 @@ def register_parser(subparsers):
         action="store_true",
         help="Maintain valid/invalid molecule ratio in sample",
     )
+    parser.add_argument(
+        "--stratify-column",
+        metavar="COL",
+        default=None,
+        help="Stratify by the values of an input column (streams, implies --stream)",
+    )
     parser.add_argument(
         "--stream",
         action="store_true",
-        help="Use reservoir sampling (memory efficient for large files)",
+        help="Use reservoir sampling over unparsed rows (memory efficient for large files)",
     )
 
     parser.set_defaults(func=run_sample)
@@ -54,8 +60,9 @@ def register_parser(subparsers):
 
 def run_sample(args) -> int:
     """Run the sample command."""
-    from rdkit_cli.core.sample import MoleculeSampler, ReservoirSampler
+    from rdkit_cli.core.sample import MoleculeSampler, ReservoirSampler, StratifiedReservoirSampler
     from rdkit_cli.io import create_reader, create_writer
+    from rdkit_cli.io.readers import passthrough_row, raw_passthrough_row
     from rdkit_cli.progress.ninja import NinjaProgress
 
     input_path = Path(args.input)
@@ -71,32 +78,52 @@ def run_sample(args) -> int:
         has_header=not args.no_header,
     )
 
-    output_path = Path(args.output)
-    writer = create_writer(output_path)
-
-    # Use reservoir sampling for streaming mode
-    if args.stream:
-        if args.fraction is not None:
-            print("Error: --stream mode requires --num-samples, not --fraction", file=sys.stderr)
-            return 1
+    if args.stratify and args.stratify_column:
+        print("Error: --stratify and --stratify-column are mutually exclusive", file=sys.stderr)
+        return 1
 
-        if not args.quiet:
-            print(f"Sampling {args.num_samples} molecules using reservoir sampling...", file=sys.stderr)
+    # Use reservoir sampling over raw rows for streaming mode
+    if args.stream or args.stratify_column:
+        with reader:
+            if args.fraction is not None:
+                if not (0.0 < args.fraction <= 1.0):
+                    print("Error: fraction must be between 0 and 1", file=sys.stderr)
+                    return 1
+                n_samples = max(1, int(len(reader) * args.fraction))
+            else:
+                n_samples = args.num_samples
+
+            parse = reader.raw_parser
+            stratum = None
+            if args.stratify_column:
+                column = args.stratify_column
+                stratum = lambda raw: (raw.metadata or {})[column]
+            elif args.stratify:
+                # Only validity stratification needs RDKit
+                stratum = lambda raw: parse(*raw).is_valid
+
+            if stratum is not None:
+                sampler = StratifiedReservoirSampler(n=n_samples, stratum=stratum, seed=args.seed)
+            else:
+                sampler = ReservoirSampler(n=n_samples, seed=args.seed)
 
-        sampler = ReservoirSampler(n=args.num_samples, seed=args.seed)
+            if not args.quiet:
+                print(f"Sampling {n_samples} molecules using reservoir sampling...", file=sys.stderr)
 
-        with reader:
-            total = len(reader)
-            progress = NinjaProgress(total=total, quiet=args.quiet)
+            progress = NinjaProgress.for_reader(reader, quiet=args.quiet)
             progress.start()
 
-            for record in reader:
-                sampler.add(record)
-                progress.update(1)
-
-            progress.finish()
+            try:
+                for raw in reader.iter_passthrough():
+                    sampler.add(raw)
+                    progress.update(1)
+            except KeyError:
+                print(f"Error: Column '{args.stratify_column}' not found", file=sys.stderr)
+                return 1
+            finally:
+                progress.finish()
 
-        sampled = sampler.get_sample()
+        rows = [raw_passthrough_row(raw, parse) for raw in sampler.get_sample()]
 
     else:
         # Load all records, then sample
@@ -105,8 +132,7 @@ def run_sample(args) -> int:
 
         records = []
         with reader:
-            total = len(reader)
-            progress = NinjaProgress(total=total, quiet=args.quiet)
+            progress = NinjaProgress.for_reader(reader, quiet=args.quiet)
             progress.start()
 
             for record in reader:
@@ -133,20 +159,17 @@ def run_sample(args) -> int:
             else:
                 print(f"Sampling {args.fraction*100:.1f}% of {len(records)} molecules...", file=sys.stderr)
 
-        sampled = sampler.sample(records)
+        rows = [
+            passthrough_row(record.smiles, record.name, record.metadata)
+            for record in sampler.sample(records)
+        ]
 
     # Write output
-    with writer:
-        for record in sampled:
-            row = {"smiles": record.smiles}
-            if record.name:
-                row["name"] = record.name
-            for key, value in record.metadata.items():
-                if key not in row and key != "smiles":
-                    row[key] = value
-            writer.write_row(row)
+    output_path = Path(args.output)
+    with create_writer(output_path) as writer:
+        writer.write_batch(rows)
 
     if not args.quiet:
-        print(f"Sampled {len(sampled)} molecules. Wrote to {output_path}", file=sys.stderr)
+        print(f"Sampled {len(rows)} molecules. Wrote to {output_path}", file=sys.stderr)
 
     return 0
@@ -3,7 +3,12 @@
 import sys
 from pathlib import Path
 
-from rdkit_cli.cli import RdkitHelpFormatter, add_common_io_options, add_common_processing_options
+from rdkit_cli.cli import (
+    RdkitHelpFormatter,
+    add_common_io_options,
+    add_common_processing_options,
+    add_shard_options,
+)
 
 
 def register_parser(subparsers):
@@ -29,6 +34,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(murcko_parser)
     add_common_processing_options(murcko_parser)
+    add_shard_options(murcko_parser)
     murcko_parser.add_argument(
         "--generic",
         action="store_true",
@@ -59,6 +65,7 @@ def register_parser(subparsers):
     )
     add_common_io_options(decompose_parser)
     add_common_processing_options(decompose_parser)
+    add_shard_options(decompose_parser)
     decompose_parser.set_defaults(func=run_decompose)
 
     # scaffold analyze
@@ -0,0 +1,114 @@
+"""Serve command implementation."""
+
+import sys
+
+from rdkit_cli.cli import RdkitHelpFormatter
+
+
+def register_parser(subparsers):
+    """Register the serve command."""
+    parser = subparsers.add_parser(
+        "serve",
+        help="Serve jobs from a warm worker pool (for many small requests)",
+        description="Run a long-lived job server. RDKit is imported and the worker pool "
+                    "started once; each worker keeps the processors it built (alert "
+                    "catalogs, SA score tables) for later requests. Jobs (descriptors, "
+                    "fingerprints, filter, sascorer, standardize) are posted as SMILES "
+                    "batches over HTTP on a TCP port or a Unix socket and answered as JSON "
+                    "or Arrow. Submit them with 'rdkit-cli client' or any HTTP client.",
+        formatter_class=RdkitHelpFormatter,
+    )
+
+    parser.add_argument(
+        "--socket",
+        default=None,
+        metavar="PATH",
+        help="Listen on a Unix socket instead of a TCP port",
+    )
+    parser.add_argument(
+        "--host",
+        default="127.0.0.1",
+        help="TCP host (default: 127.0.0.1)",
+    )
+    parser.add_argument(
+        "--port",
+        type=int,
+        default=8765,
+        help="TCP port (default: 8765)",
+    )
+    parser.add_argument(
+        "-n", "--ncpu",
+        type=int,
+        default=1,
+        metavar="N",
+        help="Worker processes (-1 for all; default: 1, jobs run in the server's threads)",
+    )
+    parser.add_argument(
+        "--chunk-size",
+        type=int,
+        default=64,
+        metavar="N",
+        help="Molecules per worker task; smaller batches run as one task (default: 64)",
+    )
+    parser.add_argument(
+        "--max-batch",
+        type=int,
+        default=100000,
+        metavar="N",
+        help="Most molecules accepted in one request (default: 100000)",
+    )
+    parser.add_argument(
+        "--preload",
+        action="append",
+        default=[],
+        metavar="JOB[=OPTIONS]",
+        help="Build a job's processor in every worker at startup; OPTIONS is a JSON "
+             "object, e.g. --preload 'filter={\"steps\": [\"pains\"]}' (repeatable)",
+    )
+    parser.add_argument(
+        "-q", "--quiet",
+        action="store_true",
+        help="Don't log requests",
+    )
+
+    parser.set_defaults(func=run_serve)
+
+
+def run_serve(args) -> int:
+    """Run the serve command."""
+    from rdkit_cli.parallel.server import JobServer, parse_preload
+
+    try:
+        preload = tuple(parse_preload(text) for text in args.preload)
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+
+    server = JobServer(
+        n_workers=args.ncpu,
+        socket_path=args.socket,
+        host=args.host,
+        port=args.port,
+        chunk_size=args.chunk_size,
+        max_batch=args.max_batch,
+        preload=preload,
+        quiet=args.quiet,
+    )
+    try:
+        server.start()
+    except (ValueError, OSError) as e:
+        server.close()
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+
+    print(
+        f"Serving on {server.url} ({server.executor.n_workers} worker(s)); "
+        "stop with Ctrl-C or 'rdkit-cli client --shutdown'",
+        file=sys.stderr,
+        flush=True,
+    )
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        print("\nStopped.", file=sys.stderr)
+    return 0
@@ -3,7 +3,14 @@
 import sys
 from pathlib import Path
 
-from rdkit_cli.cli import RdkitHelpFormatter, add_common_io_options, add_common_processing_options
+from rdkit_cli.cli import (
+    InputFile,
+    RdkitHelpFormatter,
+    add_common_io_options,
+    add_common_processing_options,
+    add_shard_options,
+    reject_shard_options,
+)
 
 # Define here to avoid loading core at startup
 SIMILARITY_METRICS = [
@@ -34,14 +41,30 @@ def register_parser(subparsers):
         help="Search for molecules similar to a query",
         formatter_class=RdkitHelpFormatter,
     )
-    add_common_io_options(search_parser)
+    add_common_io_options(search_parser, input_required=False)
     add_common_processing_options(search_parser)
+    add_shard_options(search_parser)
+    search_parser.add_argument(
+        "--fp-db",
+        default=None,
+        type=InputFile,
+        metavar="FILE",
+        help="Use a fingerprint store (.fpdb from 'fingerprints compute') instead of -i; "
+             "fingerprint parameters come from the store",
+    )
     search_parser.add_argument(
         "--query",
-        required=True,
         metavar="SMILES",
         help="Query molecule SMILES",
     )
+    search_parser.add_argument(
+        "--queries",
+        type=InputFile,
+        metavar="FILE",
+        help="File of query molecules (read with the -i column options); the library "
+             "is fingerprinted once and searched with all queries together. "
+             "Output: query_id, target_id, smiles, similarity",
+    )
     search_parser.add_argument(
         "-t", "--threshold",
         type=float,
@@ -174,6 +197,26 @@ def register_parser(subparsers):
         metavar="B",
         help="Tversky beta parameter (default: 0.5)",
     )
+    matrix_parser.add_argument(
+        "-t", "--threshold",
+        type=float,
+        default=None,
+        metavar="T",
+        help="Write only pairs with similarity >= T (distance <= T with --distance) as an i,j edge list",
+    )
+    matrix_parser.add_argument(
+        "--dtype",
+        choices=["float32", "uint8"],
+        default="float32",
+        help="Value type for .npy output; uint8 stores round(value * 255) (default: float32)",
+    )
+    matrix_parser.add_argument(
+        "--block-size",
+        type=int,
+        default=None,
+        metavar="N",
+        help="Matrix rows computed per task (default: auto)",
+    )
     matrix_parser.set_defaults(func=run_matrix)
 
     # similarity cluster
@@ -182,8 +225,16 @@ def register_parser(subparsers):
         help="Cluster molecules by similarity",
         formatter_class=RdkitHelpFormatter,
     )
-    add_common_io_options(cluster_parser)
+    add_common_io_options(cluster_parser, input_required=False)
     add_common_processing_options(cluster_parser)
+    cluster_parser.add_argument(
+        "--fp-db",
+        default=None,
+        type=InputFile,
+        metavar="FILE",
+        help="Use a fingerprint store (.fpdb from 'fingerprints compute') instead of -i; "
+             "fingerprint parameters come from the store",
+    )
     cluster_parser.add_argument(
         "-c", "--cutoff",
         type=float,
@@ -220,9 +271,10 @@ def register_parser(subparsers):
     )
     cluster_parser.add_argument(
         "--method",
-        choices=["butina", "hierarchical"],
+        choices=["butina", "sphere"],
         default="butina",
-        help="Clustering method (default: butina)",
+        help="Clustering method: butina on the sparse neighbor graph, or sphere "
+             "exclusion (leader picking, for very large sets) (default: butina)",
     )
     cluster_parser.add_argument(
         "--add-centroid",
@@ -239,9 +291,11 @@ def register_parser(subparsers):
     )
     add_common_io_options(shape_parser)
     add_common_processing_options(shape_parser)
+    add_shard_options(shape_parser)
     shape_parser.add_argument(
         "-r", "--reference",
         required=True,
+        type=InputFile,
         metavar="FILE",
         help="Reference molecule file with 3D coords (SDF, MOL, PDB)",
     )
@@ -285,6 +339,15 @@ def run_search(args) -> int:
     from rdkit_cli.io import create_reader, create_writer
     from rdkit_cli.parallel.batch import process_molecules
 
+    if bool(args.query) == bool(args.queries):
+        print("Error: exactly one of --query or --queries is required", file=sys.stderr)
+        return 1
+
+    if args.queries:
+        if reject_shard_options(args, "with --queries"):
+            return 1
+        return _run_search_queries(args)
+
     try:
         searcher = SimilaritySearcher(
             query_smiles=args.query,
@@ -299,11 +362,31 @@ def run_search(args) -> int:
         print(f"Error: {e}", file=sys.stderr)
         return 1
 
+    if args.fp_db:
+        if reject_shard_options(args, "with --fp-db"):
+            return 1
+        return _run_search_store(args, Path(args.fp_db))
+
+    if not args.input:
+        print("Error: one of -i/--input or --fp-db is required", file=sys.stderr)
+        return 1
+
     input_path = Path(args.input)
     if not input_path.exists():
         print(f"Error: Input file not found: {input_path}", file=sys.stderr)
         return 1
 
+    # The library is fingerprinted into a temporary store and searched on the
+    # packed bits, as with --queries. --shard and --checkpoint split and resume
+    # the per-row output, so those runs score each row as it is read
+    if getattr(args, "shard", None) is None and getattr(args, "checkpoint", None) is None:
+        import tempfile
+
+        with tempfile.TemporaryDirectory(prefix="rdkit-cli-") as tmp:
+            store_path = Path(tmp) / "library.fpdb"
+            failed = _build_store(args, input_path, store_path)
+            return _run_search_store(args, store_path, failed=failed)
+
     reader = create_reader(
         input_path,
         smiles_column=args.smiles_column,
@@ -335,17 +418,244 @@ def run_search(args) -> int:
     return 0
 
 
+def _run_search_store(args, store_path: Path, failed: int | None = None) -> int:
+    """Run similarity search against a fingerprint store (failed: rows not stored)."""
+    import time
+
+    from rdkit_cli.core.fpstore import FingerprintStore
+    from rdkit_cli.core.similarity import SimilarityMetric, search_fingerprint_store
+    from rdkit_cli.io import create_writer
+
+    if not store_path.exists():
+        print(f"Error: Fingerprint store not found: {store_path}", file=sys.stderr)
+        return 1
+
+    start = time.perf_counter()
+    try:
+        with FingerprintStore(store_path) as store:
+            total = len(store)
+            results = search_fingerprint_store(
+                store,
+                args.query,
+                threshold=args.threshold,
+                metric=SimilarityMetric(args.metric),
+                tversky_alpha=getattr(args, "tversky_alpha", 0.5),
+                tversky_beta=getattr(args, "tversky_beta", 0.5),
+                top_k=args.top_n,
+            )
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+
+    if args.sort and args.top_n is None:
+        results.sort(key=lambda r: -r["similarity"])
+    if args.add_rank:
+        by_similarity = sorted(results, key=lambda r: -r["similarity"])
+        for rank, result in enumerate(by_similarity, 1):
+            result["rank"] = rank
+
+    output_path = Path(args.output)
+    with create_writer(output_path) as writer:
+        writer.write_batch(results)
+
+    if not args.quiet:
+        failed_note = ""
+        if failed is not None:
+            total += failed
+            failed_note = f"({failed} failed) "
+        print(
+            f"Found {len(results)}/{total} molecules above threshold "
+            f"{failed_note}in {time.perf_counter() - start:.1f}s",
+            file=sys.stderr,
+        )
+
+    return 0
+
+
+def _read_queries(args) -> list | None:
+    """Read --queries as (query_id, mol) pairs; query_id is the name or row number."""
+    from rdkit_cli.io import create_reader
+
+    queries_path = Path(args.queries)
+    if not queries_path.exists():
+        print(f"Error: Queries file not found: {queries_path}", file=sys.stderr)
+        return None
+
+    reader = create_reader(
+        queries_path,
+        smiles_column=args.smiles_column,
+        name_column=args.name_column,
+        has_header=not args.no_header,
+    )
+
+    queries = []
+    invalid = 0
+    with reader:
+        for i, record in enumerate(reader):
+            if record.mol is None:
+                invalid += 1
+                continue
+            queries.append((record.name or str(i), record.mol))
+
+    if invalid and not args.quiet:
+        print(f"Warning: skipped {invalid} invalid queries", file=sys.stderr)
+    return queries
+
+
+def _build_store(args, input_path: Path, store_path: Path) -> int:
+    """Fingerprint -i into a temporary store, as 'fingerprints compute' would."""
+    from rdkit_cli.core.fingerprints import FingerprintCalculator, FingerprintType
+    from rdkit_cli.core.fpstore import FingerprintStoreWriter, StoreParams
+    from rdkit_cli.io import create_reader
+    from rdkit_cli.parallel.batch import process_molecules
+
+    calculator = FingerprintCalculator(
+        fp_type=FingerprintType(args.fp_type),
+        n_bits=args.bits,
+        radius=args.radius,
+        output_format="packed",
+    )
+
+    reader = create_reader(
+        input_path,
+        smiles_column=args.smiles_column,
+        name_column=args.name_column,
+        has_header=not args.no_header,
+    )
+    writer = FingerprintStoreWriter(
+        store_path,
+        StoreParams(fp_type=args.fp_type, n_bits=calculator.n_bits, radius=args.radius),
+    )
+
+    with reader, writer:
+        result = process_molecules(
+            reader=reader,
+            writer=writer,
+            processor=calculator.compute,
+            n_workers=args.ncpu,
+            quiet=args.quiet,
+            batch_processor=calculator.compute_batch,
+        )
+    return result.failed
+
+
+def _run_search_queries(args) -> int:
+    """Run a multi-query similarity search in one pass over the library."""
+    import tempfile
+    import time
+
+    from rdkit_cli.core.fpstore import FingerprintStore
+    from rdkit_cli.core.similarity import SimilarityMetric, search_store_queries
+    from rdkit_cli.io import create_writer
+
+    queries = _read_queries(args)
+    if queries is None:
+        return 1
+    if not queries:
+        print("Error: no valid queries", file=sys.stderr)
+        return 1
+
+    if not args.fp_db and not args.input:
+        print("Error: one of -i/--input or --fp-db is required", file=sys.stderr)
+        return 1
+
+    source = Path(args.fp_db or args.input)
+    if not source.exists():
+        print(f"Error: Input file not found: {source}", file=sys.stderr)
+        return 1
+
+    start = time.perf_counter()
+    n_hits = 0
+
+    with tempfile.TemporaryDirectory(prefix="rdkit-cli-") as tmp:
+        if args.fp_db:
+            store_path = source
+        else:
+            store_path = Path(tmp) / "library.fpdb"
+            _build_store(args, source, store_path)
+
+        try:
+            with FingerprintStore(store_path) as store, create_writer(Path(args.output)) as writer:
+                if not args.quiet:
+                    print(
+                        f"Searching {len(store)} molecules with {len(queries)} queries...",
+                        file=sys.stderr,
+                    )
+
+                for query_id, results in search_store_queries(
+                    store,
+                    queries,
+                    threshold=args.threshold,
+                    metric=SimilarityMetric(args.metric),
+                    tversky_alpha=getattr(args, "tversky_alpha", 0.5),
+                    tversky_beta=getattr(args, "tversky_beta", 0.5),
+                    top_k=args.top_n,
+                ):
+                    ranked = sorted(results, key=lambda r: -r["similarity"])
+                    if args.sort:
+                        results = ranked
+                    if args.add_rank:
+                        for rank, result in enumerate(ranked, 1):
+                            result["rank"] = rank
+
+                    rows = []
+                    for result in results:
+                        row = {
+                            "query_id": query_id,
+                            "target_id": result["target_id"],
+                            "smiles": result["smiles"],
+                            "similarity": result["similarity"],
+                        }
+                        if args.add_rank:
+                            row["rank"] = result["rank"]
+                        rows.append(row)
+                    writer.write_batch(rows)
+                    n_hits += len(rows)
+        except ValueError as e:
+            print(f"Error: {e}", file=sys.stderr)
+            return 1
+
+    if not args.quiet:
+        print(
+            f"Found {n_hits} hits for {len(queries)} queries "
+            f"in {time.perf_counter() - start:.1f}s",
+            file=sys.stderr,
+        )
+
+    return 0
+
+
 def run_matrix(args) -> int:
     """Compute similarity matrix."""
     # Lazy imports
-    from rdkit_cli.core.similarity import compute_similarity_matrix, SimilarityMetric
+    from rdkit_cli.core.fingerprints import FingerprintType, compute_fingerprint
+    from rdkit_cli.core.similarity import (
+        SimilarityMatrixBlocks,
+        SimilarityMetric,
+        matrix_block_size,
+    )
     from rdkit_cli.io import create_reader
+    from rdkit_cli.parallel.executor import ParallelExecutor
+    from rdkit_cli.progress import NinjaProgress
 
     input_path = Path(args.input)
     if not input_path.exists():
         print(f"Error: Input file not found: {input_path}", file=sys.stderr)
         return 1
 
+    # Output layout follows the extension: .npy is a dense memory-mapped
+    # array, .parquet or --threshold an edge list, otherwise dense text
+    output_path = Path(args.output)
+    suffix = output_path.suffix.lower()
+    threshold = getattr(args, "threshold", None)
+    if suffix == ".npy" and threshold is not None:
+        print(
+            "Error: --threshold writes an edge list; use a .csv, .tsv or .parquet output",
+            file=sys.stderr,
+        )
+        return 1
+    edges = threshold is not None or suffix == ".parquet"
+
     reader = create_reader(
         input_path,
         smiles_column=args.smiles_column,
@@ -357,28 +667,52 @@ def run_matrix(args) -> int:
     if not args.quiet:
         print("Reading molecules...", file=sys.stderr)
 
-    records = list(reader)
-    mols = [r.mol for r in records]
-    names = [r.name or r.smiles[:20] for r in records]
+    fp_type = FingerprintType(args.fp_type)
+    fps = []
+    rows = []
+    for record in reader:
+        if record.mol is None:
+            continue
+        fp = compute_fingerprint(record.mol, fp_type, n_bits=args.bits, radius=args.radius)
+        if fp is not None:
+            fps.append(fp)
+            rows.append(record)
+    n = len(fps)
 
     if not args.quiet:
-        print(f"Computing {len(mols)}x{len(mols)} similarity matrix...", file=sys.stderr)
+        print(f"Computing {n}x{n} similarity matrix...", file=sys.stderr)
 
-    matrix = compute_similarity_matrix(
-        mols,
+    blocks = SimilarityMatrixBlocks(
+        fps,
         metric=SimilarityMetric(args.metric),
         tversky_alpha=getattr(args, "tversky_alpha", 0.5),
         tversky_beta=getattr(args, "tversky_beta", 0.5),
-    )
-
-    # Write output
-    output_path = Path(args.output)
-    with open(output_path, "w") as f:
-        # Header
-        f.write("," + ",".join(names) + "\n")
-        # Data
-        for i, row in enumerate(matrix):
-            f.write(names[i] + "," + ",".join(f"{v:.4f}" for v in row) + "\n")
+        distance=args.distance,
+        dtype=args.dtype if suffix == ".npy" else "float64",
+        edges=edges,
+        threshold=threshold,
+    )
+
+    progress = NinjaProgress(total=n, quiet=args.quiet)
+
+    # The block computer (with all fingerprints) is sent to each worker once
+    with ParallelExecutor(blocks, n_workers=args.ncpu) as executor:
+        block_size = args.block_size or matrix_block_size(n, executor.n_workers)
+        ranges = [(start, min(start + block_size, n)) for start in range(0, n, block_size)]
+        results = zip(ranges, executor.imap(ranges))
+
+        progress.start()
+        try:
+            if edges:
+                value_column = "distance" if args.distance else "similarity"
+                _write_matrix_edges(results, output_path, rows, value_column, args.precision, progress)
+            elif suffix == ".npy":
+                _write_matrix_npy(results, output_path, rows, args.dtype, progress)
+            else:
+                delimiter = "\t" if suffix == ".tsv" else ","
+                _write_matrix_text(results, output_path, rows, delimiter, args.precision, progress)
+        finally:
+            progress.finish()
 
     if not args.quiet:
         print(f"Wrote similarity matrix to {output_path}", file=sys.stderr)
@@ -386,40 +720,131 @@ def run_matrix(args) -> int:
     return 0
 
 
+def _matrix_row_names(rows) -> list[str]:
+    """Label matrix rows by molecule name, or a SMILES prefix."""
+    return [r.name or r.smiles[:20] for r in rows]
+
+
+def _write_matrix_text(results, output_path: Path, rows, delimiter: str, precision: int, progress):
+    """Write dense matrix blocks as a labelled text table, one block at a time."""
+    names = _matrix_row_names(rows)
+
+    with open(output_path, "w") as f:
+        # Header
+        f.write(delimiter + delimiter.join(names) + "\n")
+        # Data
+        for (start, stop), block in results:
+            for i, values in enumerate(block, start=start):
+                f.write(names[i] + delimiter + delimiter.join(f"{v:.{precision}f}" for v in values) + "\n")
+            progress.update(stop - start)
+
+
+def _write_matrix_npy(results, output_path: Path, rows, dtype: str, progress):
+    """Write dense matrix blocks into a memory-mapped .npy file plus a row index."""
+    import numpy as np
+
+    n = len(rows)
+    if n == 0:
+        np.save(output_path, np.empty((0, 0), dtype=dtype))
+    else:
+        matrix = np.lib.format.open_memmap(output_path, mode="w+", dtype=dtype, shape=(n, n))
+        for (start, stop), block in results:
+            matrix[start:stop] = block
+            progress.update(stop - start)
+        matrix.flush()
+        del matrix
+
+    # Matrix row k corresponds to line k of the index
+    index_path = output_path.with_suffix(".rows.csv")
+    with open(index_path, "w") as f:
+        f.write("row_idx,name\n")
+        for r, name in zip(rows, _matrix_row_names(rows)):
+            name = name.replace('"', '""')
+            f.write(f'{r.row_idx},"{name}"\n')
+
+
+def _write_matrix_edges(results, output_path: Path, rows, value_column: str, precision: int, progress):
+    """Write thresholded (i, j, value) edges, with i and j as input row indices."""
+    import numpy as np
+    import pyarrow as pa
+
+    from rdkit_cli.io import create_writer
+
+    row_ids = np.array([r.row_idx for r in rows], dtype=np.int64)
+
+    with create_writer(output_path, columns=["i", "j", value_column]) as writer:
+        for (start, stop), (i, j, values) in results:
+            writer.write_arrow(pa.RecordBatch.from_arrays(
+                [pa.array(row_ids[i]), pa.array(row_ids[j]), pa.array(np.round(values, precision))],
+                names=["i", "j", value_column],
+            ))
+            progress.update(stop - start)
+
+
 def run_cluster(args) -> int:
     """Cluster molecules."""
     # Lazy imports
-    from rdkit_cli.core.similarity import cluster_molecules
+    from rdkit_cli.core.similarity import cluster_arena, cluster_molecules
     from rdkit_cli.io import create_reader
 
-    input_path = Path(args.input)
-    if not input_path.exists():
-        print(f"Error: Input file not found: {input_path}", file=sys.stderr)
-        return 1
-
-    reader = create_reader(
-        input_path,
-        smiles_column=args.smiles_column,
-        name_column=args.name_column,
-        has_header=not args.no_header,
-    )
+    if args.fp_db:
+        from rdkit_cli.core.fpsearch import FingerprintArena
+        from rdkit_cli.core.fpstore import FingerprintStore
+
+        store_path = Path(args.fp_db)
+        if not store_path.exists():
+            print(f"Error: Fingerprint store not found: {store_path}", file=sys.stderr)
+            return 1
+
+        with FingerprintStore(store_path) as store:
+            all_smiles = store.smiles
+            all_names = store.names
+            if not args.quiet:
+                print(f"Clustering {len(store)} molecules...", file=sys.stderr)
+            clusters = cluster_arena(
+                FingerprintArena.from_store(store),
+                cutoff=args.cutoff,
+                method=args.method,
+                n_workers=args.ncpu,
+                fps=store.bit_vectors,
+            )
+    else:
+        if not args.input:
+            print("Error: one of -i/--input or --fp-db is required", file=sys.stderr)
+            return 1
+
+        input_path = Path(args.input)
+        if not input_path.exists():
+            print(f"Error: Input file not found: {input_path}", file=sys.stderr)
+            return 1
+
+        reader = create_reader(
+            input_path,
+            smiles_column=args.smiles_column,
+            name_column=args.name_column,
+            has_header=not args.no_header,
+        )
 
-    # Read all molecules
-    if not args.quiet:
-        print("Reading molecules...", file=sys.stderr)
+        # Read all molecules
+        if not args.quiet:
+            print("Reading molecules...", file=sys.stderr)
 
-    records = list(reader)
-    mols = [r.mol for r in records]
+        records = list(reader)
+        mols = [r.mol for r in records]
+        all_smiles = [r.smiles for r in records]
+        all_names = [r.name for r in records]
 
-    if not args.quiet:
-        print(f"Clustering {len(mols)} molecules...", file=sys.stderr)
+        if not args.quiet:
+            print(f"Clustering {len(mols)} molecules...", file=sys.stderr)
 
-    clusters = cluster_molecules(
-        mols,
-        cutoff=args.cutoff,
-        radius=args.radius,
-        n_bits=args.bits,
-    )
+        clusters = cluster_molecules(
+            mols,
+            cutoff=args.cutoff,
+            radius=args.radius,
+            n_bits=args.bits,
+            method=args.method,
+            n_workers=args.ncpu,
+        )
 
     # Filter by minimum cluster size
     min_size = getattr(args, "min_cluster_size", 1)
@@ -432,14 +857,13 @@ def run_cluster(args) -> int:
         for cluster_id, cluster in enumerate(clusters):
             cluster_size = len(cluster)
             for idx in cluster:
-                r = records[idx]
-                smiles = r.smiles.replace('"', '""')
-                name = (r.name or "").replace('"', '""')
+                smiles = all_smiles[idx].replace('"', '""')
+                name = (all_names[idx] or "").replace('"', '""')
                 f.write(f'"{smiles}","{name}",{cluster_id},{cluster_size}\n')
 
     if not args.quiet:
         print(
-            f"Found {len(clusters)} clusters from {len(mols)} molecules. "
+            f"Found {len(clusters)} clusters from {len(all_smiles)} molecules. "
             f"Wrote to {output_path}",
             file=sys.stderr,
         )
@@ -61,6 +61,7 @@ def run_split(args) -> int:
     """Run the split command."""
     from rdkit_cli.core.split import FileSplitter
     from rdkit_cli.io import create_reader, create_writer, detect_format
+    from rdkit_cli.io.readers import raw_passthrough_row
     from rdkit_cli.progress.ninja import NinjaProgress
 
     input_path = Path(args.input)
@@ -83,26 +84,6 @@ def run_split(args) -> int:
         has_header=not args.no_header,
     )
 
-    # Read all records with progress
-    if not args.quiet:
-        print("Reading molecules...", file=sys.stderr)
-
-    records = []
-    with reader:
-        total = len(reader)
-        progress = NinjaProgress(total=total, quiet=args.quiet)
-        progress.start()
-
-        for record in reader:
-            records.append(record)
-            progress.update(1)
-
-        progress.finish()
-
-    if not records:
-        print("Error: No molecules found in input file", file=sys.stderr)
-        return 1
-
     # Create splitter
     splitter = FileSplitter(
         n_chunks=args.num_chunks,
@@ -112,36 +93,65 @@ def run_split(args) -> int:
     # Get output prefix
     prefix = args.prefix or input_path.stem
 
-    # Calculate number of chunks for filename padding
-    assignments = splitter.calculate_chunk_assignments(len(records))
-    n_chunks = len(assignments)
+    files_written = 0
+    n_records = 0
+    writer = None
+    buffer: list[dict] = []
+
+    def flush():
+        nonlocal buffer
+        if buffer:
+            writer.write_batch(buffer)
+            buffer = []
+
+    # Rows are streamed straight from the reader into rotating chunk
+    # writers; SMILES input is never parsed
+    with reader:
+        # The line count sizes the chunks and the filename padding
+        total = len(reader)
+        n_chunks = len(splitter.calculate_chunk_assignments(total))
 
-    if not args.quiet:
-        print(f"Splitting {len(records)} molecules into {n_chunks} files...", file=sys.stderr)
+        if not args.quiet:
+            print(f"Splitting {total} molecules into {n_chunks} files...", file=sys.stderr)
 
-    # Split and write
-    files_written = 0
-    for chunk_idx, chunk_records in splitter.split_records(records):
-        output_path = FileSplitter.generate_output_path(
-            output_dir=output_dir,
-            base_name=prefix,
-            chunk_idx=chunk_idx,
-            extension=out_format,
-            total_chunks=n_chunks,
-        )
+        progress = NinjaProgress.for_reader(reader, quiet=args.quiet)
+        progress.start()
 
-        writer = create_writer(output_path)
-        with writer:
-            for record in chunk_records:
-                row = {"smiles": record.smiles}
-                if record.name:
-                    row["name"] = record.name
-                for key, value in record.metadata.items():
-                    if key not in row and key != "smiles":
-                        row[key] = value
-                writer.write_row(row)
-
-        files_written += 1
+        parse = reader.raw_parser
+        current_chunk = -1
+        try:
+            for chunk_idx, raw in splitter.split_stream(reader.iter_passthrough(), total_records=total):
+                if chunk_idx != current_chunk:
+                    if writer is not None:
+                        flush()
+                        writer.close()
+                    output_path = FileSplitter.generate_output_path(
+                        output_dir=output_dir,
+                        base_name=prefix,
+                        chunk_idx=chunk_idx,
+                        extension=out_format,
+                        total_chunks=max(n_chunks, chunk_idx + 1),
+                    )
+                    writer = create_writer(output_path)
+                    current_chunk = chunk_idx
+                    files_written += 1
+
+                buffer.append(raw_passthrough_row(raw, parse))
+                if len(buffer) >= 1000:
+                    flush()
+                n_records += 1
+                progress.update(1)
+
+            if writer is not None:
+                flush()
+        finally:
+            if writer is not None:
+                writer.close()
+            progress.finish()
+
+    if n_records == 0:
+        print("Error: No molecules found in input file", file=sys.stderr)
+        return 1
 
     if not args.quiet:
         print(
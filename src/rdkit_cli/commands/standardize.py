@@ -3,7 +3,12 @@
 import sys
 from pathlib import Path
 
-from rdkit_cli.cli import RdkitHelpFormatter, add_common_io_options, add_common_processing_options
+from rdkit_cli.cli import (
+    RdkitHelpFormatter,
+    add_common_io_options,
+    add_common_processing_options,
+    add_shard_options,
+)
 
 
 def register_parser(subparsers):
@@ -17,6 +22,7 @@ def register_parser(subparsers):
 
     add_common_io_options(parser)
     add_common_processing_options(parser)
+    add_shard_options(parser)
 
     # Standardization options
     parser.add_argument(
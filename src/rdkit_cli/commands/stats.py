@@ -84,8 +84,7 @@ def run_stats(args) -> int:
 
     mols = []
     with reader:
-        total = len(reader)
-        progress = NinjaProgress(total=total, quiet=args.quiet)
+        progress = NinjaProgress.for_reader(reader, quiet=args.quiet)
         progress.start()
 
         for record in reader:
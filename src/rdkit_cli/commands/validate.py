@@ -134,8 +134,7 @@ def run_validate(args) -> int:
     n_written = 0
 
     with reader, writer:
-        total = len(reader)
-        progress = NinjaProgress(total=total, quiet=args.quiet)
+        progress = NinjaProgress.for_reader(reader, quiet=args.quiet)
         progress.start()
 
         for record in reader:
@@ -0,0 +1,102 @@
+"""
+Concatenate molecule files of one format (the reducer for --shard runs).
+
+Text formats are copied byte for byte, so values are not re-parsed or
+re-formatted; CSV/TSV headers after the first file are checked and dropped.
+Parquet files are streamed batch by batch into one output file.
+"""
+
+import shutil
+from pathlib import Path
+from typing import BinaryIO, Optional
+
+from rdkit_cli.io.formats import FileFormat, detect_format
+
+# Bytes per copy call for text formats
+_COPY_BUFFER = 1 << 20
+
+
+def _ends_with_newline(path: Path) -> bool:
+    with open(path, "rb") as f:
+        f.seek(0, 2)
+        if f.tell() == 0:
+            return True
+        f.seek(-1, 2)
+        return f.read(1) == b"\n"
+
+
+def _copy_text(path: Path, out: BinaryIO, skip_header: Optional[bytes]) -> Optional[bytes]:
+    """
+    Append a text file to out.
+
+    Args:
+        path: Input file
+        out: Output file
+        skip_header: Header line expected (and dropped) at the top of path,
+            or None to copy the file whole
+
+    Returns:
+        Header line of the file (first line), or None if it is empty
+    """
+    with open(path, "rb") as f:
+        header = f.readline()
+        if not header:
+            return None
+        if skip_header is None:
+            out.write(header)
+        elif header.rstrip(b"\r\n") != skip_header.rstrip(b"\r\n"):
+            raise ValueError(f"Header of {path} does not match the first input")
+        shutil.copyfileobj(f, out, _COPY_BUFFER)
+
+    if not _ends_with_newline(path):
+        out.write(b"\n")
+    return header
+
+
+def concat_files(inputs: list[Path | str], output: Path | str) -> int:
+    """
+    Concatenate files of one format into output, in the given order.
+
+    Args:
+        inputs: Input files (all with the output's format)
+        output: Output file
+
+    Returns:
+        Number of input files copied
+
+    Raises:
+        ValueError: If an input format differs from the output format
+    """
+    output = Path(output)
+    inputs = [Path(path) for path in inputs]
+    file_format = detect_format(output)
+    for path in inputs:
+        if detect_format(path) != file_format:
+            raise ValueError(
+                f"Cannot concatenate {path} into {output}: formats differ "
+                f"({detect_format(path).value} vs {file_format.value})"
+            )
+
+    if file_format == FileFormat.PARQUET:
+        _concat_parquet(inputs, output)
+        return len(inputs)
+
+    has_header = file_format in (FileFormat.CSV, FileFormat.TSV)
+    header: Optional[bytes] = None
+    with open(output, "wb") as out:
+        for path in inputs:
+            file_header = _copy_text(path, out, header if has_header else None)
+            if has_header and header is None:
+                header = file_header
+    return len(inputs)
+
+
+def _concat_parquet(inputs: list[Path], output: Path):
+    import pyarrow.parquet as pq
+
+    from rdkit_cli.io.writers import create_writer
+
+    with create_writer(output) as writer:
+        for path in inputs:
+            for batch in pq.ParquetFile(str(path)).iter_batches():
+                writer.write_arrow(batch)
@@ -3,10 +3,30 @@
 from typing import Optional, Any
 
 from rdkit import Chem
-from rdkit.Chem import AllChem, rdDistGeom
+from rdkit.Chem import AllChem, rdDistGeom, rdMolDescriptors
 
 from rdkit_cli.io.readers import MoleculeRecord
 
+# Rings at least this large are embedded as macrocycles (many more attempts)
+_MACROCYCLE_SIZE = 9
+_MACROCYCLE_COST_FACTOR = 4.0
+
+
+def conformer_cost(record: MoleculeRecord) -> float:
+    """
+    Estimate the relative cost of generating conformers for a molecule.
+
+    Heavy atoms times one plus the rotatable bond count, with macrocycles
+    weighted up; only the order matters (see process_molecules' cost).
+    """
+    mol = record.mol
+    if mol is None:
+        return 0.0
+    cost = mol.GetNumHeavyAtoms() * (1 + rdMolDescriptors.CalcNumRotatableBonds(mol))
+    if any(len(ring) >= _MACROCYCLE_SIZE for ring in mol.GetRingInfo().AtomRings()):
+        cost *= _MACROCYCLE_COST_FACTOR
+    return float(cost)
+
 
 class ConformerGenerator:
     """Generate 3D conformers for molecules."""
@@ -19,6 +39,7 @@ class ConformerGenerator:
         force_field: str = "mmff",
         max_iterations: int = 200,
         random_seed: int = 42,
+        num_threads: int = 1,
     ):
         """
         Initialize conformer generator.
@@ -30,6 +51,9 @@ class ConformerGenerator:
             force_field: Force field for optimization (mmff, uff)
             max_iterations: Maximum optimization iterations
             random_seed: Random seed for reproducibility
+            num_threads: Threads per molecule for embedding and optimization
+                (0 for all cores; see plan_parallelism when running in
+                worker processes)
         """
         self.num_conformers = num_conformers
         self.method = method.lower()
@@ -37,6 +61,7 @@ class ConformerGenerator:
         self.force_field = force_field.lower()
         self.max_iterations = max_iterations
         self.random_seed = random_seed
+        self.num_threads = num_threads
 
         # Set up embedding parameters
         if self.method == "etkdgv3":
@@ -49,7 +74,7 @@ class ConformerGenerator:
             raise ValueError(f"Unknown method: {method}")
 
         self.params.randomSeed = random_seed
-        self.params.numThreads = 0  # Use all available threads
+        self.params.numThreads = num_threads
 
     def generate(self, record: MoleculeRecord) -> Optional[dict[str, Any]]:
         """
@@ -85,14 +110,14 @@ class ConformerGenerator:
                     results = AllChem.MMFFOptimizeMoleculeConfs(
                         mol,
                         maxIters=self.max_iterations,
-                        numThreads=0,
+                        numThreads=self.num_threads,
                     )
                     energies = [r[1] for r in results]
                 elif self.force_field == "uff":
                     results = AllChem.UFFOptimizeMoleculeConfs(
                         mol,
                         maxIters=self.max_iterations,
-                        numThreads=0,
+                        numThreads=self.num_threads,
                     )
                     energies = [r[1] for r in results]
 
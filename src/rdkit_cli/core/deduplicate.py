@@ -1,10 +1,43 @@
-"""Molecular deduplication engine."""
-
-from typing import Optional, Callable, Iterator
+"""
+Molecular deduplication engine.
+
+Keys are compared as 128-bit BLAKE2b digests rather than strings, so the
+set of seen molecules costs a fixed 16 bytes of key per unique molecule
+whatever the key type. Keys can be computed in worker processes
+(iter_key_hashes), and Deduplicator.deduplicate_rows() handles inputs larger
+than memory by spooling rows to disk and, with a spill directory,
+hash-partitioning the keys into runs that are reduced one at a time.
+"""
+
+import hashlib
+import heapq
+import struct
+import tempfile
+from array import array
+from collections import deque
+from pathlib import Path
+from typing import Any, Optional, Callable, Iterable, Iterator
 
 from rdkit import Chem
 
 from rdkit_cli.io.readers import MoleculeRecord
+from rdkit_cli.io.spool import read_spool, write_spool
+from rdkit_cli.parallel.executor import ParallelExecutor
+
+# Size of hashed keys in bytes (128 bits)
+KEY_DIGEST_SIZE = 16
+
+# Default number of hash partitions in spill mode
+DEFAULT_PARTITIONS = 64
+
+# Partition entry: input row index and key digest
+_ENTRY = struct.Struct(f"<q{KEY_DIGEST_SIZE}s")
+
+# Row indices per read when merging runs
+_RUN_READ_ROWS = 1 << 16
+
+# File buffer size for partition and run files
+_FILE_BUFFER = 1 << 20
 
 
 def canonical_smiles_key(mol: Chem.Mol) -> str:
@@ -40,6 +73,135 @@ KEY_FUNCTIONS = {
 }
 
 
+def hash_key(key: str) -> bytes:
+    """Hash a deduplication key to a 128-bit digest."""
+    return hashlib.blake2b(key.encode(), digest_size=KEY_DIGEST_SIZE).digest()
+
+
+def _check_key_type(key_type: str):
+    if key_type not in KEY_FUNCTIONS:
+        raise ValueError(
+            f"Unknown key_type: {key_type}. "
+            f"Available: {list(KEY_FUNCTIONS.keys())}"
+        )
+
+
+class KeyHasher:
+    """
+    Worker task hashing the deduplication keys of a chunk of rows.
+
+    Returns (digest, smiles, name) per row; digest is None for molecules
+    that failed to parse or whose key could not be computed, which are
+    always kept. SMILES and name come from the parsed record, so SDF
+    entries get their SMILES generated in the worker too.
+    """
+
+    def __init__(
+        self,
+        key_type: str = "smiles",
+        parse: Optional[Callable[..., MoleculeRecord]] = None,
+    ):
+        """
+        Initialize hasher.
+
+        Args:
+            key_type: Key type (see KEY_FUNCTIONS)
+            parse: Raw row parser (MoleculeReader.raw_parser) when chunks hold
+                (row_idx, smiles, name) tuples; None for MoleculeRecords
+        """
+        _check_key_type(key_type)
+        self.key_type = key_type
+        self.parse = parse
+
+    def digest(self, mol: Optional[Chem.Mol]) -> Optional[bytes]:
+        """Hashed key of a molecule, or None if it has none."""
+        if mol is None:
+            return None
+        try:
+            return hash_key(KEY_FUNCTIONS[self.key_type](mol))
+        except Exception:
+            return None
+
+    def __call__(self, items: list) -> list[tuple[Optional[bytes], str, str]]:
+        results = []
+        for item in items:
+            record = self.parse(*item) if self.parse is not None else item
+            results.append((self.digest(record.mol), record.smiles, record.name))
+        return results
+
+
+def iter_key_hashes(
+    items: Iterable[Any],
+    key_type: str = "smiles",
+    parse: Optional[Callable[..., MoleculeRecord]] = None,
+    n_workers: int = 1,
+    chunk_size: int = 1000,
+) -> Iterator[tuple[Optional[bytes], str, str, Optional[dict[str, Any]]]]:
+    """
+    Hash deduplication keys in worker processes, in input order.
+
+    Only (row_idx, smiles, name) is sent to the workers for raw rows; row
+    metadata stays in the parent and is yielded alongside the result.
+
+    Args:
+        items: RawRecords (with parse) or MoleculeRecords
+        key_type: Key type (see KEY_FUNCTIONS)
+        parse: Raw row parser for RawRecords (MoleculeReader.raw_parser)
+        n_workers: Number of worker processes (-1 for all)
+        chunk_size: Rows per worker task
+
+    Yields:
+        (digest, smiles, name, metadata) per input row
+    """
+    hasher = KeyHasher(key_type, parse=parse)
+    metadata: deque[list[Optional[dict[str, Any]]]] = deque()
+
+    def chunks() -> Iterator[list]:
+        tasks: list = []
+        meta: list[Optional[dict[str, Any]]] = []
+        for item in items:
+            if parse is not None:
+                tasks.append((item.row_idx, item.smiles, item.name))
+            else:
+                tasks.append(item)
+            meta.append(item.metadata)
+            if len(tasks) >= chunk_size:
+                metadata.append(meta)
+                yield tasks
+                tasks, meta = [], []
+        if tasks:
+            metadata.append(meta)
+            yield tasks
+
+    with ParallelExecutor(hasher, n_workers=n_workers) as executor:
+        for results in executor.imap(chunks()):
+            for (digest, smiles, name), meta in zip(results, metadata.popleft()):
+                yield digest, smiles, name, meta
+
+
+def _tracked(rows: Iterable[tuple[Optional[bytes], Any]], on_row: Callable) -> Iterator[Any]:
+    """Yield row payloads, first calling on_row(row_idx, digest) for each."""
+    for row_idx, (digest, payload) in enumerate(rows):
+        on_row(row_idx, digest)
+        yield payload
+
+
+def _write_run(path: Path, rows: Iterable[int]):
+    """Write sorted row indices as int64."""
+    with open(path, "wb", buffering=_FILE_BUFFER) as f:
+        array("q", rows).tofile(f)
+
+
+def _read_run(path: Path) -> Iterator[int]:
+    """Yield row indices from a run file."""
+    with open(path, "rb", buffering=_FILE_BUFFER) as f:
+        while True:
+            data = f.read(_RUN_READ_ROWS * 8)
+            if not data:
+                return
+            yield from array("q", data)
+
+
 class Deduplicator:
     """Remove duplicate molecules from a dataset."""
 
@@ -47,6 +209,8 @@ class Deduplicator:
         self,
         key_type: str = "smiles",
         keep: str = "first",
+        spill_dir: Optional[str | Path] = None,
+        n_partitions: int = DEFAULT_PARTITIONS,
     ):
         """
         Initialize deduplicator.
@@ -60,18 +224,27 @@ class Deduplicator:
             keep: Which duplicate to keep:
                 - 'first': Keep first occurrence (default)
                 - 'last': Keep last occurrence
+            spill_dir: Directory for hash-partitioned key runs in
+                deduplicate_rows(), for inputs whose keys do not fit in
+                memory (default: keep the keys in memory)
+            n_partitions: Number of hash partitions with spill_dir
         """
-        if key_type not in KEY_FUNCTIONS:
-            raise ValueError(
-                f"Unknown key_type: {key_type}. "
-                f"Available: {list(KEY_FUNCTIONS.keys())}"
-            )
+        _check_key_type(key_type)
         if keep not in ("first", "last"):
             raise ValueError(f"keep must be 'first' or 'last', got: {keep}")
+        if n_partitions < 1:
+            raise ValueError(f"n_partitions must be positive, got: {n_partitions}")
 
         self.key_type = key_type
         self.key_func: Callable[[Chem.Mol], str] = KEY_FUNCTIONS[key_type]
         self.keep = keep
+        self.spill_dir = Path(spill_dir) if spill_dir is not None else None
+        self.n_partitions = n_partitions
+        self._hasher = KeyHasher(key_type)
+
+        # Rows read and duplicates dropped by the last deduplicate_rows() run
+        self.n_rows = 0
+        self.n_duplicates = 0
 
     def deduplicate(
         self,
@@ -96,20 +269,14 @@ class Deduplicator:
         records: list[MoleculeRecord],
     ) -> tuple[list[MoleculeRecord], int]:
         """Keep first occurrence of each unique molecule."""
-        seen: set[str] = set()
+        seen: set[bytes] = set()
         unique: list[MoleculeRecord] = []
         duplicates = 0
 
         for record in records:
-            if record.mol is None:
-                # Keep invalid molecules as-is
-                unique.append(record)
-                continue
-
-            try:
-                key = self.key_func(record.mol)
-            except Exception:
-                # Keep if we can't compute key
+            # Keep invalid molecules, or those we can't compute a key for, as-is
+            key = self._hasher.digest(record.mol)
+            if key is None:
                 unique.append(record)
                 continue
 
@@ -127,18 +294,13 @@ class Deduplicator:
     ) -> tuple[list[MoleculeRecord], int]:
         """Keep last occurrence of each unique molecule."""
         # Process in reverse, then reverse result
-        seen: set[str] = set()
+        seen: set[bytes] = set()
         unique: list[MoleculeRecord] = []
         duplicates = 0
 
         for record in reversed(records):
-            if record.mol is None:
-                unique.append(record)
-                continue
-
-            try:
-                key = self.key_func(record.mol)
-            except Exception:
+            key = self._hasher.digest(record.mol)
+            if key is None:
                 unique.append(record)
                 continue
 
@@ -167,16 +329,11 @@ class Deduplicator:
         if self.keep != "first":
             raise ValueError("Stream deduplication only supports keep='first'")
 
-        seen: set[str] = set()
+        seen: set[bytes] = set()
 
         for record in records:
-            if record.mol is None:
-                yield record
-                continue
-
-            try:
-                key = self.key_func(record.mol)
-            except Exception:
+            key = self._hasher.digest(record.mol)
+            if key is None:
                 yield record
                 continue
 
@@ -184,6 +341,136 @@ class Deduplicator:
                 seen.add(key)
                 yield record
 
+    def deduplicate_rows(
+        self,
+        rows: Iterable[tuple[Optional[bytes], Any]],
+    ) -> Iterator[Any]:
+        """
+        Deduplicate pre-hashed rows, yielding kept payloads in input order.
+
+        Rows are (digest, payload) pairs, e.g. from iter_key_hashes(); rows
+        with a None digest are always kept. Payloads are opaque (typically
+        output row dicts) and must be picklable.
+
+        - keep='first' without spill_dir streams: each row is yielded as soon
+          as its key is found new, holding only the set of digests.
+        - keep='last' spools payloads to a temporary file and keeps a digest
+          -> last row map, then replays the spool.
+        - With spill_dir, (row, digest) entries are written to n_partitions
+          files by digest; each partition is reduced to its kept rows on its
+          own, and the sorted runs are merged while replaying the spool.
+          Memory then holds one partition's keys at a time.
+
+        n_rows and n_duplicates are set once the output is exhausted.
+
+        Args:
+            rows: (digest, payload) pairs
+
+        Yields:
+            Payloads of kept rows
+        """
+        self.n_rows = 0
+        self.n_duplicates = 0
+
+        if self.spill_dir is None and self.keep == "first":
+            yield from self._stream_rows(rows)
+            return
+
+        if self.spill_dir is not None:
+            self.spill_dir.mkdir(parents=True, exist_ok=True)
+
+        with tempfile.TemporaryDirectory(prefix="rdkit-cli-dedup-", dir=self.spill_dir) as tmp:
+            tmp_dir = Path(tmp)
+            spool = tmp_dir / "rows.spool"
+            if self.spill_dir is None:
+                kept = self._spool_in_memory(rows, spool)
+            else:
+                kept = self._spool_partitioned(rows, spool, tmp_dir)
+
+            next_kept = next(kept, None)
+            for row_idx, payload in enumerate(read_spool(spool)):
+                if row_idx == next_kept:
+                    yield payload
+                    next_kept = next(kept, None)
+
+    def _stream_rows(self, rows: Iterable[tuple[Optional[bytes], Any]]) -> Iterator[Any]:
+        """Keep-first deduplication in one pass over in-memory digests."""
+        seen: set[bytes] = set()
+        for digest, payload in rows:
+            self.n_rows += 1
+            if digest is None:
+                yield payload
+            elif digest not in seen:
+                seen.add(digest)
+                yield payload
+            else:
+                self.n_duplicates += 1
+
+    def _spool_in_memory(self, rows: Iterable[tuple[Optional[bytes], Any]], spool: Path) -> Iterator[int]:
+        """Spool rows, keeping the chosen row per digest in memory; return sorted kept rows."""
+        chosen: dict[bytes, int] = {}
+        always: list[int] = []
+        keep_last = self.keep == "last"
+
+        def on_row(row_idx: int, digest: Optional[bytes]):
+            self.n_rows += 1
+            if digest is None:
+                always.append(row_idx)
+            elif keep_last or digest not in chosen:
+                chosen[digest] = row_idx
+
+        write_spool(spool, _tracked(rows, on_row))
+
+        self.n_duplicates = self.n_rows - len(always) - len(chosen)
+        return heapq.merge(sorted(chosen.values()), always)
+
+    def _spool_partitioned(
+        self,
+        rows: Iterable[tuple[Optional[bytes], Any]],
+        spool: Path,
+        tmp_dir: Path,
+    ) -> Iterator[int]:
+        """Spool rows and hash-partition their digests; return merged sorted kept rows."""
+        n = self.n_partitions
+        partition_paths = [tmp_dir / f"part-{i:04d}.bin" for i in range(n)]
+        always_path = tmp_dir / "always.run"
+        partitions = [open(path, "wb", buffering=_FILE_BUFFER) for path in partition_paths]
+        always = open(always_path, "wb", buffering=_FILE_BUFFER)
+
+        def on_row(row_idx: int, digest: Optional[bytes]):
+            self.n_rows += 1
+            if digest is None:
+                always.write(row_idx.to_bytes(8, "little", signed=True))
+            else:
+                partitions[int.from_bytes(digest[:8], "little") % n].write(_ENTRY.pack(row_idx, digest))
+
+        try:
+            write_spool(spool, _tracked(rows, on_row))
+        finally:
+            for f in partitions:
+                f.close()
+            always.close()
+
+        runs = [always_path]
+        keep_last = self.keep == "last"
+
+        for i, path in enumerate(partition_paths):
+            # Entries are in row order, so the first (last) one seen wins
+            chosen: dict[bytes, int] = {}
+            n_entries = 0
+            for row_idx, digest in _ENTRY.iter_unpack(path.read_bytes()):
+                n_entries += 1
+                if keep_last or digest not in chosen:
+                    chosen[digest] = row_idx
+            path.unlink()
+
+            self.n_duplicates += n_entries - len(chosen)
+            run = tmp_dir / f"kept-{i:04d}.run"
+            _write_run(run, sorted(chosen.values()))
+            runs.append(run)
+
+        return heapq.merge(*(_read_run(run) for run in runs))
+
     @staticmethod
     def available_key_types() -> list[str]:
         """Return list of available key types."""
@@ -1,13 +1,63 @@
 """Molecular depiction/visualization engine."""
 
+import io
+import tarfile
+import time
+import zipfile
 from typing import Optional, Any
 from pathlib import Path
 
 from rdkit import Chem
-from rdkit.Chem import AllChem, Draw, rdDepictor
+from rdkit.Chem import Draw, rdDepictor
 from rdkit.Chem.Draw import rdMolDraw2D
 
 from rdkit_cli.io.readers import MoleculeRecord
+from rdkit_cli.io.writers import MoleculeWriter
+
+# Output names that ImageWriter writes as a single archive
+ARCHIVE_SUFFIXES = (".zip", ".tar", ".tar.gz", ".tgz")
+
+# Set once per process by configure_depictor
+_depictor_configured = False
+
+
+def configure_depictor():
+    """Prefer CoordGen for 2D coordinates in this process (applied once)."""
+    global _depictor_configured
+    if not _depictor_configured:
+        rdDepictor.SetPreferCoordGen(True)
+        _depictor_configured = True
+
+
+def substructure_highlights(mol: Chem.Mol, pattern: Optional[Chem.Mol]) -> tuple[list[int], list[int]]:
+    """
+    Atoms and bonds of mol matched by a SMARTS pattern.
+
+    Returns:
+        Tuple of (atom indices, bond indices), empty without a pattern or match
+    """
+    atoms: list[int] = []
+    bonds: list[int] = []
+    if pattern is None:
+        return atoms, bonds
+    for match in mol.GetSubstructMatches(pattern):
+        atoms.extend(match)
+        for pattern_bond in pattern.GetBonds():
+            bond = mol.GetBondBetweenAtoms(
+                match[pattern_bond.GetBeginAtomIdx()], match[pattern_bond.GetEndAtomIdx()]
+            )
+            if bond is not None:
+                bonds.append(bond.GetIdx())
+    return atoms, bonds
+
+
+def _compile_smarts(smarts: Optional[str]) -> Optional[Chem.Mol]:
+    if not smarts:
+        return None
+    pattern = Chem.MolFromSmarts(smarts)
+    if pattern is None:
+        raise ValueError(f"Invalid SMARTS pattern: {smarts}")
+    return pattern
 
 
 class MoleculeDepiction:
@@ -25,6 +75,8 @@ class MoleculeDepiction:
         use_kekulize: bool = True,
         wedge_bonds: bool = True,
         add_chiral_hs: bool = True,
+        highlight_smarts: Optional[str] = None,
+        add_legend: bool = False,
     ):
         """
         Initialize molecule depiction.
@@ -40,6 +92,11 @@ class MoleculeDepiction:
             use_kekulize: Use Kekule form for drawing
             wedge_bonds: Draw wedged bonds
             add_chiral_hs: Add chiral Hs
+            highlight_smarts: SMARTS pattern whose matches are highlighted
+            add_legend: Draw the record name below the molecule (depict_record)
+
+        Raises:
+            ValueError: If highlight_smarts is not a valid SMARTS pattern
         """
         self.width = width
         self.height = height
@@ -51,13 +108,42 @@ class MoleculeDepiction:
         self.use_kekulize = use_kekulize
         self.wedge_bonds = wedge_bonds
         self.add_chiral_hs = add_chiral_hs
+        self.highlight_smarts = highlight_smarts
+        self.add_legend = add_legend
+
+        self._pattern = _compile_smarts(highlight_smarts)
+        self._draw_options: Optional[rdMolDraw2D.MolDrawOptions] = None
+
+    def __getstate__(self) -> dict[str, Any]:
+        # Drawer options and the SMARTS pattern are rebuilt in each worker
+        state = self.__dict__.copy()
+        state["_pattern"] = None
+        state["_draw_options"] = None
+        return state
+
+    def __setstate__(self, state: dict[str, Any]):
+        self.__dict__.update(state)
+        self._pattern = _compile_smarts(self.highlight_smarts)
+
+    def _options(self) -> rdMolDraw2D.MolDrawOptions:
+        """Drawer options, built on first use and shared by every drawer of this process."""
+        if self._draw_options is None:
+            configure_depictor()
+            opts = rdMolDraw2D.MolDrawOptions()
+            opts.addAtomIndices = self.add_atom_indices
+            opts.addStereoAnnotation = self.add_stereo_annotation
+            # Molecules are prepared once in depict()
+            opts.prepareMolsBeforeDrawing = False
+            self._draw_options = opts
+        return self._draw_options
 
-    def depict(self, mol: Chem.Mol) -> Optional[str]:
+    def depict(self, mol: Chem.Mol, legend: str = "") -> Optional[str]:
         """
         Generate depiction of a molecule.
 
         Args:
             mol: RDKit molecule
+            legend: Text drawn below the molecule
 
         Returns:
             SVG or PNG data as string/bytes
@@ -66,37 +152,36 @@ class MoleculeDepiction:
             return None
 
         try:
-            # Prepare molecule
-            mol = Chem.Mol(mol)  # Copy
-            if self.add_chiral_hs:
-                mol = Chem.AddHs(mol)
-                AllChem.EmbedMolecule(mol, AllChem.ETKDGv3())
-                mol = Chem.RemoveHs(mol)
+            opts = self._options()
 
-            # Generate 2D coords
-            rdDepictor.Compute2DCoords(mol)
+            highlight_atoms, highlight_bonds = substructure_highlights(mol, self._pattern)
+            highlight_atoms = self.highlight_atoms + highlight_atoms
+            highlight_bonds = self.highlight_bonds + highlight_bonds
 
-            # Create drawer
+            # 2D coordinates, then kekulization, chiral Hs and wedging;
+            # added Hs come last, so highlight indices stay valid
+            mol = Chem.Mol(mol)  # Copy
+            rdDepictor.Compute2DCoords(mol)
+            mol = rdMolDraw2D.PrepareMolForDrawing(
+                mol,
+                kekulize=self.use_kekulize,
+                addChiralHs=self.add_chiral_hs,
+                wedgeBonds=self.wedge_bonds,
+            )
+
+            # A finished drawer cannot be reused, so only its options are shared
             if self.image_format == "svg":
                 drawer = rdMolDraw2D.MolDraw2DSVG(self.width, self.height)
             else:
                 drawer = rdMolDraw2D.MolDraw2DCairo(self.width, self.height)
-
-            # Configure options
-            opts = drawer.drawOptions()
-            opts.addAtomIndices = self.add_atom_indices
-            opts.addStereoAnnotation = self.add_stereo_annotation
-
-            # Draw
-            if self.highlight_atoms or self.highlight_bonds:
-                drawer.DrawMolecule(
-                    mol,
-                    highlightAtoms=self.highlight_atoms,
-                    highlightBonds=self.highlight_bonds,
-                )
-            else:
-                drawer.DrawMolecule(mol)
-
+            drawer.SetDrawOptions(opts)
+
+            drawer.DrawMolecule(
+                mol,
+                highlightAtoms=highlight_atoms,
+                highlightBonds=highlight_bonds,
+                legend=legend,
+            )
             drawer.FinishDrawing()
 
             return drawer.GetDrawingText()
@@ -117,13 +202,15 @@ class MoleculeDepiction:
         if record.mol is None:
             return None
 
-        image_data = self.depict(record.mol)
+        legend = record.name if self.add_legend else ""
+        image_data = self.depict(record.mol, legend=legend)
         if image_data is None:
             return None
 
         result: dict[str, Any] = {
             "smiles": record.smiles,
             "image": image_data,
+            "index": record.row_idx,
         }
 
         if record.name:
@@ -142,6 +229,7 @@ class GridDepiction:
         mol_height: int = 200,
         legends: Optional[list[str]] = None,
         use_svg: bool = True,
+        highlight_smarts: Optional[str] = None,
     ):
         """
         Initialize grid depiction.
@@ -152,12 +240,17 @@ class GridDepiction:
             mol_height: Height per molecule
             legends: List of labels for molecules
             use_svg: Output SVG instead of PNG
+            highlight_smarts: SMARTS pattern whose matches are highlighted
+
+        Raises:
+            ValueError: If highlight_smarts is not a valid SMARTS pattern
         """
         self.mols_per_row = mols_per_row
         self.mol_width = mol_width
         self.mol_height = mol_height
         self.legends = legends
         self.use_svg = use_svg
+        self.pattern = _compile_smarts(highlight_smarts)
 
     def depict(self, mols: list[Chem.Mol]) -> Optional[str]:
         """
@@ -173,17 +266,27 @@ class GridDepiction:
             return None
 
         try:
+            configure_depictor()
+
             # Prepare molecules
             prepared_mols = []
+            highlight_atoms: list[list[int]] = []
+            highlight_bonds: list[list[int]] = []
             for mol in mols:
                 if mol is not None:
                     mol = Chem.Mol(mol)
                     rdDepictor.Compute2DCoords(mol)
-                    prepared_mols.append(mol)
+                    atoms, bonds = substructure_highlights(mol, self.pattern)
                 else:
-                    prepared_mols.append(None)
+                    atoms, bonds = [], []
+                prepared_mols.append(mol)
+                highlight_atoms.append(atoms)
+                highlight_bonds.append(bonds)
 
             legends = self.legends or [""] * len(prepared_mols)
+            highlights: dict[str, Any] = {}
+            if self.pattern is not None:
+                highlights = {"highlightAtomLists": highlight_atoms, "highlightBondLists": highlight_bonds}
 
             if self.use_svg:
                 return Draw.MolsToGridImage(
@@ -192,6 +295,7 @@ class GridDepiction:
                     subImgSize=(self.mol_width, self.mol_height),
                     legends=legends[:len(prepared_mols)],
                     useSVG=True,
+                    **highlights,
                 )
             else:
                 img = Draw.MolsToGridImage(
@@ -199,9 +303,9 @@ class GridDepiction:
                     molsPerRow=self.mols_per_row,
                     subImgSize=(self.mol_width, self.mol_height),
                     legends=legends[:len(prepared_mols)],
+                    **highlights,
                 )
                 # Convert to bytes
-                import io
                 buf = io.BytesIO()
                 img.save(buf, format="PNG")
                 return buf.getvalue()
@@ -210,6 +314,115 @@ class GridDepiction:
             return None
 
 
+def _sanitize_filename(name: str) -> str:
+    return "".join(c for c in name if c.isalnum() or c in "-_")
+
+
+def is_archive_path(path: Path | str) -> bool:
+    """Check whether ImageWriter writes path as an archive rather than a directory."""
+    return Path(path).name.lower().endswith(ARCHIVE_SUFFIXES)
+
+
+class ImageWriter(MoleculeWriter):
+    """
+    Write depict_record results as image files.
+
+    Images are written as results arrive, into a directory or as entries of
+    a single .zip, .tar or .tar.gz archive (by the path's suffix), so no
+    more than a write buffer of them is held in memory. Each file is named
+    after its molecule, or mol_<row> for unnamed molecules (or use_index);
+    a name already written in this run gets _<row> appended.
+    """
+
+    def __init__(
+        self,
+        path: Path | str,
+        image_format: str = "svg",
+        prefix: str = "",
+        suffix: str = "",
+        use_index: bool = False,
+        overwrite: bool = False,
+    ):
+        """
+        Initialize image writer.
+
+        Args:
+            path: Output directory, or archive file
+            image_format: Image format of the results ('svg' or 'png')
+            prefix: Filename prefix
+            suffix: Filename suffix (before the extension)
+            use_index: Name files by row index rather than molecule name
+            overwrite: Replace existing files in a directory (default: skip them)
+        """
+        self.path = Path(path)
+        self.image_format = image_format.lower()
+        self.prefix = prefix
+        self.suffix = suffix
+        self.use_index = use_index
+        self.overwrite = overwrite
+
+        self.written = 0
+        self.skipped = 0
+        self._names: set[str] = set()
+        self._zip: Optional[zipfile.ZipFile] = None
+        self._tar: Optional[tarfile.TarFile] = None
+
+        lower = self.path.name.lower()
+        if lower.endswith(".zip"):
+            # PNG data is already compressed
+            compression = zipfile.ZIP_DEFLATED if self.image_format == "svg" else zipfile.ZIP_STORED
+            self._zip = zipfile.ZipFile(self.path, "w", compression=compression)
+        elif lower.endswith(ARCHIVE_SUFFIXES):
+            self._tar = tarfile.open(self.path, "w" if lower.endswith(".tar") else "w:gz")
+        else:
+            self.path.mkdir(parents=True, exist_ok=True)
+
+    def filename(self, data: dict[str, Any]) -> str:
+        """File name for a result, unique within this run."""
+        index = data.get("index", -1)
+        if index < 0:
+            index = self.written + self.skipped
+        stem = "" if self.use_index else _sanitize_filename(data.get("name", ""))
+        stem = stem or f"mol_{index}"
+        filename = f"{self.prefix}{stem}{self.suffix}.{self.image_format}"
+        if filename in self._names:
+            filename = f"{self.prefix}{stem}_{index}{self.suffix}.{self.image_format}"
+        self._names.add(filename)
+        return filename
+
+    def write_row(self, data: dict[str, Any]):
+        filename = self.filename(data)
+        image = data["image"]
+        payload = image.encode() if isinstance(image, str) else image
+
+        if self._zip is not None:
+            self._zip.writestr(filename, payload)
+        elif self._tar is not None:
+            info = tarfile.TarInfo(filename)
+            info.size = len(payload)
+            info.mtime = int(time.time())
+            self._tar.addfile(info, io.BytesIO(payload))
+        else:
+            path = self.path / filename
+            if not self.overwrite and path.exists():
+                self.skipped += 1
+                return
+            path.write_bytes(payload)
+        self.written += 1
+
+    def write_batch(self, data: list[dict[str, Any]]):
+        for row in data:
+            self.write_row(row)
+
+    def close(self):
+        if self._zip is not None:
+            self._zip.close()
+            self._zip = None
+        if self._tar is not None:
+            self._tar.close()
+            self._tar = None
+
+
 def depict_smiles(
     smiles: str,
     width: int = 300,
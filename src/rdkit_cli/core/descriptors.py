@@ -5,6 +5,7 @@ from typing import Any, Optional
 
 from rdkit import Chem
 from rdkit.Chem import QED, AllChem, Descriptors, rdMolDescriptors
+from rdkit.Chem.EState import EState_VSA
 
 from rdkit_cli.io.readers import MoleculeRecord
 
@@ -167,6 +168,109 @@ def list_descriptors(
     return result
 
 
+# Descriptors that are slices of one RDKit call: group -> (function, names in
+# result order). Computing a group once per molecule replaces one full call
+# per member descriptor. Each VSA family call computes its per-atom inputs
+# (Gasteiger charges, Crippen and Labute ASA contributions, EState indices)
+# once for all its bins, where each member descriptor repeats them.
+_SHARED_GROUPS: dict[str, tuple[callable, list[str]]] = {
+    "mqn": (rdMolDescriptors.MQNs_, _MQN_NAMES),
+    "crippen": (rdMolDescriptors.CalcCrippenDescriptors, ["MolLogP", "MolMR"]),
+    "peoe_vsa": (rdMolDescriptors.PEOE_VSA_, [f"PEOE_VSA{i}" for i in range(1, 15)]),
+    "smr_vsa": (rdMolDescriptors.SMR_VSA_, [f"SMR_VSA{i}" for i in range(1, 11)]),
+    "slogp_vsa": (rdMolDescriptors.SlogP_VSA_, [f"SlogP_VSA{i}" for i in range(1, 13)]),
+    "estate_vsa": (EState_VSA.EState_VSA_, [f"EState_VSA{i}" for i in range(1, 12)]),
+    "vsa_estate": (EState_VSA.VSA_EState_, [f"VSA_EState{i}" for i in range(1, 11)]),
+    "bcut2d": (
+        getattr(rdMolDescriptors, "BCUT2D", None),
+        [
+            "BCUT2D_MWHI", "BCUT2D_MWLOW", "BCUT2D_CHGHI", "BCUT2D_CHGLO",
+            "BCUT2D_LOGPHI", "BCUT2D_LOGPLOW", "BCUT2D_MRHI", "BCUT2D_MRLOW",
+        ],
+    ),
+}
+
+
+def _clean_value(value: Any) -> Optional[float]:
+    """Convert a raw descriptor value to float, mapping NaN and inf to None."""
+    if value is None:
+        return None
+    value = float(value)
+    if value != value or abs(value) == float("inf"):
+        return None
+    return value
+
+
+class DescriptorPlan:
+    """
+    Descriptor functions resolved once, with shared intermediates grouped.
+
+    Registry lookups happen at construction. Descriptors that are slices of
+    the same RDKit call (MQNs, Crippen logP/MR, BCUT2D and the PEOE_VSA,
+    SMR_VSA, SlogP_VSA, EState_VSA and VSA_EState families) are computed
+    with one call per molecule; everything else keeps its own function.
+    Values are the same as compute_descriptor().
+    """
+
+    def __init__(self, names: list[str]):
+        """
+        Initialize plan.
+
+        Args:
+            names: Descriptor names, in output order
+
+        Raises:
+            ValueError: If a name is not a known descriptor
+        """
+        unknown = [name for name in names if name not in DESCRIPTOR_REGISTRY]
+        if unknown:
+            raise ValueError(f"Unknown descriptors: {', '.join(unknown)}")
+
+        self.names = list(names)
+        positions = {name: i for i, name in enumerate(self.names)}
+
+        # Steps: (function, [(output index, index into result or None)])
+        self._steps: list[tuple[callable, list[tuple[int, Optional[int]]]]] = []
+        grouped: set[str] = set()
+
+        for func, members in _SHARED_GROUPS.values():
+            if func is None or not all(member in DESCRIPTOR_REGISTRY for member in members):
+                continue  # RDKit version without the full group
+            slots = [(positions[m], k) for k, m in enumerate(members) if m in positions]
+            if len(slots) > 1:
+                self._steps.append((func, slots))
+                grouped.update(members)
+
+        for i, name in enumerate(self.names):
+            if name not in grouped:
+                self._steps.append((DESCRIPTOR_REGISTRY[name][0], [(i, None)]))
+
+    def compute(self, mol: Chem.Mol) -> list[Optional[float]]:
+        """
+        Compute all descriptors of a molecule.
+
+        Args:
+            mol: RDKit molecule
+
+        Returns:
+            Values in name order; None where computation failed
+        """
+        values: list[Optional[float]] = [None] * len(self.names)
+
+        for func, slots in self._steps:
+            try:
+                result = func(mol)
+            except Exception:
+                continue
+            for out, sub in slots:
+                try:
+                    values[out] = _clean_value(result if sub is None else result[sub])
+                except Exception:
+                    pass
+
+        return values
+
+
 def compute_descriptor(mol: Chem.Mol, name: str) -> Optional[float]:
     """
     Compute a single descriptor for a molecule.
@@ -224,6 +328,7 @@ class DescriptorCalculator:
             if unknown:
                 raise ValueError(f"Unknown descriptors: {', '.join(unknown)}")
             self.descriptors = descriptors
+        self._plan = DescriptorPlan(self.descriptors)
 
         self.include_smiles = include_smiles
         self.include_name = include_name
@@ -232,6 +337,18 @@ class DescriptorCalculator:
         self.generate_conformers = generate_conformers
         self._has_3d = _needs_3d(self.descriptors)
 
+    @property
+    def uses_coordinates(self) -> bool:
+        """Whether results depend on the input conformer (3D descriptors), for result caching."""
+        return self._has_3d
+
+    def cache_key(self) -> str:
+        """Describe every option affecting compute() output, for result caching."""
+        return (
+            f"descriptors={','.join(self.descriptors)};precision={self.precision};"
+            f"error_value={self.error_value};generate_conformers={self.generate_conformers}"
+        )
+
     def _format_value(self, value: Optional[float]) -> Any:
         """Format a descriptor value with precision and error handling."""
         if value is None:
@@ -264,15 +381,58 @@ class DescriptorCalculator:
 
         if self.include_smiles:
             result["smiles"] = record.smiles
-        if self.include_name and record.name:
+        if self.include_name:
+            # Always present, like the column of compute_batch and get_column_names()
             result["name"] = record.name
 
-        for desc_name in self.descriptors:
-            value = compute_descriptor(mol, desc_name)
+        for desc_name, value in zip(self.descriptors, self._plan.compute(mol)):
             result[desc_name] = self._format_value(value)
 
         return result
 
+    def compute_batch(self, records: list[MoleculeRecord]):
+        """
+        Compute descriptors for a batch of records as a columnar RecordBatch.
+
+        Invalid molecules are dropped. Failed values are null (written as
+        error_value by CSV writers), and descriptor columns are float64.
+
+        Args:
+            records: MoleculeRecords to process
+
+        Returns:
+            pyarrow RecordBatch with one row per valid molecule
+        """
+        import pyarrow as pa
+
+        valid = [record for record in records if record.mol is not None]
+        values: list[list[Optional[float]]] = [[] for _ in self.descriptors]
+
+        for record in valid:
+            mol = record.mol
+            if self._has_3d and self.generate_conformers:
+                try:
+                    mol = _ensure_3d(mol)
+                except Exception:
+                    pass  # Will get NaN for 3D descriptors
+
+            for column, value in zip(values, self._plan.compute(mol)):
+                column.append(None if value is None else round(value, self.precision))
+
+        arrays = []
+        names = []
+        if self.include_smiles:
+            names.append("smiles")
+            arrays.append(pa.array([record.smiles for record in valid], type=pa.string()))
+        if self.include_name:
+            names.append("name")
+            arrays.append(pa.array([record.name for record in valid], type=pa.string()))
+        for desc_name, column in zip(self.descriptors, values):
+            names.append(desc_name)
+            arrays.append(pa.array(column, type=pa.float64()))
+
+        return pa.RecordBatch.from_arrays(arrays, names=names)
+
     def get_column_names(self) -> list[str]:
         """Get output column names in order."""
         cols = []
@@ -4,14 +4,9 @@ from typing import Optional, Any
 
 from rdkit import Chem, DataStructs
 from rdkit.Chem import rdMolDescriptors
-from rdkit.Chem.rdFingerprintGenerator import GetMorganGenerator
 from rdkit.SimDivFilters import rdSimDivPickers
 
-
-def get_morgan_fingerprint(mol: Chem.Mol, radius: int = 2, n_bits: int = 2048):
-    """Get Morgan fingerprint for a molecule."""
-    gen = GetMorganGenerator(radius=radius, fpSize=n_bits)
-    return gen.GetFingerprint(mol)
+from rdkit_cli.core.fingerprints import get_morgan_fingerprint
 
 
 class DiversityPicker:
@@ -70,6 +65,32 @@ class DiversityPicker:
         # Generate fingerprints
         fps = [get_morgan_fingerprint(mol, self.radius, self.n_bits) for mol in valid_mols]
 
+        # Map first_picks to valid indices
+        mapped_first = None
+        if first_picks:
+            mapped_first = [valid_indices.index(i) for i in first_picks if i in valid_indices]
+
+        # Map back to original indices
+        return [valid_indices[i] for i in self.pick_fingerprints(fps, mapped_first)]
+
+    def pick_fingerprints(
+        self,
+        fps: list,
+        first_picks: Optional[list[int]] = None,
+    ) -> list[int]:
+        """
+        Pick diverse subset of precomputed fingerprints.
+
+        Args:
+            fps: Fingerprints (e.g. from a FingerprintStore)
+            first_picks: Indices of fingerprints that must be included
+
+        Returns:
+            List of selected indices
+        """
+        if len(fps) == 0:
+            return []
+
         # Adjust n_picks if larger than available
         n_to_pick = min(self.n_picks, len(fps))
 
@@ -79,23 +100,16 @@ class DiversityPicker:
         else:
             picker = rdSimDivPickers.LeaderPicker()
 
-        # Define distance function
-        def dist_func(i, j):
-            return 1 - DataStructs.TanimotoSimilarity(fps[i], fps[j])
-
         # Pick diverse molecules
         if first_picks:
-            # Map first_picks to valid indices
-            mapped_first = [valid_indices.index(i) for i in first_picks if i in valid_indices]
-            picks = list(picker.LazyBitVectorPick(fps, len(fps), n_to_pick, firstPicks=mapped_first))
+            picks = list(picker.LazyBitVectorPick(fps, len(fps), n_to_pick, firstPicks=first_picks))
         else:
             if self.seed is not None:
                 picks = list(picker.LazyBitVectorPick(fps, len(fps), n_to_pick, seed=self.seed))
             else:
                 picks = list(picker.LazyBitVectorPick(fps, len(fps), n_to_pick))
 
-        # Map back to original indices
-        return [valid_indices[i] for i in picks]
+        return picks
 
 
 class DiversityAnalyzer:
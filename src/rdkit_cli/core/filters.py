@@ -1,11 +1,13 @@
 """Molecular filtering engine."""
 
 from dataclasses import dataclass
-from typing import Optional, Any, Callable
+from pathlib import Path
+from typing import Optional, Any, Callable, Iterator
 
-from rdkit import Chem
+from rdkit import Chem, DataStructs
 from rdkit.Chem import Descriptors, FilterCatalog, rdfiltercatalog
 
+from rdkit_cli.core.results import Rejected
 from rdkit_cli.io.readers import MoleculeRecord
 
 
@@ -102,6 +104,21 @@ def check_druglike_rules(mol: Chem.Mol, rule_name: str) -> FilterResult:
     return FilterResult(passed=True)
 
 
+def _passed_row(filter_obj: Any, record: MoleculeRecord) -> dict[str, Any]:
+    """
+    Output row of a record that passed a filter.
+
+    Row metadata is not copied: process_molecules(join_metadata=True) joins
+    it in the parent.
+    """
+    result: dict[str, Any] = {}
+    if filter_obj.include_smiles:
+        result["smiles"] = record.smiles
+    if filter_obj.include_name and record.name:
+        result["name"] = record.name
+    return result
+
+
 class SubstructureFilter:
     """Filter molecules by substructure."""
 
@@ -139,30 +156,331 @@ class SubstructureFilter:
         Returns:
             Dictionary if molecule passes filter, None otherwise
         """
-        if record.mol is None:
+        if record.mol is None or not self.passes(record.mol):
             return None
+        return _passed_row(self, record)
 
-        has_match = record.mol.HasSubstructMatch(self.pattern)
+    def passes(self, mol: Chem.Mol) -> bool:
+        """Check a molecule against the filter."""
+        has_match = mol.HasSubstructMatch(self.pattern)
 
         # If exclude=True, we want molecules WITHOUT the match
         # If exclude=False, we want molecules WITH the match
-        passes = (self.exclude and not has_match) or (not self.exclude and has_match)
+        return has_match != self.exclude
 
-        if not passes:
-            return None
 
+# Default pattern fingerprint size for substructure screening
+DEFAULT_SCREEN_BITS = 2048
+
+# Panel size from which screening each molecule on the fly pays for
+# computing its pattern fingerprint (about the cost of a few matches)
+_SCREEN_MIN_PATTERNS = 4
+
+# Store rows per substructure-matching task
+_STORE_TASK_ROWS = 500
+
+PANEL_MODES = ("any", "all")
+
+
+def read_smarts_file(path: str | Path) -> list[tuple[str, str]]:
+    """
+    Read a SMARTS panel file.
+
+    One pattern per line, optionally followed by whitespace and a name;
+    blank lines and lines starting with '#' are skipped. Unnamed patterns
+    are named after their line number.
+
+    Returns:
+        List of (smarts, name) pairs
+    """
+    patterns = []
+    with open(path) as f:
+        for line_no, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            parts = line.split(None, 1)
+            name = parts[1].strip() if len(parts) > 1 else f"pattern_{line_no}"
+            patterns.append((parts[0], name))
+    return patterns
+
+
+def pattern_screen(query: Chem.Mol, n_bits: int = DEFAULT_SCREEN_BITS) -> Optional[DataStructs.ExplicitBitVect]:
+    """
+    Pattern fingerprint of a query for substructure screening.
+
+    Every bit set here is set in the pattern fingerprint of any molecule the
+    query matches, so a molecule missing one of them cannot match.
+
+    Returns:
+        Fingerprint, or None if it cannot be computed (the query is then
+        never screened out)
+    """
+    try:
+        query = Chem.Mol(query)
+        query.UpdatePropertyCache(strict=False)
+        Chem.FastFindRings(query)
+        return Chem.PatternFingerprint(query, fpSize=n_bits)
+    except Exception:
+        return None
+
+
+class SubstructurePanel:
+    """
+    Filter molecules by a panel of SMARTS patterns in one pass.
+
+    With mode "any" a molecule passes if at least one pattern matches, with
+    "all" if every pattern does; exclude inverts the outcome. Matching stops
+    as soon as the outcome is known (unless matches are reported).
+
+    Before a full substructure match, each pattern is screened with pattern
+    fingerprints: a query can only match a molecule whose fingerprint has
+    all of the query's bits. Molecule fingerprints are either computed on
+    the fly (by default for panels of _SCREEN_MIN_PATTERNS or more) or read
+    from a pattern fingerprint store (see filter_fingerprint_store).
+    """
+
+    def __init__(
+        self,
+        patterns: list[tuple[str, str]],
+        mode: str = "any",
+        exclude: bool = False,
+        add_matches: bool = False,
+        use_chirality: bool = False,
+        screen: Optional[bool] = None,
+        screen_bits: int = DEFAULT_SCREEN_BITS,
+        include_smiles: bool = True,
+        include_name: bool = True,
+    ):
+        """
+        Initialize substructure panel.
+
+        Args:
+            patterns: (smarts, name) pairs
+            mode: "any" or "all" patterns must match
+            exclude: Keep molecules that do not pass instead
+            add_matches: Add a matched_patterns column (names joined by ';')
+            use_chirality: Consider chirality in matching
+            screen: Screen each molecule on the fly (default: for panels of
+                at least _SCREEN_MIN_PATTERNS patterns)
+            screen_bits: Pattern fingerprint size
+            include_smiles: Include SMILES in output
+            include_name: Include molecule name in output
+        """
+        if not patterns:
+            raise ValueError("No SMARTS patterns given")
+        if mode not in PANEL_MODES:
+            raise ValueError(f"Unknown panel mode: {mode}. Available: {', '.join(PANEL_MODES)}")
+
+        self.queries = []
+        self.names = []
+        for smarts, name in patterns:
+            query = Chem.MolFromSmarts(smarts)
+            if query is None:
+                raise ValueError(f"Invalid SMARTS pattern: {smarts} ({name})")
+            self.queries.append(query)
+            self.names.append(name)
+
+        self.mode = mode
+        self.exclude = exclude
+        self.add_matches = add_matches
+        self.use_chirality = use_chirality
+        self.screen = len(self.queries) >= _SCREEN_MIN_PATTERNS if screen is None else screen
+        self.screen_bits = screen_bits
+        self.screens = [pattern_screen(query, screen_bits) for query in self.queries]
+        self.include_smiles = include_smiles
+        self.include_name = include_name
+
+    def __len__(self) -> int:
+        return len(self.queries)
+
+    def candidates(self, mol: Chem.Mol) -> list[int]:
+        """Indices of the patterns that survive screening against a molecule."""
+        if not self.screen:
+            return list(range(len(self.queries)))
+        fp = Chem.PatternFingerprint(mol, fpSize=self.screen_bits)
+        return [
+            i for i, screen in enumerate(self.screens)
+            if screen is None or DataStructs.AllProbeBitsMatch(screen, fp)
+        ]
+
+    @property
+    def min_candidates(self) -> int:
+        """Fewest patterns that must survive screening for the panel to be able to hit."""
+        if self.mode == "all" and not self.add_matches:
+            return len(self.queries)
+        return 1
+
+    def decided_by_screen(self, candidates: list[int]) -> bool:
+        """Check whether screening alone shows the panel cannot hit."""
+        return len(candidates) < self.min_candidates
+
+    def evaluate(self, mol: Chem.Mol, candidates: Optional[list[int]] = None) -> Optional[list[int]]:
+        """
+        Match a molecule against the panel.
+
+        Args:
+            mol: Molecule
+            candidates: Pattern indices left after screening (default:
+                screened here, if enabled)
+
+        Returns:
+            Indices of matched patterns (possibly partial when matching
+            stopped early) if the molecule passes, None otherwise
+        """
+        if candidates is None:
+            candidates = self.candidates(mol)
+
+        matched: list[int] = []
+        if not self.decided_by_screen(candidates):
+            stop_early = not self.add_matches
+            for i in candidates:
+                if mol.HasSubstructMatch(self.queries[i], useChirality=self.use_chirality):
+                    matched.append(i)
+                    if stop_early and self.mode == "any":
+                        break
+                elif stop_early and self.mode == "all":
+                    break
+
+        if self.mode == "any":
+            hit = bool(matched)
+        else:
+            hit = len(matched) == len(self.queries)
+        return matched if hit != self.exclude else None
+
+    def result(self, smiles: str, name: str, matched: list[int]) -> dict[str, Any]:
+        """Output row of a passing molecule."""
         result: dict[str, Any] = {}
         if self.include_smiles:
-            result["smiles"] = record.smiles
-        if self.include_name and record.name:
-            result["name"] = record.name
+            result["smiles"] = smiles
+        if self.include_name and name:
+            result["name"] = name
+        if self.add_matches:
+            result["matched_patterns"] = ";".join(self.names[i] for i in matched)
+        return result
 
-        # Copy other metadata
-        for key, value in record.metadata.items():
-            if key not in result:
-                result[key] = value
+    def filter(self, record: MoleculeRecord) -> Optional[dict[str, Any]]:
+        """Filter a molecule record."""
+        if record.mol is None:
+            return None
 
-        return result
+        matched = self.evaluate(record.mol)
+        if matched is None:
+            return None
+        return self.result(record.smiles, record.name, matched)
+
+    def filter_smiles(self, smiles: str, name: str, candidates: list[int]) -> Optional[dict[str, Any]]:
+        """Filter a stored molecule given its screened candidate patterns."""
+        if self.decided_by_screen(candidates):
+            # No match possible: decided without parsing
+            return self.result(smiles, name, []) if self.exclude else None
+
+        mol = Chem.MolFromSmiles(smiles)
+        if mol is None:
+            return None
+        matched = self.evaluate(mol, candidates)
+        if matched is None:
+            return None
+        return self.result(smiles, name, matched)
+
+
+class _PanelStoreTask:
+    """Worker-side substructure matching of screened store rows."""
+
+    def __init__(self, panel: SubstructurePanel):
+        self.panel = panel
+
+    def __call__(self, rows: list[tuple[str, str, list[int]]]) -> list[Optional[dict[str, Any]]]:
+        return [self.panel.filter_smiles(smiles, name, candidates) for smiles, name, candidates in rows]
+
+
+def screen_fingerprint_store(store, panel: SubstructurePanel) -> Iterator[tuple[str, str, list[int]]]:
+    """
+    Screen a pattern fingerprint store against a panel.
+
+    The subset test runs on the packed 64-bit words of each stored record
+    batch, one pattern at a time. Rows the screen rules out are not yielded
+    unless they pass anyway (exclude mode).
+
+    Args:
+        store: Open FingerprintStore of pattern fingerprints
+        panel: Panel whose screens have the store's size
+
+    Yields:
+        (smiles, name, candidate pattern indices) in store order
+    """
+    import numpy as np
+
+    from rdkit_cli.core.fingerprints import fingerprint_to_packed
+
+    n_bits = store.params.n_bits
+    screens = [
+        None if screen is None else np.frombuffer(fingerprint_to_packed(screen, n_bits), dtype="<u8")
+        for screen in panel.screens
+    ]
+    smiles = store.table.column("smiles")
+    names = store.table.column("name")
+
+    for start, words in store.iter_word_blocks():
+        mask = np.ones((len(words), len(screens)), dtype=bool)
+        for i, screen in enumerate(screens):
+            if screen is not None:
+                mask[:, i] = ((words & screen) == screen).all(axis=1)
+
+        if panel.exclude:
+            rows = range(len(words))
+        else:
+            rows = np.flatnonzero(mask.sum(axis=1) >= panel.min_candidates).tolist()
+
+        for row in rows:
+            candidates = np.flatnonzero(mask[row]).tolist()
+            yield smiles[start + row].as_py(), names[start + row].as_py(), candidates
+
+
+def filter_fingerprint_store(
+    store,
+    panel: SubstructurePanel,
+    n_workers: int = 1,
+) -> Iterator[dict[str, Any]]:
+    """
+    Filter the molecules of a pattern fingerprint store through a panel.
+
+    Only rows surviving the screen are parsed and matched, on the worker
+    pool.
+
+    Args:
+        store: Open FingerprintStore (fp_type "pattern")
+        panel: SubstructurePanel
+        n_workers: Number of worker processes for substructure matching
+
+    Yields:
+        Output rows of passing molecules, in store order
+
+    Raises:
+        ValueError: If the store does not hold pattern fingerprints
+    """
+    from itertools import islice
+
+    from rdkit_cli.parallel.executor import ParallelExecutor
+
+    if store.params.fp_type != "pattern":
+        raise ValueError(
+            f"Substructure screening needs a pattern fingerprint store, got '{store.params.fp_type}' "
+            "(build one with 'fingerprints compute --type pattern -o FILE.fpdb')"
+        )
+    if panel.screen_bits != store.params.n_bits:
+        raise ValueError(
+            f"Panel screens have {panel.screen_bits} bits, store has {store.params.n_bits}"
+        )
+
+    rows = screen_fingerprint_store(store, panel)
+    chunks = iter(lambda: list(islice(rows, _STORE_TASK_ROWS)), [])
+
+    with ParallelExecutor(_PanelStoreTask(panel), n_workers=n_workers) as executor:
+        for results in executor.imap(chunks):
+            for result in results:
+                if result is not None:
+                    yield result
 
 
 class PropertyFilter:
@@ -188,24 +506,16 @@ class PropertyFilter:
 
     def filter(self, record: MoleculeRecord) -> Optional[dict[str, Any]]:
         """Filter a molecule record."""
-        if record.mol is None:
+        if record.mol is None or not self.passes(record.mol):
             return None
+        return _passed_row(self, record)
 
-        for prop, (min_val, max_val) in self.rules.items():
-            if not check_property_range(record.mol, prop, min_val, max_val):
-                return None
-
-        result: dict[str, Any] = {}
-        if self.include_smiles:
-            result["smiles"] = record.smiles
-        if self.include_name and record.name:
-            result["name"] = record.name
-
-        for key, value in record.metadata.items():
-            if key not in result:
-                result[key] = value
-
-        return result
+    def passes(self, mol: Chem.Mol) -> bool:
+        """Check a molecule against the filter."""
+        return all(
+            check_property_range(mol, prop, min_val, max_val)
+            for prop, (min_val, max_val) in self.rules.items()
+        )
 
 
 class DruglikeFilter:
@@ -237,30 +547,19 @@ class DruglikeFilter:
 
     def filter(self, record: MoleculeRecord) -> Optional[dict[str, Any]]:
         """Filter a molecule record."""
-        if record.mol is None:
+        if record.mol is None or not self.passes(record.mol):
             return None
+        return _passed_row(self, record)
 
-        rules = DRUGLIKE_RULES[self.rule_name]
+    def passes(self, mol: Chem.Mol) -> bool:
+        """Check a molecule against the filter (stops once too many rules fail)."""
         violations = 0
-
-        for prop, (min_val, max_val) in rules.items():
-            if not check_property_range(record.mol, prop, min_val, max_val):
+        for prop, (min_val, max_val) in DRUGLIKE_RULES[self.rule_name].items():
+            if not check_property_range(mol, prop, min_val, max_val):
                 violations += 1
-
-        if violations > self.max_violations:
-            return None
-
-        result: dict[str, Any] = {}
-        if self.include_smiles:
-            result["smiles"] = record.smiles
-        if self.include_name and record.name:
-            result["name"] = record.name
-
-        for key, value in record.metadata.items():
-            if key not in result:
-                result[key] = value
-
-        return result
+                if violations > self.max_violations:
+                    return False
+        return True
 
 
 ALERT_CATALOGS = {
@@ -274,6 +573,22 @@ ALERT_CATALOGS = {
 }
 
 
+def _build_alert_catalog(catalog_name: str) -> FilterCatalog.FilterCatalog:
+    """Build a FilterCatalog for the named alert catalog (or 'all')."""
+    params = FilterCatalog.FilterCatalogParams()
+    if catalog_name == "all":
+        for cat in ALERT_CATALOGS.values():
+            params.AddCatalog(cat)
+    elif catalog_name in ALERT_CATALOGS:
+        params.AddCatalog(ALERT_CATALOGS[catalog_name])
+    else:
+        raise ValueError(
+            f"Unknown catalog: {catalog_name}. "
+            f"Available: {', '.join(list(ALERT_CATALOGS.keys()) + ['all'])}"
+        )
+    return FilterCatalog.FilterCatalog(params)
+
+
 class PAINSFilter:
     """Filter molecules using structural alert catalogs (PAINS, Brenk, NIH, ZINC)."""
 
@@ -297,47 +612,33 @@ class PAINSFilter:
         self.include_smiles = include_smiles
         self.include_name = include_name
 
-        # Initialize filter catalog
-        params = FilterCatalog.FilterCatalogParams()
-        if catalog_name == "all":
-            for cat in ALERT_CATALOGS.values():
-                params.AddCatalog(cat)
-        elif catalog_name in ALERT_CATALOGS:
-            params.AddCatalog(ALERT_CATALOGS[catalog_name])
-        else:
-            raise ValueError(
-                f"Unknown catalog: {catalog_name}. "
-                f"Available: {', '.join(list(ALERT_CATALOGS.keys()) + ['all'])}"
-            )
-        self.catalog = FilterCatalog.FilterCatalog(params)
+        self.catalog_name = catalog_name
+        self.catalog = _build_alert_catalog(catalog_name)
+
+    def __getstate__(self) -> dict[str, Any]:
+        # The catalog is rebuilt from its name in each worker rather than
+        # being serialized along with the filter.
+        state = self.__dict__.copy()
+        state.pop("catalog", None)
+        return state
+
+    def __setstate__(self, state: dict[str, Any]):
+        self.__dict__.update(state)
+        self.catalog = _build_alert_catalog(self.catalog_name)
 
     def filter(self, record: MoleculeRecord) -> Optional[dict[str, Any]]:
         """Filter a molecule record (returns None if PAINS hit and exclude=True)."""
-        if record.mol is None:
+        if record.mol is None or not self.passes(record.mol):
             return None
+        return _passed_row(self, record)
 
-        # Check for PAINS
-        entry = self.catalog.GetFirstMatch(record.mol)
-        is_pains = entry is not None
+    def passes(self, mol: Chem.Mol) -> bool:
+        """Check a molecule against the catalog."""
+        is_pains = self.catalog.GetFirstMatch(mol) is not None
 
         # If exclude=True (default), filter out PAINS hits
         # If exclude=False, keep only PAINS hits
-        if self.exclude and is_pains:
-            return None
-        if not self.exclude and not is_pains:
-            return None
-
-        result: dict[str, Any] = {}
-        if self.include_smiles:
-            result["smiles"] = record.smiles
-        if self.include_name and record.name:
-            result["name"] = record.name
-
-        for key, value in record.metadata.items():
-            if key not in result:
-                result[key] = value
-
-        return result
+        return is_pains != self.exclude
 
 
 class ElementFilter:
@@ -367,40 +668,27 @@ class ElementFilter:
 
     def filter(self, record: MoleculeRecord) -> Optional[dict[str, Any]]:
         """Filter a molecule record by elements."""
-        if record.mol is None:
+        if record.mol is None or not self.passes(record.mol):
             return None
+        return _passed_row(self, record)
 
-        # Get elements in molecule
-        elements = set()
-        for atom in record.mol.GetAtoms():
-            elements.add(atom.GetSymbol())
+    def passes(self, mol: Chem.Mol) -> bool:
+        """Check the elements of a molecule."""
+        elements = {atom.GetSymbol() for atom in mol.GetAtoms()}
 
         # Check allowed
-        if self.allowed is not None:
-            if not elements.issubset(self.allowed):
-                return None
+        if self.allowed is not None and not elements.issubset(self.allowed):
+            return False
 
         # Check required
-        if self.required is not None:
-            if not self.required.issubset(elements):
-                return None
+        if self.required is not None and not self.required.issubset(elements):
+            return False
 
         # Check forbidden
-        if self.forbidden is not None:
-            if elements.intersection(self.forbidden):
-                return None
-
-        result: dict[str, Any] = {}
-        if self.include_smiles:
-            result["smiles"] = record.smiles
-        if self.include_name and record.name:
-            result["name"] = record.name
-
-        for key, value in record.metadata.items():
-            if key not in result:
-                result[key] = value
+        if self.forbidden is not None and elements.intersection(self.forbidden):
+            return False
 
-        return result
+        return True
 
 
 class ComplexityFilter:
@@ -439,34 +727,244 @@ class ComplexityFilter:
 
     def filter(self, record: MoleculeRecord) -> Optional[dict[str, Any]]:
         """Filter a molecule record by complexity."""
-        if record.mol is None:
+        if record.mol is None or not self.passes(record.mol):
             return None
+        return _passed_row(self, record)
 
-        mol = record.mol
-
+    def passes(self, mol: Chem.Mol) -> bool:
+        """Check the complexity of a molecule."""
         # Check heavy atom count
         heavy_atoms = mol.GetNumHeavyAtoms()
         if heavy_atoms < self.min_atoms or heavy_atoms > self.max_atoms:
-            return None
+            return False
 
         # Check ring count
         ring_count = Descriptors.RingCount(mol)
         if ring_count < self.min_rings or ring_count > self.max_rings:
-            return None
+            return False
 
         # Check rotatable bonds
         rotatable = Descriptors.NumRotatableBonds(mol)
-        if rotatable < self.min_rotatable or rotatable > self.max_rotatable:
-            return None
+        return self.min_rotatable <= rotatable <= self.max_rotatable
+
+
+# Relative cost of each filter stage. Cheaper stages run first, so most
+# rejections happen before substructure searches and catalog matching.
+FILTER_STAGE_COSTS = {
+    "elements": 0,
+    "complexity": 1,
+    "property": 2,
+    "druglike": 2,
+    "substructure": 3,
+    "pains": 4,
+    "alerts": 4,
+}
 
-        result: dict[str, Any] = {}
-        if self.include_smiles:
-            result["smiles"] = record.smiles
-        if self.include_name and record.name:
-            result["name"] = record.name
+_COMPLEXITY_OPTIONS = ("min_atoms", "max_atoms", "min_rings", "max_rings", "min_rotatable", "max_rotatable")
 
-        for key, value in record.metadata.items():
-            if key not in result:
-                result[key] = value
 
-        return result
+def parse_property_rule(rule: str) -> tuple[str, Optional[float], Optional[float]]:
+    """
+    Parse a 'PROP<OP>VALUE' rule ('MolWt<500', 'LogP>=-2').
+
+    Returns:
+        (property, min_val, max_val) with one bound set
+
+    Raises:
+        ValueError: If the rule is malformed
+    """
+    for op in ("<=", ">=", "<", ">"):
+        if op in rule:
+            prop, value = rule.split(op, 1)
+            try:
+                bound = float(value.strip())
+            except ValueError:
+                raise ValueError(f"Invalid value in rule: {rule}") from None
+            if op.startswith("<"):
+                return prop.strip(), None, bound
+            return prop.strip(), bound, None
+    raise ValueError(f"Invalid rule format: {rule}")
+
+
+def parse_property_rules(rules: list[str]) -> dict[str, tuple[Optional[float], Optional[float]]]:
+    """Parse property rules, combining bounds given for the same property."""
+    parsed: dict[str, tuple[Optional[float], Optional[float]]] = {}
+    for rule in rules:
+        prop, min_val, max_val = parse_property_rule(rule)
+        old_min, old_max = parsed.get(prop, (None, None))
+        parsed[prop] = (min_val if min_val is not None else old_min, max_val if max_val is not None else old_max)
+    return parsed
+
+
+def _as_list(value: Any) -> Optional[list[str]]:
+    """Accept a list or a comma-separated string."""
+    if value is None:
+        return None
+    if isinstance(value, str):
+        return [item.strip() for item in value.split(",") if item.strip()]
+    return [str(item) for item in value]
+
+
+def _as_bool(value: Any) -> bool:
+    if isinstance(value, str):
+        return value.strip().lower() in ("1", "true", "yes", "on")
+    return bool(value)
+
+
+def build_filter_stage(kind: str, options: dict[str, Any]) -> Any:
+    """
+    Build one filter of a chain from its spec options.
+
+    Options mirror the command-line flags of the single filter commands:
+        property:     rules (list or 'MolWt<500,TPSA<140')
+        druglike:     rule, max_violations
+        pains/alerts: catalog, keep (keep alerting compounds instead)
+        elements:     allowed, required, forbidden (lists or comma-separated)
+        complexity:   min_atoms, max_atoms, min_rings, max_rings,
+                      min_rotatable, max_rotatable
+        substructure: smarts, exclude
+
+    Raises:
+        ValueError: On unknown filters, unknown options or invalid values
+    """
+    options = dict(options)
+    if kind == "property":
+        rules = _as_list(options.pop("rules", None))
+        if not rules:
+            raise ValueError("property filter needs 'rules'")
+        stage = PropertyFilter(rules=parse_property_rules(rules))
+    elif kind == "druglike":
+        stage = DruglikeFilter(
+            rule_name=options.pop("rule", "lipinski"),
+            max_violations=int(options.pop("max_violations", 0)),
+        )
+    elif kind in ("pains", "alerts"):
+        stage = PAINSFilter(
+            exclude=not _as_bool(options.pop("keep", False)),
+            catalog_name=options.pop("catalog", "pains"),
+        )
+    elif kind == "elements":
+        stage = ElementFilter(
+            allowed_elements=_as_list(options.pop("allowed", None)),
+            required_elements=_as_list(options.pop("required", None)),
+            forbidden_elements=_as_list(options.pop("forbidden", None)),
+        )
+    elif kind == "complexity":
+        values = {key: int(options.pop(key)) for key in _COMPLEXITY_OPTIONS if key in options}
+        stage = ComplexityFilter(**values)
+    elif kind == "substructure":
+        smarts = options.pop("smarts", None)
+        if smarts is None:
+            raise ValueError("substructure filter needs 'smarts'")
+        stage = SubstructureFilter(smarts=smarts, exclude=_as_bool(options.pop("exclude", False)))
+    else:
+        raise ValueError(
+            f"Unknown filter: {kind}. Available: {', '.join(FILTER_STAGE_COSTS)}"
+        )
+
+    if options:
+        raise ValueError(f"Unknown option(s) for {kind} filter: {', '.join(sorted(options))}")
+    return stage
+
+
+def parse_filter_step(text: str) -> dict[str, Any]:
+    """
+    Parse a command-line filter step: 'KIND key=value key=value ...'.
+
+    Returns:
+        Spec entry as in a filter spec file ({"filter": KIND, key: value})
+    """
+    tokens = text.split()
+    if not tokens:
+        raise ValueError("Empty filter step")
+    entry: dict[str, Any] = {"filter": tokens[0]}
+    for token in tokens[1:]:
+        key, sep, value = token.partition("=")
+        if not sep:
+            raise ValueError(f"Expected key=value in filter step '{text}', got '{token}'")
+        entry[key.replace("-", "_")] = value
+    return entry
+
+
+def load_filter_spec(path: str | Path) -> list[dict[str, Any]]:
+    """
+    Read a JSON filter spec: a list of {"filter": KIND, ...options} entries
+    (or {"filters": [...]}). An optional "name" labels a stage in reports.
+    """
+    import json
+
+    with open(path) as f:
+        spec = json.load(f)
+    if isinstance(spec, dict):
+        spec = spec.get("filters")
+    if not isinstance(spec, list) or not all(isinstance(entry, dict) for entry in spec):
+        raise ValueError(f"Filter spec must be a list of filter objects: {path}")
+    return spec
+
+
+class FilterChain:
+    """
+    Several filters applied to each molecule in one pass.
+
+    Stages run cheapest first (FILTER_STAGE_COSTS, stable for equal costs)
+    unless keep_order is set, and a molecule stops at the first stage that
+    rejects it. Rejections are returned as Rejected(stage label), so
+    process_molecules counts them per stage.
+    """
+
+    def __init__(
+        self,
+        spec: list[dict[str, Any]],
+        keep_order: bool = False,
+        include_smiles: bool = True,
+        include_name: bool = True,
+    ):
+        """
+        Initialize filter chain.
+
+        Args:
+            spec: Entries {"filter": KIND, "name": LABEL (optional), ...options}
+                (see build_filter_stage)
+            keep_order: Run stages in spec order instead of by cost
+            include_smiles: Include SMILES in output
+            include_name: Include molecule name in output
+
+        Raises:
+            ValueError: If the spec is empty or a stage is invalid
+        """
+        if not spec:
+            raise ValueError("Filter chain needs at least one filter")
+
+        stages = []
+        seen: dict[str, int] = {}
+        for entry in spec:
+            options = dict(entry)
+            kind = options.pop("filter", None)
+            if kind is None:
+                raise ValueError(f"Filter spec entry without 'filter': {entry}")
+            label = options.pop("name", None)
+            if label is None:
+                seen[kind] = seen.get(kind, 0) + 1
+                label = kind if seen[kind] == 1 else f"{kind}_{seen[kind]}"
+            stages.append((FILTER_STAGE_COSTS.get(kind, 0), label, build_filter_stage(kind, options)))
+
+        if not keep_order:
+            stages.sort(key=lambda stage: stage[0])
+        self.stages = [(label, stage) for _, label, stage in stages]
+        self.include_smiles = include_smiles
+        self.include_name = include_name
+
+    @property
+    def labels(self) -> list[str]:
+        """Stage labels in execution order."""
+        return [label for label, _ in self.stages]
+
+    def filter(self, record: MoleculeRecord) -> Optional[dict[str, Any] | Rejected]:
+        """Filter a molecule record through every stage."""
+        if record.mol is None:
+            return None
+
+        for label, stage in self.stages:
+            if not stage.passes(record.mol):
+                return Rejected(label)
+        return _passed_row(self, record)
@@ -2,6 +2,7 @@
 
 from dataclasses import dataclass
 from enum import Enum
+from functools import lru_cache
 from typing import Optional, Any
 
 from rdkit import Chem, DataStructs
@@ -105,6 +106,38 @@ def list_fingerprints() -> list[FingerprintInfo]:
     return list(FINGERPRINT_INFO.values())
 
 
+@lru_cache(maxsize=None)
+def get_fingerprint_generator(fp_type: FingerprintType, n_bits: int = 2048, radius: int = 2):
+    """
+    Get a cached fingerprint generator/encoder for the given parameters.
+
+    Generators are built once per process (i.e. once per worker) and reused
+    for every molecule instead of being re-created on each call.
+
+    Args:
+        fp_type: Type of fingerprint (MORGAN, ATOMPAIR, TORSION or MHFP)
+        n_bits: Number of bits
+        radius: Radius for Morgan fingerprints
+
+    Returns:
+        Generator object, or None if the type has no generator
+    """
+    if fp_type == FingerprintType.MORGAN:
+        return GetMorganGenerator(radius=radius, fpSize=n_bits)
+    elif fp_type == FingerprintType.ATOMPAIR:
+        return GetAtomPairGenerator(fpSize=n_bits)
+    elif fp_type == FingerprintType.TORSION:
+        return GetTopologicalTorsionGenerator(fpSize=n_bits)
+    elif fp_type == FingerprintType.MHFP:
+        return rdMHFPFingerprint.MHFPEncoder(n_bits)
+    return None
+
+
+def get_morgan_fingerprint(mol: Chem.Mol, radius: int = 2, n_bits: int = 2048):
+    """Get Morgan fingerprint for a molecule."""
+    return get_fingerprint_generator(FingerprintType.MORGAN, n_bits, radius).GetFingerprint(mol)
+
+
 def compute_fingerprint(
     mol: Chem.Mol,
     fp_type: FingerprintType,
@@ -127,7 +160,7 @@ def compute_fingerprint(
     """
     try:
         if fp_type == FingerprintType.MORGAN:
-            gen = GetMorganGenerator(radius=radius, fpSize=n_bits)
+            gen = get_fingerprint_generator(fp_type, n_bits, radius)
             if use_counts:
                 return gen.GetCountFingerprint(mol)
             else:
@@ -140,11 +173,11 @@ def compute_fingerprint(
             return Chem.RDKFingerprint(mol, fpSize=n_bits)
 
         elif fp_type == FingerprintType.ATOMPAIR:
-            gen = GetAtomPairGenerator(fpSize=n_bits)
+            gen = get_fingerprint_generator(fp_type, n_bits)
             return gen.GetFingerprint(mol)
 
         elif fp_type == FingerprintType.TORSION:
-            gen = GetTopologicalTorsionGenerator(fpSize=n_bits)
+            gen = get_fingerprint_generator(fp_type, n_bits)
             return gen.GetFingerprint(mol)
 
         elif fp_type == FingerprintType.PATTERN:
@@ -154,7 +187,7 @@ def compute_fingerprint(
             return pyAvalonTools.GetAvalonFP(mol, nBits=n_bits)
 
         elif fp_type == FingerprintType.MHFP:
-            encoder = rdMHFPFingerprint.MHFPEncoder(n_bits)
+            encoder = get_fingerprint_generator(fp_type, n_bits)
             return encoder.EncodeSECFPMol(mol, radius=radius, length=n_bits)
 
         elif fp_type == FingerprintType.PHARMACOPHORE:
@@ -200,6 +233,43 @@ def fingerprint_to_numpy(fp):
     return arr
 
 
+def packed_width(n_bits: int) -> int:
+    """Bytes per packed fingerprint: whole little-endian uint64 words."""
+    return (n_bits + 63) // 64 * 8
+
+
+def fingerprint_to_packed(fp, n_bits: int) -> bytes:
+    """
+    Pack a bit vector into little-endian uint64 words.
+
+    Bit i is bit (i % 64) of word (i // 64); the last word is zero-padded.
+
+    Args:
+        fp: ExplicitBitVect or SparseBitVect
+        n_bits: Fingerprint size in bits
+
+    Returns:
+        packed_width(n_bits) bytes
+    """
+    import numpy as np
+
+    bits = np.zeros(packed_width(n_bits) * 8, dtype=np.uint8)
+    on_bits = list(fp.GetOnBits())
+    if on_bits:
+        bits[on_bits] = 1
+    return np.packbits(bits, bitorder="little").tobytes()
+
+
+def packed_to_fingerprint(data: bytes, n_bits: int) -> DataStructs.ExplicitBitVect:
+    """Unpack fingerprint_to_packed() output into an ExplicitBitVect."""
+    import numpy as np
+
+    bits = np.unpackbits(np.frombuffer(data, dtype=np.uint8), bitorder="little")[:n_bits]
+    fp = DataStructs.ExplicitBitVect(n_bits)
+    fp.SetBitsFromList(np.flatnonzero(bits).tolist())
+    return fp
+
+
 class FingerprintCalculator:
     """Calculator for molecular fingerprints."""
 
@@ -221,7 +291,8 @@ class FingerprintCalculator:
             n_bits: Number of bits
             radius: Radius for Morgan fingerprints
             use_counts: Use count fingerprints
-            output_format: Output format (hex, bitstring, bits)
+            output_format: Output format (hex, bitstring, bits, or packed
+                for fingerprint stores)
             include_smiles: Include SMILES in output
             include_name: Include molecule name in output
         """
@@ -239,6 +310,13 @@ class FingerprintCalculator:
         elif fp_type == FingerprintType.PHARMACOPHORE:
             self.n_bits = 39972
 
+    def cache_key(self) -> str:
+        """Describe every option affecting compute() output, for result caching."""
+        return (
+            f"type={self.fp_type.value};bits={self.n_bits};radius={self.radius};"
+            f"counts={self.use_counts};format={self.output_format}"
+        )
+
     def compute(self, record: MoleculeRecord) -> Optional[dict[str, Any]]:
         """
         Compute fingerprint for a molecule record.
@@ -267,11 +345,15 @@ class FingerprintCalculator:
 
         if self.include_smiles:
             result["smiles"] = record.smiles
-        if self.include_name and record.name:
+        if self.include_name:
+            # Always present, like the column of compute_batch and get_column_names()
             result["name"] = record.name
 
         # Format fingerprint
-        if self.output_format == "hex":
+        if self.output_format == "packed":
+            result["fp"] = fingerprint_to_packed(fp, self.n_bits)
+            result["popcount"] = fp.GetNumOnBits()
+        elif self.output_format == "hex":
             result["fingerprint"] = fingerprint_to_hex(fp)
         elif self.output_format == "bitstring":
             result["fingerprint"] = fingerprint_to_bitstring(fp)
@@ -285,6 +367,77 @@ class FingerprintCalculator:
 
         return result
 
+    def compute_batch(self, records: list[MoleculeRecord]):
+        """
+        Compute fingerprints for a batch of records as a columnar RecordBatch.
+
+        Invalid molecules and failed fingerprints are dropped. With the
+        "bits" format, bit columns are uint8 arrays sliced from one matrix.
+
+        Args:
+            records: MoleculeRecords to process
+
+        Returns:
+            pyarrow RecordBatch with one row per computed fingerprint
+        """
+        import numpy as np
+        import pyarrow as pa
+
+        kept: list[MoleculeRecord] = []
+        encoded: list[Any] = []
+        popcounts: list[int] = []
+
+        for record in records:
+            if record.mol is None:
+                continue
+
+            fp = compute_fingerprint(
+                record.mol,
+                self.fp_type,
+                n_bits=self.n_bits,
+                radius=self.radius,
+                use_counts=self.use_counts,
+            )
+            if fp is None:
+                continue
+
+            kept.append(record)
+            if self.output_format == "packed":
+                encoded.append(fingerprint_to_packed(fp, self.n_bits))
+                popcounts.append(fp.GetNumOnBits())
+            elif self.output_format in ("bitstring", "bits"):
+                encoded.append(fingerprint_to_bitstring(fp))
+            else:
+                encoded.append(fingerprint_to_hex(fp))
+
+        arrays = []
+        names = []
+        if self.include_smiles:
+            names.append("smiles")
+            arrays.append(pa.array([record.smiles for record in kept], type=pa.string()))
+        if self.include_name:
+            names.append("name")
+            arrays.append(pa.array([record.name for record in kept], type=pa.string()))
+
+        if self.output_format == "packed":
+            names.extend(["fp", "popcount"])
+            arrays.append(pa.array(encoded, type=pa.binary(packed_width(self.n_bits))))
+            arrays.append(pa.array(popcounts, type=pa.uint32()))
+        elif self.output_format == "bits":
+            width = len(encoded[0]) if encoded else self.n_bits
+            matrix = (
+                np.frombuffer("".join(encoded).encode("ascii"), dtype=np.uint8).reshape(-1, width)
+                - ord("0")
+            ) if encoded else np.zeros((0, width), dtype=np.uint8)
+            for i in range(width):
+                names.append(f"bit_{i}")
+                arrays.append(pa.array(matrix[:, i]))
+        else:
+            names.append("fingerprint")
+            arrays.append(pa.array(encoded, type=pa.string()))
+
+        return pa.RecordBatch.from_arrays(arrays, names=names)
+
     def get_column_names(self) -> list[str]:
         """Get output column names in order."""
         cols = []
@@ -293,7 +446,9 @@ class FingerprintCalculator:
         if self.include_name:
             cols.append("name")
 
-        if self.output_format == "bits":
+        if self.output_format == "packed":
+            cols.extend(["fp", "popcount"])
+        elif self.output_format == "bits":
             cols.extend([f"bit_{i}" for i in range(self.n_bits)])
         else:
             cols.append("fingerprint")
@@ -0,0 +1,429 @@
+"""
+Bounded similarity search over packed fingerprint arenas.
+
+An arena holds fingerprints as an (n, n_words) array of little-endian uint64
+words (the layout of a .fpdb store) together with their popcounts. Rows are
+visited in popcount order, block by block, and every query in a batch is
+scored against a block while it is in cache.
+
+Nearly all work is skipped with the Swamidass-Baldi bound: a metric that
+grows with the number of common bits c is at most f(a, b, min(a, b)) for
+popcounts a and b, so only targets whose popcount can still reach the
+threshold (or the current k-th best score) are intersected at all.
+"""
+
+from typing import Callable, Iterable, Optional
+
+import numpy as np
+
+from rdkit_cli.parallel.executor import ParallelExecutor
+
+# Rows scored per block; blocks are contiguous in popcount order
+_BLOCK_ROWS = 1 << 16
+
+# Popcount of every byte value, for NumPy versions without bitwise_count
+_BYTE_POPCOUNT = np.unpackbits(np.arange(256, dtype=np.uint8)[:, None], axis=1).sum(axis=1)
+
+
+def _tversky(a, b, c, n_bits, alpha, beta):
+    return c, alpha * (a - c) + beta * (b - c) + c
+
+
+# Similarity as (numerator, denominator) of popcounts a (query), b (target)
+# and c (common bits); every entry must be non-decreasing in c.
+# Matches the RDKit DataStructs definitions of the same names.
+_METRICS: dict[str, Callable] = {
+    "tanimoto": lambda a, b, c, n, al, be: (c, a + b - c),
+    "onbit": lambda a, b, c, n, al, be: (c, a + b - c),
+    "dice": lambda a, b, c, n, al, be: (2 * c, a + b),
+    "cosine": lambda a, b, c, n, al, be: (c, np.sqrt(a * b)),
+    "sokal": lambda a, b, c, n, al, be: (c, 2 * a + 2 * b - 3 * c),
+    "russel": lambda a, b, c, n, al, be: (c, n),
+    "braunblanquet": lambda a, b, c, n, al, be: (c, np.maximum(a, b)),
+    "asymmetric": lambda a, b, c, n, al, be: (c, np.minimum(a, b)),
+    "kulczynski": lambda a, b, c, n, al, be: (c * (a + b), 2 * a * b),
+    "tversky": _tversky,
+}
+
+ARENA_METRICS = sorted(_METRICS)
+
+
+def popcount_words(words: np.ndarray) -> np.ndarray:
+    """
+    Count on bits per row of packed words.
+
+    Args:
+        words: (..., n_words) uint64 array
+
+    Returns:
+        (...) uint32 array of popcounts
+    """
+    if hasattr(np, "bitwise_count"):
+        return np.bitwise_count(words).sum(axis=-1, dtype=np.uint32)
+    as_bytes = np.ascontiguousarray(words).view(np.uint8)
+    return _BYTE_POPCOUNT[as_bytes].sum(axis=-1, dtype=np.uint32)
+
+
+def pack_fingerprints(fps: Iterable, n_bits: int) -> np.ndarray:
+    """
+    Pack RDKit bit vectors into an (n, n_words) uint64 array.
+
+    Args:
+        fps: ExplicitBitVects of n_bits bits
+        n_bits: Fingerprint size in bits
+
+    Returns:
+        Packed words, same layout as a fingerprint store
+    """
+    from rdkit_cli.core.fingerprints import fingerprint_to_packed, packed_width
+
+    n_words = packed_width(n_bits) // 8
+    data = b"".join(fingerprint_to_packed(fp, n_bits) for fp in fps)
+    if not data:
+        return np.zeros((0, n_words), dtype="<u8")
+    return np.frombuffer(data, dtype="<u8").reshape(-1, n_words)
+
+
+def similarity_from_counts(
+    a: np.ndarray,
+    b: np.ndarray,
+    c: np.ndarray,
+    n_bits: int,
+    metric: str = "tanimoto",
+    tversky_alpha: float = 0.5,
+    tversky_beta: float = 0.5,
+) -> np.ndarray:
+    """
+    Evaluate a metric from popcounts and common-bit counts.
+
+    Args:
+        a: Query popcounts
+        b: Target popcounts
+        c: Common on bits (broadcast with a and b)
+        n_bits: Fingerprint size in bits
+        metric: One of ARENA_METRICS
+        tversky_alpha: Alpha parameter for Tversky index
+        tversky_beta: Beta parameter for Tversky index
+
+    Returns:
+        Similarities as float64; 0.0 where the metric is undefined
+    """
+    func = _METRICS.get(metric)
+    if func is None:
+        raise ValueError(f"Metric not supported by arena search: {metric}")
+
+    a = np.asarray(a, dtype=np.float64)
+    b = np.asarray(b, dtype=np.float64)
+    c = np.asarray(c, dtype=np.float64)
+    num, den = func(a, b, c, float(n_bits), tversky_alpha, tversky_beta)
+    num, den = np.broadcast_arrays(num, den)
+
+    out = np.zeros(num.shape, dtype=np.float64)
+    np.divide(num, den, out=out, where=den > 0)
+    return out
+
+
+class FingerprintArena:
+    """
+    Packed fingerprints arranged for bounded threshold and top-k searches.
+
+    Usage:
+        arena = FingerprintArena.from_store(store)
+        hits = arena.search(query_words, threshold=0.7)
+        for indices, scores in arena.search_many(queries, top_k=10):
+            ...
+    """
+
+    def __init__(
+        self,
+        segments: list[np.ndarray] | np.ndarray,
+        popcounts: Optional[np.ndarray] = None,
+        n_bits: Optional[int] = None,
+    ):
+        """
+        Initialize arena.
+
+        Args:
+            segments: (n, n_words) uint64 array, or a list of them holding
+                consecutive rows (e.g. the record batches of a store); not copied
+            popcounts: Popcount per row (computed if not given)
+            n_bits: Fingerprint size in bits (default: 64 * n_words)
+        """
+        if isinstance(segments, np.ndarray):
+            segments = [segments]
+        self._segments = [s for s in segments if len(s)]
+        if n_bits is None:
+            n_bits = segments[0].shape[1] * 64 if segments else 0
+        self.n_bits = n_bits
+        self.n_words = (n_bits + 63) // 64
+
+        lengths = [len(s) for s in self._segments]
+        self._starts = np.cumsum([0] + lengths[:-1]).astype(np.int64)
+        self.size = int(sum(lengths))
+
+        if popcounts is None:
+            popcounts = np.concatenate(
+                [popcount_words(s) for s in self._segments] or [np.zeros(0, dtype=np.uint32)]
+            )
+        popcounts = np.asarray(popcounts)
+
+        # 16-bit keys sort with a radix sort
+        key_dtype = np.uint16 if self.n_bits < (1 << 16) else np.uint32
+        keys = popcounts.astype(key_dtype)
+        self._order = np.argsort(keys, kind="stable")
+        self._sorted_popcounts = keys[self._order].astype(np.int64)
+
+    @classmethod
+    def from_store(cls, store) -> "FingerprintArena":
+        """Build an arena over an open FingerprintStore without copying its bits."""
+        return cls(
+            [words for _, words in store.iter_word_blocks()],
+            popcounts=store.popcounts(),
+            n_bits=store.params.n_bits,
+        )
+
+    @classmethod
+    def from_fingerprints(cls, fps: list, n_bits: int) -> "FingerprintArena":
+        """Build an arena from RDKit bit vectors."""
+        return cls(pack_fingerprints(fps, n_bits), n_bits=n_bits)
+
+    def __len__(self) -> int:
+        return self.size
+
+    def rows(self, start: int, stop: int) -> np.ndarray:
+        """Packed words of rows start..stop (original order)."""
+        return self.take(np.arange(start, stop))
+
+    def take(self, rows: np.ndarray) -> np.ndarray:
+        """Copy the words of the given rows (original order) into one array."""
+        if len(self._segments) == 1:
+            return self._segments[0][rows]
+
+        segment_ids = np.searchsorted(self._starts, rows, side="right") - 1
+        out = np.empty((len(rows), self.n_words), dtype=np.uint64)
+        for seg in np.unique(segment_ids):
+            mask = segment_ids == seg
+            out[mask] = self._segments[seg][rows[mask] - self._starts[seg]]
+        return out
+
+    def search(
+        self,
+        query: np.ndarray,
+        threshold: float = 0.0,
+        top_k: Optional[int] = None,
+        metric: str = "tanimoto",
+        tversky_alpha: float = 0.5,
+        tversky_beta: float = 0.5,
+    ) -> tuple[np.ndarray, np.ndarray]:
+        """
+        Search the arena with one packed query (n_words uint64).
+
+        See search_many() for arguments and results.
+        """
+        return self.search_many(
+            np.asarray(query).reshape(1, -1),
+            threshold=threshold,
+            top_k=top_k,
+            metric=metric,
+            tversky_alpha=tversky_alpha,
+            tversky_beta=tversky_beta,
+        )[0]
+
+    def search_many(
+        self,
+        queries: np.ndarray,
+        threshold: float = 0.0,
+        top_k: Optional[int] = None,
+        metric: str = "tanimoto",
+        tversky_alpha: float = 0.5,
+        tversky_beta: float = 0.5,
+    ) -> list[tuple[np.ndarray, np.ndarray]]:
+        """
+        Search the arena with a batch of queries in one pass.
+
+        Args:
+            queries: (m, n_words) uint64 packed query fingerprints
+            threshold: Minimum similarity (inclusive)
+            top_k: Keep only the k most similar targets per query
+            metric: One of ARENA_METRICS
+            tversky_alpha: Alpha parameter for Tversky index
+            tversky_beta: Beta parameter for Tversky index
+
+        Returns:
+            Per query, (row indices, similarities): ordered by similarity
+            (descending, ties by row) with top_k, by row otherwise
+        """
+        if metric not in _METRICS:
+            raise ValueError(f"Metric not supported by arena search: {metric}")
+
+        queries = np.ascontiguousarray(queries, dtype=np.uint64)
+        n_queries = len(queries)
+        if queries.ndim != 2 or (n_queries and queries.shape[1] != self.n_words):
+            raise ValueError(
+                f"Query fingerprints must have {self.n_words} words, got shape {queries.shape}"
+            )
+
+        query_popcounts = popcount_words(queries).astype(np.int64)
+        cutoffs = np.full(n_queries, threshold, dtype=np.float64)
+        hit_rows: list[list[np.ndarray]] = [[] for _ in range(n_queries)]
+        hit_scores: list[list[np.ndarray]] = [[] for _ in range(n_queries)]
+        best: list[tuple[np.ndarray, np.ndarray]] = [
+            (np.zeros(0, dtype=np.int64), np.zeros(0, dtype=np.float64))
+        ] * n_queries
+
+        def score(a, b, c):
+            return similarity_from_counts(
+                a, b, c, self.n_bits, metric, tversky_alpha, tversky_beta
+            )
+
+        for start in range(0, self.size, _BLOCK_ROWS):
+            stop = min(start + _BLOCK_ROWS, self.size)
+            block_popcounts = self._sorted_popcounts[start:stop]
+            low, high = int(block_popcounts[0]), int(block_popcounts[-1])
+
+            # Upper bound of every query against each popcount in the block
+            values = np.arange(low, high + 1)
+            a = query_popcounts[:, None]
+            bounds = score(a, values[None, :], np.minimum(a, values[None, :]))
+            reachable = bounds >= cutoffs[:, None]
+
+            active = np.flatnonzero(reachable.any(axis=1))
+            if len(active) == 0:
+                continue
+
+            # Window of popcounts each active query can still reach
+            first = reachable[active].argmax(axis=1)
+            last = len(values) - 1 - reachable[active, ::-1].argmax(axis=1)
+            row_lo = np.searchsorted(block_popcounts, values[first], side="left")
+            row_hi = np.searchsorted(block_popcounts, values[last], side="right")
+
+            # Gather only the rows some active query needs
+            span_lo, span_hi = int(row_lo.min()), int(row_hi.max())
+            rows = self._order[start + span_lo:start + span_hi]
+            words = self.take(rows)
+            popcounts = block_popcounts[span_lo:span_hi]
+
+            for q, lo, hi in zip(active, row_lo - span_lo, row_hi - span_lo):
+                common = popcount_words(words[lo:hi] & queries[q])
+                sims = score(query_popcounts[q], popcounts[lo:hi], common)
+                keep = sims >= cutoffs[q]
+                if not keep.any():
+                    continue
+
+                found_rows, found_scores = rows[lo:hi][keep], sims[keep]
+                if top_k is None:
+                    hit_rows[q].append(found_rows)
+                    hit_scores[q].append(found_scores)
+                    continue
+
+                merged_rows = np.concatenate([best[q][0], found_rows])
+                merged_scores = np.concatenate([best[q][1], found_scores])
+                ranked = np.lexsort((merged_rows, -merged_scores))[:top_k]
+                best[q] = (merged_rows[ranked], merged_scores[ranked])
+                if len(ranked) == top_k:
+                    # Nothing scoring below the current k-th best can enter
+                    cutoffs[q] = max(cutoffs[q], float(best[q][1][-1]))
+
+        if top_k is not None:
+            return [(r.astype(np.int64), s) for r, s in best]
+
+        results = []
+        for rows_list, scores_list in zip(hit_rows, hit_scores):
+            if not rows_list:
+                results.append((np.zeros(0, dtype=np.int64), np.zeros(0, dtype=np.float64)))
+                continue
+            found_rows = np.concatenate(rows_list).astype(np.int64)
+            found_scores = np.concatenate(scores_list)
+            by_row = np.argsort(found_rows, kind="stable")
+            results.append((found_rows[by_row], found_scores[by_row]))
+        return results
+
+
+class NeighborBlocks:
+    """
+    Sparse neighbor lists of arena rows within a distance cutoff, by row block.
+
+    Callable on (start, stop); returns (i, j) arrays of neighbor pairs with
+    start <= i < stop and j > i. Picklable, so blocks can run in worker
+    processes with the arena sent once per worker.
+    """
+
+    def __init__(
+        self,
+        arena: FingerprintArena,
+        cutoff: float,
+        metric: str = "tanimoto",
+    ):
+        """
+        Initialize block computer.
+
+        Args:
+            arena: Arena to compute neighbors in
+            cutoff: Maximum distance (1 - similarity) of neighbors
+            metric: Symmetric metric from ARENA_METRICS
+        """
+        self.arena = arena
+        self.cutoff = cutoff
+        self.metric = metric
+
+    def __call__(self, block: tuple[int, int]) -> tuple[np.ndarray, np.ndarray]:
+        start, stop = block
+        # Search slightly below the cut-off, then apply it on distances exactly
+        hits = self.arena.search_many(
+            self.arena.rows(start, stop),
+            threshold=1.0 - self.cutoff - 1e-9,
+            metric=self.metric,
+        )
+
+        pairs_i, pairs_j = [], []
+        for i, (rows, sims) in enumerate(hits, start):
+            keep = (rows > i) & (1.0 - sims <= self.cutoff)
+            pairs_i.append(np.full(int(keep.sum()), i, dtype=np.int64))
+            pairs_j.append(rows[keep])
+
+        if not pairs_i:
+            return np.zeros(0, dtype=np.int64), np.zeros(0, dtype=np.int64)
+        return np.concatenate(pairs_i), np.concatenate(pairs_j)
+
+
+def neighbor_graph(
+    arena: FingerprintArena,
+    cutoff: float,
+    metric: str = "tanimoto",
+    n_workers: int = 1,
+    block_rows: int = 1024,
+) -> tuple[np.ndarray, np.ndarray]:
+    """
+    Build the symmetric neighbor graph of an arena in CSR form.
+
+    Only pairs within the cut-off are kept, so memory grows with the number
+    of neighbors instead of n^2.
+
+    Args:
+        arena: Arena to compute neighbors in
+        cutoff: Maximum distance (1 - similarity) of neighbors
+        metric: Symmetric metric from ARENA_METRICS
+        n_workers: Worker processes computing row blocks
+        block_rows: Query rows per block
+
+    Returns:
+        (indptr, indices): neighbors of row i are indices[indptr[i]:indptr[i + 1]],
+        in ascending order and excluding i itself
+    """
+    n = len(arena)
+    ranges = [(start, min(start + block_rows, n)) for start in range(0, n, block_rows)]
+
+    pairs_i, pairs_j = [np.zeros(0, dtype=np.int64)], [np.zeros(0, dtype=np.int64)]
+    with ParallelExecutor(NeighborBlocks(arena, cutoff, metric), n_workers=n_workers) as executor:
+        for i, j in executor.imap(ranges):
+            pairs_i.append(i)
+            pairs_j.append(j)
+
+    upper_i, upper_j = np.concatenate(pairs_i), np.concatenate(pairs_j)
+    src = np.concatenate([upper_i, upper_j])
+    dst = np.concatenate([upper_j, upper_i])
+
+    order = np.lexsort((dst, src))
+    indptr = np.zeros(n + 1, dtype=np.int64)
+    np.cumsum(np.bincount(src, minlength=n), out=indptr[1:])
+    return indptr, dst[order]
@@ -0,0 +1,299 @@
+"""
+Persistent fingerprint store (.fpdb files).
+
+A store is an Arrow IPC file with one row per molecule:
+
+    smiles    string
+    name      string
+    fp        fixed_size_binary  packed bits as little-endian uint64 words
+    popcount  uint32             number of on bits
+
+The fingerprint parameters are recorded in the schema metadata. Stores are
+opened memory-mapped, so the packed bits can be used directly as an
+(n, n_words) uint64 array instead of re-fingerprinting the library.
+"""
+
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Any, Iterator, Optional
+
+from rdkit import Chem
+
+from rdkit_cli.core.fingerprints import (
+    FingerprintType,
+    compute_fingerprint,
+    fingerprint_to_packed,
+    packed_to_fingerprint,
+    packed_width,
+)
+from rdkit_cli.io.writers import MoleculeWriter
+
+FPDB_SUFFIX = ".fpdb"
+FPDB_VERSION = 1
+
+# Schema metadata keys
+_METADATA_PREFIX = "rdkit_cli.fpdb."
+
+# Rows unpacked at a time when building RDKit bit vectors
+_UNPACK_BLOCK_ROWS = 10000
+
+# Minimum rows per stored record batch, so readers see few large chunks
+_WRITE_BATCH_ROWS = 1 << 16
+
+
+def is_fpdb_path(path: Path | str) -> bool:
+    """Check whether a path names a fingerprint store."""
+    return Path(path).suffix.lower() == FPDB_SUFFIX
+
+
+@dataclass(frozen=True)
+class StoreParams:
+    """Fingerprint parameters recorded in a store header."""
+
+    fp_type: str
+    n_bits: int
+    radius: int = 2
+
+    @property
+    def n_words(self) -> int:
+        """Number of uint64 words per fingerprint."""
+        return packed_width(self.n_bits) // 8
+
+    def to_metadata(self) -> dict[str, str]:
+        """Encode as Arrow schema metadata."""
+        return {
+            f"{_METADATA_PREFIX}version": str(FPDB_VERSION),
+            f"{_METADATA_PREFIX}fp_type": self.fp_type,
+            f"{_METADATA_PREFIX}n_bits": str(self.n_bits),
+            f"{_METADATA_PREFIX}radius": str(self.radius),
+        }
+
+    @classmethod
+    def from_metadata(cls, metadata: Optional[dict[bytes, bytes]]) -> "StoreParams":
+        """Decode from Arrow schema metadata."""
+        values = {
+            k.decode()[len(_METADATA_PREFIX):]: v.decode()
+            for k, v in (metadata or {}).items()
+            if k.decode().startswith(_METADATA_PREFIX)
+        }
+
+        if "version" not in values:
+            raise ValueError("Not a fingerprint store (missing header)")
+        if int(values["version"]) > FPDB_VERSION:
+            raise ValueError(f"Unsupported fingerprint store version: {values['version']}")
+
+        return cls(
+            fp_type=values["fp_type"],
+            n_bits=int(values["n_bits"]),
+            radius=int(values["radius"]),
+        )
+
+    def fingerprint(self, mol: Chem.Mol):
+        """Compute a fingerprint of a molecule with these parameters, as stored."""
+        fp = compute_fingerprint(mol, FingerprintType(self.fp_type), n_bits=self.n_bits, radius=self.radius)
+        if fp is None:
+            return None
+        # Round-trip through the packed form so it matches stored vectors
+        return packed_to_fingerprint(fingerprint_to_packed(fp, self.n_bits), self.n_bits)
+
+
+def store_schema(params: StoreParams):
+    """Arrow schema of a store with the given parameters."""
+    import pyarrow as pa
+
+    return pa.schema(
+        [
+            ("smiles", pa.string()),
+            ("name", pa.string()),
+            ("fp", pa.binary(packed_width(params.n_bits))),
+            ("popcount", pa.uint32()),
+        ],
+        metadata=params.to_metadata(),
+    )
+
+
+class FingerprintStoreWriter(MoleculeWriter):
+    """Write packed fingerprints (FingerprintCalculator "packed" format) to a store."""
+
+    supports_arrow = True
+
+    def __init__(self, path: Path | str, params: StoreParams):
+        """
+        Initialize store writer.
+
+        Args:
+            path: Output .fpdb path (overwritten)
+            params: Fingerprint parameters for the header
+        """
+        import pyarrow as pa
+
+        self.path = Path(path)
+        self.params = params
+        self.schema = store_schema(params)
+        self._writer = pa.ipc.new_file(str(self.path), self.schema)
+        self._pending: list = []
+        self._pending_rows = 0
+
+    def _append(self, batch):
+        """Buffer a batch, writing once enough rows are pending."""
+        self._pending.append(batch)
+        self._pending_rows += batch.num_rows
+        if self._pending_rows >= _WRITE_BATCH_ROWS:
+            self._flush()
+
+    def _flush(self):
+        """Write pending batches as one record batch."""
+        import pyarrow as pa
+
+        if not self._pending:
+            return
+        table = pa.Table.from_batches(self._pending, schema=self.schema).combine_chunks()
+        for batch in table.to_batches():
+            self._writer.write_batch(batch)
+        self._pending = []
+        self._pending_rows = 0
+
+    def write_row(self, data: dict[str, Any]):
+        self.write_batch([data])
+
+    def write_batch(self, data: list[dict[str, Any]]):
+        import pyarrow as pa
+
+        if data:
+            rows = [{"name": "", **row} for row in data]
+            self._append(pa.RecordBatch.from_pylist(rows, schema=self.schema))
+
+    def write_arrow(self, batch):
+        import pyarrow as pa
+
+        if batch.num_rows == 0:
+            return
+
+        names = batch.schema.names
+        arrays = []
+        for field in self.schema:
+            if field.name in names:
+                arrays.append(batch.column(names.index(field.name)).cast(field.type))
+            else:
+                arrays.append(pa.array([""] * batch.num_rows, type=field.type))
+        self._append(pa.RecordBatch.from_arrays(arrays, schema=self.schema))
+
+    def close(self):
+        if self._writer is not None:
+            self._flush()
+            self._writer.close()
+            self._writer = None
+
+
+class FingerprintStore:
+    """
+    Read-only, memory-mapped fingerprint store.
+
+    Usage:
+        with FingerprintStore("library.fpdb") as store:
+            words = store.words()       # (n, n_words) uint64
+            fps = store.bit_vectors()   # RDKit ExplicitBitVects
+    """
+
+    def __init__(self, path: Path | str):
+        """
+        Open a store.
+
+        Args:
+            path: Path to .fpdb file
+
+        Raises:
+            ValueError: If the file is not a fingerprint store
+        """
+        import pyarrow as pa
+
+        self.path = Path(path)
+        self._source = pa.memory_map(str(self.path), "r")
+        try:
+            reader = pa.ipc.open_file(self._source)
+        except pa.ArrowInvalid as e:
+            self._source.close()
+            raise ValueError(f"Not a fingerprint store: {self.path}") from e
+
+        self.params = StoreParams.from_metadata(reader.schema.metadata)
+        # Zero-copy: buffers point into the memory map
+        self.table = reader.read_all()
+
+    def __len__(self) -> int:
+        return self.table.num_rows
+
+    @property
+    def smiles(self) -> list[str]:
+        """SMILES of all stored molecules."""
+        return self.table.column("smiles").to_pylist()
+
+    @property
+    def names(self) -> list[str]:
+        """Names of all stored molecules."""
+        return self.table.column("name").to_pylist()
+
+    def iter_word_blocks(self) -> Iterator[tuple[int, Any]]:
+        """
+        Yield (first_row, words) per stored record batch without copying.
+
+        Yields:
+            Row offset and (rows, n_words) uint64 array view of the packed bits
+        """
+        import numpy as np
+
+        n_words = self.params.n_words
+        width = n_words * 8
+        start = 0
+
+        for chunk in self.table.column("fp").chunks:
+            data = chunk.buffers()[1]
+            words = np.frombuffer(
+                data, dtype="<u8", count=len(chunk) * n_words, offset=chunk.offset * width
+            ).reshape(len(chunk), n_words)
+            yield start, words
+            start += len(chunk)
+
+    def words(self):
+        """All packed fingerprints as one (n, n_words) uint64 array."""
+        import numpy as np
+
+        blocks = [words for _, words in self.iter_word_blocks()]
+        if not blocks:
+            return np.zeros((0, self.params.n_words), dtype="<u8")
+        if len(blocks) == 1:
+            return blocks[0]
+        return np.concatenate(blocks)
+
+    def popcounts(self):
+        """Number of on bits per fingerprint as a uint32 array."""
+        return self.table.column("popcount").to_numpy()
+
+    def bit_vectors(self) -> list:
+        """Unpack all fingerprints into RDKit ExplicitBitVects."""
+        import numpy as np
+        from rdkit import DataStructs
+
+        n_bits = self.params.n_bits
+        fps = []
+
+        for _, words in self.iter_word_blocks():
+            for start in range(0, len(words), _UNPACK_BLOCK_ROWS):
+                block = words[start:start + _UNPACK_BLOCK_ROWS]
+                bits = np.unpackbits(block.view(np.uint8), axis=1, bitorder="little")[:, :n_bits]
+                for row in bits:
+                    fp = DataStructs.ExplicitBitVect(n_bits)
+                    fp.SetBitsFromList(np.flatnonzero(row).tolist())
+                    fps.append(fp)
+
+        return fps
+
+    def close(self):
+        """Release the memory map."""
+        self.table = None
+        self._source.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
@@ -1,9 +1,96 @@
-"""Merge multiple molecule files."""
-
+"""
+Merge multiple molecule files.
+
+Input files are the unit of parallelism: each worker reads, parses and
+hashes the deduplication keys of one file at a time, spooling its output
+rows to a temporary file. The parent replays the spools in input order and
+deduplicates through Deduplicator.deduplicate_rows(), so the output order is
+(file, row) whatever the number of workers, and the first occurrence of a
+molecule across all files is kept.
+"""
+
+import tempfile
 from pathlib import Path
-from typing import Iterator, Optional
+from typing import Any, Iterator, Optional
 
+from rdkit_cli.core.deduplicate import (
+    DEFAULT_PARTITIONS,
+    Deduplicator,
+    KeyHasher,
+)
 from rdkit_cli.io.readers import MoleculeRecord
+from rdkit_cli.io.spool import read_spool, write_spool
+from rdkit_cli.parallel.executor import ParallelExecutor
+
+MERGE_KEYS = ["smiles", "inchi", "inchikey"]
+
+
+class _MergeFileTask:
+    """Worker task: read one input file and spool its (digest, row) pairs."""
+
+    def __init__(
+        self,
+        dedupe_key: Optional[str],
+        add_source: bool,
+        smiles_column: str,
+        name_column: Optional[str],
+        has_header: bool,
+    ):
+        self.hasher = KeyHasher(dedupe_key) if dedupe_key is not None else None
+        self.add_source = add_source
+        self.smiles_column = smiles_column
+        self.name_column = name_column
+        self.has_header = has_header
+
+    def _excluded(self, key: str) -> bool:
+        """Check whether a metadata column is the SMILES or name column."""
+        lower = key.lower()
+        if lower in ("smiles", "name", self.smiles_column.lower()):
+            return True
+        return self.name_column is not None and lower == self.name_column.lower()
+
+    def _row(self, record: MoleculeRecord, source_name: str) -> dict[str, Any]:
+        result: dict[str, Any] = {"smiles": record.smiles}
+
+        if record.name:
+            result["name"] = record.name
+
+        if self.add_source:
+            result["source_file"] = source_name
+
+        # Copy metadata (excluding smiles and name)
+        for key, value in record.metadata.items():
+            if not self._excluded(key):
+                result[key] = value
+
+        return result
+
+    def _rows(self, input_path: Path) -> Iterator[tuple[Optional[bytes], dict[str, Any]]]:
+        from rdkit_cli.io import create_reader
+
+        reader = create_reader(
+            input_path,
+            smiles_column=self.smiles_column,
+            name_column=self.name_column,
+            has_header=self.has_header,
+        )
+
+        with reader:
+            for record in reader:
+                if record.mol is None:
+                    continue
+
+                digest = None
+                if self.hasher is not None:
+                    digest = self.hasher.digest(record.mol)
+                    if digest is None:
+                        continue
+
+                yield digest, self._row(record, input_path.name)
+
+    def __call__(self, task: tuple[Path, Path]) -> tuple[Path, int]:
+        input_path, spool_path = task
+        return spool_path, write_spool(spool_path, self._rows(input_path))
 
 
 class MoleculeMerger:
@@ -14,6 +101,9 @@ class MoleculeMerger:
         deduplicate: bool = False,
         dedupe_key: str = "smiles",
         add_source: bool = False,
+        n_workers: int = 1,
+        spill_dir: Optional[str | Path] = None,
+        n_partitions: int = DEFAULT_PARTITIONS,
     ):
         """
         Initialize merger.
@@ -22,34 +112,22 @@ class MoleculeMerger:
             deduplicate: Whether to remove duplicates
             dedupe_key: Key to use for deduplication (smiles, inchi, inchikey)
             add_source: Whether to add source file column
+            n_workers: Number of files read concurrently (-1 for all CPUs)
+            spill_dir: Directory for row spools and hash-partitioned key runs
+                (default: system temporary directory, keys kept in memory)
+            n_partitions: Number of hash partitions with spill_dir
         """
+        if dedupe_key not in MERGE_KEYS:
+            raise ValueError(f"Unknown dedupe_key: {dedupe_key}. Available: {MERGE_KEYS}")
+
         self.deduplicate = deduplicate
         self.dedupe_key = dedupe_key
         self.add_source = add_source
-        self._seen: set[str] = set()
-
-    def _get_dedupe_key(self, record: MoleculeRecord) -> Optional[str]:
-        """Get deduplication key for a record."""
-        if record.mol is None:
-            return None
-
-        if self.dedupe_key == "smiles":
-            from rdkit import Chem
-            return Chem.MolToSmiles(record.mol, canonical=True)
-        elif self.dedupe_key == "inchi":
-            from rdkit.Chem import inchi
-            try:
-                return inchi.MolToInchi(record.mol)
-            except Exception:
-                return None
-        elif self.dedupe_key == "inchikey":
-            from rdkit.Chem import inchi
-            try:
-                return inchi.MolToInchiKey(record.mol)
-            except Exception:
-                return None
-        else:
-            return record.smiles
+        self.n_workers = n_workers
+        self.spill_dir = Path(spill_dir) if spill_dir is not None else None
+        self.n_partitions = n_partitions
+        self._n_read = 0
+        self._n_unique = 0
 
     def merge_files(
         self,
@@ -68,52 +146,56 @@ class MoleculeMerger:
             has_header: Whether files have headers
 
         Yields:
-            Merged molecule records as dicts
+            Merged molecule records as dicts, in (file, row) order
         """
-        from rdkit_cli.io import create_reader
-
-        for input_path in input_paths:
-            reader = create_reader(
-                input_path,
-                smiles_column=smiles_column,
-                name_column=name_column,
-                has_header=has_header,
-            )
-
-            source_name = input_path.name
-
-            with reader:
-                for record in reader:
-                    if record.mol is None:
-                        continue
-
-                    # Check for duplicates
-                    if self.deduplicate:
-                        key = self._get_dedupe_key(record)
-                        if key is None or key in self._seen:
-                            continue
-                        self._seen.add(key)
-
-                    result = {
-                        "smiles": record.smiles,
-                    }
-
-                    if record.name:
-                        result["name"] = record.name
-
-                    if self.add_source:
-                        result["source_file"] = source_name
-
-                    # Copy metadata (excluding smiles and name)
-                    for key, value in record.metadata.items():
-                        if key.lower() not in ("smiles", "name", smiles_column.lower()):
-                            if name_column is None or key.lower() != name_column.lower():
-                                result[key] = value
-
-                    yield result
+        self._n_read = 0
+        self._n_unique = 0
+
+        task = _MergeFileTask(
+            self.dedupe_key if self.deduplicate else None,
+            self.add_source,
+            smiles_column,
+            name_column,
+            has_header,
+        )
+
+        if self.spill_dir is not None:
+            self.spill_dir.mkdir(parents=True, exist_ok=True)
+
+        with tempfile.TemporaryDirectory(prefix="rdkit-cli-merge-", dir=self.spill_dir) as tmp:
+            tmp_dir = Path(tmp)
+            files = [
+                (Path(path), tmp_dir / f"file-{i:05d}.spool")
+                for i, path in enumerate(input_paths)
+            ]
+
+            with ParallelExecutor(task, n_workers=self.n_workers) as executor:
+                rows = self._replay(executor.imap(files))
+
+                if not self.deduplicate:
+                    for _, row in rows:
+                        yield row
+                    return
+
+                deduplicator = Deduplicator(
+                    keep="first",
+                    spill_dir=self.spill_dir,
+                    n_partitions=self.n_partitions,
+                )
+                for row in deduplicator.deduplicate_rows(rows):
+                    self._n_unique += 1
+                    yield row
+
+    def _replay(self, spools: Iterator[tuple[Path, int]]) -> Iterator[tuple[Optional[bytes], dict]]:
+        """Yield (digest, row) pairs from finished file spools in order, deleting each."""
+        for spool_path, n_rows in spools:
+            self._n_read += n_rows
+            yield from read_spool(spool_path)
+            spool_path.unlink()
 
     def get_stats(self) -> dict:
         """Get merge statistics."""
         return {
-            "unique_molecules": len(self._seen) if self.deduplicate else 0,
+            "valid_molecules": self._n_read,
+            "unique_molecules": self._n_unique if self.deduplicate else 0,
         }
@@ -1,7 +1,19 @@
 """Matched Molecular Pairs (MMP) module."""
 
-from typing import Optional, Iterator
-from collections import defaultdict
+import tempfile
+import zlib
+from collections import Counter
+from itertools import groupby
+from pathlib import Path
+from typing import Callable, Iterable, Optional, Iterator
+
+from rdkit_cli.io.spool import append_chunk, open_spool, read_spool
+
+# Default number of core index partitions
+DEFAULT_INDEX_PARTITIONS = 64
+
+# Fragment rows per pickled index chunk
+_INDEX_CHUNK = 1000
 
 
 def fragment_molecule(mol, max_cuts: int = 1) -> list[tuple[str, str]]:
@@ -40,63 +52,349 @@ def fragment_molecule(mol, max_cuts: int = 1) -> list[tuple[str, str]]:
         return []
 
 
+def core_heavy_atoms(core: str) -> int:
+    """
+    Count heavy atoms of a fragment core, excluding attachment points.
+
+    Parses the core without sanitization instead of substituting hydrogens
+    for the [*:n] labels and re-parsing it.
+    """
+    from rdkit import Chem
+
+    mol = Chem.MolFromSmiles(core, sanitize=False)
+    if mol is None:
+        return 0
+    return sum(1 for atom in mol.GetAtoms() if atom.GetAtomicNum() > 1)
+
+
+class FragmentTask:
+    """
+    Worker task fragmenting a chunk of molecules.
+
+    Takes (row_idx, text, name) rows, parses them with the reader's raw
+    parser and returns (smiles, name, [(core, rgroup), ...]) per row, keeping
+    only cores with at least min_core_size heavy atoms. Unparsable rows get
+    smiles None.
+    """
+
+    def __init__(
+        self,
+        max_cuts: int = 1,
+        min_core_size: int = 3,
+        parse: Optional[Callable] = None,
+    ):
+        from rdkit_cli.io.readers import parse_record
+
+        self.max_cuts = max_cuts
+        self.min_core_size = min_core_size
+        self.parse = parse or parse_record
+
+    def __call__(self, items: list[tuple[int, str, str]]) -> list[tuple]:
+        results = []
+        for row_idx, text, name in items:
+            record = self.parse(row_idx, text, name)
+            if record.mol is None:
+                results.append((None, name, []))
+                continue
+
+            fragments = [
+                (core, rgroup)
+                for core, rgroup in fragment_molecule(record.mol, max_cuts=self.max_cuts)
+                if core_heavy_atoms(core) >= self.min_core_size
+            ]
+            results.append((record.smiles, record.name, fragments))
+        return results
+
+
+class CoreIndex:
+    """
+    On-disk core -> member index.
+
+    Fragment rows (core, member, smiles, name, rgroup) are hash-partitioned
+    by core into spool files; groups() loads one partition at a time, sorts
+    it by (core, member) and yields each core's members. Memory is bounded by
+    the largest partition rather than the whole fragment set.
+    """
+
+    def __init__(self, directory: Path, n_partitions: int = DEFAULT_INDEX_PARTITIONS):
+        """
+        Initialize index.
+
+        Args:
+            directory: Existing directory for the partition files
+            n_partitions: Number of hash partitions
+        """
+        self.directory = Path(directory)
+        self.n_partitions = n_partitions
+        self._paths = [self.directory / f"cores-{i:04d}.spool" for i in range(n_partitions)]
+        self._files = [open_spool(path) for path in self._paths]
+        self._buffers: list[list[tuple]] = [[] for _ in range(n_partitions)]
+        self.n_fragments = 0
+
+    def _partition(self, core: str) -> int:
+        # Stable across processes and runs, unlike hash()
+        return zlib.crc32(core.encode()) % self.n_partitions
+
+    def add(self, core: str, member: int, smiles: str, name: str, rgroup: str):
+        """Add one fragment row."""
+        part = self._partition(core)
+        buffer = self._buffers[part]
+        buffer.append((core, member, smiles, name, rgroup))
+        self.n_fragments += 1
+        if len(buffer) >= _INDEX_CHUNK:
+            self._flush(part)
+
+    def _flush(self, part: int):
+        append_chunk(self._files[part], self._buffers[part])
+        self._buffers[part] = []
+
+    def close(self):
+        """Flush and close the partition files (groups() can then be read)."""
+        for part, f in enumerate(self._files):
+            if not f.closed:
+                self._flush(part)
+                f.close()
+
+    def groups(self) -> Iterator[tuple[str, list[tuple[int, str, str, str]]]]:
+        """
+        Yield (core, members) per core, members as (member, smiles, name, rgroup).
+
+        Cores come out partition by partition, sorted within each partition;
+        members are in input order.
+        """
+        self.close()
+        for path in self._paths:
+            rows = sorted(read_spool(path), key=lambda row: (row[0], row[1]))
+            for core, group in groupby(rows, key=lambda row: row[0]):
+                yield core, [row[1:] for row in group]
+
+
+def build_core_index(
+    items: Iterable[tuple[int, str, str]],
+    directory: Path,
+    max_cuts: int = 1,
+    min_core_size: int = 3,
+    parse: Optional[Callable] = None,
+    n_workers: int = 1,
+    n_partitions: int = DEFAULT_INDEX_PARTITIONS,
+    chunk_size: int = 100,
+) -> tuple[CoreIndex, int]:
+    """
+    Fragment molecules on the worker pool into a CoreIndex.
+
+    Args:
+        items: (row_idx, text, name) rows (see MoleculeReader.iter_raw)
+        directory: Directory for the index partitions
+        max_cuts: Maximum number of cuts
+        min_core_size: Minimum core size in heavy atoms
+        parse: Raw row parser (default: SMILES)
+        n_workers: Number of worker processes (-1 for all)
+        n_partitions: Number of index partitions
+        chunk_size: Molecules per worker task
+
+    Returns:
+        Tuple of (closed index, number of valid molecules)
+    """
+    from rdkit_cli.parallel.executor import ParallelExecutor
+
+    task = FragmentTask(max_cuts=max_cuts, min_core_size=min_core_size, parse=parse)
+    index = CoreIndex(directory, n_partitions=n_partitions)
+    n_molecules = 0
+
+    def chunks() -> Iterator[list]:
+        chunk: list = []
+        for item in items:
+            chunk.append(item)
+            if len(chunk) >= chunk_size:
+                yield chunk
+                chunk = []
+        if chunk:
+            yield chunk
+
+    try:
+        with ParallelExecutor(task, n_workers=n_workers) as executor:
+            for results in executor.imap(chunks()):
+                for smiles, name, fragments in results:
+                    if smiles is None:
+                        continue
+                    member = n_molecules
+                    n_molecules += 1
+                    for core, rgroup in fragments:
+                        index.add(core, member, smiles, name, rgroup)
+    finally:
+        index.close()
+
+    return index, n_molecules
+
+
+def iter_group_pairs(core: str, members: list[tuple[int, str, str, str]]) -> Iterator[dict]:
+    """Yield all pairs within one core group, in member order."""
+    for i, (_, smiles_1, name_1, rgroup_1) in enumerate(members):
+        for _, smiles_2, name_2, rgroup_2 in members[i + 1:]:
+            yield {
+                "core": core,
+                "smiles_1": smiles_1,
+                "smiles_2": smiles_2,
+                "name_1": name_1,
+                "name_2": name_2,
+                "rgroup_1": rgroup_1,
+                "rgroup_2": rgroup_2,
+                "transformation": f"{rgroup_1}>>{rgroup_2}",
+            }
+
+
+def count_group_transformations(members: list[tuple[int, str, str, str]], counter: Counter):
+    """
+    Add the transformations of all pairs in a core group to counter.
+
+    Counts R-group multiplicities as it goes, so a group with few distinct
+    R-groups costs O(members * distinct) instead of O(members^2) and no pair
+    is built.
+    """
+    seen: Counter = Counter()
+    for _, _, _, rgroup in members:
+        for previous, n in seen.items():
+            counter[f"{previous}>>{rgroup}"] += n
+        seen[rgroup] += 1
+
+
+class MatchedPairFinder:
+    """
+    Find matched molecular pairs through an on-disk core index.
+
+    Molecules are fragmented in parallel into a CoreIndex; pairs are then
+    generated one core group at a time, so only the current group is held
+    in memory. Groups larger than max_group_size are skipped, bounding the
+    O(k^2) pairs emitted per core.
+    """
+
+    def __init__(
+        self,
+        max_cuts: int = 1,
+        min_core_size: int = 3,
+        max_group_size: Optional[int] = None,
+        n_workers: int = 1,
+        spill_dir: Optional[str | Path] = None,
+        n_partitions: int = DEFAULT_INDEX_PARTITIONS,
+    ):
+        """
+        Initialize finder.
+
+        Args:
+            max_cuts: Maximum number of cuts
+            min_core_size: Minimum core size in heavy atoms
+            max_group_size: Skip cores shared by more molecules (default: no limit)
+            n_workers: Number of worker processes for fragmentation
+            spill_dir: Directory for the core index (default: system temporary directory)
+            n_partitions: Number of core index partitions
+        """
+        self.max_cuts = max_cuts
+        self.min_core_size = min_core_size
+        self.max_group_size = max_group_size
+        self.n_workers = n_workers
+        self.spill_dir = Path(spill_dir) if spill_dir is not None else None
+        self.n_partitions = n_partitions
+
+        self.n_molecules = 0
+        self.n_groups = 0
+        self.n_skipped_groups = 0
+
+    def _groups(self, items, parse) -> Iterator[tuple[str, list]]:
+        """Build the index in a temporary directory and yield pairable groups."""
+        self.n_molecules = 0
+        self.n_groups = 0
+        self.n_skipped_groups = 0
+
+        if self.spill_dir is not None:
+            self.spill_dir.mkdir(parents=True, exist_ok=True)
+
+        with tempfile.TemporaryDirectory(prefix="rdkit-cli-mmp-", dir=self.spill_dir) as tmp:
+            index, self.n_molecules = build_core_index(
+                items,
+                Path(tmp),
+                max_cuts=self.max_cuts,
+                min_core_size=self.min_core_size,
+                parse=parse,
+                n_workers=self.n_workers,
+                n_partitions=self.n_partitions,
+            )
+
+            for core, members in index.groups():
+                if len(members) < 2:
+                    continue
+                if self.max_group_size is not None and len(members) > self.max_group_size:
+                    self.n_skipped_groups += 1
+                    continue
+                self.n_groups += 1
+                yield core, members
+
+    def pairs(
+        self,
+        items: Iterable[tuple[int, str, str]],
+        parse: Optional[Callable] = None,
+    ) -> Iterator[dict]:
+        """
+        Yield matched pairs, streamed per core group.
+
+        Args:
+            items: (row_idx, text, name) rows
+            parse: Raw row parser (default: SMILES)
+        """
+        for core, members in self._groups(items, parse):
+            yield from iter_group_pairs(core, members)
+
+    def transformation_counts(
+        self,
+        items: Iterable[tuple[int, str, str]],
+        parse: Optional[Callable] = None,
+    ) -> Counter:
+        """
+        Count pair transformations without materializing the pairs.
+
+        Args:
+            items: (row_idx, text, name) rows
+            parse: Raw row parser (default: SMILES)
+
+        Returns:
+            Counter of "rgroup_1>>rgroup_2" transformations
+        """
+        counter: Counter = Counter()
+        for _, members in self._groups(items, parse):
+            count_group_transformations(members, counter)
+        return counter
+
+
 def find_matched_pairs(
-    molecules: list[tuple],
+    molecules: Iterable[tuple],
     max_cuts: int = 1,
     min_core_size: int = 3,
+    max_group_size: Optional[int] = None,
+    n_workers: int = 1,
+    spill_dir: Optional[str | Path] = None,
 ) -> Iterator[dict]:
     """
     Find matched molecular pairs in a dataset.
 
     Args:
-        molecules: List of (smiles, name, properties) tuples
+        molecules: Iterable of (smiles, name, properties) tuples
         max_cuts: Maximum number of cuts
         min_core_size: Minimum core size in heavy atoms
+        max_group_size: Skip cores shared by more molecules (default: no limit)
+        n_workers: Number of worker processes for fragmentation
+        spill_dir: Directory for the core index
 
     Yields:
         Dictionaries with pair information
     """
-    from rdkit import Chem
-
-    # Fragment all molecules and group by core
-    core_groups = defaultdict(list)
-
-    for smiles, name, props in molecules:
-        mol = Chem.MolFromSmiles(smiles)
-        if mol is None:
-            continue
-
-        fragments = fragment_molecule(mol, max_cuts=max_cuts)
-
-        for core, rgroup in fragments:
-            # Check core size
-            core_mol = Chem.MolFromSmiles(core.replace("[*:1]", "[H]").replace("[*:2]", "[H]"))
-            if core_mol and core_mol.GetNumHeavyAtoms() >= min_core_size:
-                core_groups[core].append({
-                    "smiles": smiles,
-                    "name": name,
-                    "rgroup": rgroup,
-                    "properties": props,
-                })
-
-    # Generate pairs from each core group
-    for core, members in core_groups.items():
-        if len(members) < 2:
-            continue
-
-        # Generate all pairs within the group
-        for i, mol1 in enumerate(members):
-            for mol2 in members[i + 1:]:
-                yield {
-                    "core": core,
-                    "smiles_1": mol1["smiles"],
-                    "smiles_2": mol2["smiles"],
-                    "name_1": mol1["name"],
-                    "name_2": mol2["name"],
-                    "rgroup_1": mol1["rgroup"],
-                    "rgroup_2": mol2["rgroup"],
-                    "transformation": f"{mol1['rgroup']}>>{mol2['rgroup']}",
-                }
+    finder = MatchedPairFinder(
+        max_cuts=max_cuts,
+        min_core_size=min_core_size,
+        max_group_size=max_group_size,
+        n_workers=n_workers,
+        spill_dir=spill_dir,
+    )
+    items = ((i, smiles, name) for i, (smiles, name, _) in enumerate(molecules))
+    yield from finder.pairs(items)
 
 
 class MMPFragmenter:
@@ -203,22 +501,18 @@ class MMPTransformer:
             return []
 
 
-def analyze_transformations(pairs: list[dict], top_n: int = 20) -> list[tuple]:
+def summarize_transformations(counter: Counter, top_n: Optional[int] = 20) -> list[tuple]:
     """
-    Analyze frequency of transformations.
+    Rank transformation counts.
 
     Args:
-        pairs: List of pair dictionaries with 'transformation' key
-        top_n: Number of top transformations to return
+        counter: Transformation counts
+        top_n: Number of top transformations to return (None for all)
 
     Returns:
         List of (transformation, count, percentage) tuples
     """
-    from collections import Counter
-
-    transformations = [p.get("transformation", "") for p in pairs if p.get("transformation")]
-    counter = Counter(transformations)
-    total = len(transformations)
+    total = sum(counter.values())
 
     results = []
     for trans, count in counter.most_common(top_n):
@@ -226,3 +520,18 @@ def analyze_transformations(pairs: list[dict], top_n: int = 20) -> list[tuple]:
         results.append((trans, count, pct))
 
     return results
+
+
+def analyze_transformations(pairs: Iterable[dict], top_n: int = 20) -> list[tuple]:
+    """
+    Analyze frequency of transformations.
+
+    Args:
+        pairs: Pair dictionaries with 'transformation' key (consumed as a stream)
+        top_n: Number of top transformations to return
+
+    Returns:
+        List of (transformation, count, percentage) tuples
+    """
+    counter = Counter(p.get("transformation", "") for p in pairs if p.get("transformation"))
+    return summarize_transformations(counter, top_n)
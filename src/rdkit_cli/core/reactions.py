@@ -1,12 +1,135 @@
 """Reaction transformation engine."""
 
-from typing import Optional, Any
+import math
+import random
+from pathlib import Path
+from typing import Iterable, Iterator, Optional, Any
 
 from rdkit import Chem
 from rdkit.Chem import AllChem, rdChemReactions
 
 from rdkit_cli.io.readers import MoleculeRecord
 
+# Reactant combinations per worker task in streamed enumeration
+ENUMERATION_TASK_SIZE = 2000
+
+
+def product_space_size(sizes: list[int]) -> int:
+    """Number of reactant combinations in a cartesian product of lists of these sizes."""
+    return math.prod(sizes) if sizes else 0
+
+
+def decode_product_index(index: int, sizes: list[int]) -> tuple[int, ...]:
+    """
+    Map a flat index to one reactant index per list.
+
+    Indices follow itertools.product order (the last list varies fastest),
+    so a contiguous index range is a contiguous run of combinations.
+    """
+    digits = []
+    for size in reversed(sizes):
+        index, digit = divmod(index, size)
+        digits.append(digit)
+    return tuple(reversed(digits))
+
+
+def product_index_tasks(
+    n_combinations: int,
+    task_size: int = ENUMERATION_TASK_SIZE,
+    sample: Optional[int] = None,
+    seed: int = 42,
+) -> Iterator[Iterable[int]]:
+    """
+    Split the product space into worker tasks.
+
+    Args:
+        n_combinations: Size of the product space
+        task_size: Combinations per task
+        sample: Enumerate only this many combinations, drawn uniformly
+            without replacement (in index order)
+        seed: Random seed for sampling
+
+    Yields:
+        range objects covering the space in order, or sorted index lists
+        when sampling
+    """
+    task_size = max(1, task_size)
+
+    if sample is None:
+        for start in range(0, n_combinations, task_size):
+            yield range(start, min(start + task_size, n_combinations))
+        return
+
+    # random.sample over a range draws indices without materializing the space
+    indices = sorted(random.Random(seed).sample(range(n_combinations), min(sample, n_combinations)))
+    for start in range(0, len(indices), task_size):
+        yield indices[start:start + task_size]
+
+
+def _product_smiles(reaction, reactants: tuple) -> Iterator[str]:
+    """Yield the SMILES of every product that sanitizes, in RunReactants order."""
+    try:
+        products = reaction.RunReactants(reactants)
+    except Exception:
+        return
+
+    for product_set in products:
+        for prod in product_set:
+            try:
+                Chem.SanitizeMol(prod)
+                yield Chem.MolToSmiles(prod)
+            except Exception:
+                continue
+
+
+class _EnumerationTask:
+    """
+    Worker task enumerating the products of a set of product-space indices.
+
+    The reactant lists travel to each worker once, with the task; the
+    reaction and reactant SMILES are rebuilt there on first use. Returns
+    (n_combinations, rows) with rows of (digest, product dict), already
+    deduplicated within the task.
+    """
+
+    def __init__(self, reaction_smarts: str, reactant_lists: list[list[Chem.Mol]]):
+        self.reaction_smarts = reaction_smarts
+        self.reactant_lists = reactant_lists
+        self.sizes = [len(mols) for mols in reactant_lists]
+        self._reaction = None
+        self._labels: Optional[list[list[str]]] = None
+
+    def __getstate__(self):
+        state = self.__dict__.copy()
+        state["_reaction"] = None
+        state["_labels"] = None
+        return state
+
+    def __call__(self, indices: Iterable[int]) -> tuple[int, list[tuple[bytes, dict[str, Any]]]]:
+        from rdkit_cli.core.deduplicate import hash_key
+
+        if self._reaction is None:
+            self._reaction = AllChem.ReactionFromSmarts(self.reaction_smarts)
+            self._labels = [[Chem.MolToSmiles(m) for m in mols] for mols in self.reactant_lists]
+
+        rows = []
+        seen: set[str] = set()
+        n_combinations = 0
+
+        for index in indices:
+            n_combinations += 1
+            combination = decode_product_index(index, self.sizes)
+            reactants = tuple(mols[k] for mols, k in zip(self.reactant_lists, combination))
+
+            for smi in _product_smiles(self._reaction, reactants):
+                if smi in seen:
+                    continue
+                seen.add(smi)
+                label = ".".join(labels[k] for labels, k in zip(self._labels, combination))
+                rows.append((hash_key(smi), {"smiles": smi, "reactants": label}))
+
+        return n_combinations, rows
+
 
 class ReactionTransformer:
     """Apply SMIRKS transformations to molecules."""
@@ -93,12 +216,14 @@ class ReactionEnumerator:
 
         Args:
             reaction_smarts: Reaction SMARTS
-            max_products: Maximum products to generate
+            max_products: Maximum products to generate (0 for no limit
+                in enumerate_stream)
         """
         self.reaction = AllChem.ReactionFromSmarts(reaction_smarts)
         if self.reaction is None:
             raise ValueError(f"Invalid reaction SMARTS: {reaction_smarts}")
 
+        self.reaction_smarts = reaction_smarts
         self.max_products = max_products
         self.num_reactants = self.reaction.GetNumReactantTemplates()
 
@@ -115,10 +240,7 @@ class ReactionEnumerator:
         Returns:
             List of product dictionaries
         """
-        if len(reactant_lists) != self.num_reactants:
-            raise ValueError(
-                f"Expected {self.num_reactants} reactant lists, got {len(reactant_lists)}"
-            )
+        self.check_reactant_lists(reactant_lists)
 
         results = []
         unique_products = set()
@@ -130,34 +252,93 @@ class ReactionEnumerator:
             if len(results) >= self.max_products:
                 break
 
-            try:
-                products = self.reaction.RunReactants(reactants)
-
-                for product_set in products:
-                    for prod in product_set:
-                        try:
-                            Chem.SanitizeMol(prod)
-                            smi = Chem.MolToSmiles(prod)
-
-                            if smi not in unique_products:
-                                unique_products.add(smi)
-                                results.append({
-                                    "smiles": smi,
-                                    "reactants": ".".join(
-                                        Chem.MolToSmiles(r) for r in reactants
-                                    ),
-                                })
-
-                                if len(results) >= self.max_products:
-                                    break
-                        except Exception:
-                            continue
+            for smi in _product_smiles(self.reaction, reactants):
+                if smi not in unique_products:
+                    unique_products.add(smi)
+                    results.append({
+                        "smiles": smi,
+                        "reactants": ".".join(
+                            Chem.MolToSmiles(r) for r in reactants
+                        ),
+                    })
 
-            except Exception:
-                continue
+                    if len(results) >= self.max_products:
+                        break
 
         return results
 
+    def check_reactant_lists(self, reactant_lists: list[list[Chem.Mol]]):
+        """Raise ValueError unless there is one reactant list per template."""
+        if len(reactant_lists) != self.num_reactants:
+            raise ValueError(
+                f"Expected {self.num_reactants} reactant lists, got {len(reactant_lists)}"
+            )
+
+    def enumerate_stream(
+        self,
+        reactant_lists: list[list[Chem.Mol]],
+        n_workers: int = 1,
+        sample: Optional[int] = None,
+        seed: int = 42,
+        spill_dir: Optional[str | Path] = None,
+        n_partitions: Optional[int] = None,
+        task_size: int = ENUMERATION_TASK_SIZE,
+        progress=None,
+    ) -> Iterator[dict[str, Any]]:
+        """
+        Enumerate reaction products as a stream, sharded across workers.
+
+        The product space is split into index ranges (see
+        product_index_tasks), enumerated on the worker pool and yielded in
+        product order, so results match enumerate() without holding them
+        all. Products are deduplicated globally by 128-bit SMILES digest:
+        an in-memory digest set by default, or hash partitions under
+        spill_dir (see Deduplicator.deduplicate_rows; rows are then
+        yielded once the whole space has been enumerated).
+
+        Args:
+            reactant_lists: List of reactant lists (one per reactant template)
+            n_workers: Number of worker processes (-1 for all)
+            sample: Enumerate only this many randomly drawn combinations
+            seed: Random seed for sampling
+            spill_dir: Directory for on-disk deduplication partitions
+            n_partitions: Number of partitions with spill_dir
+            task_size: Combinations per worker task
+            progress: Optional NinjaProgress, advanced per combination
+
+        Yields:
+            Product dictionaries (smiles, reactants), at most max_products
+            unless max_products is 0
+        """
+        from rdkit_cli.core.deduplicate import DEFAULT_PARTITIONS, Deduplicator
+        from rdkit_cli.parallel.executor import ParallelExecutor
+
+        self.check_reactant_lists(reactant_lists)
+
+        task = _EnumerationTask(self.reaction_smarts, reactant_lists)
+        n_combinations = product_space_size(task.sizes)
+        tasks = product_index_tasks(n_combinations, task_size, sample=sample, seed=seed)
+        deduplicator = Deduplicator(
+            keep="first",
+            spill_dir=spill_dir,
+            n_partitions=n_partitions or DEFAULT_PARTITIONS,
+        )
+
+        with ParallelExecutor(task, n_workers=n_workers) as executor:
+
+            def rows() -> Iterator[tuple[bytes, dict[str, Any]]]:
+                for n_done, task_rows in executor.imap(tasks):
+                    yield from task_rows
+                    if progress is not None:
+                        progress.update(n_done)
+
+            n_yielded = 0
+            for row in deduplicator.deduplicate_rows(rows()):
+                yield row
+                n_yielded += 1
+                if self.max_products and n_yielded >= self.max_products:
+                    return
+
 
 def compute_reaction_fingerprint(
     reaction_smarts: str,
@@ -0,0 +1,13 @@
+"""Processor result types shared by the calculators and the execution layer."""
+
+from typing import NamedTuple
+
+
+class Rejected(NamedTuple):
+    """
+    Processor result for a record rejected for a named reason.
+
+    Counted as failed like None, and tallied per reason.
+    """
+
+    reason: str
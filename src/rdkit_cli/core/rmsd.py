@@ -54,6 +54,102 @@ def calculate_rmsd(
         return None
 
 
+def condensed_index(i: int, j: int) -> int:
+    """
+    Position of the pair (i, j) in a condensed conformer RMSD matrix.
+
+    The condensed layout is the lower triangle row by row (pairs (1, 0),
+    (2, 0), (2, 1), ...), as returned by GetConformerRMSMatrix and expected
+    by Butina.ClusterData.
+    """
+    if i < j:
+        i, j = j, i
+    return i * (i - 1) // 2 + j
+
+
+def _conformer_coordinates(mol):
+    """Centered coordinates of all conformers as an (n_conf, n_atoms, 3) float64 array."""
+    import numpy as np
+
+    coords = np.stack([conf.GetPositions() for conf in mol.GetConformers()])
+    return coords - coords.mean(axis=1, keepdims=True)
+
+
+def _aligned_rmsd_condensed(mol, num_threads: int):
+    """
+    Pairwise RMSD after optimal superposition (atom i onto atom i), by Kabsch.
+
+    Each row i is one vectorized batch of 3x3 SVDs against conformers j < i;
+    rows are spread over threads (numpy releases the GIL).
+    """
+    from concurrent.futures import ThreadPoolExecutor
+
+    import numpy as np
+
+    coords = _conformer_coordinates(mol)
+    n_conf, n_atoms = coords.shape[:2]
+    sq_norms = np.einsum("cak,cak->c", coords, coords)
+    out = np.zeros(n_conf * (n_conf - 1) // 2, dtype=np.float32)
+
+    def row(i: int):
+        covariance = np.einsum("jak,al->jkl", coords[:i], coords[i])
+        singular = np.linalg.svd(covariance, compute_uv=False)
+        # Reflections are not allowed: flip the smallest axis when det < 0
+        singular[:, 2] *= np.sign(np.linalg.det(covariance))
+        msd = (sq_norms[:i] + sq_norms[i] - 2.0 * singular.sum(axis=1)) / n_atoms
+        offset = i * (i - 1) // 2
+        out[offset:offset + i] = np.sqrt(np.maximum(msd, 0.0))
+
+    with ThreadPoolExecutor(max_workers=max(1, num_threads)) as pool:
+        list(pool.map(row, range(1, n_conf)))
+
+    return out
+
+
+def conformer_rmsd_condensed(
+    mol,
+    symmetry: bool = True,
+    heavy_atoms_only: bool = False,
+    num_threads: int = 1,
+):
+    """
+    Calculate the condensed pairwise RMSD matrix between conformers of a molecule.
+
+    Every pair is aligned optimally. With symmetry, RDKit's
+    GetAllConformerBestRMS computes the symmetry-equivalent atom mappings
+    once for the molecule and evaluates all pairs on num_threads threads;
+    the input molecule's coordinates are left untouched.
+
+    Args:
+        mol: Molecule with multiple conformers
+        symmetry: Consider molecular symmetry
+        heavy_atoms_only: Only use heavy atoms
+        num_threads: Threads to spread pairs over (0 for all cores)
+
+    Returns:
+        float32 array of n_conf * (n_conf - 1) / 2 RMSD values (see condensed_index)
+    """
+    import os
+
+    import numpy as np
+    from rdkit import Chem
+    from rdkit.Chem import rdMolAlign
+
+    if mol.GetNumConformers() < 2:
+        return np.zeros(0, dtype=np.float32)
+
+    if num_threads <= 0:
+        num_threads = os.cpu_count() or 1
+
+    mol = Chem.RemoveHs(mol) if heavy_atoms_only else Chem.Mol(mol)
+
+    if symmetry:
+        rmsds = rdMolAlign.GetAllConformerBestRMS(mol, numThreads=num_threads)
+        return np.asarray(rmsds, dtype=np.float32)
+
+    return _aligned_rmsd_condensed(mol, num_threads)
+
+
 def calculate_conformer_rmsd_matrix(mol, symmetry: bool = True) -> list[list[float]]:
     """
     Calculate pairwise RMSD matrix between all conformers of a molecule.
@@ -65,20 +161,16 @@ def calculate_conformer_rmsd_matrix(mol, symmetry: bool = True) -> list[list[flo
     Returns:
         2D list with RMSD values
     """
-    from rdkit.Chem import AllChem
-
     n_conf = mol.GetNumConformers()
     if n_conf == 0:
         return []
 
+    condensed = conformer_rmsd_condensed(mol, symmetry=symmetry)
     matrix = [[0.0] * n_conf for _ in range(n_conf)]
 
-    for i in range(n_conf):
-        for j in range(i + 1, n_conf):
-            if symmetry:
-                rmsd = AllChem.GetConformerRMS(mol, i, j, prealigned=False)
-            else:
-                rmsd = AllChem.GetConformerRMS(mol, i, j, prealigned=True)
+    for i in range(1, n_conf):
+        for j in range(i):
+            rmsd = float(condensed[condensed_index(i, j)])
             matrix[i][j] = rmsd
             matrix[j][i] = rmsd
 
@@ -88,56 +180,37 @@ def calculate_conformer_rmsd_matrix(mol, symmetry: bool = True) -> list[list[flo
 def cluster_conformers_by_rmsd(
     mol,
     threshold: float = 1.0,
+    symmetry: bool = True,
+    num_threads: int = 1,
+    rmsds=None,
 ) -> list[list[int]]:
     """
-    Cluster conformers by RMSD.
+    Cluster conformers by RMSD (Butina clustering).
 
     Args:
         mol: Molecule with multiple conformers
         threshold: RMSD threshold for clustering
+        symmetry: Consider molecular symmetry
+        num_threads: Threads for the RMSD matrix
+        rmsds: Precomputed condensed matrix (see conformer_rmsd_condensed)
 
     Returns:
-        List of clusters (each cluster is a list of conformer indices)
+        List of clusters (each cluster is a list of conformer indices,
+        centroid first, largest cluster first)
     """
-    from rdkit.Chem import AllChem
+    from rdkit.ML.Cluster import Butina
 
     n_conf = mol.GetNumConformers()
     if n_conf == 0:
         return []
+    if n_conf == 1:
+        return [[0]]
 
-    # Get all RMSDs
-    rmsds = AllChem.GetConformerRMSMatrix(mol, prealigned=False)
-
-    # Simple greedy clustering
-    clusters = []
-    assigned = set()
-
-    conf_indices = list(range(n_conf))
+    if rmsds is None:
+        rmsds = conformer_rmsd_condensed(mol, symmetry=symmetry, num_threads=num_threads)
 
-    for i in conf_indices:
-        if i in assigned:
-            continue
-
-        cluster = [i]
-        assigned.add(i)
-
-        for j in conf_indices:
-            if j in assigned:
-                continue
-
-            # Calculate index in condensed matrix
-            if i < j:
-                idx = i * n_conf - i * (i + 1) // 2 + j - i - 1
-            else:
-                idx = j * n_conf - j * (j + 1) // 2 + i - j - 1
-
-            if idx < len(rmsds) and rmsds[idx] < threshold:
-                cluster.append(j)
-                assigned.add(j)
-
-        clusters.append(cluster)
-
-    return clusters
+    clusters = Butina.ClusterData(rmsds, n_conf, threshold, isDistData=True, reordering=True)
+    return [list(cluster) for cluster in clusters]
 
 
 class RMSDCalculator:
@@ -192,9 +265,23 @@ class ConformerRMSDAnalyzer:
         self,
         symmetry: bool = True,
         heavy_atoms_only: bool = False,
+        num_threads: int = 1,
+        cluster_threshold: Optional[float] = None,
     ):
+        """
+        Initialize analyzer.
+
+        Args:
+            symmetry: Consider molecular symmetry
+            heavy_atoms_only: Only use heavy atoms
+            num_threads: Threads for each molecule's RMSD matrix
+            cluster_threshold: Also report the number of Butina clusters
+                at this RMSD threshold
+        """
         self.symmetry = symmetry
         self.heavy_atoms_only = heavy_atoms_only
+        self.num_threads = num_threads
+        self.cluster_threshold = cluster_threshold
 
     def analyze(self, mol) -> Optional[dict]:
         """
@@ -202,46 +289,39 @@ class ConformerRMSDAnalyzer:
 
         Returns dictionary with statistics.
         """
-        from rdkit import Chem
-
         if mol is None:
             return None
 
         n_conf = mol.GetNumConformers()
         if n_conf < 2:
-            return {
+            stats = {
                 "num_conformers": n_conf,
                 "min_rmsd": 0.0,
                 "max_rmsd": 0.0,
                 "mean_rmsd": 0.0,
             }
-
-        if self.heavy_atoms_only:
-            mol = Chem.RemoveHs(mol)
+            if self.cluster_threshold is not None:
+                stats["num_clusters"] = n_conf
+            return stats
 
         try:
-            matrix = calculate_conformer_rmsd_matrix(mol, symmetry=self.symmetry)
-
-            # Calculate statistics (upper triangle only)
-            rmsds = []
-            for i in range(len(matrix)):
-                for j in range(i + 1, len(matrix)):
-                    rmsds.append(matrix[i][j])
-
-            if not rmsds:
-                return {
-                    "num_conformers": n_conf,
-                    "min_rmsd": 0.0,
-                    "max_rmsd": 0.0,
-                    "mean_rmsd": 0.0,
-                }
-
-            return {
+            rmsds = conformer_rmsd_condensed(
+                mol,
+                symmetry=self.symmetry,
+                heavy_atoms_only=self.heavy_atoms_only,
+                num_threads=self.num_threads,
+            )
+
+            stats = {
                 "num_conformers": n_conf,
-                "min_rmsd": round(min(rmsds), 4),
-                "max_rmsd": round(max(rmsds), 4),
-                "mean_rmsd": round(sum(rmsds) / len(rmsds), 4),
+                "min_rmsd": round(float(rmsds.min()), 4),
+                "max_rmsd": round(float(rmsds.max()), 4),
+                "mean_rmsd": round(float(rmsds.mean(dtype="float64")), 4),
             }
+            if self.cluster_threshold is not None:
+                clusters = cluster_conformers_by_rmsd(mol, self.cluster_threshold, rmsds=rmsds)
+                stats["num_clusters"] = len(clusters)
+            return stats
 
         except Exception:
             return None
@@ -1,7 +1,7 @@
 """Random sampling engine for molecular datasets."""
 
 import random
-from typing import Optional
+from typing import Any, Callable, Hashable, Optional
 
 from rdkit_cli.io.readers import MoleculeRecord
 
@@ -154,3 +154,91 @@ class ReservoirSampler:
             List of sampled records
         """
         return list(self._reservoir)
+
+
+class StratifiedReservoirSampler(ReservoirSampler):
+    """
+    Stream-based stratified sampling.
+
+    Keeps a reservoir of up to n items per stratum while counting stratum
+    sizes; get_sample() then allocates the n slots proportionally to the
+    observed sizes (largest remainder) and draws each stratum's share from
+    its reservoir. Memory is n items per stratum, independent of input size.
+
+    Items can be anything the stratum function accepts (e.g. raw rows), so
+    the input need not be parsed unless the stratum is chemistry-based.
+    """
+
+    def __init__(
+        self,
+        n: int,
+        stratum: Callable[[Any], Hashable],
+        seed: Optional[int] = None,
+    ):
+        """
+        Initialize stratified reservoir sampler.
+
+        Args:
+            n: Number of items to sample
+            stratum: Function mapping an item to its stratum key
+            seed: Random seed for reproducibility
+        """
+        super().__init__(n, seed=seed)
+        self.stratum = stratum
+        self._strata: dict[Hashable, ReservoirSampler] = {}
+
+    def add(self, record: Any) -> None:
+        """
+        Add an item to its stratum's reservoir.
+
+        Args:
+            record: Item to potentially include
+        """
+        key = self.stratum(record)
+        reservoir = self._strata.get(key)
+        if reservoir is None:
+            # Per-stratum streams derived from the seed, in order of first appearance
+            reservoir = ReservoirSampler(self.n, seed=self._rng.getrandbits(64))
+            self._strata[key] = reservoir
+        reservoir.add(record)
+        self._count += 1
+
+    def allocation(self) -> dict[Hashable, int]:
+        """
+        Number of items drawn from each stratum.
+
+        Returns:
+            Mapping of stratum key to sample size
+        """
+        total = self._count
+        size = min(self.n, total)
+        if size == 0:
+            return {key: 0 for key in self._strata}
+
+        quotas = {key: size * r._count / total for key, r in self._strata.items()}
+        counts = {key: int(q) for key, q in quotas.items()}
+
+        # Hand out the remaining slots by largest fractional part
+        remaining = size - sum(counts.values())
+        by_remainder = sorted(quotas, key=lambda key: quotas[key] - counts[key], reverse=True)
+        for key in by_remainder[:remaining]:
+            counts[key] += 1
+
+        return counts
+
+    def stratum_sizes(self) -> dict[Hashable, int]:
+        """Number of items seen per stratum."""
+        return {key: r._count for key, r in self._strata.items()}
+
+    def get_sample(self) -> list[Any]:
+        """
+        Get the stratified sample, shuffled.
+
+        Returns:
+            List of sampled items
+        """
+        result: list[Any] = []
+        for key, k in self.allocation().items():
+            result.extend(self._rng.sample(self._strata[key].get_sample(), k))
+        self._rng.shuffle(result)
+        return result
@@ -18,6 +18,9 @@ from rdkit_cli.io.readers import MoleculeRecord
 # Cache for fragment scores (loaded lazily)
 _fscores: Optional[dict] = None
 
+# Cache for the fragment fingerprint generator (built once per process)
+_fragment_generator = None
+
 
 def _load_fragment_scores() -> dict:
     """Load fragment contribution scores from RDKit Contrib."""
@@ -47,6 +50,15 @@ def _generate_default_scores() -> dict:
     return {}
 
 
+def _get_fragment_generator():
+    """Get the radius-2 Morgan generator used for fragment contributions."""
+    global _fragment_generator
+    if _fragment_generator is None:
+        from rdkit.Chem.rdFingerprintGenerator import GetMorganGenerator
+        _fragment_generator = GetMorganGenerator(radius=2)
+    return _fragment_generator
+
+
 def calculate_sa_score(mol) -> Optional[float]:
     """
     Calculate Synthetic Accessibility Score for a molecule.
@@ -70,9 +82,7 @@ def calculate_sa_score(mol) -> Optional[float]:
         fscores = _load_fragment_scores()
 
         # Calculate Morgan fingerprint fragments
-        from rdkit.Chem.rdFingerprintGenerator import GetMorganGenerator
-        gen = GetMorganGenerator(radius=2)
-        fp = gen.GetSparseCountFingerprint(mol)
+        fp = _get_fragment_generator().GetSparseCountFingerprint(mol)
         fps = fp.GetNonzeroElements()
 
         # Fragment score
@@ -202,6 +212,10 @@ class SAScoreCalculator:
         self.include_smiles = include_smiles
         self.include_name = include_name
 
+    def cache_key(self) -> str:
+        """Describe every option affecting compute() output, for result caching."""
+        return f"sa={self.include_sa};npc={self.include_npc};qed={self.include_qed}"
+
     def compute(self, record: MoleculeRecord) -> Optional[dict]:
         """Compute scores for a molecule record."""
         if record.mol is None:
@@ -211,7 +225,8 @@ class SAScoreCalculator:
 
         if self.include_smiles:
             result["smiles"] = record.smiles
-        if self.include_name and record.name:
+        if self.include_name:
+            # Always present, as in get_column_names() and cached results
             result["name"] = record.name
 
         if self.include_sa:
@@ -2,13 +2,12 @@
 
 from dataclasses import dataclass
 from enum import Enum
-from typing import Optional, Any
+from typing import Iterator, Optional, Any
 
 from rdkit import Chem, DataStructs
 from rdkit.Chem import AllChem, rdMolDescriptors
-from rdkit.Chem.rdFingerprintGenerator import GetMorganGenerator
-from rdkit.ML.Cluster import Butina
 
+from rdkit_cli.core.fingerprints import get_morgan_fingerprint
 from rdkit_cli.io.readers import MoleculeRecord
 
 
@@ -30,12 +29,6 @@ class SimilarityMetric(Enum):
     TVERSKY = "tversky"
 
 
-def get_morgan_fingerprint(mol: Chem.Mol, radius: int = 2, n_bits: int = 2048):
-    """Get Morgan fingerprint for a molecule."""
-    gen = GetMorganGenerator(radius=radius, fpSize=n_bits)
-    return gen.GetFingerprint(mol)
-
-
 def compute_similarity(
     fp1,
     fp2,
@@ -85,6 +78,59 @@ def bulk_tanimoto_similarity(query_fp, fps: list) -> list[float]:
     return list(DataStructs.BulkTanimotoSimilarity(query_fp, fps))
 
 
+def bulk_similarity(
+    query_fp,
+    fps: list,
+    metric: SimilarityMetric = SimilarityMetric.TANIMOTO,
+    tversky_alpha: float = 0.5,
+    tversky_beta: float = 0.5,
+) -> list[float]:
+    """
+    Compute similarity of query against multiple fingerprints in one call.
+
+    Args:
+        query_fp: Query fingerprint
+        fps: Fingerprints to compare against
+        metric: Similarity metric to use
+        tversky_alpha: Alpha parameter for Tversky index
+        tversky_beta: Beta parameter for Tversky index
+
+    Returns:
+        Similarity scores (0-1), one per fingerprint
+    """
+    bulk_funcs = {
+        SimilarityMetric.TANIMOTO: DataStructs.BulkTanimotoSimilarity,
+        SimilarityMetric.DICE: DataStructs.BulkDiceSimilarity,
+        SimilarityMetric.COSINE: DataStructs.BulkCosineSimilarity,
+        SimilarityMetric.SOKAL: DataStructs.BulkSokalSimilarity,
+        SimilarityMetric.RUSSEL: DataStructs.BulkRusselSimilarity,
+        SimilarityMetric.ALLBIT: DataStructs.BulkAllBitSimilarity,
+        SimilarityMetric.ASYMMETRIC: DataStructs.BulkAsymmetricSimilarity,
+        SimilarityMetric.BRAUNBLANQUET: DataStructs.BulkBraunBlanquetSimilarity,
+        SimilarityMetric.KULCZYNSKI: DataStructs.BulkKulczynskiSimilarity,
+        SimilarityMetric.MCCONNAUGHEY: DataStructs.BulkMcConnaugheySimilarity,
+        SimilarityMetric.ONBIT: DataStructs.BulkOnBitSimilarity,
+        SimilarityMetric.ROGOTGOLDBERG: DataStructs.BulkRogotGoldbergSimilarity,
+    }
+
+    if metric == SimilarityMetric.TVERSKY:
+        return list(DataStructs.BulkTverskySimilarity(query_fp, fps, tversky_alpha, tversky_beta))
+
+    func = bulk_funcs.get(metric)
+    if func is None:
+        raise ValueError(f"Unknown metric: {metric}")
+    return list(func(query_fp, fps))
+
+
+def is_symmetric_metric(
+    metric: SimilarityMetric,
+    tversky_alpha: float = 0.5,
+    tversky_beta: float = 0.5,
+) -> bool:
+    """Check whether sim(a, b) == sim(b, a) for a metric."""
+    return metric != SimilarityMetric.TVERSKY or tversky_alpha == tversky_beta
+
+
 class SimilaritySearcher:
     """Search for similar molecules."""
 
@@ -158,6 +204,150 @@ class SimilaritySearcher:
         return result
 
 
+def _store_hits(
+    store,
+    query_fps: list,
+    threshold: float,
+    metric: SimilarityMetric,
+    tversky_alpha: float,
+    tversky_beta: float,
+    top_k: Optional[int],
+) -> list[tuple[list[int], list[float]]]:
+    """Search a store with several query fingerprints; (rows, similarities) per query."""
+    from rdkit_cli.core.fpsearch import ARENA_METRICS, FingerprintArena, pack_fingerprints
+
+    if metric.value in ARENA_METRICS:
+        arena = FingerprintArena.from_store(store)
+        hits = arena.search_many(
+            pack_fingerprints(query_fps, store.params.n_bits),
+            threshold=threshold,
+            top_k=top_k,
+            metric=metric.value,
+            tversky_alpha=tversky_alpha,
+            tversky_beta=tversky_beta,
+        )
+        return [(rows.tolist(), sims.tolist()) for rows, sims in hits]
+
+    fps = store.bit_vectors()
+    hits = []
+    for query_fp in query_fps:
+        all_sims = bulk_similarity(
+            query_fp, fps, metric,
+            tversky_alpha=tversky_alpha,
+            tversky_beta=tversky_beta,
+        )
+        rows = [i for i, sim in enumerate(all_sims) if sim >= threshold]
+        if top_k is not None:
+            rows = sorted(rows, key=lambda i: -all_sims[i])[:top_k]
+        hits.append((rows, [all_sims[i] for i in rows]))
+    return hits
+
+
+def _store_hit_rows(store, rows: list[int], sims: list[float]) -> list[dict[str, Any]]:
+    """Build result rows (smiles, similarity, name) for store hits."""
+    import pyarrow as pa
+
+    hits = store.table.select(["smiles", "name"]).take(pa.array(rows, type=pa.int64()))
+
+    results = []
+    for smiles, name, similarity in zip(
+        hits.column("smiles").to_pylist(), hits.column("name").to_pylist(), sims
+    ):
+        result: dict[str, Any] = {"smiles": smiles, "similarity": round(similarity, 4)}
+        if name:
+            result["name"] = name
+        results.append(result)
+    return results
+
+
+def search_fingerprint_store(
+    store,
+    query_smiles: str,
+    threshold: float = 0.7,
+    metric: SimilarityMetric = SimilarityMetric.TANIMOTO,
+    tversky_alpha: float = 0.5,
+    tversky_beta: float = 0.5,
+    top_k: Optional[int] = None,
+) -> list[dict[str, Any]]:
+    """
+    Search a FingerprintStore for molecules similar to a query.
+
+    The query is fingerprinted with the parameters recorded in the store;
+    library fingerprints are used as stored. Metrics in ARENA_METRICS are
+    searched on the packed bits with popcount bounds; the others fall back
+    to the RDKit bulk functions.
+
+    Args:
+        store: Open FingerprintStore
+        query_smiles: Query molecule SMILES
+        threshold: Minimum similarity threshold
+        metric: Similarity metric
+        tversky_alpha: Alpha parameter for Tversky index
+        tversky_beta: Beta parameter for Tversky index
+        top_k: Keep only the k most similar molecules
+
+    Returns:
+        Result rows (smiles, similarity, name): most similar first with
+        top_k, in store order otherwise
+    """
+    query_mol = Chem.MolFromSmiles(query_smiles)
+    if query_mol is None:
+        raise ValueError(f"Invalid query SMILES: {query_smiles}")
+
+    query_fp = store.params.fingerprint(query_mol)
+    if query_fp is None:
+        raise ValueError(f"Could not fingerprint query: {query_smiles}")
+
+    rows, sims = _store_hits(
+        store, [query_fp], threshold, metric, tversky_alpha, tversky_beta, top_k
+    )[0]
+    return _store_hit_rows(store, rows, sims)
+
+
+def search_store_queries(
+    store,
+    queries: list[tuple[str, Chem.Mol]],
+    threshold: float = 0.7,
+    metric: SimilarityMetric = SimilarityMetric.TANIMOTO,
+    tversky_alpha: float = 0.5,
+    tversky_beta: float = 0.5,
+    top_k: Optional[int] = None,
+) -> Iterator[tuple[str, list[dict[str, Any]]]]:
+    """
+    Search a FingerprintStore with many queries in one pass over the store.
+
+    Args:
+        store: Open FingerprintStore
+        queries: (query_id, molecule) pairs
+        threshold: Minimum similarity threshold
+        metric: Similarity metric
+        tversky_alpha: Alpha parameter for Tversky index
+        tversky_beta: Beta parameter for Tversky index
+        top_k: Keep only the k most similar molecules per query
+
+    Yields:
+        (query_id, result rows) per query, rows as in search_fingerprint_store();
+        each row also carries target_id (store name, or row index if unnamed)
+
+    Raises:
+        ValueError: If a query cannot be fingerprinted
+    """
+    query_fps = []
+    for query_id, mol in queries:
+        fp = store.params.fingerprint(mol)
+        if fp is None:
+            raise ValueError(f"Could not fingerprint query: {query_id}")
+        query_fps.append(fp)
+
+    hits = _store_hits(store, query_fps, threshold, metric, tversky_alpha, tversky_beta, top_k)
+
+    for (query_id, _), (rows, sims) in zip(queries, hits):
+        results = _store_hit_rows(store, rows, sims)
+        for row, result in zip(rows, results):
+            result["target_id"] = result.get("name") or str(row)
+        yield query_id, results
+
+
 def compute_similarity_matrix(
     mols: list[Chem.Mol],
     metric: SimilarityMetric = SimilarityMetric.TANIMOTO,
@@ -184,23 +374,145 @@ def compute_similarity_matrix(
     fps = [get_morgan_fingerprint(mol, radius, n_bits) for mol in mols if mol is not None]
     n = len(fps)
 
-    # Compute pairwise similarities
+    # Compute the upper triangle one row at a time
     matrix = [[0.0] * n for _ in range(n)]
 
     for i in range(n):
         matrix[i][i] = 1.0
-        for j in range(i + 1, n):
-            sim = compute_similarity(
-                fps[i], fps[j], metric,
-                tversky_alpha=tversky_alpha,
-                tversky_beta=tversky_beta,
-            )
+        sims = bulk_similarity(
+            fps[i], fps[i + 1:], metric,
+            tversky_alpha=tversky_alpha,
+            tversky_beta=tversky_beta,
+        )
+        for j, sim in enumerate(sims, start=i + 1):
             matrix[i][j] = sim
             matrix[j][i] = sim
 
     return matrix
 
 
+# Target number of matrix cells per row block
+_BLOCK_CELLS = 1 << 22
+
+# Scale for uint8-quantized similarities (value = code / 255)
+_UINT8_SCALE = 255
+
+
+def matrix_block_size(n: int, n_workers: int = 1) -> int:
+    """Pick rows per block: about 4M cells, with a few blocks per worker."""
+    rows = max(1, _BLOCK_CELLS // max(1, n))
+    return max(1, min(rows, -(-n // (n_workers * 4))))
+
+
+class SimilarityMatrixBlocks:
+    """
+    Compute a similarity matrix one block of rows at a time.
+
+    An instance holds all fingerprints and is sent to each worker once;
+    calling it with (start, stop) computes matrix rows start..stop-1 with
+    the Bulk* similarity functions, so no n x n structure is ever built.
+
+    In dense mode a block is a (stop - start, n) numpy array; row i holds
+    sim(fp_i, fp_j) for every j, with 1.0 on the diagonal. In edge mode a
+    block is (i, j, value) arrays for the pairs passing the threshold;
+    symmetric metrics only report j > i.
+    """
+
+    def __init__(
+        self,
+        fps: list,
+        metric: SimilarityMetric = SimilarityMetric.TANIMOTO,
+        tversky_alpha: float = 0.5,
+        tversky_beta: float = 0.5,
+        distance: bool = False,
+        dtype: str = "float64",
+        edges: bool = False,
+        threshold: Optional[float] = None,
+    ):
+        """
+        Initialize block computer.
+
+        Args:
+            fps: Fingerprints, one per matrix row
+            metric: Similarity metric
+            tversky_alpha: Alpha parameter for Tversky index
+            tversky_beta: Beta parameter for Tversky index
+            distance: Report 1 - similarity
+            dtype: Dense block dtype: float64, float32 or uint8 (quantized x255)
+            edges: Return thresholded (i, j, value) edges instead of dense rows
+            threshold: Keep edges with similarity >= threshold
+                (distance <= threshold); None keeps all pairs
+        """
+        self.fps = fps
+        self.metric = metric
+        self.tversky_alpha = tversky_alpha
+        self.tversky_beta = tversky_beta
+        self.distance = distance
+        self.dtype = dtype
+        self.edges = edges
+        self.threshold = threshold
+        self.symmetric = is_symmetric_metric(metric, tversky_alpha, tversky_beta)
+
+    def _row(self, i: int, offset: int):
+        """Similarities (or distances) of row i against fps[offset:]."""
+        import numpy as np
+
+        values = np.asarray(
+            bulk_similarity(
+                self.fps[i], self.fps[offset:], self.metric,
+                tversky_alpha=self.tversky_alpha,
+                tversky_beta=self.tversky_beta,
+            ),
+            dtype=np.float64,
+        )
+        if i >= offset:
+            values[i - offset] = 1.0
+        if self.distance:
+            values = 1.0 - values
+        return values
+
+    def __call__(self, block: tuple[int, int]):
+        if self.edges:
+            return self._edge_block(*block)
+        return self._dense_block(*block)
+
+    def _dense_block(self, start: int, stop: int):
+        import numpy as np
+
+        out = np.empty((stop - start, len(self.fps)), dtype=self.dtype)
+        for k, i in enumerate(range(start, stop)):
+            values = self._row(i, 0)
+            if self.dtype == "uint8":
+                values = np.rint(values * _UINT8_SCALE)
+            out[k] = values
+        return out
+
+    def _edge_block(self, start: int, stop: int):
+        import numpy as np
+
+        rows, cols, vals = [], [], []
+        for i in range(start, stop):
+            offset = i + 1 if self.symmetric else 0
+            values = self._row(i, offset)
+            j = np.arange(offset, len(self.fps))
+
+            keep = j != i
+            if self.threshold is not None:
+                if self.distance:
+                    keep &= values <= self.threshold
+                else:
+                    keep &= values >= self.threshold
+
+            rows.append(np.full(int(keep.sum()), i, dtype=np.int64))
+            cols.append(j[keep])
+            vals.append(values[keep])
+
+        if not rows:
+            empty = np.empty(0, dtype=np.int64)
+            return empty, empty, np.empty(0)
+        return np.concatenate(rows), np.concatenate(cols), np.concatenate(vals)
+
+
 class ShapeSimilaritySearcher:
     """Search for molecules with similar 3D shape."""
 
@@ -282,20 +594,27 @@ class ShapeSimilaritySearcher:
         return result
 
 
+CLUSTER_METHODS = ["butina", "sphere"]
+
+
 def cluster_molecules(
     mols: list[Chem.Mol],
     cutoff: float = 0.3,
     radius: int = 2,
     n_bits: int = 2048,
+    method: str = "butina",
+    n_workers: int = 1,
 ) -> list[list[int]]:
     """
-    Cluster molecules using Butina algorithm.
+    Cluster molecules on Morgan fingerprints.
 
     Args:
         mols: List of molecules
         cutoff: Distance cutoff (1 - similarity)
         radius: Morgan fingerprint radius
         n_bits: Fingerprint bit size
+        method: Clustering method (see cluster_fingerprints)
+        n_workers: Worker processes for the neighbor search
 
     Returns:
         List of clusters (each cluster is a list of molecule indices)
@@ -308,22 +627,147 @@ def cluster_molecules(
             fps.append(get_morgan_fingerprint(mol, radius, n_bits))
             valid_indices.append(i)
 
-    n = len(fps)
-    if n == 0:
+    clusters = cluster_fingerprints(fps, cutoff, method=method, n_workers=n_workers)
+
+    # Map back to original indices
+    return [[valid_indices[i] for i in cluster] for cluster in clusters]
+
+
+def cluster_fingerprints(
+    fps: list,
+    cutoff: float = 0.3,
+    method: str = "butina",
+    n_workers: int = 1,
+) -> list[list[int]]:
+    """
+    Cluster precomputed fingerprints on Tanimoto distance.
+
+    Methods:
+        butina: Butina clustering on the sparse neighbor graph
+        sphere: sphere exclusion; leaders picked with RDKit's LeaderPicker,
+            every fingerprint joins its most similar leader
+
+    Args:
+        fps: Fingerprints (e.g. from a FingerprintStore)
+        cutoff: Distance cutoff (1 - similarity)
+        method: Clustering method
+        n_workers: Worker processes for the neighbor search
+
+    Returns:
+        List of clusters (each cluster is a list of fingerprint indices,
+        centroid first)
+    """
+    from rdkit_cli.core.fpsearch import FingerprintArena
+
+    if len(fps) == 0:
         return []
 
-    # Compute distance matrix (lower triangle)
-    dists = []
-    for i in range(1, n):
-        sims = DataStructs.BulkTanimotoSimilarity(fps[i], fps[:i])
-        dists.extend([1 - s for s in sims])
+    arena = FingerprintArena.from_fingerprints(fps, fps[0].GetNumBits())
+    return cluster_arena(arena, cutoff, method=method, n_workers=n_workers, fps=fps)
 
-    # Cluster using Butina
-    clusters = Butina.ClusterData(dists, n, cutoff, isDistData=True)
 
-    # Map back to original indices
-    result = []
-    for cluster in clusters:
-        result.append([valid_indices[i] for i in cluster])
+def cluster_arena(
+    arena,
+    cutoff: float = 0.3,
+    method: str = "butina",
+    n_workers: int = 1,
+    fps: Optional[list] = None,
+) -> list[list[int]]:
+    """
+    Cluster the fingerprints of a FingerprintArena.
 
-    return result
+    Args:
+        arena: FingerprintArena (e.g. from a FingerprintStore)
+        cutoff: Distance cutoff (1 - similarity)
+        method: Clustering method (see cluster_fingerprints)
+        n_workers: Worker processes for the neighbor search
+        fps: The same fingerprints as RDKit bit vectors, or a callable
+            returning them (needed by "sphere" only)
+
+    Returns:
+        List of clusters (each cluster is a list of row indices, centroid first)
+    """
+    if method not in CLUSTER_METHODS:
+        raise ValueError(f"Unknown clustering method: {method}")
+    if len(arena) == 0:
+        return []
+
+    if method == "sphere":
+        return _sphere_exclusion(arena, fps() if callable(fps) else fps, cutoff, n_workers)
+
+    from rdkit_cli.core.fpsearch import neighbor_graph
+
+    indptr, indices = neighbor_graph(arena, cutoff, n_workers=n_workers)
+    return butina_from_neighbors(indptr, indices)
+
+
+def butina_from_neighbors(indptr, indices) -> list[list[int]]:
+    """
+    Butina clustering of a sparse neighbor graph.
+
+    Gives the same clusters as rdkit.ML.Cluster.Butina.ClusterData on the
+    full distance list: points are taken as centroids in order of neighbor
+    count (ties by higher index), each claiming its unassigned neighbors.
+
+    Args:
+        indptr: CSR row pointers (n + 1)
+        indices: CSR neighbor indices, ascending per row, excluding self
+
+    Returns:
+        List of clusters (each cluster is a list of indices, centroid first)
+    """
+    import numpy as np
+
+    n = len(indptr) - 1
+    counts = np.diff(indptr)
+    order = np.lexsort((np.arange(n), counts))[::-1]
+
+    seen = np.zeros(n, dtype=bool)
+    clusters = []
+    for idx in order.tolist():
+        if seen[idx]:
+            continue
+        seen[idx] = True
+        neighbors = indices[indptr[idx]:indptr[idx + 1]]
+        members = neighbors[~seen[neighbors]]
+        seen[members] = True
+        clusters.append([idx] + members.tolist())
+
+    return clusters
+
+
+def _sphere_exclusion(arena, fps: list, cutoff: float, n_workers: int) -> list[list[int]]:
+    """Sphere exclusion: pick leaders, then assign every row to its nearest leader."""
+    import numpy as np
+    from rdkit.SimDivFilters import rdSimDivPickers
+
+    from rdkit_cli.core.fpsearch import FingerprintArena
+
+    picker = rdSimDivPickers.LeaderPicker()
+    leaders = list(picker.LazyBitVectorPick(fps, len(fps), cutoff, numThreads=n_workers))
+
+    leader_rows = np.asarray(leaders, dtype=np.int64)
+    leader_arena = FingerprintArena(arena.take(leader_rows), n_bits=arena.n_bits)
+
+    # Nearest leader per row, in blocks so memory stays bounded
+    assignment = np.full(len(arena), -1, dtype=np.int64)
+    block_rows = 1 << 14
+    for start in range(0, len(arena), block_rows):
+        stop = min(start + block_rows, len(arena))
+        hits = leader_arena.search_many(
+            arena.rows(start, stop), threshold=1.0 - cutoff - 1e-9, top_k=1
+        )
+        for i, (rows, _) in enumerate(hits, start):
+            if len(rows):
+                assignment[i] = rows[0]
+    assignment[leader_rows] = np.arange(len(leaders))
+
+    clusters = [[row] for row in leaders]
+    for i, leader in enumerate(assignment.tolist()):
+        if leader < 0:
+            # Off by rounding only: a row no leader covers leads itself
+            clusters.append([i])
+        elif i != leaders[leader]:
+            clusters[leader].append(i)
+
+    return clusters
@@ -1,10 +1,12 @@
 """File splitting engine for molecular datasets."""
 
 from pathlib import Path
-from typing import Iterator, Optional
+from typing import Iterable, Iterator, Optional, TypeVar
 
 from rdkit_cli.io.readers import MoleculeRecord
 
+T = TypeVar("T")
+
 
 class FileSplitter:
     """Split molecular datasets into smaller files."""
@@ -86,6 +88,40 @@ class FileSplitter:
         for chunk_idx, (start, end) in enumerate(assignments):
             yield chunk_idx, records[start:end]
 
+    def split_stream(
+        self,
+        items: Iterable[T],
+        total_records: Optional[int] = None,
+    ) -> Iterator[tuple[int, T]]:
+        """
+        Assign streamed items to chunks without materializing them.
+
+        With chunk_size no total is needed. With n_chunks, chunk boundaries
+        come from total_records (e.g. the reader's line count); items beyond
+        that total go to the last chunk.
+
+        Args:
+            items: Items in input order
+            total_records: Expected number of items (required with n_chunks)
+
+        Yields:
+            Tuples of (chunk_index, item), chunk indices non-decreasing
+        """
+        if self.n_chunks is None:
+            for idx, item in enumerate(items):
+                yield idx // self.chunk_size, item
+            return
+
+        if total_records is None:
+            raise ValueError("total_records is required when splitting into n_chunks")
+
+        ends = [end for _, end in self.calculate_chunk_assignments(total_records)]
+        chunk_idx = 0
+        for idx, item in enumerate(items):
+            while chunk_idx < len(ends) - 1 and idx >= ends[chunk_idx]:
+                chunk_idx += 1
+            yield chunk_idx, item
+
     @staticmethod
     def generate_output_path(
         output_dir: Path,
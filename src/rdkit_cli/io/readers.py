@@ -1,11 +1,13 @@
 """File readers for various molecular file formats."""
 
+import csv
+import os
 import sys
 from abc import ABC, abstractmethod
+from itertools import islice
 from pathlib import Path
-from typing import Iterator, Optional, Any
+from typing import Callable, Iterator, Optional, Any, NamedTuple
 
-import pandas as pd
 from rdkit import Chem
 
 from rdkit_cli.io.formats import FileFormat, FormatConfig, detect_format
@@ -18,6 +20,17 @@ def _warn_parse_failed(row_idx: int, smiles: str, max_len: int = 50):
         print(f"Warning: Failed to parse SMILES at row {row_idx}: {smiles[:max_len]}", file=sys.stderr)
 
 
+def _warn_ragged_row(row_idx: int, n_values: int, n_columns: int):
+    """Print a warning for a CSV row with too few or too many fields if warnings are enabled."""
+    from rdkit_cli.utils import are_app_warnings_suppressed
+    if not are_app_warnings_suppressed():
+        action = "missing values left empty" if n_values < n_columns else "extra values ignored"
+        print(
+            f"Warning: Row {row_idx} has {n_values} fields, expected {n_columns}; {action}",
+            file=sys.stderr,
+        )
+
+
 class MoleculeRecord:
     """A molecule with its associated metadata."""
 
@@ -43,19 +56,396 @@ class MoleculeRecord:
         return self.mol is not None
 
 
+class RawRecord(NamedTuple):
+    """
+    An unparsed input row: molecule text plus metadata, no RDKit Mol.
+
+    The smiles field holds the SMILES string, or the molfile block for SDF
+    input (see MoleculeReader.raw_parser).
+    """
+
+    row_idx: int
+    smiles: str
+    name: str
+    metadata: Optional[dict[str, Any]]
+
+
+def parse_record(
+    row_idx: int,
+    smiles: str,
+    name: str = "",
+    metadata: Optional[dict[str, Any]] = None,
+    warn_row: Optional[int] = None,
+) -> MoleculeRecord:
+    """
+    Parse a raw SMILES row into a MoleculeRecord.
+
+    Used by readers in the parent process and by workers when rows are
+    shipped unparsed (see MoleculeReader.iter_raw).
+
+    Args:
+        row_idx: Row index in the input file
+        smiles: SMILES string
+        name: Molecule name
+        metadata: Row metadata
+        warn_row: Row number reported if parsing fails (default: row_idx)
+
+    Returns:
+        MoleculeRecord (mol is None if parsing failed)
+    """
+    mol = None
+    if smiles:
+        try:
+            mol = Chem.MolFromSmiles(smiles)
+        except Exception:
+            pass
+
+    if mol is None and smiles:
+        _warn_parse_failed(row_idx if warn_row is None else warn_row, smiles)
+
+    return MoleculeRecord(
+        mol=mol,
+        smiles=smiles,
+        name=name,
+        metadata=metadata,
+        row_idx=row_idx,
+    )
+
+
+def parse_smi_record(
+    row_idx: int,
+    smiles: str,
+    name: str = "",
+    metadata: Optional[dict[str, Any]] = None,
+) -> MoleculeRecord:
+    """parse_record for SMI rows, whose parse warnings give 1-based line numbers (after any header)."""
+    return parse_record(row_idx, smiles, name, metadata, warn_row=row_idx + 1)
+
+
+def parse_molblock_record(
+    row_idx: int,
+    molblock: str,
+    name: str = "",
+    metadata: Optional[dict[str, Any]] = None,
+) -> MoleculeRecord:
+    """
+    Parse a raw SDF entry into a MoleculeRecord.
+
+    The canonical SMILES is generated here too, so with raw iteration both
+    parsing and SMILES generation run in the workers.
+
+    Args:
+        row_idx: Entry index in the input file
+        molblock: Molfile block of the entry
+        name: Molecule name (default: the molfile title line)
+        metadata: SD properties of the entry
+
+    Returns:
+        MoleculeRecord (mol is None if parsing failed)
+    """
+    mol = None
+    try:
+        mol = Chem.MolFromMolBlock(molblock)
+    except Exception:
+        pass
+
+    if mol is None:
+        _warn_parse_failed(row_idx, "(SDF molecule)")
+        return MoleculeRecord(mol=None, metadata=metadata, row_idx=row_idx)
+
+    if not name and mol.HasProp("_Name"):
+        name = mol.GetProp("_Name")
+
+    return MoleculeRecord(
+        mol=mol,
+        smiles=Chem.MolToSmiles(mol),
+        name=name,
+        metadata=metadata,
+        row_idx=row_idx,
+    )
+
+
+def passthrough_row(smiles: str, name: str, metadata: Optional[dict[str, Any]]) -> dict[str, Any]:
+    """
+    Output row for an input record written through unchanged.
+
+    Args:
+        smiles: SMILES string
+        name: Molecule name
+        metadata: Row metadata (other input columns)
+
+    Returns:
+        Row with SMILES, name (if any), then the other input columns
+    """
+    row: dict[str, Any] = {"smiles": smiles}
+    if name:
+        row["name"] = name
+    for key, value in (metadata or {}).items():
+        if key not in row and key != "smiles":
+            row[key] = value
+    return row
+
+
+def raw_passthrough_row(
+    raw: RawRecord,
+    parse: Callable[..., MoleculeRecord] = parse_record,
+) -> dict[str, Any]:
+    """
+    Output row for a raw input row written through unchanged.
+
+    SMILES rows are used as read, without RDKit; other raw formats (SDF
+    molfile blocks) are parsed to get their SMILES.
+
+    Args:
+        raw: Raw row from MoleculeReader.iter_raw()
+        parse: The reader's raw_parser
+
+    Returns:
+        Row as built by passthrough_row()
+    """
+    if parse is parse_record or parse is parse_smi_record:
+        return passthrough_row(raw.smiles, raw.name, raw.metadata)
+    record = parse(*raw)
+    return passthrough_row(record.smiles, record.name, record.metadata)
+
+
+def _parse_sd_properties(lines: list[str]) -> dict[str, str]:
+    """Parse the SD data items following a molfile block into a dict of strings."""
+    properties: dict[str, str] = {}
+    key: Optional[str] = None
+    values: list[str] = []
+
+    for line in lines:
+        line = line.rstrip("\r\n")
+
+        if key is None:
+            # Header line, e.g. ">  <MolWeight>  (1)"
+            if line.startswith(">"):
+                start = line.find("<")
+                end = line.find(">", start + 1)
+                if start != -1 and end != -1:
+                    key = line[start + 1:end]
+                    values = []
+        elif line.strip():
+            values.append(line)
+        else:
+            properties[key] = "\n".join(values)
+            key = None
+
+    if key is not None:
+        properties[key] = "\n".join(values)
+
+    return properties
+
+
+# Block size for record counting scans
+_COUNT_BLOCK_SIZE = 1 << 24
+
+# Bytes read from the start of a file to estimate its record count
+_ESTIMATE_SAMPLE_SIZE = 1 << 20
+
+# SDF record terminator (the preceding newline anchors it to a line start)
+_SDF_DELIMITER = b"\n$$$$"
+
+
+def _count_occurrences(path: Path, needle: bytes) -> int:
+    """
+    Count occurrences of needle in a file, scanning it in large blocks.
+
+    The scan is single-threaded: bytes.count holds the GIL, so counting
+    blocks on several threads would not run faster, and one C-level pass
+    over 16 MiB blocks is disk-bound on most inputs anyway.
+    """
+    count = 0
+    overlap = len(needle) - 1
+    tail = b""
+
+    with open(path, "rb") as f:
+        while block := f.read(_COUNT_BLOCK_SIZE):
+            data = tail + block if tail else block
+            count += data.count(needle)
+            # Keep enough bytes to catch a needle split across blocks
+            tail = data[-overlap:] if overlap else b""
+
+    return count
+
+
+def _iter_sdf_entries(path: Path, start: int = 0) -> Iterator[bytes]:
+    """
+    Yield the bytes of SDF entries (without their $$$$ line), from entry start on.
+
+    A line starting with $$$$ ends an entry; non-blank text after the last
+    such line is a final entry (see _count_sdf_entries). Delimiters are
+    found with bytes.find over large blocks instead of line by line.
+    """
+    idx = 0
+    with open(path, "rb") as f:
+        buffer = f.read(_COUNT_BLOCK_SIZE)
+        pos = 0
+        eof = not buffer
+        while True:
+            # pos is always at a line start
+            if buffer.startswith(b"$$$$", pos):
+                cut = pos
+            else:
+                cut = buffer.find(_SDF_DELIMITER, pos)
+                if cut >= 0:
+                    cut += 1
+            newline = buffer.find(b"\n", cut) if cut >= 0 else -1
+
+            if cut >= 0 and (newline >= 0 or eof):
+                if idx >= start:
+                    yield buffer[pos:cut]
+                idx += 1
+                pos = newline + 1 if newline >= 0 else len(buffer)
+                continue
+
+            if eof:
+                tail = buffer[pos:]
+                if tail.strip() and idx >= start:
+                    yield tail
+                return
+
+            block = f.read(_COUNT_BLOCK_SIZE)
+            eof = not block
+            buffer = buffer[pos:] + block
+            pos = 0
+
+
+def _count_sdf_entries(path: Path) -> int:
+    """
+    Count SDF entries as SDFReader.iter_raw yields them.
+
+    That is one per $$$$ line, plus a last entry not closed by $$$$ when
+    non-blank text follows the final delimiter line.
+    """
+    count = _count_occurrences(path, _SDF_DELIMITER)
+
+    # Read backwards from the end until the last delimiter is in view
+    size = os.path.getsize(path)
+    tail = b""
+    cut = -1
+    with open(path, "rb") as f:
+        if f.read(4) == b"$$$$":
+            count += 1
+        pos = size
+        while pos > 0:
+            step = min(_COUNT_BLOCK_SIZE, pos)
+            pos -= step
+            f.seek(pos)
+            tail = f.read(step) + tail
+            cut = tail.rfind(_SDF_DELIMITER)
+            if cut >= 0 or pos == 0:
+                break
+
+    if cut >= 0:
+        # Skip the rest of the delimiter line
+        newline = tail.find(b"\n", cut + 1)
+        tail = tail[newline + 1:] if newline >= 0 else b""
+    elif tail.startswith(b"$$$$"):
+        newline = tail.find(b"\n")
+        tail = tail[newline + 1:] if newline >= 0 else b""
+
+    if tail.strip():
+        count += 1
+    return count
+
+
+def _count_lines(path: Path) -> int:
+    """Count lines in a file, including a final line without a newline."""
+    count = _count_occurrences(path, b"\n")
+
+    size = os.path.getsize(path)
+    if size:
+        with open(path, "rb") as f:
+            f.seek(size - 1)
+            if f.read(1) != b"\n":
+                count += 1
+
+    return count
+
+
+def _estimate_occurrences(path: Path, needle: bytes) -> int:
+    """Estimate occurrences of needle from its density in the start of the file."""
+    size = os.path.getsize(path)
+
+    with open(path, "rb") as f:
+        sample = f.read(_ESTIMATE_SAMPLE_SIZE)
+
+    n = sample.count(needle)
+    if len(sample) >= size:
+        return n
+
+    return max(n, round(size * n / len(sample)))
+
+
 class MoleculeReader(ABC):
     """Abstract base class for molecule file readers."""
 
+    # Whether iter_raw() is available
+    supports_raw: bool = False
+
+    # Whether len() is known without scanning the file
+    cheap_len: bool = False
+
     @abstractmethod
     def __iter__(self) -> Iterator[MoleculeRecord]:
         """Yield MoleculeRecord objects."""
         pass
 
+    def iter_raw(self, with_metadata: bool = True) -> Iterator[RawRecord]:
+        """
+        Yield unparsed RawRecord rows without calling RDKit.
+
+        Lets callers defer SMILES parsing to worker processes, so only the
+        (row_idx, smiles, name) triple has to cross the process boundary.
+
+        Args:
+            with_metadata: Build the per-row metadata dict (None otherwise)
+        """
+        raise NotImplementedError(f"{type(self).__name__} does not support raw iteration")
+
+    def iter_raw_from(self, start: int, with_metadata: bool = True) -> Iterator[RawRecord]:
+        """
+        iter_raw() from row `start` on, with unchanged row indices (for --shard).
+
+        Readers that can skip ahead without splitting the rows before it
+        (SDF) override this; the default drops the first rows of iter_raw().
+        """
+        return islice(self.iter_raw(with_metadata=with_metadata), start, None)
+
+    @property
+    def raw_parser(self) -> Callable[..., MoleculeRecord]:
+        """Module-level function turning RawRecord fields into a MoleculeRecord."""
+        return parse_record
+
+    def iter_passthrough(self) -> Iterator[RawRecord]:
+        """
+        Yield rows with metadata for writing through unchanged.
+
+        Raw rows when supported (no RDKit parsing), otherwise parsed records
+        repackaged as RawRecords. Pair with raw_passthrough_row(raw, self.raw_parser).
+        """
+        if self.supports_raw:
+            yield from self.iter_raw(with_metadata=True)
+            return
+        for record in self:
+            yield RawRecord(record.row_idx, record.smiles, record.name, record.metadata)
+
     @abstractmethod
     def __len__(self) -> int:
         """Return total number of molecules (for progress)."""
         pass
 
+    def estimate_len(self) -> int:
+        """
+        Return an approximate number of molecules without a full file scan.
+
+        Used for progress totals when exact counting is too expensive.
+        Readers without a cheaper estimate return len().
+        """
+        return len(self)
+
     @abstractmethod
     def close(self):
         """Close any open resources."""
@@ -71,6 +461,8 @@ class MoleculeReader(ABC):
 class CSVReader(MoleculeReader):
     """Read molecules from CSV/TSV files."""
 
+    supports_raw = True
+
     def __init__(
         self,
         path: Path | str,
@@ -85,53 +477,128 @@ class CSVReader(MoleculeReader):
         self.delimiter = delimiter
         self.has_header = has_header
         self._count: Optional[int] = None
-        self._df: Optional[pd.DataFrame] = None
 
     def __len__(self) -> int:
         if self._count is None:
-            # Count lines efficiently
-            with open(self.path, "rb") as f:
-                self._count = sum(1 for _ in f) - (1 if self.has_header else 0)
+            self._count = _count_lines(self.path) - (1 if self.has_header else 0)
         return self._count
 
+    def estimate_len(self) -> int:
+        if self._count is not None:
+            return self._count
+        return max(0, _estimate_occurrences(self.path, b"\n") - (1 if self.has_header else 0))
+
     def __iter__(self) -> Iterator[MoleculeRecord]:
-        header = 0 if self.has_header else None
+        for raw in self.iter_raw():
+            yield parse_record(*raw)
+
+    def _column_names(self) -> list[str]:
+        """Read column names from the header, or generate them from the first row."""
+        # utf-8-sig drops the byte order mark of Excel exports
+        with open(self.path, "r", newline="", encoding="utf-8-sig") as f:
+            first_row = next(csv.reader(f, delimiter=self.delimiter), [])
+
+        if self.has_header:
+            return first_row
+
+        # Assume first column is SMILES
+        return [self.smiles_column] + [f"col_{i}" for i in range(1, len(first_row))]
+
+    def iter_raw(self, with_metadata: bool = True) -> Iterator[RawRecord]:
+        import pyarrow as pa
+        import pyarrow.csv as pa_csv
+
+        column_names = self._column_names()
+        if not column_names:
+            return
+
+        # Keep every value as a string, empty fields included
+        convert_options = pa_csv.ConvertOptions(
+            column_types={name: pa.string() for name in column_names},
+            strings_can_be_null=False,
+            quoted_strings_can_be_null=False,
+            include_columns=None if with_metadata else _projection(
+                column_names, self.smiles_column, self.name_column
+            ),
+        )
+        read_options = pa_csv.ReadOptions(
+            column_names=column_names,
+            skip_rows=1 if self.has_header else 0,
+        )
 
-        # Read in chunks for memory efficiency
-        for chunk in pd.read_csv(
-            self.path,
+        # Arrow can only skip rows with the wrong field count; they are noted
+        # here and the file is then read on by _iter_raw_rows, which pads them
+        ragged = []
+
+        def on_invalid_row(row) -> str:
+            ragged.append(row)
+            return "skip"
+
+        parse_options = pa_csv.ParseOptions(
             delimiter=self.delimiter,
-            header=header,
-            chunksize=10000,
-            dtype=str,
-            na_filter=False,
-        ):
-            # Handle no-header case
-            if not self.has_header:
-                # Assume first column is SMILES
-                chunk.columns = [self.smiles_column] + [f"col_{i}" for i in range(1, len(chunk.columns))]
-
-            for idx, row in chunk.iterrows():
-                smiles = str(row.get(self.smiles_column, ""))
-                name = str(row.get(self.name_column, "")) if self.name_column else ""
-
-                mol = None
-                if smiles:
-                    try:
-                        mol = Chem.MolFromSmiles(smiles)
-                    except Exception:
-                        pass
-
-                if mol is None and smiles:
-                    _warn_parse_failed(idx, smiles)
-
-                yield MoleculeRecord(
-                    mol=mol,
-                    smiles=smiles,
-                    name=name,
-                    metadata=row.to_dict(),
-                    row_idx=int(idx),
+            newlines_in_values=True,
+            invalid_row_handler=on_invalid_row,
+        )
+
+        # Stream record batches for memory efficiency
+        row_idx = 0
+        with pa_csv.open_csv(
+            self.path,
+            read_options=read_options,
+            parse_options=parse_options,
+            convert_options=convert_options,
+        ) as stream:
+            for batch in stream:
+                # A batch is parsed before it is returned, so rows up to
+                # row_idx came before any skipped row
+                if ragged:
+                    break
+                yield from _iter_batch_records(
+                    batch, row_idx, self.smiles_column, self.name_column, with_metadata
                 )
+                row_idx += batch.num_rows
+
+        if ragged:
+            yield from self._iter_raw_rows(column_names, row_idx, with_metadata)
+
+    def _iter_raw_rows(
+        self,
+        column_names: list[str],
+        start_idx: int,
+        with_metadata: bool,
+    ) -> Iterator[RawRecord]:
+        """
+        Read rows with the csv module from row start_idx on, for files with ragged rows.
+
+        Short rows are padded with empty values and extra values are dropped,
+        as pandas did, with a warning per row.
+        """
+        n_columns = len(column_names)
+        positions = {name: i for i, name in enumerate(column_names)}
+        smiles_pos = positions.get(self.smiles_column)
+        name_pos = positions.get(self.name_column) if self.name_column else None
+
+        with open(self.path, "r", newline="", encoding="utf-8-sig") as f:
+            rows = csv.reader(f, delimiter=self.delimiter)
+            if self.has_header:
+                next(rows, None)
+
+            row_idx = 0
+            for values in rows:
+                # Empty lines are skipped, like Arrow does
+                if not values:
+                    continue
+                if row_idx >= start_idx:
+                    if len(values) != n_columns:
+                        _warn_ragged_row(row_idx, len(values), n_columns)
+                        values = (values + [""] * n_columns)[:n_columns]
+                    yield RawRecord(
+                        row_idx,
+                        values[smiles_pos] if smiles_pos is not None else "",
+                        values[name_pos] if name_pos is not None else "",
+                        dict(zip(column_names, values)) if with_metadata else None,
+                    )
+                row_idx += 1
 
     def close(self):
         pass
@@ -140,6 +607,8 @@ class CSVReader(MoleculeReader):
 class SMIReader(MoleculeReader):
     """Read molecules from SMILES files."""
 
+    supports_raw = True
+
     def __init__(
         self,
         path: Path | str,
@@ -153,12 +622,23 @@ class SMIReader(MoleculeReader):
 
     def __len__(self) -> int:
         if self._count is None:
-            with open(self.path, "r") as f:
-                count = sum(1 for _ in f)
-            self._count = count - (1 if self.has_header else 0)
+            self._count = _count_lines(self.path) - (1 if self.has_header else 0)
         return self._count
 
+    def estimate_len(self) -> int:
+        if self._count is not None:
+            return self._count
+        return max(0, _estimate_occurrences(self.path, b"\n") - (1 if self.has_header else 0))
+
+    @property
+    def raw_parser(self) -> Callable[..., MoleculeRecord]:
+        return parse_smi_record
+
     def __iter__(self) -> Iterator[MoleculeRecord]:
+        for raw in self.iter_raw():
+            yield parse_smi_record(*raw)
+
+    def iter_raw(self, with_metadata: bool = True) -> Iterator[RawRecord]:
         with open(self.path, "r") as f:
             if self.has_header:
                 next(f)
@@ -172,22 +652,11 @@ class SMIReader(MoleculeReader):
                 smiles = parts[0] if parts else ""
                 name = parts[1].strip() if len(parts) > 1 else ""
 
-                mol = None
-                if smiles:
-                    try:
-                        mol = Chem.MolFromSmiles(smiles)
-                    except Exception:
-                        pass
-
-                if mol is None and smiles:
-                    _warn_parse_failed(idx + 1, smiles)
-
-                yield MoleculeRecord(
-                    mol=mol,
-                    smiles=smiles,
-                    name=name,
-                    metadata={"smiles": smiles, "name": name},
-                    row_idx=idx,
+                yield RawRecord(
+                    idx,
+                    smiles,
+                    name,
+                    {"smiles": smiles, "name": name} if with_metadata else None,
                 )
 
     def close(self):
@@ -197,42 +666,61 @@ class SMIReader(MoleculeReader):
 class SDFReader(MoleculeReader):
     """Read molecules from SDF files."""
 
+    supports_raw = True
+
     def __init__(self, path: Path | str):
         self.path = Path(path)
         self._count: Optional[int] = None
 
     def __len__(self) -> int:
         if self._count is None:
-            # Count $$$$ delimiters
-            with open(self.path, "rb") as f:
-                self._count = sum(1 for line in f if line.strip() == b"$$$$")
+            self._count = _count_sdf_entries(self.path)
         return self._count
 
-    def __iter__(self) -> Iterator[MoleculeRecord]:
-        supplier = Chem.SDMolSupplier(str(self.path))
-
-        for idx, mol in enumerate(supplier):
-            metadata = {}
-            smiles = ""
-            name = ""
+    def estimate_len(self) -> int:
+        if self._count is not None:
+            return self._count
+        return _estimate_occurrences(self.path, _SDF_DELIMITER)
 
-            if mol is not None:
-                # Extract properties
-                for prop in mol.GetPropsAsDict():
-                    metadata[prop] = mol.GetProp(prop)
+    @property
+    def raw_parser(self) -> Callable[..., MoleculeRecord]:
+        return parse_molblock_record
 
-                name = mol.GetProp("_Name") if mol.HasProp("_Name") else ""
-                smiles = Chem.MolToSmiles(mol)
-            else:
-                _warn_parse_failed(idx, "(SDF molecule)")
-
-            yield MoleculeRecord(
-                mol=mol,
-                smiles=smiles,
-                name=name,
-                metadata=metadata,
-                row_idx=idx,
-            )
+    def __iter__(self) -> Iterator[MoleculeRecord]:
+        for raw in self.iter_raw():
+            yield parse_molblock_record(*raw)
+
+    def iter_raw(self, with_metadata: bool = True) -> Iterator[RawRecord]:
+        return self.iter_raw_from(0, with_metadata=with_metadata)
+
+    def iter_raw_from(self, start: int, with_metadata: bool = True) -> Iterator[RawRecord]:
+        # Entries are split on $$$$ in binary blocks; RDKit parses each molfile
+        # block later, in the workers when running in parallel. Entries before
+        # start are only delimited, not decoded
+        for idx, entry in enumerate(_iter_sdf_entries(self.path, start), start):
+            yield self._raw_entry(idx, entry, with_metadata)
+
+    @staticmethod
+    def _raw_entry(idx: int, entry: bytes, with_metadata: bool) -> RawRecord:
+        """Build a RawRecord from the bytes of one SDF entry."""
+        text = entry.decode("utf-8", errors="replace")
+        if "\r" in text:
+            text = text.replace("\r\n", "\n").replace("\r", "\n")
+
+        # The molfile block ends with its "M  END" line
+        if text.startswith("M  END"):
+            block_end = 0
+        else:
+            block_end = text.find("\nM  END")
+            block_end = block_end + 1 if block_end >= 0 else -1
+        if block_end < 0:
+            block_end = len(text)
+        else:
+            newline = text.find("\n", block_end)
+            block_end = len(text) if newline < 0 else newline + 1
+
+        metadata = _parse_sd_properties(text[block_end:].split("\n")) if with_metadata else None
+        return RawRecord(idx, text[:block_end], "", metadata)
 
     def close(self):
         pass
@@ -241,6 +729,9 @@ class SDFReader(MoleculeReader):
 class ParquetReader(MoleculeReader):
     """Read molecules from Parquet files."""
 
+    supports_raw = True
+    cheap_len = True
+
     def __init__(
         self,
         path: Path | str,
@@ -259,42 +750,70 @@ class ParquetReader(MoleculeReader):
         return self._count
 
     def __iter__(self) -> Iterator[MoleculeRecord]:
+        for raw in self.iter_raw():
+            yield parse_record(*raw)
+
+    def iter_raw(self, with_metadata: bool = True) -> Iterator[RawRecord]:
         import pyarrow.parquet as pq
 
-        # Read in batches for memory efficiency
         parquet_file = pq.ParquetFile(self.path)
 
+        # Only decode the SMILES and name columns unless the rest is needed
+        columns = None
+        if not with_metadata:
+            columns = _projection(
+                parquet_file.schema_arrow.names, self.smiles_column, self.name_column
+            )
+
+        # Read in batches for memory efficiency
         row_idx = 0
-        for batch in parquet_file.iter_batches(batch_size=10000):
-            df = batch.to_pandas()
-
-            for _, row in df.iterrows():
-                smiles = str(row.get(self.smiles_column, ""))
-                name = str(row.get(self.name_column, "")) if self.name_column else ""
-
-                mol = None
-                if smiles:
-                    try:
-                        mol = Chem.MolFromSmiles(smiles)
-                    except Exception:
-                        pass
-
-                if mol is None and smiles:
-                    _warn_parse_failed(row_idx, smiles)
-
-                yield MoleculeRecord(
-                    mol=mol,
-                    smiles=smiles,
-                    name=name,
-                    metadata=row.to_dict(),
-                    row_idx=row_idx,
-                )
-                row_idx += 1
+        for batch in parquet_file.iter_batches(batch_size=10000, columns=columns):
+            yield from _iter_batch_records(
+                batch, row_idx, self.smiles_column, self.name_column, with_metadata
+            )
+            row_idx += batch.num_rows
 
     def close(self):
         pass
 
 
+def _projection(
+    available: list[str],
+    smiles_column: str,
+    name_column: Optional[str],
+) -> Optional[list[str]]:
+    """Columns to decode when row metadata is not needed (None means all)."""
+    columns = [c for c in (smiles_column, name_column) if c and c in available]
+    # An empty selection would read every column; one column is enough for row counts
+    return columns or available[:1] or None
+
+
+def _column_strings(batch, column: Optional[str]) -> list[str]:
+    """Return a RecordBatch column as a list of strings ("" for missing values)."""
+    if not column or column not in batch.schema.names:
+        return [""] * batch.num_rows
+
+    values = batch.column(batch.schema.get_field_index(column)).to_pylist()
+    return ["" if v is None else str(v) for v in values]
+
+
+def _iter_batch_records(
+    batch,
+    start_idx: int,
+    smiles_column: str,
+    name_column: Optional[str],
+    with_metadata: bool,
+) -> Iterator[RawRecord]:
+    """Yield RawRecords from a pyarrow RecordBatch, converting whole columns at once."""
+    smiles_values = _column_strings(batch, smiles_column)
+    name_values = _column_strings(batch, name_column)
+
+    rows = batch.to_pylist() if with_metadata else [None] * batch.num_rows
+
+    for offset, (smiles, name, metadata) in enumerate(zip(smiles_values, name_values, rows)):
+        yield RawRecord(start_idx + offset, smiles, name, metadata)
+
+
 def create_reader(
     path: str | Path,
     format_config: Optional[FormatConfig] = None,
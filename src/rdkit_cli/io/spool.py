@@ -0,0 +1,61 @@
+"""
+Spool files: temporary on-disk sequences of picklable items.
+
+A spool is a concatenation of pickled lists ("chunks"), so it can be
+appended to one chunk at a time and streamed back without loading it
+whole. Used for rows that are written out later (deduplicate, merge, mmp,
+checkpointed processing).
+"""
+
+import pickle
+from pathlib import Path
+from typing import Any, BinaryIO, Iterable, Iterator
+
+# Items per pickled chunk in write_spool
+SPOOL_CHUNK = 1000
+
+# File buffer size for spool files
+SPOOL_BUFFER = 1 << 20
+
+
+def open_spool(path: Path) -> BinaryIO:
+    """Open a spool file for writing (truncating it)."""
+    return open(path, "wb", buffering=SPOOL_BUFFER)
+
+
+def append_chunk(f: BinaryIO, items: list[Any]):
+    """Append one chunk of items to an open spool file."""
+    if items:
+        pickle.dump(items, f, protocol=pickle.HIGHEST_PROTOCOL)
+
+
+def write_spool(path: Path, items: Iterable[Any]) -> int:
+    """
+    Pickle items to a spool file in chunks.
+
+    Returns:
+        Number of items written
+    """
+    n_items = 0
+    with open_spool(path) as f:
+        chunk: list[Any] = []
+        for item in items:
+            chunk.append(item)
+            if len(chunk) >= SPOOL_CHUNK:
+                append_chunk(f, chunk)
+                n_items += len(chunk)
+                chunk = []
+        append_chunk(f, chunk)
+        n_items += len(chunk)
+    return n_items
+
+
+def read_spool(path: Path) -> Iterator[Any]:
+    """Yield items from a spool file."""
+    with open(path, "rb", buffering=SPOOL_BUFFER) as f:
+        while True:
+            try:
+                chunk = pickle.load(f)
+            except EOFError:
+                return
+            yield from chunk
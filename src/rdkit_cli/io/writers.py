@@ -1,5 +1,6 @@
 """File writers for various molecular file formats."""
 
+import re
 from abc import ABC, abstractmethod
 from pathlib import Path
 from typing import Any, Optional
@@ -13,6 +14,9 @@ from rdkit_cli.io.formats import FileFormat, detect_format
 class MoleculeWriter(ABC):
     """Abstract base class for molecule file writers."""
 
+    # Whether write_arrow() is implemented natively (without per-row dicts)
+    supports_arrow: bool = False
+
     @abstractmethod
     def write_row(self, data: dict[str, Any]):
         """Write a single row of data."""
@@ -23,6 +27,15 @@ class MoleculeWriter(ABC):
         """Write a batch of results."""
         pass
 
+    def write_arrow(self, batch):
+        """
+        Write a pyarrow RecordBatch of results.
+
+        The default implementation converts to row dicts; writers with
+        supports_arrow serialize the columns directly.
+        """
+        self.write_batch(batch.to_pylist())
+
     @abstractmethod
     def close(self):
         """Finalize and close the file."""
@@ -38,15 +51,28 @@ class MoleculeWriter(ABC):
 class CSVWriter(MoleculeWriter):
     """Write results to CSV/TSV files."""
 
+    supports_arrow = True
+
     def __init__(
         self,
         path: Path | str,
         delimiter: str = ",",
         columns: Optional[list[str]] = None,
+        null_value: str = "",
     ):
+        """
+        Initialize CSV writer.
+
+        Args:
+            path: Output file path
+            delimiter: Field delimiter
+            columns: Column order for output
+            null_value: Text written for nulls in Arrow batches
+        """
         self.path = Path(path)
         self.delimiter = delimiter
         self.columns = columns
+        self.null_value = null_value
         self._file = open(path, "w", newline="", encoding="utf-8")
         self._header_written = False
         self._column_order: Optional[list[str]] = None
@@ -93,6 +119,91 @@ class CSVWriter(MoleculeWriter):
                 values.append(val)
             self._file.write(self.delimiter.join(values) + "\n")
 
+    def write_arrow(self, batch):
+        """Write a RecordBatch column by column with pyarrow.compute, without per-value Python."""
+        import pyarrow as pa
+        import pyarrow.compute as pc
+
+        n_rows = batch.num_rows
+        if n_rows == 0:
+            return
+
+        if self._column_order is None:
+            self._column_order = self.columns or batch.schema.names
+
+        if not self._header_written:
+            self._file.write(self.delimiter.join(self._column_order) + "\n")
+            self._header_written = True
+
+        names = batch.schema.names
+        formatted = []
+        for col in self._column_order:
+            if col in names:
+                formatted.append(self._format_column(batch.column(names.index(col))))
+            else:
+                formatted.append(pa.repeat("", n_rows))
+
+        lines = pc.binary_join_element_wise(*formatted, self.delimiter)
+        self._file.write("\n".join(lines.to_pylist()) + "\n")
+
+    def _format_column(self, array):
+        """Format one Arrow column as a string array of CSV fields, matching write_batch output."""
+        import pyarrow as pa
+        import pyarrow.compute as pc
+
+        typ = array.type
+
+        if pa.types.is_integer(typ):
+            # Integer formatting is identical in Arrow and Python
+            text = pc.cast(array, pa.string())
+        elif pa.types.is_floating(typ):
+            text = self._format_floats(array)
+        elif pa.types.is_string(typ) or pa.types.is_large_string(typ):
+            text = array
+        else:
+            # Rare types (booleans, lists, ...) use Python's str(), as write_batch does
+            text = pa.array([None if v is None else str(v) for v in array.to_pylist()], pa.string())
+
+        text = pc.fill_null(pc.cast(text, pa.string()), self.null_value)
+
+        # Quote fields holding the delimiter, a quote or a newline
+        special = "[" + re.escape(self.delimiter) + '"\n]'
+        quoted = pc.binary_join_element_wise('"', pc.replace_substring(text, '"', '""'), '"', "")
+        return pc.if_else(pc.match_substring_regex(text, special), quoted, text)
+
+    @staticmethod
+    def _format_floats(array):
+        """
+        Format floats as Python's str() does (nulls kept, NaN as empty).
+
+        Arrow's cast gives the same shortest digits but drops the ".0" of
+        integral values and switches to exponent notation at other
+        magnitudes, so the few values outside [1e-4, 1e16) use str().
+        """
+        import pyarrow as pa
+        import pyarrow.compute as pc
+
+        # Digits of the double value, as str() of to_pylist() values
+        array = pc.cast(array, pa.float64())
+        text = pc.cast(array, pa.string())
+        integral = pc.match_substring_regex(text, r"^-?[0-9]+$")
+        text = pc.if_else(integral, pc.binary_join_element_wise(text, ".0", ""), text)
+
+        magnitude = pc.abs(array)
+        outside = pc.or_(
+            pc.greater_equal(magnitude, 1e16),
+            pc.and_(pc.greater(magnitude, 0.0), pc.less(magnitude, 1e-4)),
+        )
+        outside = pc.and_(pc.fill_null(outside, False), pc.invert(pc.is_nan(array)))
+        indices = pc.indices_nonzero(outside).to_pylist()
+        if indices:
+            values = text.to_pylist()
+            for i in indices:
+                values[i] = str(array[i].as_py())
+            text = pa.array(values, pa.string())
+
+        return pc.if_else(pc.fill_null(pc.is_nan(array), False), "", text)
+
     def close(self):
         """Close the file."""
         if self._file:
@@ -176,18 +287,83 @@ class SDFWriter(MoleculeWriter):
             self._writer = None
 
 
+# Compression codecs accepted by ParquetWriter
+PARQUET_COMPRESSIONS = ["snappy", "zstd", "gzip", "lz4", "brotli", "none"]
+
+# Process-wide Parquet defaults (set from CLI options, see configure_parquet)
+_parquet_compression = "snappy"
+_parquet_row_group_size = 100000
+
+
+def configure_parquet(
+    compression: Optional[str] = None,
+    row_group_size: Optional[int] = None,
+):
+    """
+    Set default Parquet output options for writers created afterwards.
+
+    Args:
+        compression: Compression codec (see PARQUET_COMPRESSIONS)
+        row_group_size: Number of rows per Parquet row group
+    """
+    global _parquet_compression, _parquet_row_group_size
+    if compression is not None:
+        if compression not in PARQUET_COMPRESSIONS:
+            raise ValueError(
+                f"Unknown Parquet compression: {compression}. "
+                f"Available: {', '.join(PARQUET_COMPRESSIONS)}"
+            )
+        _parquet_compression = compression
+    if row_group_size is not None:
+        if row_group_size < 1:
+            raise ValueError("Row group size must be positive")
+        _parquet_row_group_size = row_group_size
+
+
 class ParquetWriter(MoleculeWriter):
-    """Write results to Parquet files."""
+    """
+    Write results to Parquet files.
+
+    Rows are streamed into a single open pyarrow ParquetWriter, one row group
+    per flush, so memory use is bounded by the row group size rather than the
+    output size. The schema is fixed when the first row group is written,
+    from every row buffered until then (types widened, e.g. int to float).
+    Later rows are conformed to it: missing columns become null, and a column
+    the schema does not have is an error, since it cannot be added to an
+    open file. In dict rows, null_value (the calculators' error value) is
+    written as null in columns that are not strings, as in Arrow batches.
+    """
+
+    supports_arrow = True
 
     def __init__(
         self,
         path: Path | str,
         columns: Optional[list[str]] = None,
+        compression: Optional[str] = None,
+        row_group_size: Optional[int] = None,
+        null_value: Optional[str] = None,
     ):
+        """
+        Initialize Parquet writer.
+
+        Args:
+            path: Output file path
+            columns: Column order for output (extra columns follow)
+            compression: Compression codec (default: snappy)
+            row_group_size: Rows per row group (default: 100000)
+            null_value: Text of failed values in dict rows, written as null
+        """
         self.path = Path(path)
         self.columns = columns
+        self.null_value = null_value
+        self.compression = compression or _parquet_compression
+        self._batch_size = row_group_size or _parquet_row_group_size
         self._batches: list[dict[str, Any]] = []
-        self._batch_size = 100000  # Write in batches of 100k
+        self._arrow_batches: list = []
+        self._arrow_rows = 0
+        self._writer = None
+        self._schema = None
 
     def write_row(self, data: dict[str, Any]):
         """Write a single row."""
@@ -204,38 +380,188 @@ class ParquetWriter(MoleculeWriter):
             clean_data = {k: v for k, v in row.items() if k != "mol"}
             self._batches.append(clean_data)
 
-        if len(self._batches) >= self._batch_size:
+        while len(self._batches) >= self._batch_size:
             self._flush()
 
-    def _flush(self):
-        """Write accumulated batches to file."""
-        if not self._batches:
+    def write_arrow(self, batch):
+        """Write a RecordBatch, buffering until a full row group is available."""
+        if batch.num_rows == 0:
             return
 
         import pyarrow as pa
-        import pyarrow.parquet as pq
 
-        df = pd.DataFrame(self._batches)
+        # Keep output order when dict rows are pending
+        while self._batches:
+            self._flush()
+
+        # Until the first row group is written, batches are kept as they
+        # come, and the schema is unified across them at the first flush
+        table = pa.Table.from_batches([batch])
+        self._arrow_batches.append(table if self._writer is None else self._conform(table))
+        self._arrow_rows += batch.num_rows
+
+        if self._arrow_rows >= self._batch_size:
+            self._flush_arrow(final=False)
+
+    def _build_schema(self, schema):
+        """Derive the file schema from the first row group's schema."""
+        import pyarrow as pa
 
         # Reorder columns if specified
+        names = schema.names
         if self.columns:
-            cols = [c for c in self.columns if c in df.columns]
-            extra = [c for c in df.columns if c not in self.columns]
-            df = df[cols + extra]
+            cols = [c for c in self.columns if c in names]
+            extra = [c for c in names if c not in self.columns]
+            names = cols + extra
+
+        # All-null columns in the first group would otherwise lock in a null type
+        fields = []
+        for name in names:
+            field = schema.field(name)
+            if pa.types.is_null(field.type):
+                field = field.with_type(pa.string())
+            fields.append(field)
+
+        return pa.schema(fields)
+
+    def _open(self, schema):
+        """Fix the file schema and open the underlying ParquetWriter."""
+        import pyarrow.parquet as pq
+
+        self._schema = self._build_schema(schema)
+        self._writer = pq.ParquetWriter(
+            self.path,
+            self._schema,
+            compression=self.compression,
+        )
+
+    def _check_columns(self, names: list[str]):
+        """Raise if a later row group has columns the file schema does not have."""
+        unknown = [name for name in names if name not in self._schema.names]
+        if unknown:
+            raise ValueError(
+                f"Column(s) {', '.join(unknown)} first appear after the first Parquet row "
+                f"group ({self._batch_size} rows) and cannot be added to the file schema; "
+                f"use a larger --row-group-size or CSV output"
+            )
+
+    def _conform(self, table):
+        """Select, order and cast a table's columns to match the file schema."""
+        import pyarrow as pa
+
+        self._check_columns(table.schema.names)
+        arrays = []
+        for field in self._schema:
+            if field.name in table.schema.names:
+                column = table.column(field.name)
+                if column.type != field.type:
+                    try:
+                        column = column.cast(field.type)
+                    except (pa.ArrowInvalid, pa.ArrowNotImplementedError) as e:
+                        raise ValueError(
+                            f"Column '{field.name}' values do not fit type {field.type}, fixed "
+                            f"by the first Parquet row group ({self._batch_size} rows); use a "
+                            f"larger --row-group-size: {e}"
+                        ) from e
+                arrays.append(column)
+            else:
+                arrays.append(pa.nulls(table.num_rows, field.type))
+        return pa.Table.from_arrays(arrays, schema=self._schema)
+
+    def _column_array(self, name: str, values: list[Any], type=None):
+        """Convert one column of dict rows (null_value is null in columns that are not strings)."""
+        import pyarrow as pa
+
+        try:
+            return pa.array(values, type=type)
+        except (pa.ArrowInvalid, pa.ArrowTypeError):
+            pass
+
+        if type is not None and pa.types.is_string(type):
+            # Values of a column that was empty or text in the first row group
+            return pa.array([None if v is None else str(v) for v in values], type=type)
+
+        if self.null_value is not None:
+            values = [None if isinstance(v, str) and v == self.null_value else v for v in values]
+        try:
+            return pa.array(values, type=type)
+        except (pa.ArrowInvalid, pa.ArrowTypeError) as e:
+            if type is None:
+                raise ValueError(f"Column '{name}' values do not fit one Parquet type: {e}") from e
+            raise ValueError(
+                f"Column '{name}' values do not fit type {type}, fixed by the first Parquet "
+                f"row group ({self._batch_size} rows); use a larger --row-group-size: {e}"
+            ) from e
+
+    def _to_table(self, rows: list[dict[str, Any]]):
+        """Convert rows to a table, matching the file schema once it is fixed."""
+        import pyarrow as pa
+
+        # Every key of every row, in first-seen order
+        names = list(dict.fromkeys(key for row in rows for key in row))
+        if self._schema is None:
+            arrays = [self._column_array(name, [row.get(name) for row in rows]) for name in names]
+            return pa.Table.from_arrays(arrays, names=names)
+
+        self._check_columns(names)
+        arrays = [
+            self._column_array(field.name, [row.get(field.name) for row in rows], field.type)
+            for field in self._schema
+        ]
+        return pa.Table.from_arrays(arrays, schema=self._schema)
+
+    def _flush_arrow(self, final: bool):
+        """Write buffered Arrow data as full row groups (and the remainder if final)."""
+        if not self._arrow_batches:
+            return
+
+        import pyarrow as pa
+
+        if self._writer is None:
+            schema = pa.unify_schemas(
+                [table.schema for table in self._arrow_batches], promote_options="permissive"
+            )
+            self._open(schema)
+            self._arrow_batches = [self._conform(table) for table in self._arrow_batches]
+
+        table = pa.concat_tables(self._arrow_batches)
+        n_write = table.num_rows if final else (table.num_rows // self._batch_size) * self._batch_size
+
+        if n_write:
+            self._writer.write_table(table.slice(0, n_write), row_group_size=self._batch_size)
+
+        remainder = table.slice(n_write)
+        self._arrow_batches = [remainder] if remainder.num_rows else []
+        self._arrow_rows = remainder.num_rows
+
+    def _flush(self):
+        """Write accumulated rows (up to one row group) to file."""
+        if not self._batches:
+            return
 
-        table = pa.Table.from_pandas(df, preserve_index=False)
+        # Keep output order when Arrow batches are pending
+        self._flush_arrow(final=True)
 
-        if self.path.exists():
-            # Append to existing file
-            existing = pq.read_table(self.path)
-            table = pa.concat_tables([existing, table])
+        rows = self._batches[:self._batch_size]
+        self._batches = self._batches[self._batch_size:]
 
-        pq.write_table(table, self.path)
-        self._batches = []
+        table = self._to_table(rows)
+        if self._writer is None:
+            self._open(table.schema)
+            table = self._conform(table)
+        self._writer.write_table(table, row_group_size=self._batch_size)
 
     def close(self):
         """Finalize and close the file."""
-        self._flush()
+        try:
+            while self._batches:
+                self._flush()
+            self._flush_arrow(final=True)
+        finally:
+            # Row groups already written stay readable if a flush fails
+            if self._writer is not None:
+                self._writer.close()
+                self._writer = None
 
 
 def create_writer(
@@ -244,6 +570,9 @@ def create_writer(
     columns: Optional[list[str]] = None,
     smiles_column: str = "smiles",
     name_column: Optional[str] = "name",
+    compression: Optional[str] = None,
+    row_group_size: Optional[int] = None,
+    null_value: str = "",
 ) -> MoleculeWriter:
     """
     Factory function to create appropriate writer.
@@ -254,6 +583,10 @@ def create_writer(
         columns: Column order for output
         smiles_column: Name of SMILES column (for SMI files)
         name_column: Name of name column (for SMI files)
+        compression: Compression codec (for Parquet files)
+        row_group_size: Rows per row group (for Parquet files)
+        null_value: Text for nulls in Arrow batches (for CSV/TSV files), read
+            as null in non-string columns of dict rows (for Parquet files)
 
     Returns:
         Appropriate MoleculeWriter instance
@@ -262,14 +595,20 @@ def create_writer(
     file_format = format_override or detect_format(path)
 
     if file_format == FileFormat.CSV:
-        return CSVWriter(path, delimiter=",", columns=columns)
+        return CSVWriter(path, delimiter=",", columns=columns, null_value=null_value)
     elif file_format == FileFormat.TSV:
-        return CSVWriter(path, delimiter="\t", columns=columns)
+        return CSVWriter(path, delimiter="\t", columns=columns, null_value=null_value)
     elif file_format == FileFormat.SMI:
         return SMIWriter(path, smiles_column=smiles_column, name_column=name_column)
     elif file_format == FileFormat.SDF:
         return SDFWriter(path)
     elif file_format == FileFormat.PARQUET:
-        return ParquetWriter(path, columns=columns)
+        return ParquetWriter(
+            path,
+            columns=columns,
+            compression=compression,
+            row_group_size=row_group_size,
+            null_value=null_value,
+        )
     else:
         raise ValueError(f"Unsupported format: {file_format}")
@@ -1,12 +1,21 @@
 """Batch processing utilities."""
 
-from dataclasses import dataclass
-from typing import Callable, Any, Optional
-
-from rdkit_cli.io.readers import MoleculeReader, MoleculeRecord
+from collections import Counter
+from contextlib import nullcontext
+from dataclasses import dataclass, field
+from itertools import islice
+from typing import Callable, Any, Iterable, Iterator, Optional
+
+from rdkit_cli.core.results import Rejected
+from rdkit_cli.io.readers import MoleculeReader, MoleculeRecord, RawRecord, parse_record
 from rdkit_cli.io.writers import MoleculeWriter
 from rdkit_cli.progress.ninja import NinjaProgress
+from rdkit_cli.parallel.cache import cache_namespace, cached_processor
+from rdkit_cli.parallel.checkpoint import Checkpoint, open_checkpoint
 from rdkit_cli.parallel.executor import ParallelExecutor
+from rdkit_cli.parallel.pipeline import MoleculePipeline
+from rdkit_cli.parallel.profile import ProfiledTask, ProfiledWriter, open_profile
+from rdkit_cli.parallel.shard import active_shard
 
 
 @dataclass
@@ -17,6 +26,99 @@ class BatchResult:
     successful: int
     failed: int
     elapsed_time: float
+    # Failed records per reason, for processors returning Rejected
+    rejected: dict[str, int] = field(default_factory=dict)
+
+
+def _split_raw(raw: RawRecord) -> tuple[tuple[int, str, str], Optional[dict[str, Any]]]:
+    """Split a raw row into the worker task and the parent-side metadata."""
+    return (raw.row_idx, raw.smiles, raw.name), raw.metadata
+
+
+def _split_record(record: MoleculeRecord) -> tuple[MoleculeRecord, Optional[dict[str, Any]]]:
+    """Split a parsed record into a metadata-free worker task and the parent-side metadata."""
+    task = MoleculeRecord(record.mol, record.smiles, record.name, row_idx=record.row_idx)
+    return task, record.metadata
+
+
+class _ParseAndProcess:
+    """Worker-side wrapper that parses a raw (row_idx, smiles, name) row before processing."""
+
+    def __init__(
+        self,
+        processor: Callable[[MoleculeRecord], Optional[dict[str, Any]]],
+        parse: Callable[..., MoleculeRecord] = parse_record,
+    ):
+        self.processor = processor
+        self.parse = parse
+
+    def __call__(self, raw: tuple[int, str, str]) -> Optional[dict[str, Any]]:
+        row_idx, smiles, name = raw
+        return self.processor(self.parse(row_idx, smiles, name))
+
+
+class _BatchTask:
+    """Worker-side wrapper that runs a batch processor over a whole chunk."""
+
+    def __init__(
+        self,
+        batch_processor: Callable[[list[MoleculeRecord]], Any],
+        parse: Optional[Callable[..., MoleculeRecord]] = None,
+    ):
+        self.batch_processor = batch_processor
+        self.parse = parse
+
+    def __call__(self, items: list[Any]) -> Any:
+        if self.parse is not None:
+            items = [self.parse(row_idx, smiles, name) for row_idx, smiles, name in items]
+        return self.batch_processor(items)
+
+
+def _processor_id(processor: Callable) -> str:
+    """Describe a processor for checkpoint manifests (its cache namespace when it has one)."""
+    namespace = cache_namespace(processor)
+    if namespace is not None:
+        return namespace
+    name = getattr(processor, "__qualname__", type(processor).__qualname__)
+    return f"{getattr(processor, '__module__', '')}.{name}"
+
+
+def _run_checkpointed(
+    checkpoint: Checkpoint,
+    items: Iterator[Any],
+    writer: MoleculeWriter,
+    run_segment: Callable[[Iterable[Any], MoleculeWriter], tuple[int, int, Counter]],
+) -> tuple[int, int, Counter]:
+    """
+    Process items in checkpointed segments, then replay all parts into writer.
+
+    Items already covered by the checkpoint's manifest are skipped unparsed.
+
+    Returns:
+        Tuple of (successful, failed, rejected) counts over the whole run
+    """
+    if not checkpoint.complete:
+        remaining = islice(items, checkpoint.rows_done, None)
+        while True:
+            part = checkpoint.part_writer(supports_arrow=writer.supports_arrow)
+            try:
+                successful, failed, rejected = run_segment(islice(remaining, checkpoint.rows), part)
+            except BaseException:
+                part.close()
+                raise
+
+            n_rows = successful + failed
+            if n_rows == 0:
+                part.close()
+                part.path.unlink()
+                break
+            checkpoint.commit(part, n_rows, successful, failed, rejected)
+            if n_rows < checkpoint.rows:
+                break
+        checkpoint.finish()
+
+    checkpoint.replay(writer)
+    return checkpoint.successful, checkpoint.failed, checkpoint.rejected
 
 
 def process_molecules(
@@ -26,97 +128,243 @@ def process_molecules(
     n_workers: int = -1,
     quiet: bool = False,
     batch_size: int = 1000,
+    parse_in_workers: bool = True,
+    join_metadata: bool = False,
+    batch_processor: Optional[Callable[[list[MoleculeRecord]], Any]] = None,
+    cost: Optional[Callable[[MoleculeRecord], float]] = None,
 ) -> BatchResult:
     """
     Process molecules from reader through processor and write to writer.
 
     This is the main batch processing function used by most commands.
 
+    In parallel mode with a reader supporting raw rows, only (row_idx, smiles,
+    name) is sent to the workers, which parse the molecule themselves (for
+    SDF, the molfile block is sent and SMILES are generated there). Row
+    metadata never leaves the parent; with join_metadata, parsed records
+    are sent without it as well, and it is merged back into each result
+    (without overriding keys the processor set), on every path, so
+    processors need not copy it themselves. Without
+    join_metadata, such readers only decode the SMILES and name columns, in
+    sequential mode as well.
+
+    If batch_processor is given and the writer supports Arrow batches, whole
+    chunks are processed at once into pyarrow RecordBatches and written
+    columnar, bypassing per-row dicts. Metadata is not joined on this path.
+
     Args:
         reader: MoleculeReader to read from
         writer: MoleculeWriter to write to
         processor: Function that takes MoleculeRecord and returns dict or None
         n_workers: Number of worker processes (-1 for all)
         quiet: Suppress progress output
-        batch_size: Number of records to process in each batch
+        batch_size: Maximum number of records per worker task
+        parse_in_workers: Parse molecules in workers when the reader supports it
+        join_metadata: Merge input row metadata into results in the parent
+        batch_processor: Optional columnar equivalent of processor, taking a
+            list of MoleculeRecords and returning a RecordBatch of the
+            successful rows
+        cost: Optional estimate of a record's processing time; in parallel
+            mode records are then parsed in the parent and dispatched one
+            per task, costliest first within each window (see
+            MoleculePipeline), which keeps a few slow molecules from
+            finishing last on an otherwise idle pool
+
+    A processor may return Rejected(reason) instead of None; such records
+    count as failed and are tallied per reason in BatchResult.rejected.
+
+    With a result cache configured (--cache) and a processor that supports
+    it, results are looked up per molecule and only misses are computed;
+    the row path is used then, since hits and misses are merged per record.
+
+    With a shard configured (--shard), only that shard's row range is
+    processed; rows outside it are skipped before parsing. With a checkpoint
+    configured (--checkpoint), rows are processed in segments recorded in
+    the checkpoint's manifest, and an interrupted run resumes after the
+    last recorded segment (see parallel.checkpoint). With a profile
+    configured (--profile), per-stage timings, worker utilization, queue
+    depths and the slowest molecules are reported (see parallel.profile).
 
     Returns:
         BatchResult with processing statistics
     """
-    total = len(reader)
-    progress = NinjaProgress(total=total, quiet=quiet)
-
-    successful = 0
-    failed = 0
-    write_buffer: list[dict[str, Any]] = []
-    write_buffer_size = 1000
+    processor_id = _processor_id(processor)
+    cached = cached_processor(processor)
+    if cached is not None:
+        processor = cached
+        batch_processor = None
+
+    progress = NinjaProgress.for_reader(reader, quiet=quiet)
+    columnar = batch_processor is not None and writer.supports_arrow
+
+    # Raw readers skip decoding columns no result will use; in parallel mode
+    # raw rows are only used when the workers parse them
+    use_raw = reader.supports_raw and (n_workers == 1 or (parse_in_workers and cost is None))
+    with_metadata = join_metadata and not columnar
+
+    shard = active_shard()
+    if shard is None:
+        items = reader.iter_raw(with_metadata=with_metadata) if use_raw else iter(reader)
+    else:
+        start, stop = shard.row_range(len(reader))
+        if use_raw:
+            # Raw readers can skip to the shard's first row without building rows
+            items = islice(reader.iter_raw_from(start, with_metadata=with_metadata), stop - start)
+        else:
+            items = islice(reader, start, stop)
+        progress.set_total(stop - start, exact=True)
 
-    progress.start()
+    checkpoint = open_checkpoint(getattr(reader, "path", None), processor_id, shard)
+    if checkpoint is not None:
+        progress.set_total(max(0, progress.total - checkpoint.rows_done))
 
-    try:
-        if n_workers == 1:
-            # Sequential processing
-            for record in reader:
-                result = processor(record)
-                if result is not None:
-                    write_buffer.append(result)
-                    successful += 1
-                else:
-                    failed += 1
+    total = progress.total
+    write_buffer_size = 1000
 
-                progress.update()
+    profile = open_profile(processor_id)
+    compute = processor
+    compute_batch = batch_processor
+    if profile is not None:
+        timed_processor = ProfiledTask(processor)
+        compute = lambda record: profile.unwrap(timed_processor(record))
+        if columnar:
+            timed_batch = ProfiledTask(batch_processor)
+            compute_batch = lambda chunk: profile.unwrap(timed_batch(chunk))
+
+    def run_sequential(records: Iterable[MoleculeRecord], out: MoleculeWriter) -> tuple[int, int, Counter]:
+        successful = 0
+        failed = 0
+        rejected: Counter = Counter()
+        if profile is not None:
+            out = ProfiledWriter(out, profile)
+
+        if columnar:
+            chunk: list[MoleculeRecord] = []
+            for record in records:
+                chunk.append(record)
+                if len(chunk) >= batch_size:
+                    batch = compute_batch(chunk)
+                    out.write_arrow(batch)
+                    successful += batch.num_rows
+                    failed += len(chunk) - batch.num_rows
+                    progress.update(len(chunk))
+                    chunk = []
+            if chunk:
+                batch = compute_batch(chunk)
+                out.write_arrow(batch)
+                successful += batch.num_rows
+                failed += len(chunk) - batch.num_rows
+                progress.update(len(chunk))
+            return successful, failed, rejected
+
+        write_buffer: list[dict[str, Any]] = []
+        for record in records:
+            result = compute(record)
+            if isinstance(result, Rejected):
+                rejected[result.reason] += 1
+                failed += 1
+            elif result is not None:
+                if join_metadata and record.metadata:
+                    for key, value in record.metadata.items():
+                        result.setdefault(key, value)
+                write_buffer.append(result)
+                successful += 1
+            else:
+                failed += 1
+
+            progress.update()
+
+            if len(write_buffer) >= write_buffer_size:
+                out.write_batch(write_buffer)
+                write_buffer = []
 
-                if len(write_buffer) >= write_buffer_size:
-                    writer.write_batch(write_buffer)
-                    write_buffer = []
+        if write_buffer:
+            out.write_batch(write_buffer)
+        return successful, failed, rejected
+
+    if n_workers == 1:
+        executor_context = nullcontext()
+        parse = reader.raw_parser if use_raw else None
+        if profile is not None:
+            items = profile.timed_iter("read", items)
+            if parse is not None:
+                parse = profile.timed("parse", parse)
+        stream = (parse(*raw) for raw in items) if parse is not None else items
+    else:
+        if columnar:
+            task = _BatchTask(batch_processor, parse=reader.raw_parser if use_raw else None)
+            if profile is not None:
+                task = ProfiledTask(task)
+        elif profile is not None:
+            # Times parse and compute separately in the workers
+            task = ProfiledTask(processor, parse=reader.raw_parser if use_raw else None)
+        elif use_raw:
+            task = _ParseAndProcess(processor, parse=reader.raw_parser)
         else:
-            # Parallel processing - collect batch, process in parallel, write
-            executor = ParallelExecutor(processor, n_workers=n_workers)
-            batch: list[MoleculeRecord] = []
+            task = processor
+        executor_context = ParallelExecutor(task, n_workers=n_workers)
+        stream = items
+        if use_raw:
+            split_item = _split_raw
+        elif join_metadata and not columnar:
+            split_item = _split_record
+        else:
+            split_item = None
 
-            for record in reader:
-                batch.append(record)
-
-                if len(batch) >= batch_size:
-                    # Process batch in parallel
-                    results = executor.map_ordered(batch)
-                    for result in results:
-                        if result is not None:
-                            write_buffer.append(result)
-                            successful += 1
-                        else:
-                            failed += 1
-                        progress.update()
-
-                    if len(write_buffer) >= write_buffer_size:
-                        writer.write_batch(write_buffer)
-                        write_buffer = []
-
-                    batch = []
-
-            # Process remaining batch
-            if batch:
-                results = executor.map_ordered(batch)
-                for result in results:
-                    if result is not None:
-                        write_buffer.append(result)
-                        successful += 1
-                    else:
-                        failed += 1
-                    progress.update()
+    successful = failed = 0
+    if profile is not None:
+        profile.start()
+    progress.start()
 
-        # Write remaining buffer
-        if write_buffer:
-            writer.write_batch(write_buffer)
+    try:
+        # In parallel mode reading, computing and writing overlap, and one
+        # worker pool serves the whole run, across checkpoint segments
+        with executor_context as executor:
+            if executor is None:
+                run_segment = run_sequential
+            else:
+                if profile is not None:
+                    profile.n_workers = executor.n_workers
+
+                # Give each worker several chunks even on small inputs
+                chunk_size = min(batch_size, max(1, total // (executor.n_workers * 4)))
+
+                def run_segment(segment: Iterable[Any], out: MoleculeWriter) -> tuple[int, int, Counter]:
+                    if profile is not None:
+                        out = ProfiledWriter(out, profile)
+                    pipeline = MoleculePipeline(
+                        executor,
+                        out,
+                        progress,
+                        chunk_size=chunk_size,
+                        write_buffer_size=write_buffer_size,
+                        split_item=split_item,
+                        columnar=columnar,
+                        sort_key=None if columnar else cost,
+                        profile=profile,
+                    )
+                    successful, failed = pipeline.run(segment)
+                    return successful, failed, pipeline.rejected
+
+            if checkpoint is None:
+                successful, failed, rejected = run_segment(stream, writer)
+            else:
+                successful, failed, rejected = _run_checkpointed(checkpoint, stream, writer, run_segment)
 
     finally:
         progress.finish()
+        if profile is not None:
+            profile.finish(successful, failed)
+        if cached is not None:
+            # Workers write their buffered entries when the pool shuts down
+            cached.cache.close()
 
     return BatchResult(
-        total_processed=total,
+        total_processed=successful + failed,
         successful=successful,
         failed=failed,
         elapsed_time=progress.elapsed_time,
+        rejected=dict(rejected),
     )
 
 
@@ -138,8 +386,7 @@ def process_molecules_simple(
     Returns:
         Tuple of (results list, BatchResult)
     """
-    total = len(reader)
-    progress = NinjaProgress(total=total, quiet=quiet)
+    progress = NinjaProgress.for_reader(reader, quiet=quiet)
 
     results: list[dict[str, Any]] = []
     successful = 0
@@ -158,23 +405,23 @@ def process_molecules_simple(
                     failed += 1
                 progress.update()
         else:
-            executor = ParallelExecutor(processor, n_workers=n_workers)
             records = list(reader)
-            progress.set_total(len(records))
+            progress.set_total(len(records), exact=True)
 
-            for result in executor.map_ordered(records):
-                if result is not None:
-                    results.append(result)
-                    successful += 1
-                else:
-                    failed += 1
-                progress.update()
+            with ParallelExecutor(processor, n_workers=n_workers) as executor:
+                for result in executor.map_ordered(records):
+                    if result is not None:
+                        results.append(result)
+                        successful += 1
+                    else:
+                        failed += 1
+                    progress.update()
 
     finally:
         progress.finish()
 
     return results, BatchResult(
-        total_processed=total,
+        total_processed=successful + failed,
         successful=successful,
         failed=failed,
         elapsed_time=progress.elapsed_time,
@@ -0,0 +1,254 @@
+"""
+Content-addressed on-disk cache of per-molecule results.
+
+Results are keyed by a hash of the canonical SMILES and the calculator
+configuration, so re-running a command over a mostly unchanged library only
+computes the molecules that changed. Calculators opt in by providing a
+cache_key() method describing every option that affects their output.
+Calculators whose output depends on the input conformer (3D descriptors)
+also set uses_coordinates, and molecules with coordinates are then keyed by
+those as well.
+
+The cache is one SQLite database per directory, opened in WAL mode so worker
+processes can look up and store results concurrently. Each process buffers
+its new entries and writes them in batches, one transaction per batch, so
+workers do not queue on the write lock once per molecule.
+"""
+
+import hashlib
+import pickle
+import sqlite3
+from multiprocessing import util
+from pathlib import Path
+from typing import Any, Callable, Optional
+
+from rdkit import Chem
+
+from rdkit_cli.io.readers import MoleculeRecord
+
+CACHE_FILENAME = "results.sqlite"
+
+# Output keys filled from the input record rather than cached
+_IDENTITY_KEYS = ("smiles", "name")
+
+# Buffered entries are written in transactions of this many
+PUT_BATCH_SIZE = 256
+
+# Process-wide cache directory (set from CLI options, see configure_cache)
+_cache_dir: Optional[Path] = None
+
+
+def configure_cache(directory: Optional[str | Path]):
+    """
+    Enable the result cache for processors created afterwards.
+
+    Args:
+        directory: Cache directory (created if missing), or None to disable
+    """
+    global _cache_dir
+    if directory is None:
+        _cache_dir = None
+        return
+    path = Path(directory)
+    path.mkdir(parents=True, exist_ok=True)
+    _cache_dir = path
+
+
+def _processor_owner(processor: Callable) -> Any:
+    """Return the calculator a bound compute method belongs to."""
+    return getattr(processor, "__self__", processor)
+
+
+def molecule_key(mol: Chem.Mol, with_coordinates: bool = False) -> str:
+    """
+    Cache key text of a molecule: its canonical SMILES.
+
+    With with_coordinates, a molecule having a conformer is keyed by its
+    coordinates as well (in canonical atom order, rounded to 1e-4 A), so
+    another conformation of the same molecule is a different entry.
+    """
+    smiles = Chem.MolToSmiles(mol)
+    if not with_coordinates or mol.GetNumConformers() == 0:
+        return smiles
+
+    conf = mol.GetConformer()
+    order = mol.GetProp("_smilesAtomOutputOrder").strip("[]").split(",")
+    positions = []
+    for idx in order:
+        if idx:
+            point = conf.GetAtomPosition(int(idx))
+            positions.append(f"{point.x:.4f},{point.y:.4f},{point.z:.4f}")
+    digest = hashlib.blake2b(";".join(positions).encode(), digest_size=16).hexdigest()
+    return f"{smiles}\0{digest}"
+
+
+def cache_namespace(processor: Callable) -> Optional[str]:
+    """
+    Describe a processor's configuration for cache keys.
+
+    Returns:
+        Namespace string, or None if the processor does not support caching
+    """
+    owner = _processor_owner(processor)
+    cache_key = getattr(owner, "cache_key", None)
+    if cache_key is None:
+        return None
+
+    from rdkit import __version__ as rdkit_version
+
+    from rdkit_cli import __version__
+
+    name = getattr(processor, "__name__", "")
+    return f"{type(owner).__name__}.{name}|{cache_key()}|rdkit={rdkit_version}|rdkit-cli={__version__}"
+
+
+class ResultCache:
+    """SQLite-backed map from (namespace, canonical SMILES) to result values."""
+
+    def __init__(self, directory: str | Path, namespace: str):
+        """
+        Initialize cache.
+
+        Args:
+            directory: Cache directory
+            namespace: Calculator configuration (see cache_namespace)
+        """
+        self.path = Path(directory) / CACHE_FILENAME
+        self.namespace = namespace
+        self._conn: Optional[sqlite3.Connection] = None
+        # Entries not yet written, by key
+        self._pending: dict[bytes, bytes] = {}
+        self._finalizer: Optional[util.Finalize] = None
+
+    def __getstate__(self):
+        # Each worker process opens its own connection and buffer
+        state = self.__dict__.copy()
+        state["_conn"] = None
+        state["_pending"] = {}
+        state["_finalizer"] = None
+        return state
+
+    @property
+    def conn(self) -> sqlite3.Connection:
+        if self._conn is None:
+            self._conn = sqlite3.connect(str(self.path), timeout=60.0, isolation_level=None)
+            self._conn.execute("PRAGMA journal_mode=WAL")
+            self._conn.execute("PRAGMA synchronous=NORMAL")
+            self._conn.execute(
+                "CREATE TABLE IF NOT EXISTS results (key BLOB PRIMARY KEY, value BLOB NOT NULL)"
+            )
+        return self._conn
+
+    def key(self, canonical_smiles: str) -> bytes:
+        """Cache key of a molecule under this namespace."""
+        return hashlib.sha256(f"{self.namespace}\0{canonical_smiles}".encode()).digest()
+
+    def get(self, key: bytes) -> Optional[dict[str, Any]]:
+        """Look up cached values, or None on a miss."""
+        value = self._pending.get(key)
+        if value is None:
+            row = self.conn.execute("SELECT value FROM results WHERE key = ?", (key,)).fetchone()
+            if row is None:
+                return None
+            value = row[0]
+        return pickle.loads(value)
+
+    def put(self, key: bytes, values: dict[str, Any]):
+        """
+        Store values (overwriting any previous entry).
+
+        Entries are buffered and written every PUT_BATCH_SIZE puts, on
+        flush() or close(), and when the process exits (worker processes
+        included).
+        """
+        self._pending[key] = pickle.dumps(values, protocol=pickle.HIGHEST_PROTOCOL)
+        if self._finalizer is None:
+            # Registered until close(); runs at exit, also in worker processes
+            self._finalizer = util.Finalize(None, self.close, exitpriority=10)
+        if len(self._pending) >= PUT_BATCH_SIZE:
+            self.flush()
+
+    def flush(self):
+        """Write buffered entries in one transaction."""
+        if not self._pending:
+            return
+        conn = self.conn
+        conn.execute("BEGIN IMMEDIATE")
+        try:
+            conn.executemany(
+                "INSERT OR REPLACE INTO results (key, value) VALUES (?, ?)",
+                self._pending.items(),
+            )
+        except BaseException:
+            conn.execute("ROLLBACK")
+            raise
+        conn.execute("COMMIT")
+        self._pending.clear()
+
+    def close(self):
+        """Write buffered entries and close the connection."""
+        self.flush()
+        if self._finalizer is not None:
+            self._finalizer.cancel()
+            self._finalizer = None
+        if self._conn is not None:
+            self._conn.close()
+            self._conn = None
+
+
+class CachedProcessor:
+    """
+    Processor wrapper that serves results from a ResultCache.
+
+    Hits skip the wrapped processor; the SMILES and name columns are taken
+    from the input record, as the calculator would. Misses are computed and
+    stored. Failed results (None) are not cached.
+    """
+
+    def __init__(self, processor: Callable[[MoleculeRecord], Optional[dict[str, Any]]], cache: ResultCache):
+        self.processor = processor
+        self.cache = cache
+        owner = _processor_owner(processor)
+        self.include_smiles = getattr(owner, "include_smiles", True)
+        self.include_name = getattr(owner, "include_name", True)
+        self.uses_coordinates = getattr(owner, "uses_coordinates", False)
+
+    def __call__(self, record: MoleculeRecord) -> Optional[dict[str, Any]]:
+        if record.mol is None:
+            return self.processor(record)
+
+        try:
+            key = self.cache.key(molecule_key(record.mol, self.uses_coordinates))
+        except Exception:
+            return self.processor(record)
+
+        values = self.cache.get(key)
+        if values is None:
+            result = self.processor(record)
+            if result is not None:
+                self.cache.put(key, {k: v for k, v in result.items() if k not in _IDENTITY_KEYS})
+            return result
+
+        result: dict[str, Any] = {}
+        if self.include_smiles:
+            result["smiles"] = record.smiles
+        if self.include_name:
+            result["name"] = record.name
+        result.update(values)
+        return result
+
+
+def cached_processor(processor: Callable) -> Optional[CachedProcessor]:
+    """
+    Wrap a processor with the configured cache.
+
+    Returns:
+        CachedProcessor, or None if no cache is configured or the processor
+        does not support caching
+    """
+    if _cache_dir is None:
+        return None
+    namespace = cache_namespace(processor)
+    if namespace is None:
+        return None
+    return CachedProcessor(processor, ResultCache(_cache_dir, namespace))
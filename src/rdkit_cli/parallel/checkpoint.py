@@ -0,0 +1,292 @@
+"""
+Checkpointed execution: resume process_molecules after an interruption.
+
+With --checkpoint DIR, results are written in segments of a fixed number
+of input rows. Each finished segment is stored as a part file (a spool of
+row batches or Arrow batches) and recorded in a JSON manifest, replaced
+atomically so it always describes complete parts only. A rerun of the same
+command skips the rows covered by the manifest, processes the rest, then
+replays every part into the real output. Parts are kept, so rerunning a
+finished job only rewrites the output.
+
+The manifest records the input file (path, size, modification time), the
+shard, the processor configuration and the command options; resuming with
+any of them changed is refused rather than mixing results.
+"""
+
+import json
+import os
+from collections import Counter
+from pathlib import Path
+from typing import Any, Iterator, Optional
+
+from rdkit_cli.io.spool import append_chunk, open_spool, read_spool
+from rdkit_cli.io.writers import MoleculeWriter
+from rdkit_cli.parallel.shard import Shard
+
+MANIFEST_VERSION = 1
+
+# Default input rows per checkpointed segment
+DEFAULT_CHECKPOINT_ROWS = 10000
+
+
+class SpoolWriter(MoleculeWriter):
+    """
+    Writer storing batches in a spool file, for replay into another writer.
+
+    Mirrors the Arrow support of the writer it stands in for, so columnar
+    processors keep producing RecordBatches.
+    """
+
+    def __init__(self, path: Path, supports_arrow: bool = False):
+        self.path = Path(path)
+        self.supports_arrow = supports_arrow
+        self._file = open_spool(self.path)
+
+    def write_row(self, data: dict[str, Any]):
+        self.write_batch([data])
+
+    def write_batch(self, data: list[dict[str, Any]]):
+        if data:
+            append_chunk(self._file, [("rows", list(data))])
+
+    def write_arrow(self, batch):
+        if batch.num_rows:
+            append_chunk(self._file, [("arrow", batch)])
+
+    def close(self):
+        """Flush the spool to stable storage and close it."""
+        if not self._file.closed:
+            self._file.flush()
+            os.fsync(self._file.fileno())
+            self._file.close()
+
+
+def replay_spool(path: Path, writer: MoleculeWriter):
+    """Write the batches stored by a SpoolWriter to another writer."""
+    for kind, data in read_spool(path):
+        if kind == "arrow":
+            writer.write_arrow(data)
+        else:
+            writer.write_batch(data)
+
+
+def _write_json_atomic(path: Path, data: dict[str, Any]):
+    """Replace a JSON file so readers see the old or new content, never a mix."""
+    tmp_path = path.with_name(path.name + ".tmp")
+    with open(tmp_path, "w") as f:
+        json.dump(data, f, indent=2)
+        f.flush()
+        os.fsync(f.fileno())
+    os.replace(tmp_path, path)
+
+
+def input_identity(path: Optional[Path]) -> Optional[dict[str, Any]]:
+    """Describe an input file so changes to it are detected on resume."""
+    if path is None:
+        return None
+    stat = Path(path).stat()
+    return {
+        "path": str(Path(path).resolve()),
+        "size": stat.st_size,
+        "mtime_ns": stat.st_mtime_ns,
+    }
+
+
+class Checkpoint:
+    """
+    Manifest and part files of one checkpointed run.
+
+    Usage:
+        checkpoint = Checkpoint(directory, identity, shard)
+        for each segment:
+            writer = checkpoint.part_writer(supports_arrow)
+            ... process checkpoint.rows rows into writer ...
+            checkpoint.commit(writer, rows, successful, failed)
+        checkpoint.replay(output_writer)
+        checkpoint.finish()
+    """
+
+    def __init__(
+        self,
+        directory: str | Path,
+        identity: dict[str, Any],
+        shard: Optional[Shard] = None,
+        rows: int = DEFAULT_CHECKPOINT_ROWS,
+    ):
+        """
+        Open a checkpoint, loading the manifest of an earlier run if present.
+
+        Args:
+            directory: Checkpoint directory (created if missing)
+            identity: Input and processor description (see input_identity)
+            shard: Shard being processed, or None for the whole input
+            rows: Input rows per segment
+
+        Raises:
+            ValueError: If the directory holds a checkpoint of a different run
+        """
+        if rows < 1:
+            raise ValueError(f"Checkpoint rows must be at least 1, got {rows}")
+
+        self.directory = Path(directory)
+        self.rows = rows
+        if shard is None:
+            self.manifest_path = self.directory / "manifest.json"
+            self.parts_dir = self.directory / "parts"
+        else:
+            self.manifest_path = self.directory / f"manifest-{shard.label}.json"
+            self.parts_dir = self.directory / shard.label
+        self.parts_dir.mkdir(parents=True, exist_ok=True)
+
+        self.identity = {**identity, "shard": None if shard is None else str(shard)}
+        self.parts: list[dict[str, Any]] = []
+        self.complete = False
+
+        if self.manifest_path.exists():
+            self._load()
+
+    def _load(self):
+        with open(self.manifest_path) as f:
+            manifest = json.load(f)
+
+        if manifest.get("version") != MANIFEST_VERSION:
+            raise ValueError(f"Unsupported checkpoint manifest: {self.manifest_path}")
+        if manifest.get("identity") != self.identity:
+            raise ValueError(
+                f"Checkpoint in {self.directory} belongs to a different run "
+                "(input, shard or options changed); use a new checkpoint directory"
+            )
+
+        self.parts = manifest["parts"]
+        self.complete = manifest.get("complete", False)
+        for part in self.parts:
+            if not (self.parts_dir / part["file"]).exists():
+                raise ValueError(f"Checkpoint part missing: {self.parts_dir / part['file']}")
+
+    def _save(self):
+        _write_json_atomic(
+            self.manifest_path,
+            {
+                "version": MANIFEST_VERSION,
+                "identity": self.identity,
+                "parts": self.parts,
+                "complete": self.complete,
+            },
+        )
+
+    @property
+    def rows_done(self) -> int:
+        """Input rows covered by committed parts."""
+        return sum(part["rows"] for part in self.parts)
+
+    @property
+    def successful(self) -> int:
+        return sum(part["successful"] for part in self.parts)
+
+    @property
+    def failed(self) -> int:
+        return sum(part["failed"] for part in self.parts)
+
+    @property
+    def rejected(self) -> Counter:
+        """Failed rows per rejection reason (see core.results.Rejected)."""
+        total: Counter = Counter()
+        for part in self.parts:
+            total.update(part.get("rejected", {}))
+        return total
+
+    def part_writer(self, supports_arrow: bool = False) -> SpoolWriter:
+        """Open the writer for the next part (overwriting leftovers of an unfinished one)."""
+        return SpoolWriter(self.parts_dir / f"part-{len(self.parts):06d}.spool", supports_arrow)
+
+    def commit(
+        self,
+        writer: SpoolWriter,
+        rows: int,
+        successful: int,
+        failed: int,
+        rejected: Optional[dict[str, int]] = None,
+    ):
+        """Close a finished part and record it in the manifest."""
+        writer.close()
+        self.parts.append({
+            "file": writer.path.name,
+            "rows": rows,
+            "successful": successful,
+            "failed": failed,
+            "rejected": dict(rejected or {}),
+        })
+        self._save()
+
+    def iter_part_paths(self) -> Iterator[Path]:
+        for part in self.parts:
+            yield self.parts_dir / part["file"]
+
+    def replay(self, writer: MoleculeWriter):
+        """Write all committed parts, in order, to the output writer."""
+        for path in self.iter_part_paths():
+            replay_spool(path, writer)
+
+    def finish(self):
+        """Mark the run complete (a rerun then only replays the parts)."""
+        self.complete = True
+        self._save()
+
+
+# Process-wide checkpoint settings (set from CLI options, see configure_checkpoint)
+_checkpoint_dir: Optional[Path] = None
+_checkpoint_rows = DEFAULT_CHECKPOINT_ROWS
+_checkpoint_options: Optional[dict[str, Any]] = None
+
+
+def configure_checkpoint(
+    directory: Optional[str | Path],
+    rows: Optional[int] = None,
+    options: Optional[dict[str, Any]] = None,
+):
+    """
+    Checkpoint process_molecules runs started afterwards.
+
+    Args:
+        directory: Checkpoint directory, or None to disable
+        rows: Input rows per segment (default: DEFAULT_CHECKPOINT_ROWS)
+        options: Command options that determine the results (SMARTS,
+            rules, filter specs, ...), recorded in the manifest identity so
+            a rerun with other options is refused. Processors without a
+            cache key are otherwise only told apart by their type.
+
+    Raises:
+        ValueError: If rows is not positive
+    """
+    global _checkpoint_dir, _checkpoint_rows, _checkpoint_options
+    if rows is not None and rows < 1:
+        raise ValueError(f"--checkpoint-rows must be at least 1, got {rows}")
+    _checkpoint_dir = None if directory is None else Path(directory)
+    _checkpoint_rows = rows or DEFAULT_CHECKPOINT_ROWS
+    # Normalized as the manifest stores it (tuples become lists, others strings)
+    _checkpoint_options = None if options is None else json.loads(json.dumps(options, default=str))
+
+
+def open_checkpoint(
+    input_path: Optional[Path],
+    processor_id: str,
+    shard: Optional[Shard] = None,
+) -> Optional[Checkpoint]:
+    """
+    Open the configured checkpoint for a run.
+
+    Args:
+        input_path: Input file of the run
+        processor_id: Description of the processor and its options
+        shard: Shard being processed
+
+    Returns:
+        Checkpoint, or None if checkpointing is not configured
+    """
+    if _checkpoint_dir is None:
+        return None
+    identity = {"input": input_identity(input_path), "processor": processor_id}
+    if _checkpoint_options is not None:
+        identity["options"] = _checkpoint_options
+    return Checkpoint(_checkpoint_dir, identity, shard=shard, rows=_checkpoint_rows)
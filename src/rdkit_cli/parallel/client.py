@@ -0,0 +1,197 @@
+"""
+Thin client of the job server (rdkit-cli serve).
+
+Standard library only, so submitting a job costs a connection round trip
+rather than an RDKit import. The connection is kept alive between calls.
+
+    client = ServerClient("unix:///tmp/rdkit-cli.sock")
+    response = client.run("descriptors", ["CCO", "c1ccccc1"], options={"descriptors": "MolWt,TPSA"})
+    response["results"]   # one row (or None) per input SMILES
+"""
+
+import http.client
+import json
+import socket
+from typing import Any, Optional
+from urllib.parse import urlsplit
+
+DEFAULT_HOST = "127.0.0.1"
+DEFAULT_PORT = 8765
+DEFAULT_URL = f"http://{DEFAULT_HOST}:{DEFAULT_PORT}"
+
+ARROW_STREAM_TYPE = "application/vnd.apache.arrow.stream"
+
+
+class ServerError(RuntimeError):
+    """Job refused or failed on the server."""
+
+    def __init__(self, status: int, message: str):
+        super().__init__(message)
+        self.status = status
+
+
+class _UnixHTTPConnection(http.client.HTTPConnection):
+    """HTTPConnection over a Unix domain socket."""
+
+    def __init__(self, path: str, timeout: Optional[float] = None):
+        super().__init__("localhost", timeout=timeout)
+        self.socket_path = path
+
+    def connect(self):
+        self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        if self.timeout is not None:
+            self.sock.settimeout(self.timeout)
+        self.sock.connect(self.socket_path)
+
+
+def server_url(socket_path: Optional[str] = None, url: Optional[str] = None) -> str:
+    """Server URL from a --socket path or --url (default: DEFAULT_URL)."""
+    if socket_path is not None:
+        return f"unix://{socket_path}"
+    return url or DEFAULT_URL
+
+
+class ServerClient:
+    """Submit jobs to a running job server."""
+
+    def __init__(self, url: str = DEFAULT_URL, timeout: Optional[float] = None):
+        """
+        Initialize client.
+
+        Args:
+            url: http://HOST:PORT, or unix:///path/to/socket
+            timeout: Socket timeout in seconds (None waits indefinitely)
+
+        Raises:
+            ValueError: If the URL scheme is not http or unix
+        """
+        parts = urlsplit(url)
+        if parts.scheme not in ("http", "unix"):
+            raise ValueError(f"Server URL must be http://HOST:PORT or unix:///PATH, got '{url}'")
+        self.url = url
+        self._parts = parts
+        self.timeout = timeout
+        self._conn: Optional[http.client.HTTPConnection] = None
+
+    def _connect(self) -> http.client.HTTPConnection:
+        if self._conn is None:
+            if self._parts.scheme == "unix":
+                self._conn = _UnixHTTPConnection(self._parts.path, timeout=self.timeout)
+            else:
+                self._conn = http.client.HTTPConnection(
+                    self._parts.hostname or DEFAULT_HOST,
+                    self._parts.port or DEFAULT_PORT,
+                    timeout=self.timeout,
+                )
+        return self._conn
+
+    def close(self):
+        if self._conn is not None:
+            self._conn.close()
+            self._conn = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def _request(
+        self,
+        method: str,
+        path: str,
+        body: Optional[dict[str, Any]] = None,
+        accept: str = "application/json",
+    ) -> tuple[bytes, dict[str, str]]:
+        payload = None if body is None else json.dumps(body).encode()
+        headers = {"Accept": accept}
+        if payload is not None:
+            headers["Content-Type"] = "application/json"
+
+        # A kept-alive connection the server closed is reopened once
+        for attempt in (0, 1):
+            conn = self._connect()
+            try:
+                conn.request(method, path, body=payload, headers=headers)
+                response = conn.getresponse()
+                data = response.read()
+                break
+            except (http.client.RemoteDisconnected, BrokenPipeError, ConnectionResetError):
+                self.close()
+                if attempt:
+                    raise
+
+        if response.status >= 400:
+            try:
+                message = json.loads(data)["error"]
+            except (ValueError, KeyError, TypeError):
+                message = data.decode(errors="replace") or response.reason
+            raise ServerError(response.status, message)
+        return data, {key.lower(): value for key, value in response.getheaders()}
+
+    def health(self) -> dict[str, Any]:
+        """Server status: version, workers, jobs and cached processors."""
+        data, _ = self._request("GET", "/health")
+        return json.loads(data)
+
+    def run(
+        self,
+        job: str,
+        smiles: list[str],
+        names: Optional[list[str]] = None,
+        options: Optional[dict[str, Any]] = None,
+    ) -> dict[str, Any]:
+        """
+        Run a job on a batch of SMILES.
+
+        Args:
+            job: Job name (see the server's /health)
+            smiles: Input SMILES
+            names: Optional molecule names, one per SMILES
+            options: Job options (calculator settings, see rdkit-cli serve --help)
+
+        Returns:
+            Response with "results" (a row or None per input, in order),
+            "successful", "failed", "rejected" and "seconds"
+
+        Raises:
+            ServerError: If the job is unknown, its options are invalid or it failed
+        """
+        data, _ = self._request("POST", f"/jobs/{job}", _job_body(smiles, names, options))
+        return json.loads(data)
+
+    def run_arrow(
+        self,
+        job: str,
+        smiles: list[str],
+        names: Optional[list[str]] = None,
+        options: Optional[dict[str, Any]] = None,
+    ) -> tuple[bytes, dict[str, int]]:
+        """
+        Run a job and receive the successful rows as an Arrow IPC stream.
+
+        Returns:
+            Tuple of (stream bytes, {"successful": n, "failed": n})
+        """
+        data, headers = self._request(
+            "POST", f"/jobs/{job}", _job_body(smiles, names, options), accept=ARROW_STREAM_TYPE
+        )
+        counts = {
+            "successful": int(headers.get("x-successful", 0)),
+            "failed": int(headers.get("x-failed", 0)),
+        }
+        return data, counts
+
+    def shutdown(self):
+        """Stop the server."""
+        self._request("POST", "/shutdown")
+        self.close()
+
+
+def _job_body(smiles: list[str], names: Optional[list[str]], options: Optional[dict[str, Any]]) -> dict[str, Any]:
+    body: dict[str, Any] = {"smiles": list(smiles)}
+    if names is not None:
+        body["names"] = list(names)
+    if options:
+        body["options"] = options
+    return body
@@ -1,8 +1,9 @@
 """Parallel processing executor."""
 
 import os
-from concurrent.futures import ProcessPoolExecutor, as_completed
-from typing import Callable, Iterator, TypeVar, Optional, Any
+from collections import deque
+from concurrent.futures import Future, ProcessPoolExecutor, as_completed
+from typing import Callable, Iterable, Iterator, TypeVar, Optional, Any
 from dataclasses import dataclass
 
 T = TypeVar("T")
@@ -37,16 +38,53 @@ def get_worker_count(n_requested: int) -> int:
     return min(n_requested, max_workers)
 
 
+def plan_parallelism(n_requested: int, n_items: int, max_threads_per_item: int = 1) -> tuple[int, int]:
+    """
+    Split a core budget between worker processes and threads per item.
+
+    For processors that are themselves multithreaded (conformer embedding and
+    force field optimization), running N processes that each start
+    cpu_count() threads oversubscribes the machine. Processes are preferred,
+    since items are independent; threads only take the cores left over when
+    there are fewer items than cores, so processes x threads <= cores.
+
+    Args:
+        n_requested: Requested core budget (-1 for all, as for get_worker_count)
+        n_items: Number of items to process (0 if unknown)
+        max_threads_per_item: Most threads a single item can use
+
+    Returns:
+        Tuple of (n_workers, threads_per_item)
+    """
+    cores = get_worker_count(n_requested)
+    n_workers = min(cores, n_items) if n_items > 0 else cores
+    n_workers = max(1, n_workers)
+    threads = max(1, min(max_threads_per_item, cores // n_workers))
+    return n_workers, threads
+
+
 # Global worker function storage for pickling
 _worker_func: Optional[Callable] = None
 _worker_args: tuple = ()
 
 
-def _init_worker(func: Callable, args: tuple):
-    """Initialize worker process with function and extra args."""
+def _init_worker(
+    func: Callable,
+    args: tuple = (),
+    initializer: Optional[Callable] = None,
+    initargs: tuple = (),
+):
+    """
+    Initialize worker process with function and extra args.
+
+    The function (and any processor state bound to it) is transferred once
+    per worker at pool startup instead of once per submitted task.
+    """
     global _worker_func, _worker_args
     _worker_func = func
     _worker_args = args
+    if initializer is not None:
+        initializer(*initargs)
 
 
 def _worker_wrapper(item: Any) -> Any:
@@ -57,12 +95,28 @@ def _worker_wrapper(item: Any) -> Any:
     return _worker_func(item, *_worker_args)
 
 
+def _worker_chunk(items: list) -> list:
+    """Apply the stored worker function to a chunk of items."""
+    global _worker_func, _worker_args
+    if _worker_func is None:
+        raise RuntimeError("Worker function not initialized")
+    return [_worker_func(item, *_worker_args) for item in items]
+
+
 class ParallelExecutor:
     """
     Generic parallel executor for batch processing.
 
     Uses ProcessPoolExecutor since RDKit operations are CPU-bound
     and benefit from true parallelism (bypassing GIL).
+
+    Used as a context manager, the executor keeps a single worker pool
+    alive across all map calls, so process startup and processor setup
+    are paid once per command rather than once per batch:
+
+        with ParallelExecutor(processor, n_workers=8) as executor:
+            for batch in batches:
+                results = executor.map_ordered(batch)
     """
 
     def __init__(
@@ -85,6 +139,81 @@ class ParallelExecutor:
         self.n_workers = get_worker_count(n_workers)
         self.initializer = initializer
         self.initargs = initargs
+        self._pool: Optional[ProcessPoolExecutor] = None
+
+    def start(self):
+        """Start the persistent worker pool (no-op if running or single worker)."""
+        if self._pool is not None or self.n_workers == 1:
+            return
+
+        self._pool = ProcessPoolExecutor(
+            max_workers=self.n_workers,
+            initializer=_init_worker,
+            initargs=(self.func, (), self.initializer, self.initargs),
+        )
+
+    def shutdown(self):
+        """Shut down the worker pool."""
+        if self._pool is not None:
+            self._pool.shutdown(wait=True, cancel_futures=True)
+            self._pool = None
+
+    @property
+    def is_running(self) -> bool:
+        """Check if the persistent worker pool is running."""
+        return self._pool is not None
+
+    def __enter__(self):
+        self.start()
+        return self
+
+    def __exit__(self, *args):
+        self.shutdown()
+
+    def submit(self, item: T) -> Future:
+        """
+        Submit a single item as one task on the persistent pool.
+
+        Without a running pool (single worker), the item is processed
+        immediately and an already-completed Future is returned.
+
+        Args:
+            item: Item to process
+
+        Returns:
+            Future resolving to the result
+        """
+        if self._pool is not None:
+            return self._pool.submit(_worker_wrapper, item)
+        return self._run_inline(self.func, item)
+
+    def submit_chunk(self, items: list[T]) -> Future:
+        """
+        Submit a chunk of items as a single task.
+
+        Args:
+            items: Items to process together in one worker
+
+        Returns:
+            Future resolving to the list of results, in input order
+        """
+        if self._pool is not None:
+            return self._pool.submit(_worker_chunk, items)
+        return self._run_inline(lambda chunk: [self.func(item) for item in chunk], items)
+
+    @staticmethod
+    def _run_inline(func: Callable, arg: Any) -> Future:
+        """Run func(arg) in the calling thread and wrap the outcome in a Future."""
+        future: Future = Future()
+        try:
+            future.set_result(func(arg))
+        except Exception as e:
+            future.set_exception(e)
+        return future
+
+    def _chunk_size(self, n_items: int) -> int:
+        """Pick a chunk size that gives each worker a few chunks per map call."""
+        return max(1, n_items // (self.n_workers * 4))
 
     def map_unordered(
         self,
@@ -112,21 +241,22 @@ class ParallelExecutor:
                 yield self.func(item)
             return
 
-        with ProcessPoolExecutor(
-            max_workers=self.n_workers,
-            initializer=self.initializer,
-            initargs=self.initargs,
-        ) as executor:
-            # Submit all tasks
-            futures = {executor.submit(self.func, item): i for i, item in enumerate(items)}
-
-            # Yield results as they complete
-            for future in as_completed(futures):
-                try:
-                    yield future.result()
-                except Exception as e:
-                    # Yield None for failed items, let caller handle
-                    yield None
+        if self._pool is None:
+            # One-shot pool for callers not using the context manager
+            with self:
+                yield from self.map_unordered(items, chunk_size)
+            return
+
+        # Submit all tasks
+        futures = {self._pool.submit(_worker_wrapper, item): i for i, item in enumerate(items)}
+
+        # Yield results as they complete
+        for future in as_completed(futures):
+            try:
+                yield future.result()
+            except Exception:
+                # Yield None for failed items, let caller handle
+                yield None
 
     def map_ordered(
         self,
@@ -150,8 +280,44 @@ class ParallelExecutor:
         if len(items) == 1 or self.n_workers == 1:
             return [self.func(item) for item in items]
 
-        with ProcessPoolExecutor(max_workers=self.n_workers) as executor:
-            return list(executor.map(self.func, items, chunksize=max(1, len(items) // (self.n_workers * 4))))
+        if self._pool is None:
+            # One-shot pool for callers not using the context manager
+            with self:
+                return self.map_ordered(items, chunk_size)
+
+        return list(
+            self._pool.map(_worker_wrapper, items, chunksize=self._chunk_size(len(items)))
+        )
+
+    def imap(
+        self,
+        items: Iterable[T],
+        max_in_flight: Optional[int] = None,
+    ) -> Iterator[R]:
+        """
+        Lazily process items, yielding results in input order.
+
+        At most max_in_flight items are submitted but not yet yielded, so
+        large results (e.g. array blocks) never pile up in memory. Items run
+        on the persistent pool, or inline without one.
+
+        Args:
+            items: Items to process (consumed lazily)
+            max_in_flight: Maximum pending tasks (default: 2 per worker)
+
+        Yields:
+            Results in same order as input
+        """
+        limit = max_in_flight or max(2, self.n_workers * 2)
+        pending: deque[Future] = deque()
+
+        for item in items:
+            pending.append(self.submit(item))
+            if len(pending) >= limit:
+                yield pending.popleft().result()
+
+        while pending:
+            yield pending.popleft().result()
 
 
 def parallel_map(
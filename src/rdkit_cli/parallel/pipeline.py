@@ -0,0 +1,361 @@
+"""Pipelined read -> compute -> write execution."""
+
+import queue
+import threading
+import time
+from collections import Counter
+from concurrent.futures import Future
+from typing import Any, Callable, Iterable, Optional
+
+from rdkit_cli.core.results import Rejected
+from rdkit_cli.io.writers import MoleculeWriter
+from rdkit_cli.parallel.executor import ParallelExecutor
+from rdkit_cli.progress.ninja import NinjaProgress
+
+# Marks the end of a stage's output
+_END = object()
+
+# How often blocked stages re-check for cancellation (seconds)
+_POLL_INTERVAL = 0.1
+
+
+class MoleculePipeline:
+    """
+    Three-stage pipeline that overlaps reading, computing and writing.
+
+    - A reader thread pulls items from the input and groups them into chunks,
+      feeding a bounded queue.
+    - The calling thread submits chunks to the worker pool as they arrive, with
+      at most `max_in_flight` chunks submitted but not yet written.
+    - A writer thread collects finished chunks through a reorder buffer and
+      writes them in input order.
+
+    The bounded queue and in-flight limit provide backpressure, so memory use
+    stays proportional to `max_in_flight * chunk_size` whatever the input size.
+
+    With a sort_key, items are dispatched one per task in descending key
+    order within each window of `sort_window` items (longest-processing-time
+    first), so the most expensive items of a window start first and the
+    cheap ones fill in behind them. Results are still written in input order.
+    """
+
+    def __init__(
+        self,
+        executor: ParallelExecutor,
+        writer: MoleculeWriter,
+        progress: NinjaProgress,
+        chunk_size: int = 100,
+        max_in_flight: Optional[int] = None,
+        write_buffer_size: int = 1000,
+        split_item: Optional[Callable[[Any], tuple[Any, Optional[dict[str, Any]]]]] = None,
+        columnar: bool = False,
+        sort_key: Optional[Callable[[Any], float]] = None,
+        sort_window: int = 256,
+        profile=None,
+    ):
+        """
+        Initialize pipeline.
+
+        Args:
+            executor: Running ParallelExecutor to submit chunks to
+            writer: MoleculeWriter receiving results (used only by the writer thread)
+            progress: Progress reporter, updated as results are written
+            chunk_size: Number of items per worker task
+            max_in_flight: Maximum chunks between dispatch and write
+                (default: 2 per worker)
+            write_buffer_size: Number of results per write_batch call
+            split_item: Function mapping an input item to (task, metadata);
+                metadata, if not None, is merged into the result in the parent
+            columnar: Each chunk is one task whose result is a pyarrow
+                RecordBatch, written with writer.write_arrow()
+            sort_key: Estimated cost of a task; dispatch items costliest
+                first within each window (chunk_size is then 1)
+            sort_window: Number of items reordered at a time with sort_key
+            profile: Optional RunProfile; results are then Timed (see
+                parallel.profile.ProfiledTask) and unwrapped by the writer
+        """
+        self.executor = executor
+        self.writer = writer
+        self.progress = progress
+        self.sort_key = sort_key
+        self.sort_window = max(1, sort_window)
+        self.chunk_size = 1 if sort_key is not None else max(1, chunk_size)
+        self.max_in_flight = max_in_flight or max(2, executor.n_workers * 2)
+        if sort_key is not None:
+            # The writer waits on the earliest unwritten item, which may be
+            # dispatched last in its window
+            self.max_in_flight = max(self.max_in_flight, self.sort_window)
+        self.write_buffer_size = write_buffer_size
+        self.split_item = split_item or (lambda item: (item, None))
+        self.columnar = columnar
+        self.profile = profile
+
+        self.successful = 0
+        self.failed = 0
+        self.rejected: Counter = Counter()
+
+        self._read_queue: queue.Queue = queue.Queue(maxsize=self.max_in_flight)
+        self._done_queue: queue.Queue = queue.Queue()
+        self._in_flight = threading.Semaphore(self.max_in_flight)
+        self._stop = threading.Event()
+        self._errors: list[BaseException] = []
+
+        # Per-chunk submit and completion times, kept only when profiling
+        self._submitted: dict[int, float] = {}
+        self._completed: dict[int, float] = {}
+        self._n_pending = 0
+        self._n_dispatched = 0
+        self._n_released = 0
+
+    def run(self, items: Iterable[Any]) -> tuple[int, int]:
+        """
+        Run all items through the pipeline.
+
+        Args:
+            items: Input items (MoleculeRecords or raw rows)
+
+        Returns:
+            Tuple of (successful, failed) counts
+        """
+        if self.profile is not None:
+            items = self.profile.timed_iter("read", items)
+            self.profile.add_gauge("read_queue", self._read_queue.qsize)
+            self.profile.add_gauge("in_flight", lambda: self._n_dispatched - self._n_released)
+            self.profile.add_gauge("reorder_buffer", lambda: self._n_pending)
+
+        read_thread = threading.Thread(
+            target=self._read_stage, args=(items,), name="rdkit-cli-reader", daemon=True
+        )
+        write_thread = threading.Thread(
+            target=self._write_stage, name="rdkit-cli-writer", daemon=True
+        )
+
+        read_thread.start()
+        write_thread.start()
+
+        n_submitted = 0
+        try:
+            n_submitted = self._dispatch_stage()
+        except BaseException as e:
+            self._fail(e)
+        finally:
+            # Tell the writer how many chunks to expect, then drain
+            self._done_queue.put((n_submitted, None, _END))
+            read_thread.join()
+            write_thread.join()
+            if self.profile is not None:
+                for name in ("read_queue", "in_flight", "reorder_buffer"):
+                    self.profile.remove_gauge(name)
+
+        if self._errors:
+            raise self._errors[0]
+
+        return self.successful, self.failed
+
+    def _fail(self, error: BaseException):
+        """Record an error and signal all stages to stop."""
+        self._errors.append(error)
+        self._stop.set()
+
+    def _put(self, item: Any) -> bool:
+        """Put onto the read queue, giving up if the pipeline is stopping."""
+        while not self._stop.is_set():
+            try:
+                self._read_queue.put(item, timeout=_POLL_INTERVAL)
+                return True
+            except queue.Full:
+                continue
+        return False
+
+    def _read_stage(self, items: Iterable[Any]):
+        """Reader thread: stream items into numbered chunks on the read queue."""
+        try:
+            if self.sort_key is not None:
+                self._read_sorted(items)
+                return
+
+            tasks: list[Any] = []
+            metadata: list[Optional[dict[str, Any]]] = []
+            seq = 0
+
+            for item in items:
+                task, meta = self.split_item(item)
+                tasks.append(task)
+                metadata.append(meta)
+
+                if len(tasks) >= self.chunk_size:
+                    if not self._put((seq, tasks, metadata)):
+                        return
+                    tasks, metadata = [], []
+                    seq += 1
+
+            if tasks:
+                self._put((seq, tasks, metadata))
+        except BaseException as e:
+            self._fail(e)
+        finally:
+            self._put(_END)
+
+    def _read_sorted(self, items: Iterable[Any]):
+        """Queue single-item chunks costliest first within each window."""
+        window: list[tuple[float, int, Any, Optional[dict[str, Any]]]] = []
+        seq = 0
+
+        def flush() -> bool:
+            window.sort(key=lambda entry: entry[0], reverse=True)
+            for _, position, task, meta in window:
+                if not self._put((position, [task], [meta])):
+                    return False
+            window.clear()
+            return True
+
+        for item in items:
+            task, meta = self.split_item(item)
+            window.append((self.sort_key(task), seq, task, meta))
+            seq += 1
+            if len(window) >= self.sort_window and not flush():
+                return
+
+        if window:
+            flush()
+
+    def _dispatch_stage(self) -> int:
+        """Calling thread: submit chunks to the pool as they arrive."""
+        n_submitted = 0
+
+        while not self._stop.is_set():
+            try:
+                chunk = self._read_queue.get(timeout=_POLL_INTERVAL)
+            except queue.Empty:
+                continue
+
+            if chunk is _END:
+                break
+
+            # Backpressure: wait until the writer has caught up
+            while not self._in_flight.acquire(timeout=_POLL_INTERVAL):
+                if self._stop.is_set():
+                    return n_submitted
+
+            seq, tasks, metadata = chunk
+            if self.profile is not None:
+                start = time.perf_counter()
+                self._submitted[seq] = start
+            if self.columnar:
+                future = self.executor.submit(tasks)
+            else:
+                future = self.executor.submit_chunk(tasks)
+            if self.profile is not None:
+                self.profile.add("dispatch", time.perf_counter() - start, len(tasks))
+            future.add_done_callback(self._make_callback(seq, metadata))
+            n_submitted += 1
+            self._n_dispatched = n_submitted
+
+        return n_submitted
+
+    def _make_callback(self, seq: int, metadata: list[Optional[dict[str, Any]]]):
+        """Build a done-callback forwarding a finished chunk to the writer."""
+        def callback(future: Future):
+            if self.profile is not None:
+                self._completed[seq] = time.perf_counter()
+            self._done_queue.put((seq, metadata, future))
+        return callback
+
+    def _write_stage(self):
+        """Writer thread: write finished chunks in input order."""
+        pending: dict[int, tuple[list, Future]] = {}
+        next_seq = 0
+        n_received = 0
+        n_chunks: Optional[int] = None
+        buffer: list[dict[str, Any]] = []
+
+        try:
+            while n_chunks is None or n_received < n_chunks:
+                seq, metadata, future = self._done_queue.get()
+
+                if future is _END:
+                    n_chunks = seq
+                    continue
+
+                n_received += 1
+
+                # Reorder buffer: hold chunks that finished early
+                pending[seq] = (metadata, future)
+                self._n_pending = len(pending)
+
+                while next_seq in pending:
+                    metadata, future = pending.pop(next_seq)
+                    self._n_pending = len(pending)
+                    seq = next_seq
+                    next_seq += 1
+                    self._n_released = next_seq
+                    self._in_flight.release()
+
+                    if self._stop.is_set():
+                        continue
+
+                    results = future.result()
+                    if self.profile is not None:
+                        results = self._unwrap(seq, results)
+
+                    if self.columnar:
+                        self._write_columnar(results, len(metadata))
+                        continue
+
+                    if self.profile is not None:
+                        start = time.perf_counter()
+                        self._collect(results, metadata, buffer)
+                        self.profile.add("collect", time.perf_counter() - start, len(metadata))
+                    else:
+                        self._collect(results, metadata, buffer)
+
+                    if len(buffer) >= self.write_buffer_size:
+                        self.writer.write_batch(buffer)
+                        buffer = []
+
+            if buffer and not self._stop.is_set():
+                self.writer.write_batch(buffer)
+        except BaseException as e:
+            self._fail(e)
+
+    def _unwrap(self, seq: int, results: Any) -> Any:
+        """Record a chunk's Timed results; charge latency not spent in the worker to transfer."""
+        if self.columnar:
+            timed = [results]
+            results = self.profile.unwrap(results)
+        else:
+            timed = results
+            results = [self.profile.unwrap(t) for t in timed]
+
+        latency = self._completed.pop(seq) - self._submitted.pop(seq)
+        worker = sum(t.parse_seconds + t.compute_seconds for t in timed)
+        self.profile.add("transfer", max(0.0, latency - worker), len(timed))
+        return results
+
+    def _write_columnar(self, batch, n_items: int):
+        """Count and write one RecordBatch result."""
+        self.writer.write_arrow(batch)
+        self.successful += batch.num_rows
+        self.failed += n_items - batch.num_rows
+        self.progress.update(n_items)
+
+    def _collect(
+        self,
+        results: list[Optional[dict[str, Any]]],
+        metadata: list[Optional[dict[str, Any]]],
+        buffer: list[dict[str, Any]],
+    ):
+        """Count results and append successful ones to the write buffer."""
+        for result, meta in zip(results, metadata):
+            if isinstance(result, Rejected):
+                self.rejected[result.reason] += 1
+                self.failed += 1
+            elif result is not None:
+                if meta:
+                    for key, value in meta.items():
+                        result.setdefault(key, value)
+                buffer.append(result)
+                self.successful += 1
+            else:
+                self.failed += 1
+            self.progress.update()
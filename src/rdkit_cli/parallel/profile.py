@@ -0,0 +1,371 @@
+"""
+Per-stage profiling of process_molecules runs (--profile).
+
+With a profile configured, process_molecules records cumulative time and
+counts per stage:
+
+    read      pulling rows (or parsed records) from the reader
+    parse     building molecules from raw rows (parent or worker)
+    dispatch  submitting chunks to the worker pool
+    compute   the processor itself (in the workers)
+    transfer  submit-to-result latency not spent in a worker: pool
+              queueing, pickling and IPC
+    collect   unwrapping results and joining metadata in the parent
+    write     the MoleculeWriter
+
+plus busy time per worker process, queue depths sampled while the pipeline
+runs, and the slowest molecules with their SMILES. The report is written as
+JSON when the run ends; optionally a JSONL line of running totals is
+appended every few seconds for dashboards.
+
+Without a profile none of this is set up, and the only cost is a None check
+per chunk.
+"""
+
+import heapq
+import json
+import os
+import threading
+import time
+from pathlib import Path
+from typing import Any, Callable, Iterable, Iterator, NamedTuple, Optional
+
+from rdkit_cli.io.writers import MoleculeWriter
+
+STAGES = ("read", "parse", "dispatch", "compute", "transfer", "collect", "write")
+
+# Molecules listed in the report's "slowest" section
+SLOWEST_MOLECULES = 10
+
+DEFAULT_METRICS_INTERVAL = 10.0
+
+# How often queue depths are sampled (seconds)
+_GAUGE_INTERVAL = 0.25
+
+
+class Timed(NamedTuple):
+    """A worker result with the time its item took, unwrapped by RunProfile.unwrap()."""
+
+    result: Any
+    parse_seconds: float
+    compute_seconds: float
+    pid: int
+    n_items: int
+    # SMILES of a single-molecule item, None for whole chunks
+    smiles: Optional[str]
+
+
+class ProfiledTask:
+    """
+    Worker-side wrapper timing parse and compute of each item.
+
+    Wraps a processor (one MoleculeRecord, or one raw row with parse) or a
+    batch task (a list of items, timed as a whole).
+    """
+
+    def __init__(self, processor: Callable[[Any], Any], parse: Optional[Callable[..., Any]] = None):
+        self.processor = processor
+        self.parse = parse
+
+    def __call__(self, item: Any) -> Timed:
+        start = time.perf_counter()
+        if self.parse is not None:
+            record = self.parse(*item)
+            parsed = time.perf_counter()
+        else:
+            record = item
+            parsed = start
+        result = self.processor(record)
+        done = time.perf_counter()
+
+        if isinstance(record, list):
+            n_items, smiles = len(record), None
+        else:
+            n_items, smiles = 1, getattr(record, "smiles", None)
+        return Timed(result, parsed - start, done - parsed, os.getpid(), n_items, smiles)
+
+
+class _Gauge:
+    """Running mean and maximum of a sampled value."""
+
+    __slots__ = ("read", "total", "samples", "maximum", "current")
+
+    def __init__(self, read: Callable[[], int]):
+        self.read = read
+        self.total = 0
+        self.samples = 0
+        self.maximum = 0
+        self.current = 0
+
+    def sample(self):
+        value = self.read()
+        self.current = value
+        self.total += value
+        self.samples += 1
+        self.maximum = max(self.maximum, value)
+
+
+class RunProfile:
+    """Stage timings, worker utilization and queue depths of one run."""
+
+    def __init__(
+        self,
+        path: Path,
+        processor_id: str = "",
+        metrics_path: Optional[Path] = None,
+        metrics_interval: float = DEFAULT_METRICS_INTERVAL,
+    ):
+        """
+        Initialize profile.
+
+        Args:
+            path: JSON report path (written by finish())
+            processor_id: Processor description for the report
+            metrics_path: Optional JSONL file receiving periodic snapshots
+            metrics_interval: Seconds between snapshots
+        """
+        self.path = path
+        self.processor_id = processor_id
+        self.metrics_path = metrics_path
+        self.metrics_interval = metrics_interval
+        self.n_workers = 1
+
+        self.seconds = dict.fromkeys(STAGES, 0.0)
+        self.counts = dict.fromkeys(STAGES, 0)
+        self.items = 0
+        self.worker_busy: dict[int, float] = {}
+        self.worker_items: dict[int, int] = {}
+        self._slowest: list[tuple[float, int, str]] = []
+        self._n_timed = 0
+        self._gauges: dict[str, _Gauge] = {}
+
+        self._lock = threading.Lock()
+        self._stop = threading.Event()
+        self._sampler: Optional[threading.Thread] = None
+        self._started = 0.0
+
+    def start(self, n_workers: int = 1):
+        """Start the clock and the sampler thread."""
+        self.n_workers = n_workers
+        self._started = time.perf_counter()
+        if self.metrics_path is not None:
+            self.metrics_path.parent.mkdir(parents=True, exist_ok=True)
+            self.metrics_path.write_text("")
+        self._sampler = threading.Thread(target=self._sample_loop, name="rdkit-cli-profile", daemon=True)
+        self._sampler.start()
+
+    @property
+    def elapsed(self) -> float:
+        return time.perf_counter() - self._started
+
+    def add(self, stage: str, seconds: float, count: int = 1):
+        """Add time and a count to a stage."""
+        with self._lock:
+            self.seconds[stage] += seconds
+            self.counts[stage] += count
+
+    def timed_iter(self, stage: str, items: Iterable[Any]) -> Iterator[Any]:
+        """Yield from items, charging the time spent fetching each to a stage."""
+        iterator = iter(items)
+        while True:
+            start = time.perf_counter()
+            try:
+                item = next(iterator)
+            except StopIteration:
+                self.add(stage, time.perf_counter() - start, 0)
+                return
+            self.add(stage, time.perf_counter() - start)
+            yield item
+
+    def timed(self, stage: str, func: Callable) -> Callable:
+        """Wrap a function so each call is charged to a stage."""
+        def wrapper(*args, **kwargs):
+            start = time.perf_counter()
+            try:
+                return func(*args, **kwargs)
+            finally:
+                self.add(stage, time.perf_counter() - start)
+        return wrapper
+
+    def unwrap(self, timed: Timed) -> Any:
+        """Record a worker's Timed result and return the processor's result."""
+        with self._lock:
+            if timed.parse_seconds:
+                self.seconds["parse"] += timed.parse_seconds
+                self.counts["parse"] += timed.n_items
+            self.seconds["compute"] += timed.compute_seconds
+            self.counts["compute"] += timed.n_items
+            self.items += timed.n_items
+
+            busy = timed.parse_seconds + timed.compute_seconds
+            self.worker_busy[timed.pid] = self.worker_busy.get(timed.pid, 0.0) + busy
+            self.worker_items[timed.pid] = self.worker_items.get(timed.pid, 0) + timed.n_items
+
+            if timed.smiles is not None:
+                self._n_timed += 1
+                entry = (timed.compute_seconds, self._n_timed, timed.smiles)
+                if len(self._slowest) < SLOWEST_MOLECULES:
+                    heapq.heappush(self._slowest, entry)
+                elif entry > self._slowest[0]:
+                    heapq.heapreplace(self._slowest, entry)
+        return timed.result
+
+    def add_gauge(self, name: str, read: Callable[[], int]):
+        """Sample read() as a queue depth while the run lasts (replacing any previous gauge)."""
+        gauge = self._gauges.get(name)
+        if gauge is None:
+            self._gauges[name] = _Gauge(read)
+        else:
+            gauge.read = read
+
+    def remove_gauge(self, name: str):
+        """Stop sampling a gauge, keeping its statistics."""
+        gauge = self._gauges.get(name)
+        if gauge is not None:
+            gauge.read = lambda: 0
+
+    def _sample_loop(self):
+        next_snapshot = time.perf_counter() + self.metrics_interval
+        while not self._stop.wait(_GAUGE_INTERVAL):
+            for gauge in list(self._gauges.values()):
+                gauge.sample()
+            if self.metrics_path is not None and time.perf_counter() >= next_snapshot:
+                self._append_snapshot()
+                next_snapshot += self.metrics_interval
+
+    def _append_snapshot(self):
+        with self._lock:
+            snapshot = {
+                "time": time.time(),
+                "elapsed_seconds": round(self.elapsed, 3),
+                "items": self.items,
+                "stages": {stage: round(seconds, 6) for stage, seconds in self.seconds.items()},
+                "queues": {name: gauge.current for name, gauge in self._gauges.items()},
+            }
+        with open(self.metrics_path, "a") as f:
+            f.write(json.dumps(snapshot) + "\n")
+
+    def report(self, successful: int = 0, failed: int = 0) -> dict[str, Any]:
+        """Build the final report."""
+        elapsed = self.elapsed
+        with self._lock:
+            return {
+                "processor": self.processor_id,
+                "elapsed_seconds": round(elapsed, 6),
+                "items": self.items,
+                "successful": successful,
+                "failed": failed,
+                "items_per_second": round(self.items / elapsed, 3) if elapsed > 0 else None,
+                "n_workers": self.n_workers,
+                "stages": {
+                    stage: {"seconds": round(self.seconds[stage], 6), "count": self.counts[stage]}
+                    for stage in STAGES
+                },
+                "workers": [
+                    {
+                        "pid": pid,
+                        "items": self.worker_items[pid],
+                        "busy_seconds": round(busy, 6),
+                        "utilization": round(busy / elapsed, 4) if elapsed > 0 else None,
+                    }
+                    for pid, busy in sorted(self.worker_busy.items())
+                ],
+                "queues": {
+                    name: {
+                        "mean": round(gauge.total / gauge.samples, 3) if gauge.samples else 0.0,
+                        "max": gauge.maximum,
+                    }
+                    for name, gauge in self._gauges.items()
+                },
+                "slowest": [
+                    {"smiles": smiles, "seconds": round(seconds, 6)}
+                    for seconds, _, smiles in sorted(self._slowest, reverse=True)
+                ],
+            }
+
+    def finish(self, successful: int = 0, failed: int = 0) -> dict[str, Any]:
+        """Stop sampling and write the JSON report (and a last metrics line)."""
+        self._stop.set()
+        if self._sampler is not None:
+            self._sampler.join()
+        if self.metrics_path is not None:
+            self._append_snapshot()
+
+        report = self.report(successful, failed)
+        self.path.parent.mkdir(parents=True, exist_ok=True)
+        self.path.write_text(json.dumps(report, indent=2) + "\n")
+        return report
+
+
+class ProfiledWriter(MoleculeWriter):
+    """Writer proxy charging every write to the profile's write stage."""
+
+    def __init__(self, writer: MoleculeWriter, profile: RunProfile):
+        self.writer = writer
+        self.profile = profile
+        self.supports_arrow = writer.supports_arrow
+
+    def write_row(self, data: dict[str, Any]):
+        start = time.perf_counter()
+        self.writer.write_row(data)
+        self.profile.add("write", time.perf_counter() - start)
+
+    def write_batch(self, data: list[dict[str, Any]]):
+        start = time.perf_counter()
+        self.writer.write_batch(data)
+        self.profile.add("write", time.perf_counter() - start, len(data))
+
+    def write_arrow(self, batch):
+        start = time.perf_counter()
+        self.writer.write_arrow(batch)
+        self.profile.add("write", time.perf_counter() - start, batch.num_rows)
+
+    def close(self):
+        # The wrapped writer is closed by its owner
+        pass
+
+
+# Process-wide profile settings (set from CLI options, see configure_profile)
+_profile_path: Optional[Path] = None
+_metrics_path: Optional[Path] = None
+_metrics_interval = DEFAULT_METRICS_INTERVAL
+_profile_applied = False
+
+
+def configure_profile(
+    path: Optional[str | Path],
+    metrics_path: Optional[str | Path] = None,
+    metrics_interval: Optional[float] = None,
+):
+    """
+    Profile process_molecules runs started afterwards.
+
+    Args:
+        path: JSON report path, or None to disable profiling
+        metrics_path: Optional JSONL file for periodic snapshots
+        metrics_interval: Seconds between snapshots (default: 10)
+
+    Raises:
+        ValueError: If metrics_interval is not positive
+    """
+    global _profile_path, _metrics_path, _metrics_interval, _profile_applied
+    if metrics_interval is not None and metrics_interval <= 0:
+        raise ValueError(f"--profile-interval must be positive, got {metrics_interval}")
+    _profile_path = Path(path) if path is not None else None
+    _metrics_path = Path(metrics_path) if metrics_path is not None else None
+    _metrics_interval = metrics_interval or DEFAULT_METRICS_INTERVAL
+    _profile_applied = False
+
+
+def open_profile(processor_id: str = "") -> Optional[RunProfile]:
+    """Create a RunProfile for a run if profiling is configured, marking it applied."""
+    global _profile_applied
+    if _profile_path is None:
+        return None
+    _profile_applied = True
+    return RunProfile(_profile_path, processor_id, _metrics_path, _metrics_interval)
+
+
+def profile_ignored() -> bool:
+    """Check whether a profile was configured but no run recorded one."""
+    return _profile_path is not None and not _profile_applied
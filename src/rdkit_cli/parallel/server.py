@@ -0,0 +1,546 @@
+"""
+Long-lived job server with warm workers (rdkit-cli serve).
+
+A one-shot rdkit-cli call pays for interpreter startup, the RDKit import
+and processor setup (alert catalogs, the SA score fragment table) before
+it computes anything. The server pays these once: a persistent worker pool
+is started and warmed at launch, and each worker keeps the processors it
+built, keyed by job and options, for every later request.
+
+Jobs are posted over HTTP, on a TCP port or a Unix socket:
+
+    POST /jobs/<job>   {"smiles": [...], "names": [...], "options": {...}}
+                       -> {"results": [row or null, ...], "successful": n,
+                           "failed": n, "rejected": {...}, "seconds": s}
+                       (Accept: application/vnd.apache.arrow.stream for the
+                       successful rows as an Arrow IPC stream)
+    GET  /health       -> version, workers, jobs
+    POST /shutdown
+
+A batch is split into chunks spread over the workers; results come back in
+input order. See parallel.client for the matching client.
+"""
+
+import json
+import socket
+import socketserver
+import sys
+import threading
+import time
+from collections import Counter, OrderedDict
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from pathlib import Path
+from typing import Any, Callable, NamedTuple, Optional
+
+from rdkit_cli import __version__
+from rdkit_cli.core.results import Rejected
+from rdkit_cli.parallel.client import ARROW_STREAM_TYPE, DEFAULT_HOST, DEFAULT_PORT
+from rdkit_cli.parallel.executor import ParallelExecutor
+
+DEFAULT_CHUNK_SIZE = 64
+DEFAULT_MAX_BATCH = 100_000
+
+# Processors kept per worker (least recently used are dropped)
+MAX_CACHED_PROCESSORS = 32
+
+
+def _names(value: Any) -> Optional[list[str]]:
+    """Accept a list or a comma-separated string."""
+    if value is None:
+        return None
+    if isinstance(value, str):
+        return [item.strip() for item in value.split(",") if item.strip()]
+    return [str(item) for item in value]
+
+
+def _check_options(job: str, options: dict[str, Any]):
+    if options:
+        raise ValueError(f"Unknown option(s) for {job} job: {', '.join(sorted(options))}")
+
+
+def _descriptors_job(options: dict[str, Any]) -> Callable:
+    from rdkit_cli.core.descriptors import DescriptorCalculator
+
+    calculator = DescriptorCalculator(
+        descriptors=_names(options.pop("descriptors", None)),
+        precision=int(options.pop("precision", 4)),
+        include_smiles=bool(options.pop("include_smiles", True)),
+        include_name=bool(options.pop("include_name", True)),
+    )
+    _check_options("descriptors", options)
+    return calculator.compute
+
+
+def _fingerprints_job(options: dict[str, Any]) -> Callable:
+    from rdkit_cli.core.fingerprints import FingerprintCalculator, FingerprintType
+
+    calculator = FingerprintCalculator(
+        fp_type=FingerprintType(options.pop("type", "morgan")),
+        n_bits=int(options.pop("bits", 2048)),
+        radius=int(options.pop("radius", 2)),
+        use_counts=bool(options.pop("counts", False)),
+        output_format=options.pop("format", "hex"),
+        include_smiles=bool(options.pop("include_smiles", True)),
+        include_name=bool(options.pop("include_name", True)),
+    )
+    _check_options("fingerprints", options)
+    return calculator.compute
+
+
+def _filter_job(options: dict[str, Any]) -> Callable:
+    from rdkit_cli.core.filters import FilterChain, parse_filter_step
+
+    spec = list(options.pop("filters", []))
+    spec.extend(parse_filter_step(step) for step in options.pop("steps", []))
+    chain = FilterChain(spec, keep_order=bool(options.pop("keep_order", False)))
+    _check_options("filter", options)
+    return chain.filter
+
+
+def _sascorer_job(options: dict[str, Any]) -> Callable:
+    from rdkit_cli.core.sascorer import SAScoreCalculator
+
+    calculator = SAScoreCalculator(
+        include_sa=bool(options.pop("sa", True)),
+        include_npc=bool(options.pop("npc", False)),
+        include_qed=bool(options.pop("qed", False)),
+        include_smiles=bool(options.pop("include_smiles", True)),
+        include_name=bool(options.pop("include_name", True)),
+    )
+    _check_options("sascorer", options)
+    return calculator.compute
+
+
+_STANDARDIZE_OPTIONS = (
+    "canonicalize", "remove_stereo", "disconnect_metals", "normalize", "reionize",
+    "uncharge", "fragment_parent", "tautomer_parent", "include_original",
+)
+
+
+def _standardize_job(options: dict[str, Any]) -> Callable:
+    from rdkit_cli.core.standardizer import MoleculeStandardizer
+
+    values = {key: bool(options.pop(key)) for key in _STANDARDIZE_OPTIONS if key in options}
+    _check_options("standardize", options)
+    return MoleculeStandardizer(**values).standardize
+
+
+# Job name -> builder of its processor from the request options. Options
+# mirror the flags of the matching command:
+#   descriptors:  descriptors (list or 'MolWt,TPSA', default: all), precision
+#   fingerprints: type, bits, radius, counts, format
+#   filter:       filters (filter chain spec entries), steps ('KIND key=value'),
+#                 keep_order
+#   sascorer:     sa, npc, qed
+#   standardize:  canonicalize, remove_stereo, disconnect_metals, normalize,
+#                 reionize, uncharge, fragment_parent, tautomer_parent,
+#                 include_original
+# descriptors, fingerprints and sascorer also take include_smiles/include_name.
+JOBS: dict[str, Callable[[dict[str, Any]], Callable]] = {
+    "descriptors": _descriptors_job,
+    "fingerprints": _fingerprints_job,
+    "filter": _filter_job,
+    "sascorer": _sascorer_job,
+    "standardize": _standardize_job,
+}
+
+
+def build_job_processor(job: str, options: dict[str, Any]) -> Callable:
+    """
+    Build the processor of a job.
+
+    Raises:
+        ValueError: On an unknown job, unknown options or invalid values
+    """
+    builder = JOBS.get(job)
+    if builder is None:
+        raise ValueError(f"Unknown job: {job}. Available: {', '.join(JOBS)}")
+    if not isinstance(options, dict):
+        raise ValueError(f"Job options must be an object, got {type(options).__name__}")
+    return builder(dict(options))
+
+
+def options_key(options: Optional[dict[str, Any]]) -> str:
+    """Canonical form of job options, the processor cache key."""
+    return json.dumps(options or {}, sort_keys=True)
+
+
+# Per-process processor cache (in each worker, or the server itself inline)
+_processors: "OrderedDict[tuple[str, str], Callable]" = OrderedDict()
+_processors_lock = threading.Lock()
+
+
+def cached_job_processor(job: str, key: str) -> Callable:
+    """Return the processor of a job and options key, building it on first use."""
+    with _processors_lock:
+        processor = _processors.get((job, key))
+        if processor is not None:
+            _processors.move_to_end((job, key))
+            return processor
+
+    processor = build_job_processor(job, json.loads(key))
+    with _processors_lock:
+        _processors[(job, key)] = processor
+        while len(_processors) > MAX_CACHED_PROCESSORS:
+            _processors.popitem(last=False)
+    return processor
+
+
+class JobChunk(NamedTuple):
+    """A slice of one request's molecules, run as one worker task."""
+
+    job: str
+    options_key: str
+    rows: list[tuple[str, str]]
+
+
+def run_job_chunk(chunk: Optional[JobChunk]) -> Any:
+    """
+    Worker task: parse and process a chunk of (SMILES, name) rows.
+
+    A None chunk does nothing (used to start the pool's workers).
+    """
+    if chunk is None:
+        return None
+
+    from rdkit_cli.io.readers import parse_record
+
+    processor = cached_job_processor(chunk.job, chunk.options_key)
+    results = []
+    for smiles, name in chunk.rows:
+        record = parse_record(-1, smiles, name)
+        try:
+            results.append(processor(record))
+        except Exception:
+            results.append(None)
+    return results
+
+
+def init_server_worker(preload: tuple[tuple[str, str], ...] = ()):
+    """Import RDKit and build preloaded processors up front."""
+    from rdkit import Chem  # noqa: F401
+
+    for job, key in preload:
+        cached_job_processor(job, key)
+
+
+def parse_preload(text: str) -> tuple[str, str]:
+    """
+    Parse a --preload value: JOB or JOB=OPTIONS_JSON.
+
+    Raises:
+        ValueError: If the job is unknown or the options are not a JSON object
+    """
+    job, sep, raw = text.partition("=")
+    job = job.strip()
+    if job not in JOBS:
+        raise ValueError(f"Unknown job: {job}. Available: {', '.join(JOBS)}")
+    options: dict[str, Any] = {}
+    if sep:
+        try:
+            options = json.loads(raw)
+        except json.JSONDecodeError as e:
+            raise ValueError(f"Invalid options for --preload {job}: {e}") from None
+        if not isinstance(options, dict):
+            raise ValueError(f"Options for --preload {job} must be a JSON object")
+    return job, options_key(options)
+
+
+class JobServer:
+    """Warm worker pool serving jobs over HTTP."""
+
+    def __init__(
+        self,
+        n_workers: int = 1,
+        socket_path: Optional[str | Path] = None,
+        host: str = DEFAULT_HOST,
+        port: int = DEFAULT_PORT,
+        chunk_size: int = DEFAULT_CHUNK_SIZE,
+        max_batch: int = DEFAULT_MAX_BATCH,
+        preload: tuple[tuple[str, str], ...] = (),
+        quiet: bool = False,
+    ):
+        """
+        Initialize server.
+
+        Args:
+            n_workers: Worker processes (1 processes jobs in the server's threads)
+            socket_path: Listen on this Unix socket instead of host:port
+            host: TCP host
+            port: TCP port (0 picks a free one)
+            chunk_size: Molecules per worker task; smaller batches are one task
+            max_batch: Most molecules accepted in one request
+            preload: (job, options key) processors built in every worker at startup
+            quiet: Don't log requests
+        """
+        self.executor = ParallelExecutor(
+            run_job_chunk, n_workers=n_workers,
+            initializer=init_server_worker, initargs=(tuple(preload),),
+        )
+        self.socket_path = Path(socket_path) if socket_path is not None else None
+        self.host = host
+        self.port = port
+        self.chunk_size = max(1, chunk_size)
+        self.max_batch = max_batch
+        self.preload = tuple(preload)
+        self.quiet = quiet
+
+        self.jobs_served: Counter = Counter()
+        self.molecules_served = 0
+        self._stats_lock = threading.Lock()
+        self._httpd: Optional[socketserver.BaseServer] = None
+        self._started = 0.0
+
+    @property
+    def url(self) -> str:
+        if self.socket_path is not None:
+            return f"unix://{self.socket_path}"
+        return f"http://{self.host}:{self.port}"
+
+    def start(self):
+        """Start and warm the worker pool, then bind the listening socket."""
+        self.executor.start()
+        if self.executor.is_running:
+            # One task per worker makes the pool spawn (and initialize) all of them now
+            for future in [self.executor.submit(None) for _ in range(self.executor.n_workers)]:
+                future.result()
+        else:
+            init_server_worker(self.preload)
+
+        if self.socket_path is not None:
+            _remove_stale_socket(self.socket_path)
+            self._httpd = _UnixHTTPServer(str(self.socket_path), _JobHandler)
+        else:
+            self._httpd = _TCPHTTPServer((self.host, self.port), _JobHandler)
+            self.port = self._httpd.server_address[1]
+        self._httpd.job_server = self
+        self._started = time.perf_counter()
+
+    def serve_forever(self):
+        """Serve requests until shutdown() (or POST /shutdown)."""
+        if self._httpd is None:
+            self.start()
+        try:
+            self._httpd.serve_forever()
+        finally:
+            self.close()
+
+    def shutdown(self):
+        """Stop serve_forever() (safe to call from a request thread)."""
+        if self._httpd is not None:
+            threading.Thread(target=self._httpd.shutdown, daemon=True).start()
+
+    def close(self):
+        """Release the socket and the worker pool."""
+        if self._httpd is not None:
+            self._httpd.server_close()
+            self._httpd = None
+            if self.socket_path is not None:
+                self.socket_path.unlink(missing_ok=True)
+        self.executor.shutdown()
+
+    def health(self) -> dict[str, Any]:
+        with self._stats_lock:
+            return {
+                "status": "ok",
+                "version": __version__,
+                "workers": self.executor.n_workers,
+                "jobs": list(JOBS),
+                "uptime_seconds": round(time.perf_counter() - self._started, 3),
+                "requests": dict(self.jobs_served),
+                "molecules": self.molecules_served,
+            }
+
+    def run(
+        self,
+        job: str,
+        smiles: list[str],
+        names: Optional[list[str]] = None,
+        options: Optional[dict[str, Any]] = None,
+    ) -> dict[str, Any]:
+        """
+        Run a job on a batch of SMILES.
+
+        Returns:
+            {"results": [...], "successful", "failed", "rejected", "seconds"}
+
+        Raises:
+            ValueError: On an invalid job, options or batch
+        """
+        start = time.perf_counter()
+        if job not in JOBS:
+            raise ValueError(f"Unknown job: {job}. Available: {', '.join(JOBS)}")
+        if len(smiles) > self.max_batch:
+            raise ValueError(f"Batch of {len(smiles)} molecules exceeds the limit of {self.max_batch}")
+        if names is None:
+            names = [""] * len(smiles)
+        elif len(names) != len(smiles):
+            raise ValueError(f"Got {len(names)} names for {len(smiles)} SMILES")
+
+        key = options_key(options)
+        rows = [(str(smi), str(name)) for smi, name in zip(smiles, names)]
+
+        # Spread the batch over the workers, in chunks of at least chunk_size
+        n_chunks = max(1, min(self.executor.n_workers, len(rows) // self.chunk_size))
+        size = -(-len(rows) // n_chunks) if rows else 0
+        futures = [
+            self.executor.submit(JobChunk(job, key, rows[i:i + size]))
+            for i in range(0, len(rows), size or 1)
+        ]
+        if not futures:
+            # Validate the options even for an empty batch
+            cached_job_processor(job, key)
+
+        results: list[Any] = []
+        for future in futures:
+            results.extend(future.result())
+
+        rejected: Counter = Counter()
+        successful = failed = 0
+        for i, result in enumerate(results):
+            if isinstance(result, Rejected):
+                rejected[result.reason] += 1
+                results[i] = None
+                failed += 1
+            elif result is None:
+                failed += 1
+            else:
+                successful += 1
+
+        with self._stats_lock:
+            self.jobs_served[job] += 1
+            self.molecules_served += len(rows)
+
+        return {
+            "job": job,
+            "results": results,
+            "successful": successful,
+            "failed": failed,
+            "rejected": dict(rejected),
+            "seconds": round(time.perf_counter() - start, 6),
+        }
+
+
+def _remove_stale_socket(path: Path):
+    """Remove a socket file left by a dead server; refuse one still in use."""
+    if not path.exists():
+        return
+    probe = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    try:
+        probe.connect(str(path))
+    except OSError:
+        path.unlink()
+    else:
+        raise ValueError(f"A server is already listening on {path}")
+    finally:
+        probe.close()
+
+
+def _rows_to_arrow(rows: list[dict[str, Any]]) -> bytes:
+    import pyarrow as pa
+
+    table = pa.Table.from_pylist(rows)
+    sink = pa.BufferOutputStream()
+    with pa.ipc.new_stream(sink, table.schema) as writer:
+        writer.write_table(table)
+    return sink.getvalue().to_pybytes()
+
+
+class _TCPHTTPServer(ThreadingHTTPServer):
+    daemon_threads = True
+    allow_reuse_address = True
+
+
+class _UnixHTTPServer(socketserver.ThreadingMixIn, socketserver.UnixStreamServer):
+    daemon_threads = True
+
+
+class _JobHandler(BaseHTTPRequestHandler):
+    """HTTP front end of a JobServer (self.server.job_server)."""
+
+    server_version = f"rdkit-cli/{__version__}"
+    # Keep-alive: the client reuses one connection for all its calls
+    protocol_version = "HTTP/1.1"
+    # Buffered writes send headers and body together; separate small writes
+    # stall on Nagle's algorithm and delayed ACKs (~40 ms on TCP)
+    wbufsize = -1
+
+    @property
+    def job_server(self) -> JobServer:
+        return self.server.job_server
+
+    def address_string(self) -> str:
+        # Unix socket peers have no address
+        return self.client_address[0] if self.client_address else "unix"
+
+    def log_message(self, format: str, *args):
+        if not self.job_server.quiet:
+            sys.stderr.write(f"[{self.log_date_time_string()}] {format % args}\n")
+
+    def _send(self, status: int, body: bytes, content_type: str, headers: Optional[dict[str, str]] = None):
+        self.send_response(status)
+        self.send_header("Content-Type", content_type)
+        self.send_header("Content-Length", str(len(body)))
+        for key, value in (headers or {}).items():
+            self.send_header(key, value)
+        self.end_headers()
+        self.wfile.write(body)
+
+    def _send_json(self, status: int, data: dict[str, Any]):
+        self._send(status, json.dumps(data, default=str).encode(), "application/json")
+
+    def _read_json(self) -> Any:
+        length = int(self.headers.get("Content-Length") or 0)
+        raw = self.rfile.read(length) if length else b""
+        if not raw:
+            return {}
+        try:
+            return json.loads(raw)
+        except json.JSONDecodeError as e:
+            raise ValueError(f"Invalid JSON body: {e}") from None
+
+    def do_GET(self):
+        if self.path == "/health":
+            self._send_json(200, self.job_server.health())
+        else:
+            self._send_json(404, {"error": f"Not found: {self.path}"})
+
+    def do_POST(self):
+        try:
+            body = self._read_json()
+        except ValueError as e:
+            self._send_json(400, {"error": str(e)})
+            return
+
+        if self.path == "/shutdown":
+            self._send_json(200, {"status": "shutting down"})
+            self.close_connection = True
+            self.job_server.shutdown()
+            return
+
+        if not self.path.startswith("/jobs/"):
+            self._send_json(404, {"error": f"Not found: {self.path}"})
+            return
+
+        job = self.path[len("/jobs/"):]
+        try:
+            if not isinstance(body, dict) or not isinstance(body.get("smiles", []), list):
+                raise ValueError('Job body must be an object with a "smiles" list')
+            response = self.job_server.run(
+                job, body.get("smiles", []), body.get("names"), body.get("options")
+            )
+        except ValueError as e:
+            self._send_json(404 if str(e).startswith("Unknown job") else 400, {"error": str(e)})
+            return
+        except Exception as e:
+            self._send_json(500, {"error": f"{type(e).__name__}: {e}"})
+            return
+
+        if ARROW_STREAM_TYPE in (self.headers.get("Accept") or ""):
+            rows = [row for row in response["results"] if row is not None]
+            self._send(
+                200, _rows_to_arrow(rows), ARROW_STREAM_TYPE,
+                {"X-Successful": str(response["successful"]), "X-Failed": str(response["failed"])},
+            )
+        else:
+            self._send_json(200, response)
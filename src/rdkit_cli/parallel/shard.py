@@ -0,0 +1,82 @@
+"""
+Sharded execution: split one input across independent processes.
+
+With --shard I/N, a command built on process_molecules handles only the
+I-th of N contiguous row ranges of its input. The ranges are computed from
+the exact row count, so N processes (on one machine or many) together
+cover every row exactly once, and the shard outputs concatenated in shard
+order (rdkit-cli concat) equal the unsharded output.
+"""
+
+from dataclasses import dataclass
+from typing import Optional
+
+
+@dataclass(frozen=True)
+class Shard:
+    """One of `count` contiguous row ranges (index is 1-based)."""
+
+    index: int
+    count: int
+
+    def __post_init__(self):
+        if self.count < 1:
+            raise ValueError(f"Shard count must be at least 1, got {self.count}")
+        if not 1 <= self.index <= self.count:
+            raise ValueError(f"Shard index must be in 1..{self.count}, got {self.index}")
+
+    def row_range(self, total: int) -> tuple[int, int]:
+        """
+        Row range [start, stop) of this shard in an input of `total` rows.
+
+        Shards differ in size by at most one row.
+        """
+        start = (self.index - 1) * total // self.count
+        stop = self.index * total // self.count
+        return start, stop
+
+    @property
+    def label(self) -> str:
+        """Filesystem-friendly name, e.g. 'shard-2-of-8'."""
+        return f"shard-{self.index}-of-{self.count}"
+
+    def __str__(self) -> str:
+        return f"{self.index}/{self.count}"
+
+
+def parse_shard(text: str) -> Shard:
+    """
+    Parse an 'I/N' shard specification.
+
+    Raises:
+        ValueError: If the text is not of the form I/N with 1 <= I <= N
+    """
+    index, sep, count = text.partition("/")
+    if not sep:
+        raise ValueError(f"Shard must be given as I/N, got '{text}'")
+    try:
+        return Shard(int(index), int(count))
+    except ValueError as e:
+        if "Shard" in str(e):
+            raise
+        raise ValueError(f"Shard must be given as I/N, got '{text}'") from None
+
+
+# Process-wide shard (set from CLI options, see configure_shard)
+_shard: Optional[Shard] = None
+
+
+def configure_shard(shard: Optional[Shard]):
+    """
+    Restrict process_molecules runs to one shard of their input.
+
+    Args:
+        shard: Shard to process, or None to process whole inputs
+    """
+    global _shard
+    _shard = shard
+
+
+def active_shard() -> Optional[Shard]:
+    """Return the configured shard."""
+    return _shard
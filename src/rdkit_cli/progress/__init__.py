@@ -1,5 +1,5 @@
 """Progress monitoring utilities."""
 
-from rdkit_cli.progress.ninja import NinjaProgress
+from rdkit_cli.progress.ninja import NinjaProgress, configure_progress
 
-__all__ = ["NinjaProgress"]
+__all__ = ["NinjaProgress", "configure_progress"]
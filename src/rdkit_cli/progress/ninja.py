@@ -6,6 +6,28 @@ import threading
 from dataclasses import dataclass
 from typing import Optional
 
+# How progress totals are obtained for file readers
+PROGRESS_TOTAL_MODES = ["count", "estimate"]
+
+_total_mode = "count"
+
+
+def configure_progress(total_mode: str = "count"):
+    """
+    Configure how NinjaProgress.for_reader() obtains totals.
+
+    Args:
+        total_mode: "count" scans the input for an exact total;
+            "estimate" extrapolates it from the start of the file
+    """
+    global _total_mode
+    if total_mode not in PROGRESS_TOTAL_MODES:
+        raise ValueError(
+            f"Unknown progress total mode: {total_mode}. "
+            f"Choose from: {', '.join(PROGRESS_TOTAL_MODES)}"
+        )
+    _total_mode = total_mode
+
 
 @dataclass
 class ProgressStats:
@@ -29,6 +51,7 @@ class NinjaProgress:
     - No progress bar (just stats)
     - Updates in-place on single line
     - Thread-safe updates
+    - Estimated totals shown as [42/~100], raised if exceeded
     """
 
     def __init__(
@@ -37,6 +60,7 @@ class NinjaProgress:
         quiet: bool = False,
         update_interval: float = 0.1,
         file=None,
+        estimated: bool = False,
     ):
         """
         Initialize progress reporter.
@@ -46,9 +70,11 @@ class NinjaProgress:
             quiet: If True, suppress all output
             update_interval: Minimum seconds between display updates
             file: File to write progress to (default: stderr)
+            estimated: total is approximate
         """
         self.total = total
         self.quiet = quiet
+        self.estimated = estimated
         self.update_interval = update_interval
         self._file = file or sys.stderr
 
@@ -59,6 +85,24 @@ class NinjaProgress:
         self._finished = False
         self._last_line_length = 0
 
+    @classmethod
+    def for_reader(cls, reader, quiet: bool = False, **kwargs) -> "NinjaProgress":
+        """
+        Create a progress reporter sized from a MoleculeReader.
+
+        The exact total is used when the reader knows it cheaply. Otherwise
+        it is estimated without a full file scan when quiet (the total is
+        never shown) or when the total mode is "estimate".
+
+        Args:
+            reader: MoleculeReader to be processed
+            quiet: If True, suppress all output
+            **kwargs: Passed to NinjaProgress
+        """
+        if reader.cheap_len or not (quiet or _total_mode == "estimate"):
+            return cls(total=len(reader), quiet=quiet, **kwargs)
+        return cls(total=reader.estimate_len(), quiet=quiet, estimated=True, **kwargs)
+
     def start(self):
         """Start the progress tracker."""
         self._start_time = time.perf_counter()
@@ -73,6 +117,8 @@ class NinjaProgress:
         """
         with self._lock:
             self._completed += n
+            if self.estimated and self._completed > self.total:
+                self.total = self._completed
 
             # Throttle display updates
             now = time.perf_counter()
@@ -80,15 +126,27 @@ class NinjaProgress:
                 self._display()
                 self._last_update_time = now
 
-    def set_total(self, total: int):
-        """Update the total count (useful when count is discovered during processing)."""
+    def set_total(self, total: int, exact: bool = False):
+        """
+        Update the total count (useful when count is discovered during processing).
+
+        Args:
+            total: New total
+            exact: total is an exact count; otherwise an estimated total stays estimated
+        """
         with self._lock:
             self.total = total
+            if exact:
+                self.estimated = False
 
     def finish(self):
         """Complete the progress display."""
         with self._lock:
             self._finished = True
+            if self.estimated:
+                # The final count is exact
+                self.total = self._completed
+                self.estimated = False
             self._display(final=True)
             if not self.quiet:
                 self._file.write("\n")
@@ -138,8 +196,9 @@ class NinjaProgress:
         stats = self._calculate_stats()
 
         # Format: [42/100] 42% | 15.3 it/s | ETA: 3.8s | Elapsed: 2.8s
+        total = f"~{stats.total}" if self.estimated else f"{stats.total}"
         parts = [
-            f"[{stats.completed}/{stats.total}]",
+            f"[{stats.completed}/{total}]",
             f"{stats.percentage:.0f}%",
             f"{stats.rate:.1f} it/s",
         ]
@@ -44,6 +44,25 @@ class TestDescriptorsCommand:
         assert "MolWt" in content
         assert "MolLogP" in content
 
+    def test_compute_descriptors_profile(self, sample_csv, output_csv, tmp_dir):
+        """Test the --profile JSON report."""
+        import json
+
+        report_path = tmp_dir / "profile.json"
+        result = run_cli([
+            "descriptors", "compute",
+            "-i", str(sample_csv),
+            "-o", str(output_csv),
+            "-d", "MolWt,MolLogP",
+            "--profile", str(report_path),
+            "-n", "2",
+            "-q",
+        ])
+        assert result.returncode == 0
+        report = json.loads(report_path.read_text())
+        assert report["stages"]["compute"]["count"] == report["items"] > 0
+        assert "Warning" not in result.stderr
+
 
 class TestFingerprintsCommand:
     """Test fingerprints command."""
@@ -95,6 +114,69 @@ class TestFilterCommand:
         assert result.returncode == 0
         assert output_csv.exists()
 
+    def test_filter_smarts_file_panel(self, sample_csv, output_csv, tmp_dir):
+        """Test matching a SMARTS panel in one pass, in-memory and via a pattern store."""
+        panel = tmp_dir / "panel.smarts"
+        panel.write_text("# test panel\nc1ccccc1 benzene\n[OX2H] hydroxyl\nC(=O)O acid\nN#N\n")
+
+        result = run_cli([
+            "filter", "substructure",
+            "-i", str(sample_csv),
+            "-o", str(output_csv),
+            "--smarts-file", str(panel),
+            "--add-matches",
+            "-q",
+        ])
+        assert result.returncode == 0
+        direct = output_csv.read_text()
+        rows = [line.split(",") for line in direct.strip().splitlines()]
+        assert rows[0][-1] == "matched_patterns"
+        assert {row[1]: row[-1] for row in rows[1:]} == {
+            "aspirin": "benzene;hydroxyl;acid",
+            "benzene": "benzene",
+            "ethanol": "hydroxyl",
+        }
+
+        store = tmp_dir / "pattern.fpdb"
+        result = run_cli([
+            "fingerprints", "compute",
+            "-i", str(sample_csv),
+            "-o", str(store),
+            "--type", "pattern",
+            "-q",
+        ])
+        assert result.returncode == 0
+
+        store_output = tmp_dir / "store_out.csv"
+        result = run_cli([
+            "filter", "substructure",
+            "--fp-db", str(store),
+            "-o", str(store_output),
+            "--smarts-file", str(panel),
+            "--add-matches",
+            "-q",
+        ])
+        assert result.returncode == 0
+        store_rows = [line.split(",") for line in store_output.read_text().strip().splitlines()]
+        assert [row[1:] for row in store_rows[1:]] == [row[1:] for row in rows[1:]]
+
+    def test_filter_chain(self, sample_csv, output_csv, tmp_dir):
+        """Test several filters applied in one pass from a spec and steps."""
+        spec = tmp_dir / "triage.json"
+        spec.write_text('[{"filter": "pains"}, {"filter": "druglike", "rule": "lipinski"}]')
+
+        result = run_cli([
+            "filter", "chain",
+            "-i", str(sample_csv),
+            "-o", str(output_csv),
+            "--spec", str(spec),
+            "--step", "elements allowed=C,H,O",
+        ])
+        assert result.returncode == 0
+        names = [line.split(",")[1] for line in output_csv.read_text().strip().splitlines()[1:]]
+        assert names == ["aspirin", "benzene", "ethanol", "acetone"]
+        assert "rejected by elements: 1" in result.stderr
+
     def test_filter_druglike(self, sample_csv, output_csv):
         """Test drug-likeness filtering."""
         result = run_cli([
@@ -315,6 +397,109 @@ class TestSimilarityCommand:
         assert result.returncode == 0
         assert output_csv.exists()
 
+    def test_similarity_search_fp_db(self, sample_csv, output_csv, tmp_dir):
+        """Test similarity search against a fingerprint store."""
+        store = tmp_dir / "lib.fpdb"
+        result = run_cli([
+            "fingerprints", "compute",
+            "-i", str(sample_csv),
+            "-o", str(store),
+            "-q",
+        ])
+        assert result.returncode == 0
+
+        result = run_cli([
+            "similarity", "search",
+            "--fp-db", str(store),
+            "-o", str(output_csv),
+            "--query", "c1ccccc1",
+            "--threshold", "0.1",
+            "-q",
+        ])
+        assert result.returncode == 0
+        assert "similarity" in output_csv.read_text().split("\n")[0]
+
+    def test_similarity_search_matches_per_row_path(self, sample_csv, output_csv, tmp_dir):
+        """Test the arena search of -i gives the rows of the per-row --shard path."""
+        search = [
+            "similarity", "search",
+            "-i", str(sample_csv),
+            "--query", "c1ccccc1",
+            "--threshold", "0.1",
+            "-q",
+        ]
+        per_row = tmp_dir / "per_row.csv"
+
+        assert run_cli(search + ["-o", str(output_csv)]).returncode == 0
+        assert run_cli(search + ["-o", str(per_row), "--shard", "1/1"]).returncode == 0
+        assert output_csv.read_text() == per_row.read_text()
+
+    def test_similarity_search_queries(self, sample_csv, output_csv):
+        """Test multi-query search with per-query top-k in long format."""
+        result = run_cli([
+            "similarity", "search",
+            "-i", str(sample_csv),
+            "-o", str(output_csv),
+            "--queries", str(sample_csv),
+            "--threshold", "0.0",
+            "--top-n", "2",
+            "-q",
+        ])
+        assert result.returncode == 0
+        lines = output_csv.read_text().strip().split("\n")
+        assert lines[0].startswith("query_id,target_id")
+        assert len(lines) == 1 + 5 * 2
+
+    def test_similarity_matrix_csv(self, sample_csv, output_csv):
+        """Test dense text similarity matrix."""
+        result = run_cli([
+            "similarity", "matrix",
+            "-i", str(sample_csv),
+            "-o", str(output_csv),
+            "-q",
+        ])
+        assert result.returncode == 0
+        lines = output_csv.read_text().strip().split("\n")
+        assert len(lines) == 6
+        assert all(len(line.split(",")) == 6 for line in lines)
+
+    def test_similarity_matrix_npy(self, sample_csv, tmp_dir):
+        """Test memory-mapped .npy matrix output with parallel blocks."""
+        import numpy as np
+
+        output = tmp_dir / "matrix.npy"
+        result = run_cli([
+            "similarity", "matrix",
+            "-i", str(sample_csv),
+            "-o", str(output),
+            "--dtype", "uint8",
+            "--block-size", "2",
+            "-n", "2",
+            "-q",
+        ])
+        assert result.returncode == 0
+        matrix = np.load(output, mmap_mode="r")
+        assert matrix.shape == (5, 5)
+        assert matrix.dtype == np.uint8
+        assert (tmp_dir / "matrix.rows.csv").exists()
+
+    def test_similarity_matrix_edges(self, sample_csv, tmp_dir):
+        """Test thresholded edge list output."""
+        import pandas as pd
+
+        output = tmp_dir / "edges.parquet"
+        result = run_cli([
+            "similarity", "matrix",
+            "-i", str(sample_csv),
+            "-o", str(output),
+            "--threshold", "0.0",
+            "-q",
+        ])
+        assert result.returncode == 0
+        df = pd.read_parquet(output)
+        assert list(df.columns) == ["i", "j", "similarity"]
+        assert len(df) == 10
+
 
 class TestScaffoldCommand:
     """Test scaffold command."""
@@ -352,6 +537,71 @@ class TestHelpCommand:
         assert result.returncode == 0
 
 
+# Startup cost of parsing a command line, over a bare interpreter (milliseconds)
+STARTUP_BUDGET_MS = 80
+
+# Parses the descriptors compute command line and reports what was imported
+STARTUP_PROBE = """
+import sys
+from rdkit_cli.cli import create_parser, _selected_command
+argv = ["descriptors", "compute", "-i", "in.csv", "-o", "out.csv", "--all"]
+create_parser(_selected_command(argv)).parse_args(argv)
+print(" ".join(sorted(sys.modules)))
+"""
+
+
+def _best_of(cmd: list[str], runs: int = 5) -> float:
+    """Fastest wall time of a command in milliseconds."""
+    import time
+
+    best = float("inf")
+    for _ in range(runs):
+        start = time.perf_counter()
+        subprocess.run(cmd, capture_output=True, check=True, timeout=60)
+        best = min(best, (time.perf_counter() - start) * 1000)
+    return best
+
+
+class TestStartup:
+    """Test lazy command registration and the startup budget."""
+
+    def test_registry_matches_commands(self):
+        """Test the static registry lists every command with its own help."""
+        import pkgutil
+
+        import rdkit_cli.commands
+        from rdkit_cli.cli import COMMANDS, create_parser
+
+        modules = {m.name for m in pkgutil.iter_modules(rdkit_cli.commands.__path__)}
+        assert modules == set(COMMANDS)
+
+        parser = create_parser()
+        subparsers = parser._subparsers._group_actions[0]
+        registered = {action.dest: action.help for action in subparsers._choices_actions}
+        assert registered == COMMANDS
+
+    def test_parse_imports_only_selected_command(self):
+        """Test parsing loads one command module and no heavy dependencies."""
+        result = subprocess.run(
+            [sys.executable, "-c", STARTUP_PROBE], capture_output=True, text=True, timeout=60
+        )
+        assert result.returncode == 0, result.stderr
+        modules = set(result.stdout.split())
+        commands = {m for m in modules if m.startswith("rdkit_cli.commands.")}
+        assert commands == {"rdkit_cli.commands.descriptors"}
+        for heavy in ("rdkit", "numpy", "pandas", "pyarrow", "rich", "rich_argparse"):
+            assert heavy not in modules
+
+    @pytest.mark.benchmark
+    def test_startup_budget(self):
+        """Test parsing a command line stays within the startup budget (timing, opt-in)."""
+        baseline = _best_of([sys.executable, "-c", "pass"])
+        version = _best_of([sys.executable, "-m", "rdkit_cli", "--version"])
+        parse = _best_of([sys.executable, "-c", STARTUP_PROBE])
+        assert version - baseline < STARTUP_BUDGET_MS
+        assert parse - baseline < STARTUP_BUDGET_MS
+
+
 class TestErrorHandling:
     """Test error handling."""
 
@@ -561,6 +811,51 @@ class TestDepictCommand:
         assert result.returncode == 0
         assert output_svg.exists()
 
+    def test_depict_batch_archive(self, sample_csv, tmp_dir):
+        """Test batch depiction on workers into a zip archive."""
+        import zipfile
+
+        archive = tmp_dir / "images.zip"
+        result = run_cli([
+            "depict", "batch",
+            "-i", str(sample_csv),
+            "-o", str(archive),
+            "--name-column", "name",
+            "-n", "2",
+            "-q",
+        ])
+        assert result.returncode == 0
+        with zipfile.ZipFile(archive) as images:
+            assert sorted(images.namelist()) == sorted(
+                f"{name}.svg" for name in ["aspirin", "caffeine", "benzene", "ethanol", "acetone"]
+            )
+
+    def test_depict_grid_window(self, sample_csv, tmp_dir):
+        """Test grid depiction of a sorted window of the input."""
+        window = tmp_dir / "window.svg"
+        result = run_cli([
+            "depict", "grid",
+            "-i", str(sample_csv),
+            "-o", str(window),
+            "--name-column", "name",
+            "--sort-by", "name",
+            "--offset", "1",
+            "--max-mols", "2",
+        ])
+        assert result.returncode == 0
+
+        # Sorted names: acetone, aspirin, benzene, caffeine, ethanol
+        expected_csv = tmp_dir / "expected.csv"
+        expected_csv.write_text("smiles,name\nCC(=O)OC1=CC=CC=C1C(=O)O,aspirin\nc1ccccc1,benzene\n")
+        expected = tmp_dir / "expected.svg"
+        result = run_cli([
+            "depict", "grid",
+            "-i", str(expected_csv),
+            "-o", str(expected),
+            "--name-column", "name",
+        ])
+        assert result.returncode == 0
+        assert window.read_text() == expected.read_text()
 
 class TestConformersCommand:
     """Test conformers command."""
@@ -594,6 +889,44 @@ class TestReactionsCommand:
         assert result.returncode == 0
         assert output_csv.exists()
 
+    def test_reactions_enumerate_sampled(self, tmp_dir, output_csv):
+        """Test streamed, sampled two-component enumeration."""
+        acids = tmp_dir / "acids.csv"
+        alcohols = tmp_dir / "alcohols.csv"
+        acids.write_text("smiles,name\nCC(=O)O,acetic\nCCC(=O)O,propionic\nOC(=O)c1ccccc1,benzoic\n")
+        alcohols.write_text("smiles,name\nCCO,ethanol\nCO,methanol\n")
+
+        result = run_cli([
+            "reactions", "enumerate",
+            "-i", str(acids),
+            "--reactant2", str(alcohols),
+            "-o", str(output_csv),
+            "-t", "[C:1](=[O:2])[OH].[OH:3][C:4]>>[C:1](=[O:2])[O:3][C:4]",
+            "--sample", "4",
+            "-n", "2",
+            "-q",
+        ])
+        assert result.returncode == 0
+        lines = output_csv.read_text().strip().splitlines()
+        assert lines[0].startswith("smiles")
+        assert 2 <= len(lines) <= 5
+
+    @pytest.mark.parametrize("option", ["--sample", "--partitions"])
+    def test_reactions_enumerate_rejects_non_positive(self, sample_csv, output_csv, option):
+        """Test that --sample and --partitions below 1 are refused before enumerating."""
+        for value in ("0", "-3"):
+            result = run_cli([
+                "reactions", "enumerate",
+                "-i", str(sample_csv),
+                "-o", str(output_csv),
+                "-t", "[OH:1]>>[O-:1]",
+                option, value,
+                "-q",
+            ])
+            assert result.returncode == 1
+            assert f"{option} must be positive" in result.stderr
+            assert not output_csv.exists()
+
 
 class TestStatsCommand:
     """Test stats command."""
@@ -684,6 +1017,25 @@ class TestSplitCommand:
         assert any("molecules" in f.name for f in output_dir.glob("*.csv"))
 
 
+    def test_split_streams_rows_unchanged(self, tmp_dir, output_dir):
+        """Test that rows are written through as read, invalid SMILES included."""
+        input_csv = tmp_dir / "rows.csv"
+        input_csv.write_text("smiles,name,vendor\nCCO,a,x\nnot_a_smiles,b,y\nC,c,z\n")
+
+        result = run_cli([
+            "split",
+            "-i", str(input_csv),
+            "-o", str(output_dir),
+            "-s", "2",
+            "-q",
+        ])
+        assert result.returncode == 0
+        files = sorted(output_dir.glob("*.csv"))
+        assert len(files) == 2
+        assert "not_a_smiles,b,y" in files[0].read_text()
+        assert files[1].read_text().strip().splitlines()[1] == "C,c,z"
+
+
 class TestSampleCommand:
     """Test sample command."""
 
@@ -731,6 +1083,26 @@ class TestSampleCommand:
         assert output_csv.exists()
 
 
+    def test_sample_stream_stratify_column(self, tmp_dir, output_csv):
+        """Test streaming sampling stratified by an input column."""
+        input_csv = tmp_dir / "vendors.csv"
+        rows = [f"{'C' * (i + 1)},m{i},{'x' if i < 6 else 'y'}" for i in range(9)]
+        input_csv.write_text("smiles,name,vendor\n" + "\n".join(rows) + "\n")
+
+        result = run_cli([
+            "sample",
+            "-i", str(input_csv),
+            "-o", str(output_csv),
+            "-f", "0.34",
+            "--stratify-column", "vendor",
+            "--seed", "1",
+            "-q",
+        ])
+        assert result.returncode == 0
+        lines = output_csv.read_text().strip().splitlines()[1:]
+        assert sorted(line.split(",")[2] for line in lines) == ["x", "x", "y"]
+
+
 class TestDeduplicateCommand:
     """Test deduplicate command."""
 
@@ -757,6 +1129,25 @@ class TestDeduplicateCommand:
         assert result.returncode == 0
         assert output_csv.exists()
 
+    def test_deduplicate_spill_keep_last(self, tmp_dir, output_csv):
+        """Test partitioned deduplication keeping the last occurrence."""
+        input_csv = tmp_dir / "dupes.csv"
+        input_csv.write_text("smiles,name\nCCO,a\nC,b\nOCC,c\nC,d\n")
+
+        result = run_cli([
+            "deduplicate",
+            "-i", str(input_csv),
+            "-o", str(output_csv),
+            "--keep", "last",
+            "--spill-dir", str(tmp_dir / "spill"),
+            "--partitions", "4",
+            "-n", "2",
+            "-q",
+        ])
+        assert result.returncode == 0
+        lines = output_csv.read_text().strip().splitlines()
+        assert [line.split(",")[1] for line in lines[1:]] == ["c", "d"]
+
     def test_deduplicate_list_keys(self):
         """Test listing available key types."""
         result = run_cli(["deduplicate", "-i", "dummy.csv", "-o", "out.csv", "--list-keys"])
@@ -833,3 +1224,46 @@ class TestValidateCommand:
         assert output_csv.exists()
         # Check summary was printed
         assert "Invalid:" in result.stderr
+
+
+class TestServeCommand:
+    """Test serve and client commands."""
+
+    def test_serve_and_client(self, tmp_dir):
+        """Test jobs submitted to a running server, then stopping it."""
+        import json
+        import time
+
+        socket_path = tmp_dir / "rdkit.sock"
+        server = subprocess.Popen(
+            [sys.executable, "-m", "rdkit_cli", "serve", "--socket", str(socket_path), "-q",
+             "--preload", 'filter={"steps": ["pains"]}'],
+            stderr=subprocess.PIPE, text=True,
+        )
+        try:
+            deadline = time.monotonic() + 60
+            while not socket_path.exists():
+                assert server.poll() is None, server.stderr.read()
+                assert time.monotonic() < deadline
+                time.sleep(0.1)
+
+            result = run_cli([
+                "client", "descriptors",
+                "--socket", str(socket_path),
+                "--smiles", "CCO", "invalid",
+                "--options", '{"descriptors": "MolWt"}',
+            ])
+            assert result.returncode == 0
+            rows = [json.loads(line) for line in result.stdout.splitlines()]
+            assert rows[0]["smiles"] == "CCO" and "MolWt" in rows[0]
+            assert rows[1] is None
+            assert "1 successful, 1 failed" in result.stderr
+
+            result = run_cli(["client", "--socket", str(socket_path), "--shutdown"])
+            assert result.returncode == 0
+            assert server.wait(timeout=30) == 0
+            assert not socket_path.exists()
+        finally:
+            if server.poll() is None:
+                server.kill()
+                server.wait()
@@ -73,6 +73,114 @@ class TestMergeCommand:
         # CCO should appear only once
         assert content.count("CCO") == 1
 
+    def test_merge_parallel_spill(self, cli_runner, tmp_dir):
+        """Test parallel merging with partitioned deduplication."""
+        files = []
+        for i, content in enumerate(["CCO,a\nCCC,b\n", "OCC,c\nc1ccccc1,d\n", "CCC,e\n"]):
+            path = tmp_dir / f"vendor{i}.csv"
+            path.write_text("smiles,name\n" + content)
+            files.append(str(path))
+        output = tmp_dir / "merged.csv"
+
+        result = cli_runner([
+            "merge",
+            "-i", *files,
+            "-o", str(output),
+            "--dedupe",
+            "--spill-dir", str(tmp_dir / "spill"),
+            "-n", "2",
+            "-q",
+        ])
+
+        assert result == 0
+        lines = output.read_text().strip().splitlines()
+        assert [line.split(",")[1] for line in lines[1:]] == ["a", "b", "d"]
+
+
+class TestConcatCommand:
+    """Test concat command and --shard runs."""
+
+    def test_sharded_descriptors_concat(self, cli_runner, sample_csv, tmp_dir):
+        """Test that concatenated shard outputs equal the unsharded output."""
+        full = tmp_dir / "full.csv"
+        assert cli_runner([
+            "descriptors", "compute", "-i", str(sample_csv), "-o", str(full),
+            "-d", "MolWt", "-q",
+        ]) == 0
+
+        shards = []
+        for i in (1, 2, 3):
+            output = tmp_dir / f"shard{i}.csv"
+            assert cli_runner([
+                "descriptors", "compute", "-i", str(sample_csv), "-o", str(output),
+                "-d", "MolWt", "--shard", f"{i}/3", "--checkpoint", str(tmp_dir / "ckpt"), "-q",
+            ]) == 0
+            shards.append(str(output))
+
+        joined = tmp_dir / "joined.csv"
+        assert cli_runner(["concat", "-i", *shards, "-o", str(joined), "-q"]) == 0
+        assert joined.read_text() == full.read_text()
+        assert (tmp_dir / "ckpt" / "manifest-shard-2-of-3.json").exists()
+
+    def test_checkpoint_refuses_changed_options(self, cli_runner, sample_csv, tmp_dir):
+        """Test that resuming a checkpoint with other command options is refused."""
+        checkpoint = str(tmp_dir / "ckpt")
+        spec = tmp_dir / "spec.json"
+        spec.write_text('[{"filter": "property", "rules": ["MolWt < 500"]}]')
+
+        def run(*options):
+            return cli_runner([
+                "filter", "chain", "-i", str(sample_csv), "-o", str(tmp_dir / "out.csv"),
+                "--checkpoint", checkpoint, "-q", *options,
+            ])
+
+        assert run("--spec", str(spec)) == 0
+        assert run("--spec", str(spec)) == 0
+        spec.write_text('[{"filter": "property", "rules": ["MolWt < 100"]}]')
+        assert run("--spec", str(spec)) == 1
+        assert run("--spec", str(spec), "--step", "druglike") == 1
+
+    def test_checkpoint_options_digest_only_file_options(self, tmp_dir, monkeypatch):
+        """Test that only InputFile options are recorded by file digest."""
+        import argparse
+        from rdkit_cli.cli import InputFile, _result_options
+
+        spec = tmp_dir / "spec.json"
+        spec.write_text("[]")
+        monkeypatch.chdir(tmp_dir)
+
+        options = _result_options(
+            argparse.Namespace(spec=InputFile("spec.json"), smarts="spec.json")
+        )
+
+        assert options["smarts"] == "spec.json"
+        assert options["spec"]["path"] == str(spec.resolve())
+        assert "digest" in options["spec"]
+
+    def test_shard_refused_where_unsupported(self, cli_runner, sample_csv, tmp_dir):
+        """Test that --shard is refused up front by commands that would ignore it."""
+        with pytest.raises(SystemExit) as exc:
+            cli_runner([
+                "deduplicate", "-i", str(sample_csv), "-o", str(tmp_dir / "out.csv"),
+                "--shard", "1/2",
+            ])
+        assert exc.value.code == 2
+        assert not (tmp_dir / "out.csv").exists()
+
+        result = cli_runner([
+            "similarity", "search", "--queries", str(sample_csv), "-i", str(sample_csv),
+            "-o", str(tmp_dir / "hits.csv"), "--shard", "1/2",
+        ])
+        assert result == 1
+        assert not (tmp_dir / "hits.csv").exists()
+
+    def test_concat_format_mismatch(self, cli_runner, sample_csv, tmp_dir):
+        """Test that inputs of another format are rejected."""
+        smi = tmp_dir / "mols.smi"
+        smi.write_text("CCO ethanol\n")
+        result = cli_runner(["concat", "-i", str(sample_csv), str(smi), "-o", str(tmp_dir / "out.csv")])
+        assert result == 1
+
 
 class TestSAScorerCommand:
     """Test sascorer command."""
@@ -174,6 +282,25 @@ class TestMMPCommand:
         assert result == 0
         assert output_csv.exists()
 
+    def test_mmp_find_aggregate(self, cli_runner, tmp_dir, output_csv):
+        """Test MMP transformation counts without writing pairs."""
+        input_file = tmp_dir / "mols.csv"
+        input_file.write_text("smiles,name\nc1ccccc1CCO,a\nc1ccccc1CCN,b\nc1ccccc1CCC,c\n")
+
+        result = cli_runner([
+            "mmp", "find",
+            "-i", str(input_file),
+            "-o", str(output_csv),
+            "--max-cuts", "2",
+            "--aggregate",
+            "--max-group-size", "100",
+            "-n", "2",
+            "-q",
+        ])
+
+        assert result == 0
+        assert output_csv.read_text().startswith("transformation,count,percentage")
+
     def test_mmp_transform(self, cli_runner, tmp_dir, output_csv):
         """Test MMP transformation."""
         input_file = tmp_dir / "mols.csv"
@@ -159,3 +159,87 @@ class TestDeduplicator:
         assert "inchi" in key_types
         assert "inchikey" in key_types
         assert "scaffold" in key_types
+
+
+class TestHashedDeduplication:
+    """Test hashed keys and out-of-core deduplicate_rows."""
+
+    ROWS = ["C", "CC", "C", None, "CCO", "CC", None, "C"]
+
+    def _hashed_rows(self):
+        from rdkit_cli.core.deduplicate import hash_key
+
+        return [
+            (None if key is None else hash_key(key), (i, key))
+            for i, key in enumerate(self.ROWS)
+        ]
+
+    def test_hash_key_is_128_bit(self):
+        """Test that keys hash to 16-byte digests."""
+        from rdkit_cli.core.deduplicate import hash_key
+
+        assert len(hash_key("CCO")) == 16
+        assert hash_key("CCO") == hash_key("CCO")
+        assert hash_key("CCO") != hash_key("OCC")
+
+    def test_key_hasher_parses_raw_rows(self):
+        """Test worker-side hashing of raw rows."""
+        from rdkit_cli.core.deduplicate import KeyHasher, hash_key
+        from rdkit_cli.io.readers import parse_record
+
+        hasher = KeyHasher("smiles", parse=parse_record)
+        results = hasher([(0, "OCC", "a"), (1, "not_a_smiles", "b")])
+
+        assert results[0] == (hash_key("CCO"), "OCC", "a")
+        assert results[1][0] is None
+
+    def test_iter_key_hashes_keeps_metadata(self):
+        """Test that metadata stays with its row."""
+        from rdkit_cli.core.deduplicate import hash_key, iter_key_hashes
+        from rdkit_cli.io.readers import RawRecord, parse_record
+
+        raws = [RawRecord(i, smi, "", {"id": i}) for i, smi in enumerate(["C", "OCC", "C"])]
+        results = list(iter_key_hashes(raws, parse=parse_record, chunk_size=2))
+
+        assert [meta["id"] for _, _, _, meta in results] == [0, 1, 2]
+        assert results[1][0] == hash_key("CCO")
+        assert results[0][0] == results[2][0]
+
+    @pytest.mark.parametrize("spill", [False, True])
+    def test_deduplicate_rows_keep_first(self, tmp_path, spill):
+        """Test keep-first in memory and spilled to partitions."""
+        from rdkit_cli.core.deduplicate import Deduplicator
+
+        dedup = Deduplicator(keep="first", spill_dir=tmp_path if spill else None, n_partitions=3)
+        kept = list(dedup.deduplicate_rows(self._hashed_rows()))
+
+        assert [i for i, _ in kept] == [0, 1, 3, 4, 6]
+        assert dedup.n_rows == 8
+        assert dedup.n_duplicates == 3
+
+    @pytest.mark.parametrize("spill", [False, True])
+    def test_deduplicate_rows_keep_last(self, tmp_path, spill):
+        """Test keep-last in memory and spilled to partitions."""
+        from rdkit_cli.core.deduplicate import Deduplicator
+
+        dedup = Deduplicator(keep="last", spill_dir=tmp_path if spill else None, n_partitions=3)
+        kept = list(dedup.deduplicate_rows(self._hashed_rows()))
+
+        assert [i for i, _ in kept] == [3, 4, 5, 6, 7]
+        assert dedup.n_duplicates == 3
+
+    def test_spill_dir_cleaned_up(self, tmp_path):
+        """Test that partition and spool files are removed afterwards."""
+        from rdkit_cli.core.deduplicate import Deduplicator
+
+        dedup = Deduplicator(keep="first", spill_dir=tmp_path)
+        list(dedup.deduplicate_rows(self._hashed_rows()))
+
+        assert list(tmp_path.iterdir()) == []
+
+    def test_invalid_partitions(self):
+        """Test error on non-positive partition count."""
+        from rdkit_cli.core.deduplicate import Deduplicator
+
+        with pytest.raises(ValueError, match="n_partitions"):
+            Deduplicator(n_partitions=0)
@@ -66,6 +66,95 @@ class TestMoleculeDepiction:
         assert result["smiles"] == "CCO"
         assert "image" in result
 
+    def test_depict_highlight_smarts(self):
+        """Test SMARTS highlighting and legend are drawn."""
+        from rdkit_cli.core.depict import MoleculeDepiction
+        from rdkit_cli.io.readers import MoleculeRecord
+
+        record = MoleculeRecord(mol=Chem.MolFromSmiles("c1ccccc1O"), smiles="c1ccccc1O", name="phenol")
+        plain = MoleculeDepiction().depict_record(record)
+        highlighted = MoleculeDepiction(highlight_smarts="[OX2H]", add_legend=True).depict_record(record)
+
+        assert highlighted["image"] != plain["image"]
+        assert "phenol" not in plain["image"]
+
+    def test_depict_invalid_smarts(self):
+        """Test invalid highlight SMARTS is refused."""
+        from rdkit_cli.core.depict import MoleculeDepiction
+
+        with pytest.raises(ValueError):
+            MoleculeDepiction(highlight_smarts="[C")
+
+    def test_depict_pickled(self):
+        """Test depiction after pickling (as sent to workers) matches the original."""
+        import pickle
+        from rdkit_cli.core.depict import MoleculeDepiction
+
+        mol = Chem.MolFromSmiles("CC(=O)Oc1ccccc1C(=O)O")
+        depictor = MoleculeDepiction(highlight_smarts="C(=O)O")
+        first = depictor.depict(mol)
+        copy = pickle.loads(pickle.dumps(depictor))
+
+        assert copy.depict(mol) == first
+        assert depictor.depict(mol) == first
+
+
+class TestImageWriter:
+    """Test ImageWriter class."""
+
+    def _rows(self):
+        return [
+            {"image": "<svg>a</svg>", "name": "aspirin", "index": 0},
+            {"image": "<svg>b</svg>", "index": 1},
+            {"image": "<svg>c</svg>", "name": "aspirin", "index": 2},
+        ]
+
+    def test_directory(self, tmp_dir):
+        """Test images are written to a directory, with unique names."""
+        from rdkit_cli.core.depict import ImageWriter
+
+        with ImageWriter(tmp_dir / "images", prefix="x_") as writer:
+            writer.write_batch(self._rows())
+
+        names = sorted(p.name for p in (tmp_dir / "images").iterdir())
+        assert names == ["x_aspirin.svg", "x_aspirin_2.svg", "x_mol_1.svg"]
+        assert writer.written == 3
+
+    def test_directory_skips_existing(self, tmp_dir):
+        """Test existing files are kept unless overwrite is set."""
+        from rdkit_cli.core.depict import ImageWriter
+
+        out = tmp_dir / "images"
+        out.mkdir()
+        (out / "aspirin.svg").write_text("old")
+
+        with ImageWriter(out) as writer:
+            writer.write_batch(self._rows()[:1])
+        assert writer.skipped == 1
+        assert (out / "aspirin.svg").read_text() == "old"
+
+        with ImageWriter(out, overwrite=True) as writer:
+            writer.write_batch(self._rows()[:1])
+        assert (out / "aspirin.svg").read_text() == "<svg>a</svg>"
+
+    def test_archives(self, tmp_dir):
+        """Test zip and tar archives hold one entry per image."""
+        import tarfile
+        import zipfile
+        from rdkit_cli.core.depict import ImageWriter
+
+        with ImageWriter(tmp_dir / "images.zip", use_index=True) as writer:
+            writer.write_batch(self._rows())
+        with zipfile.ZipFile(tmp_dir / "images.zip") as archive:
+            assert archive.namelist() == ["mol_0.svg", "mol_1.svg", "mol_2.svg"]
+            assert archive.read("mol_1.svg") == b"<svg>b</svg>"
+
+        with ImageWriter(tmp_dir / "images.tar.gz", image_format="png") as writer:
+            writer.write_row({"image": b"\x89PNG", "name": "benzene", "index": 0})
+        with tarfile.open(tmp_dir / "images.tar.gz") as archive:
+            assert archive.getnames() == ["benzene.png"]
+            assert archive.extractfile("benzene.png").read() == b"\x89PNG"
+
 
 class TestGridDepiction:
     """Test GridDepiction class."""
@@ -125,6 +214,17 @@ class TestGridDepiction:
 
         assert result is not None
 
+    def test_grid_highlight(self):
+        """Test grid with SMARTS highlighting."""
+        from rdkit_cli.core.depict import GridDepiction
+
+        mols = [Chem.MolFromSmiles("CCO"), Chem.MolFromSmiles("CC")]
+        plain = GridDepiction(use_svg=True).depict(mols)
+        highlighted = GridDepiction(use_svg=True, highlight_smarts="[OH]").depict(mols)
+
+        assert highlighted is not None
+        assert highlighted != plain
+
 
 class TestDepictSmiles:
     """Test depict_smiles function."""
@@ -89,3 +89,125 @@ class TestListDescriptors:
 
         constitutional = list_descriptors(category="constitutional")
         assert len(constitutional) > 0
+
+
+class TestDescriptorPlan:
+    """Test grouped descriptor computation."""
+
+    def test_plan_matches_compute_descriptor(self, sample_molecules):
+        """Test that grouped values equal one-by-one computation."""
+        import math
+
+        from rdkit_cli.core.descriptors import (
+            DESCRIPTOR_REGISTRY,
+            THREE_D_DESCRIPTORS,
+            DescriptorPlan,
+            compute_descriptor,
+        )
+
+        names = [name for name in DESCRIPTOR_REGISTRY if name not in THREE_D_DESCRIPTORS]
+        plan = DescriptorPlan(names)
+
+        for _, smi in sample_molecules:
+            mol = Chem.MolFromSmiles(smi)
+            for name, value in zip(names, plan.compute(mol)):
+                expected = compute_descriptor(mol, name)
+                if expected is None:
+                    assert value is None, name
+                else:
+                    assert math.isclose(value, expected, rel_tol=1e-12, abs_tol=1e-12), name
+
+    def test_plan_groups_shared_calls(self):
+        """Test that MQN and Crippen members are computed by one call each."""
+        from rdkit_cli.core.descriptors import DescriptorPlan
+
+        plan = DescriptorPlan(["MQN1", "MQN2", "MolLogP", "MolMR", "TPSA"])
+        assert len(plan._steps) == 3
+
+    def test_plan_groups_vsa_families(self):
+        """Test that each VSA family is computed by one call for all its bins."""
+        from rdkit_cli.core.descriptors import DescriptorPlan
+
+        families = ["PEOE_VSA", "SMR_VSA", "SlogP_VSA", "EState_VSA", "VSA_EState"]
+        plan = DescriptorPlan([f"{family}{i}" for family in families for i in (1, 2, 3)])
+        assert len(plan._steps) == len(families)
+
+    def test_plan_unknown_descriptor(self):
+        """Test that unknown names are rejected."""
+        from rdkit_cli.core.descriptors import DescriptorPlan
+
+        with pytest.raises(ValueError):
+            DescriptorPlan(["NotADescriptor"])
+
+
+class TestDescriptorBatch:
+    """Test columnar descriptor computation."""
+
+    def test_compute_batch_matches_compute(self, sample_molecules):
+        """Test that compute_batch gives the same values as compute."""
+        from rdkit_cli.core.descriptors import DescriptorCalculator
+        from rdkit_cli.io.readers import MoleculeRecord
+
+        calc = DescriptorCalculator(descriptors=["MolWt", "TPSA", "NumHDonors"])
+        records = [
+            MoleculeRecord(mol=Chem.MolFromSmiles(smi), smiles=smi, name=name)
+            for name, smi in sample_molecules
+        ]
+        records.append(MoleculeRecord(mol=None, smiles="invalid"))
+
+        batch = calc.compute_batch(records)
+
+        assert batch.num_rows == len(sample_molecules)
+        assert batch.schema.names == calc.get_column_names()
+        for row, record in zip(batch.to_pylist(), records):
+            expected = calc.compute(record)
+            for desc in ["MolWt", "TPSA", "NumHDonors"]:
+                assert row[desc] == expected[desc]
+
+    def test_csv_output_matches_row_path(self, sample_molecules, tmp_dir):
+        """Test that columnar and row-wise CSV output are identical."""
+        from rdkit_cli.core.descriptors import DescriptorCalculator
+        from rdkit_cli.io.readers import MoleculeRecord
+        from rdkit_cli.io.writers import CSVWriter
+
+        calc = DescriptorCalculator(descriptors=["MolWt", "MolLogP", "RingCount"])
+        records = [
+            MoleculeRecord(mol=Chem.MolFromSmiles(smi), smiles=smi, name=name)
+            for name, smi in sample_molecules
+        ]
+
+        row_path = tmp_dir / "rows.csv"
+        with CSVWriter(row_path, columns=calc.get_column_names()) as writer:
+            writer.write_batch([calc.compute(r) for r in records])
+
+        arrow_path = tmp_dir / "arrow.csv"
+        with CSVWriter(arrow_path, columns=calc.get_column_names()) as writer:
+            writer.write_arrow(calc.compute_batch(records))
+
+        assert arrow_path.read_text() == row_path.read_text()
+
+    def test_paths_emit_same_columns(self, tmp_dir):
+        """Test that compute and compute_batch give the same columns, unnamed molecules included."""
+        from rdkit_cli.core.descriptors import DescriptorCalculator
+        from rdkit_cli.io.readers import MoleculeRecord
+        from rdkit_cli.io.writers import CSVWriter
+
+        calc = DescriptorCalculator(descriptors=["MolWt", "NumHDonors"], precision=2)
+        records = [
+            MoleculeRecord(mol=Chem.MolFromSmiles("CCO"), smiles="CCO"),
+            MoleculeRecord(mol=Chem.MolFromSmiles("c1ccccc1"), smiles="c1ccccc1", name="benzene"),
+        ]
+
+        rows = [calc.compute(r) for r in records]
+        batch = calc.compute_batch(records)
+        assert [list(row) for row in rows] == [batch.schema.names] * 2
+
+        # No explicit column order: the writers take it from the first row or batch
+        row_path = tmp_dir / "rows.csv"
+        with CSVWriter(row_path) as writer:
+            writer.write_batch(rows)
+        arrow_path = tmp_dir / "arrow.csv"
+        with CSVWriter(arrow_path) as writer:
+            writer.write_arrow(batch)
+
+        assert arrow_path.read_text() == row_path.read_text()
@@ -123,6 +123,62 @@ class TestDruglikeFilter:
             DruglikeFilter(rule_name="not_a_rule")
 
 
+class TestSubstructurePanel:
+    """Test SubstructurePanel multi-pattern filtering."""
+
+    def test_any_and_all_modes(self):
+        """Test any/all modes and reported matches."""
+        from rdkit_cli.core.filters import SubstructurePanel
+        from rdkit_cli.io.readers import MoleculeRecord
+
+        patterns = [("c1ccccc1", "benzene"), ("C(=O)O", "acid")]
+        aspirin = MoleculeRecord(mol=Chem.MolFromSmiles("CC(=O)Oc1ccccc1C(=O)O"), smiles="aspirin_smi", name="aspirin")
+        benzene = MoleculeRecord(mol=Chem.MolFromSmiles("c1ccccc1"), smiles="c1ccccc1", name="benzene")
+
+        any_panel = SubstructurePanel(patterns, add_matches=True)
+        assert any_panel.filter(aspirin)["matched_patterns"] == "benzene;acid"
+        assert any_panel.filter(benzene)["matched_patterns"] == "benzene"
+
+        all_panel = SubstructurePanel(patterns, mode="all")
+        assert all_panel.filter(aspirin) is not None
+        assert all_panel.filter(benzene) is None
+
+        exclude_panel = SubstructurePanel(patterns, mode="all", exclude=True)
+        assert exclude_panel.filter(benzene) is not None
+
+    def test_screening_does_not_change_results(self, sample_molecules):
+        """Test that pattern fingerprint screening only skips non-matches."""
+        from rdkit_cli.core.filters import SubstructurePanel
+
+        patterns = [
+            ("c1ccccc1", "benzene"), ("[OX2H]", "hydroxyl"), ("C=O", "carbonyl"),
+            ("n", "aromatic_n"), ("[#7]C(=O)[#7]", "urea"), ("C#N", "nitrile"),
+        ]
+        screened = SubstructurePanel(patterns, add_matches=True, screen=True)
+        unscreened = SubstructurePanel(patterns, add_matches=True, screen=False)
+
+        for _, smi in sample_molecules:
+            mol = Chem.MolFromSmiles(smi)
+            assert screened.evaluate(mol) == unscreened.evaluate(mol)
+        # Benzene cannot contain a nitrile: screened out without matching
+        assert 5 not in screened.candidates(Chem.MolFromSmiles("c1ccccc1"))
+
+    def test_read_smarts_file(self, tmp_dir):
+        """Test panel file parsing with names, comments and blank lines."""
+        from rdkit_cli.core.filters import read_smarts_file
+
+        path = tmp_dir / "panel.smarts"
+        path.write_text("# comment\nc1ccccc1 benzene ring\n\n[OH]\n")
+        assert read_smarts_file(path) == [("c1ccccc1", "benzene ring"), ("[OH]", "pattern_4")]
+
+    def test_invalid_pattern_named(self):
+        """Test that an invalid panel pattern is reported with its name."""
+        from rdkit_cli.core.filters import SubstructurePanel
+
+        with pytest.raises(ValueError, match="bad"):
+            SubstructurePanel([("C((", "bad")])
+
+
 class TestPropertyFilter:
     """Test PropertyFilter class."""
 
@@ -527,3 +583,59 @@ class TestPAINSFilterExcludeMode:
         filt_keep = PAINSFilter(exclude=False)
         result = filt_keep.filter(record)
         assert result is not None  # PAINS hit is kept
+
+
+class TestFilterChain:
+    """Test FilterChain single-pass filtering."""
+
+    def test_cheap_stages_run_first(self):
+        """Test cost ordering and keep_order."""
+        from rdkit_cli.core.filters import FilterChain
+
+        spec = [{"filter": "pains"}, {"filter": "druglike"}, {"filter": "elements", "allowed": "C,H,N,O"}]
+        assert FilterChain(spec).labels == ["elements", "druglike", "pains"]
+        assert FilterChain(spec, keep_order=True).labels == ["pains", "druglike", "elements"]
+
+    def test_rejections_name_the_stage(self):
+        """Test that a molecule stops at the first rejecting stage."""
+        from rdkit_cli.core.filters import FilterChain
+        from rdkit_cli.io.readers import MoleculeRecord
+        from rdkit_cli.core.results import Rejected
+
+        chain = FilterChain([
+            {"filter": "property", "rules": ["MolWt<100"]},
+            {"filter": "elements", "allowed": ["C", "H", "O"], "name": "cho_only"},
+        ])
+
+        caffeine = "CN1C=NC2=C1C(=O)N(C(=O)N2C)C"
+        record = MoleculeRecord(mol=Chem.MolFromSmiles(caffeine), smiles=caffeine, name="caffeine")
+        assert chain.filter(record) == Rejected("cho_only")
+
+        aspirin = "CC(=O)OC1=CC=CC=C1C(=O)O"
+        record = MoleculeRecord(mol=Chem.MolFromSmiles(aspirin), smiles=aspirin, name="aspirin")
+        assert chain.filter(record) == Rejected("property")
+
+        record = MoleculeRecord(mol=Chem.MolFromSmiles("CCO"), smiles="CCO", name="ethanol")
+        assert chain.filter(record) == {"smiles": "CCO", "name": "ethanol"}
+
+    def test_invalid_spec(self):
+        """Test that unknown filters and options are rejected."""
+        from rdkit_cli.core.filters import FilterChain
+
+        with pytest.raises(ValueError, match="Unknown filter"):
+            FilterChain([{"filter": "nonsense"}])
+        with pytest.raises(ValueError, match="Unknown option"):
+            FilterChain([{"filter": "druglike", "colour": "red"}])
+
+    def test_parse_steps_and_rules(self):
+        """Test command-line steps and combined property bounds."""
+        from rdkit_cli.core.filters import parse_filter_step, parse_property_rules
+
+        assert parse_filter_step("druglike rule=veber max-violations=1") == {
+            "filter": "druglike", "rule": "veber", "max_violations": "1",
+        }
+        assert parse_property_rules(["MolWt>200", "MolWt < 500", "TPSA<=140"]) == {
+            "MolWt": (200.0, 500.0),
+            "TPSA": (None, 140.0),
+        }
+
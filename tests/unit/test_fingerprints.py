@@ -68,6 +68,48 @@ class TestFingerprintCalculator:
         assert result is None
 
 
+class TestFingerprintBatch:
+    """Test columnar fingerprint computation."""
+
+    def test_compute_batch_hex(self, sample_molecules):
+        """Test that compute_batch matches compute for hex output."""
+        from rdkit_cli.core.fingerprints import FingerprintCalculator, FingerprintType
+        from rdkit_cli.io.readers import MoleculeRecord
+
+        calc = FingerprintCalculator(fp_type=FingerprintType.MORGAN)
+        records = [
+            MoleculeRecord(mol=Chem.MolFromSmiles(smi), smiles=smi, name=name)
+            for name, smi in sample_molecules
+        ]
+        records.append(MoleculeRecord(mol=None, smiles="invalid"))
+
+        batch = calc.compute_batch(records)
+
+        assert batch.num_rows == len(sample_molecules)
+        fingerprints = batch.column(batch.schema.names.index("fingerprint")).to_pylist()
+        assert fingerprints == [calc.compute(r)["fingerprint"] for r in records[:-1]]
+
+    def test_compute_batch_bits(self, sample_molecules):
+        """Test bit columns in columnar output."""
+        from rdkit_cli.core.fingerprints import FingerprintCalculator, FingerprintType
+        from rdkit_cli.io.readers import MoleculeRecord
+
+        calc = FingerprintCalculator(
+            fp_type=FingerprintType.MORGAN,
+            n_bits=64,
+            output_format="bits",
+        )
+        name, smi = sample_molecules[0]
+        record = MoleculeRecord(mol=Chem.MolFromSmiles(smi), smiles=smi, name=name)
+
+        batch = calc.compute_batch([record])
+        row = batch.to_pylist()[0]
+        expected = calc.compute(record)
+
+        assert batch.schema.names == calc.get_column_names()
+        assert all(row[f"bit_{i}"] == expected[f"bit_{i}"] for i in range(64))
+
+
 class TestListFingerprints:
     """Test list_fingerprints function."""
 
@@ -0,0 +1,91 @@
+"""Unit tests for arena similarity search module."""
+
+import pytest
+from rdkit import Chem, DataStructs
+
+
+LIBRARY = [
+    "CCO", "CCCO", "CCCCO", "c1ccccc1", "Cc1ccccc1", "CCc1ccccc1", "Oc1ccccc1",
+    "CC(=O)Oc1ccccc1C(=O)O", "CCN(CC)CC", "c1ccc2ccccc2c1", "C1CCCCC1", "CC(C)O",
+]
+
+
+def _library_fps():
+    from rdkit_cli.core.fingerprints import get_morgan_fingerprint
+
+    return [get_morgan_fingerprint(Chem.MolFromSmiles(smi), 2, 1024) for smi in LIBRARY]
+
+
+class TestPopcount:
+    """Test popcount kernels."""
+
+    def test_popcount_words(self):
+        """Test popcounts match RDKit on-bit counts."""
+        from rdkit_cli.core.fpsearch import pack_fingerprints, popcount_words
+
+        fps = _library_fps()
+        counts = popcount_words(pack_fingerprints(fps, 1024))
+        assert counts.tolist() == [fp.GetNumOnBits() for fp in fps]
+
+
+class TestFingerprintArena:
+    """Test FingerprintArena searches."""
+
+    @pytest.mark.parametrize("metric", ["tanimoto", "dice", "cosine", "tversky"])
+    def test_threshold_matches_rdkit(self, metric):
+        """Test bounded threshold search returns exactly the brute-force hits."""
+        from rdkit_cli.core.fpsearch import FingerprintArena, pack_fingerprints
+        from rdkit_cli.core.similarity import SimilarityMetric, bulk_similarity
+
+        fps = _library_fps()
+        arena = FingerprintArena.from_fingerprints(fps, 1024)
+        query = fps[4]
+
+        rows, sims = arena.search(
+            pack_fingerprints([query], 1024)[0], threshold=0.3, metric=metric,
+            tversky_alpha=0.7, tversky_beta=0.3,
+        )
+
+        expected = bulk_similarity(
+            query, fps, SimilarityMetric(metric), tversky_alpha=0.7, tversky_beta=0.3,
+        )
+        assert rows.tolist() == [i for i, s in enumerate(expected) if s >= 0.3]
+        assert sims.tolist() == pytest.approx([s for s in expected if s >= 0.3])
+
+    def test_top_k(self):
+        """Test top-k results are the k best, most similar first."""
+        from rdkit_cli.core.fpsearch import FingerprintArena, pack_fingerprints
+
+        fps = _library_fps()
+        arena = FingerprintArena.from_fingerprints(fps, 1024)
+
+        rows, sims = arena.search(pack_fingerprints([fps[3]], 1024)[0], top_k=3)
+
+        expected = DataStructs.BulkTanimotoSimilarity(fps[3], fps)
+        assert rows[0] == 3
+        assert sims.tolist() == pytest.approx(sorted(expected, reverse=True)[:3])
+
+    def test_search_many_segments(self):
+        """Test multi-query search over a segmented arena matches single queries."""
+        from rdkit_cli.core.fpsearch import FingerprintArena, pack_fingerprints
+
+        words = pack_fingerprints(_library_fps(), 1024)
+        whole = FingerprintArena(words, n_bits=1024)
+        segmented = FingerprintArena([words[:5], words[5:]], n_bits=1024)
+
+        results = segmented.search_many(words[[0, 3, 8]], threshold=0.2)
+
+        assert len(results) == 3
+        for (rows, sims), q in zip(results, [0, 3, 8]):
+            single_rows, single_sims = whole.search(words[q], threshold=0.2)
+            assert rows.tolist() == single_rows.tolist()
+            assert sims.tolist() == pytest.approx(single_sims.tolist())
+
+    def test_unsupported_metric(self):
+        """Test metrics without a popcount form are rejected."""
+        from rdkit_cli.core.fpsearch import FingerprintArena, pack_fingerprints
+
+        words = pack_fingerprints(_library_fps(), 1024)
+        arena = FingerprintArena(words, n_bits=1024)
+        with pytest.raises(ValueError):
+            arena.search(words[0], metric="rogotgoldberg")
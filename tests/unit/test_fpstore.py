@@ -0,0 +1,135 @@
+"""Unit tests for fingerprint store module."""
+
+import pytest
+from rdkit import Chem, DataStructs
+
+
+SMILES = ["CCO", "c1ccccc1", "Cc1ccccc1", "CC(=O)Oc1ccccc1C(=O)O", "CCN(CC)CC"]
+
+
+def _write_store(path, n_bits=2048):
+    from rdkit_cli.core.fingerprints import FingerprintCalculator
+    from rdkit_cli.core.fpstore import FingerprintStoreWriter, StoreParams
+    from rdkit_cli.io.readers import MoleculeRecord
+
+    calculator = FingerprintCalculator(n_bits=n_bits, output_format="packed")
+    rows = [
+        calculator.compute(MoleculeRecord(mol=Chem.MolFromSmiles(smi), smiles=smi, name=f"mol{i}"))
+        for i, smi in enumerate(SMILES)
+    ]
+    with FingerprintStoreWriter(path, StoreParams("morgan", n_bits, 2)) as writer:
+        writer.write_batch(rows[:2])
+        writer.write_batch(rows[2:])
+
+
+class TestPackedFingerprints:
+    """Test packed fingerprint encoding."""
+
+    def test_packed_width(self):
+        """Test width is rounded up to whole uint64 words."""
+        from rdkit_cli.core.fingerprints import packed_width
+
+        assert packed_width(2048) == 256
+        assert packed_width(167) == 24
+
+    def test_round_trip(self):
+        """Test packing and unpacking preserves on bits."""
+        from rdkit_cli.core.fingerprints import (
+            fingerprint_to_packed,
+            get_morgan_fingerprint,
+            packed_to_fingerprint,
+        )
+
+        fp = get_morgan_fingerprint(Chem.MolFromSmiles("c1ccccc1O"), 2, 1024)
+        data = fingerprint_to_packed(fp, 1024)
+        assert len(data) == 128
+        assert list(packed_to_fingerprint(data, 1024).GetOnBits()) == list(fp.GetOnBits())
+
+
+class TestFingerprintStore:
+    """Test FingerprintStore reading and writing."""
+
+    def test_params_round_trip(self, tmp_dir):
+        """Test fingerprint parameters are read back from the header."""
+        from rdkit_cli.core.fpstore import FingerprintStore
+
+        path = tmp_dir / "lib.fpdb"
+        _write_store(path, n_bits=1024)
+
+        with FingerprintStore(path) as store:
+            assert len(store) == len(SMILES)
+            assert store.params.fp_type == "morgan"
+            assert store.params.n_bits == 1024
+            assert store.smiles == SMILES
+            assert store.names[0] == "mol0"
+
+    def test_words_and_popcounts(self, tmp_dir):
+        """Test the packed arena shape and stored popcounts."""
+        import numpy as np
+        from rdkit_cli.core.fpstore import FingerprintStore
+
+        path = tmp_dir / "lib.fpdb"
+        _write_store(path)
+
+        with FingerprintStore(path) as store:
+            words = store.words()
+            assert words.shape == (len(SMILES), 32)
+            assert words.dtype == np.dtype("<u8")
+            bits = np.unpackbits(words.view(np.uint8), axis=1)
+            assert bits.sum(axis=1).tolist() == store.popcounts().tolist()
+
+    def test_bit_vectors_match(self, tmp_dir):
+        """Test unpacked fingerprints give the same similarities."""
+        from rdkit_cli.core.fingerprints import get_morgan_fingerprint
+        from rdkit_cli.core.fpstore import FingerprintStore
+
+        path = tmp_dir / "lib.fpdb"
+        _write_store(path)
+        originals = [get_morgan_fingerprint(Chem.MolFromSmiles(smi)) for smi in SMILES]
+
+        with FingerprintStore(path) as store:
+            stored = store.bit_vectors()
+
+        assert DataStructs.BulkTanimotoSimilarity(stored[1], stored) == pytest.approx(
+            DataStructs.BulkTanimotoSimilarity(originals[1], originals)
+        )
+
+    def test_not_a_store(self, tmp_dir):
+        """Test opening a non-store file raises ValueError."""
+        from rdkit_cli.core.fpstore import FingerprintStore
+
+        path = tmp_dir / "bad.fpdb"
+        path.write_text("not arrow")
+        with pytest.raises(ValueError):
+            FingerprintStore(path)
+
+    def test_search_store(self, tmp_dir):
+        """Test similarity search against a store."""
+        from rdkit_cli.core.fpstore import FingerprintStore
+        from rdkit_cli.core.similarity import search_fingerprint_store
+
+        path = tmp_dir / "lib.fpdb"
+        _write_store(path)
+
+        with FingerprintStore(path) as store:
+            results = search_fingerprint_store(store, "c1ccccc1", threshold=0.99)
+
+        assert [r["smiles"] for r in results] == ["c1ccccc1"]
+        assert results[0]["similarity"] == 1.0
+
+    def test_search_store_queries(self, tmp_dir):
+        """Test multi-query search yields per-query top-k hits."""
+        from rdkit_cli.core.fpstore import FingerprintStore
+        from rdkit_cli.core.similarity import search_store_queries
+
+        path = tmp_dir / "lib.fpdb"
+        _write_store(path)
+        queries = [("q1", Chem.MolFromSmiles("c1ccccc1")), ("q2", Chem.MolFromSmiles("CCO"))]
+
+        with FingerprintStore(path) as store:
+            results = dict(search_store_queries(store, queries, threshold=0.0, top_k=2))
+
+        assert list(results) == ["q1", "q2"]
+        assert [r["target_id"] for r in results["q1"]][0] == "mol1"
+        assert results["q2"][0]["smiles"] == "CCO"
+        assert all(len(hits) == 2 for hits in results.values())
@@ -85,6 +85,208 @@ class TestSMIReader:
         assert records[0].smiles is not None
 
 
+class TestRawRecords:
+    """Test unparsed raw record iteration."""
+
+    def test_csv_iter_raw(self, sample_csv):
+        """Test raw CSV rows carry SMILES and metadata but no Mol."""
+        from rdkit_cli.io.readers import create_reader
+
+        reader = create_reader(sample_csv, name_column="name")
+        rows = list(reader.iter_raw())
+
+        assert len(rows) == 5
+        assert rows[0].row_idx == 0
+        assert rows[0].smiles == "CC(=O)OC1=CC=CC=C1C(=O)O"
+        assert rows[0].name == "aspirin"
+        assert rows[0].metadata["name"] == "aspirin"
+
+    def test_iter_raw_without_metadata(self, sample_smi):
+        """Test raw rows skip metadata when not requested."""
+        from rdkit_cli.io.readers import create_reader
+
+        reader = create_reader(sample_smi)
+        rows = list(reader.iter_raw(with_metadata=False))
+
+        assert len(rows) == 5
+        assert all(row.metadata is None for row in rows)
+
+    def test_csv_values_kept_as_strings(self, tmp_dir):
+        """Test CSV values stay strings, with empty and quoted fields preserved."""
+        from rdkit_cli.io.readers import create_reader
+
+        csv_path = tmp_dir / "typed.csv"
+        csv_path.write_text('smiles,id,note\nCCO,007,\nc1ccccc1,2,"a, b"\n')
+
+        rows = list(create_reader(csv_path).iter_raw())
+
+        assert rows[0].metadata == {"smiles": "CCO", "id": "007", "note": ""}
+        assert rows[1].metadata["note"] == "a, b"
+
+    def test_csv_without_header(self, tmp_dir):
+        """Test headerless CSV treats the first column as SMILES."""
+        from rdkit_cli.io.readers import CSVReader
+
+        csv_path = tmp_dir / "noheader.csv"
+        csv_path.write_text("CCO,ethanol\nCC,ethane\n")
+
+        rows = list(CSVReader(csv_path, has_header=False).iter_raw())
+
+        assert [row.smiles for row in rows] == ["CCO", "CC"]
+        assert rows[1].metadata == {"smiles": "CC", "col_1": "ethane"}
+
+    def test_csv_byte_order_mark(self, tmp_dir):
+        """Test a UTF-8 BOM (Excel export) does not end up in the first column name."""
+        from rdkit_cli.io.readers import CSVReader
+
+        csv_path = tmp_dir / "excel.csv"
+        csv_path.write_bytes("smiles,name\nCCO,ethanol\n".encode("utf-8-sig"))
+
+        rows = list(CSVReader(csv_path, name_column="name").iter_raw())
+
+        assert [(row.smiles, row.name) for row in rows] == [("CCO", "ethanol")]
+        assert list(rows[0].metadata) == ["smiles", "name"]
+
+    def test_csv_ragged_rows(self, tmp_dir):
+        """Test short rows are padded and extra values dropped instead of failing the read."""
+        from rdkit_cli.io.readers import CSVReader
+
+        csv_path = tmp_dir / "ragged.csv"
+        csv_path.write_text(
+            "smiles,name,mw\nCCO,ethanol,46\nCC\nC,methane,16,extra\nCCC,propane,44\n"
+        )
+
+        rows = list(CSVReader(csv_path, name_column="name").iter_raw())
+
+        assert [row.row_idx for row in rows] == [0, 1, 2, 3]
+        assert [row.smiles for row in rows] == ["CCO", "CC", "C", "CCC"]
+        assert rows[1].metadata == {"smiles": "CC", "name": "", "mw": ""}
+        assert rows[2].metadata == {"smiles": "C", "name": "methane", "mw": "16"}
+        assert len(CSVReader(csv_path)) == 4
+
+    def test_parquet_projection(self, tmp_dir):
+        """Test Parquet rows without metadata match full rows on SMILES and name."""
+        import pandas as pd
+        from rdkit_cli.io.readers import ParquetReader
+
+        path = tmp_dir / "wide.parquet"
+        df = pd.DataFrame({"smiles": ["CCO", "CC"], "name": ["a", "b"]})
+        for i in range(20):
+            df[f"extra_{i}"] = [float(i), None]
+        df.to_parquet(path)
+
+        reader = ParquetReader(path, name_column="name")
+        full = list(reader.iter_raw())
+        projected = list(reader.iter_raw(with_metadata=False))
+
+        assert [(r.row_idx, r.smiles, r.name) for r in projected] == [
+            (r.row_idx, r.smiles, r.name) for r in full
+        ]
+        assert full[1].metadata["extra_3"] is None
+        assert all(r.metadata is None for r in projected)
+
+    def test_parse_record(self):
+        """Test parsing a raw row into a MoleculeRecord."""
+        from rdkit_cli.io.readers import parse_record
+
+        record = parse_record(3, "CCO", "ethanol")
+
+        assert record.mol is not None
+        assert record.row_idx == 3
+        assert record.name == "ethanol"
+        assert record.metadata == {}
+
+    def test_smi_parse_warning_line_number(self, tmp_dir, capsys, monkeypatch):
+        """Test that SMI parse warnings give 1-based line numbers, in the parent and via raw_parser."""
+        from rdkit_cli.io.readers import SMIReader
+
+        monkeypatch.setattr("rdkit_cli.utils.logging._app_warnings_suppressed", False)
+        path = tmp_dir / "bad.smi"
+        path.write_text("CCO ethanol\nnot_a_smiles bad\n")
+        reader = SMIReader(path)
+
+        records = list(reader)
+        assert "at row 2: not_a_smiles" in capsys.readouterr().err
+        assert records[1].mol is None and records[1].row_idx == 1
+
+        reader.raw_parser(*list(reader.iter_raw())[1])
+        assert "at row 2: not_a_smiles" in capsys.readouterr().err
+
+    def test_sdf_iter_raw(self, tmp_dir):
+        """Test raw SDF entries carry the molfile block and SD properties."""
+        from rdkit import Chem
+        from rdkit_cli.io.readers import SDFReader, parse_molblock_record
+
+        path = tmp_dir / "raw.sdf"
+        writer = Chem.SDWriter(str(path))
+        for smiles, name in [("CCO", "ethanol"), ("c1ccccc1", "benzene")]:
+            mol = Chem.MolFromSmiles(smiles)
+            mol.SetProp("_Name", name)
+            mol.SetProp("source", f"{name} db")
+            writer.write(mol)
+        writer.close()
+
+        rows = list(SDFReader(path).iter_raw())
+
+        assert len(rows) == 2
+        assert rows[1].metadata == {"source": "benzene db"}
+        assert "M  END" in rows[1].smiles
+        assert "source" not in rows[1].smiles
+
+        record = parse_molblock_record(*rows[1])
+
+        assert record.smiles == "c1ccccc1"
+        assert record.name == "benzene"
+        assert record.metadata == {"source": "benzene db"}
+
+    def test_sdf_multiline_property(self, tmp_dir):
+        """Test multi-line SD property values are joined and entries split on $$$$."""
+        from rdkit_cli.io.readers import SDFReader
+
+        block = "mol\n  test\n\n  0  0  0  0  0  0  0  0  0  0999 V2000\nM  END\n"
+        path = tmp_dir / "props.sdf"
+        path.write_text(block + ">  <note>  (1)\nline one\nline two\n\n$$$$\n" + block + "$$$$\n")
+
+        rows = list(SDFReader(path).iter_raw())
+
+        assert [row.row_idx for row in rows] == [0, 1]
+        assert rows[0].metadata == {"note": "line one\nline two"}
+        assert rows[1].metadata == {}
+
+    def test_sdf_iter_raw_across_blocks(self, tmp_dir, monkeypatch):
+        """Test entries split across scan blocks, CRLF line ends and a bare leading $$$$."""
+        from rdkit_cli.io import readers
+
+        block = "mol\r\n  test\r\n\r\nM  END\r\n"
+        path = tmp_dir / "blocks.sdf"
+        path.write_bytes(
+            ("$$$$\r\n" + block + ">  <id>\r\n7\r\n\r\n$$$$\r\n" + block).encode()
+        )
+        monkeypatch.setattr(readers, "_COUNT_BLOCK_SIZE", 4)
+
+        rows = list(readers.SDFReader(path).iter_raw())
+
+        assert [row.row_idx for row in rows] == [0, 1, 2]
+        assert rows[0].smiles == ""
+        assert rows[1].smiles == "mol\n  test\n\nM  END\n"
+        assert rows[1].metadata == {"id": "7"}
+        assert rows[2].smiles == rows[1].smiles and rows[2].metadata == {}
+
+    def test_sdf_iter_raw_from(self, tmp_dir, monkeypatch):
+        """Test iter_raw_from skips to an entry and keeps the row indices of iter_raw."""
+        from rdkit_cli.io import readers
+
+        path = tmp_dir / "from.sdf"
+        path.write_text("".join(f"m{i}\n\nM  END\n> <i>\n{i}\n\n$$$$\n" for i in range(6)))
+        monkeypatch.setattr(readers, "_COUNT_BLOCK_SIZE", 7)
+
+        reader = readers.SDFReader(path)
+        rows = list(reader.iter_raw())
+
+        for start in range(8):
+            assert list(reader.iter_raw_from(start)) == rows[start:]
+
+
 class TestCSVWriter:
     """Test CSV writer."""
 
@@ -122,6 +324,51 @@ class TestCSVWriter:
         assert "C" in content
 
 
+class TestCSVWriterArrow:
+    """Test columnar CSV writing."""
+
+    def test_write_arrow_quoting_and_nulls(self, output_csv):
+        """Test that Arrow batches are quoted and nulls replaced."""
+        import pyarrow as pa
+        from rdkit_cli.io.writers import CSVWriter
+
+        batch = pa.RecordBatch.from_pydict({
+            "smiles": ["CCO", "C"],
+            "name": ["ethanol, abs", "methane"],
+            "count": [1, None],
+            "value": [1.5, None],
+        })
+
+        with CSVWriter(output_csv, null_value="NaN") as writer:
+            writer.write_arrow(batch)
+
+        lines = output_csv.read_text().splitlines()
+        assert lines[0] == "smiles,name,count,value"
+        assert lines[1] == 'CCO,"ethanol, abs",1,1.5'
+        assert lines[2] == "C,methane,NaN,NaN"
+
+    def test_write_arrow_matches_write_batch(self, tmp_dir):
+        """Test that Arrow formatting of floats, integers and strings matches the row path."""
+        import pyarrow as pa
+        from rdkit_cli.io.writers import CSVWriter
+
+        columns = {
+            "text": ["a", 'say "hi"', "x\ny", "1,2", "", "b", "c", "d", "e", "f"],
+            "count": [0, -3, 12, 10**12, 7, 1, 2, 3, 4, 5],
+            "value": [1.0, 2.5, 1e-05, 1e16, 123.456, -0.0, 1e15, float("nan"), 0.1, -7.25e-7],
+        }
+        rows = [dict(zip(columns, values)) for values in zip(*columns.values())]
+
+        row_path = tmp_dir / "rows.csv"
+        with CSVWriter(row_path) as writer:
+            writer.write_batch(rows)
+        arrow_path = tmp_dir / "arrow.csv"
+        with CSVWriter(arrow_path) as writer:
+            writer.write_arrow(pa.RecordBatch.from_pydict(columns))
+
+        assert arrow_path.read_text() == row_path.read_text()
+
+
 class TestSMIWriter:
     """Test SMI writer."""
 
@@ -140,6 +387,121 @@ class TestSMIWriter:
         assert "CCO" in content
 
 
+class TestParquetWriter:
+    """Test streaming Parquet writer."""
+
+    def test_write_multiple_row_groups(self, tmp_dir):
+        """Test that flushes append row groups to a single file."""
+        import pyarrow.parquet as pq
+        from rdkit_cli.io.writers import ParquetWriter
+
+        path = tmp_dir / "out.parquet"
+        writer = ParquetWriter(path, columns=["smiles", "value"], row_group_size=10)
+
+        with writer:
+            for i in range(3):
+                writer.write_batch([{"smiles": "C" * (j + 1), "value": float(j)} for j in range(10)])
+            writer.write_row({"smiles": "CCO", "value": 1.5})
+
+        pf = pq.ParquetFile(path)
+        assert pf.metadata.num_rows == 31
+        assert pf.metadata.num_row_groups == 4
+        assert pf.schema_arrow.names == ["smiles", "value"]
+
+    def test_schema_widened_before_first_flush(self, tmp_dir):
+        """Test that types and columns are unified over the rows buffered for the first group."""
+        import pyarrow.parquet as pq
+        from rdkit_cli.io.writers import ParquetWriter
+
+        path = tmp_dir / "out.parquet"
+        writer = ParquetWriter(path, row_group_size=4, null_value="NaN")
+
+        with writer:
+            writer.write_batch([
+                {"smiles": "C", "value": 1},
+                {"smiles": "CC", "value": 2.5, "extra": "x"},
+                {"smiles": "CCC", "value": "NaN"},
+                {"smiles": "CCCC", "value": 4},
+                {"smiles": "CCCCC", "value": "NaN"},
+                {"smiles": "CCCCCC"},
+            ])
+
+        table = pq.read_table(path)
+        assert table.column_names == ["smiles", "value", "extra"]
+        assert table.column("value").to_pylist() == [1.0, 2.5, None, 4.0, None, None]
+        assert table.column("extra").to_pylist() == [None, "x", None, None, None, None]
+
+    def test_arrow_schema_unified_before_first_flush(self, tmp_dir):
+        """Test that buffered Arrow batches are unified (int to float) at the first flush."""
+        import pyarrow as pa
+        import pyarrow.parquet as pq
+        from rdkit_cli.io.writers import ParquetWriter
+
+        path = tmp_dir / "out.parquet"
+        with ParquetWriter(path, row_group_size=10) as writer:
+            writer.write_arrow(pa.RecordBatch.from_pydict({"smiles": ["C"], "value": [1]}))
+            writer.write_arrow(pa.RecordBatch.from_pydict({"smiles": ["CC"], "value": [2.5]}))
+
+        assert pq.read_table(path).column("value").to_pylist() == [1.0, 2.5]
+
+    def test_new_column_after_first_group_is_error(self, tmp_dir):
+        """Test that a column first seen in row group 2 fails loudly, leaving a readable file."""
+        import pyarrow.parquet as pq
+        from rdkit_cli.io.writers import ParquetWriter
+
+        path = tmp_dir / "out.parquet"
+        with pytest.raises(ValueError, match="extra"):
+            with ParquetWriter(path, row_group_size=2) as writer:
+                writer.write_batch([
+                    {"smiles": "C", "value": 1.0},
+                    {"smiles": "CC", "value": 2.0},
+                    {"smiles": "CCC", "value": 3.0, "extra": "late"},
+                ])
+
+        table = pq.read_table(path)
+        assert table.column_names == ["smiles", "value"]
+        assert table.num_rows == 2
+
+    def test_error_value_after_first_group(self, tmp_dir):
+        """Test that the error value in a later row group is written as null."""
+        import pyarrow.parquet as pq
+        from rdkit_cli.io.writers import create_writer
+
+        path = tmp_dir / "out.parquet"
+        with create_writer(path, row_group_size=2, null_value="NaN") as writer:
+            writer.write_batch([
+                {"smiles": "C", "value": 1.0},
+                {"smiles": "CC", "value": 2.0},
+                {"smiles": "CCC", "value": "NaN"},
+            ])
+
+        assert pq.read_table(path).column("value").to_pylist() == [1.0, 2.0, None]
+
+    def test_compression(self, tmp_dir):
+        """Test configurable compression codec."""
+        import pyarrow.parquet as pq
+        from rdkit_cli.io.writers import create_writer
+
+        path = tmp_dir / "out.parquet"
+        with create_writer(path, compression="zstd") as writer:
+            writer.write_row({"smiles": "CCO"})
+
+        codec = pq.ParquetFile(path).metadata.row_group(0).column(0).compression
+        assert codec.upper() == "ZSTD"
+
+    def test_overwrites_existing_file(self, tmp_dir):
+        """Test that an existing output file is replaced, not appended to."""
+        import pyarrow.parquet as pq
+        from rdkit_cli.io.writers import ParquetWriter
+
+        path = tmp_dir / "out.parquet"
+        for _ in range(2):
+            with ParquetWriter(path) as writer:
+                writer.write_row({"smiles": "CCO"})
+
+        assert pq.read_table(path).num_rows == 1
+
+
 class TestMoleculeRecord:
     """Test MoleculeRecord class."""
 
@@ -178,3 +540,105 @@ class TestMoleculeRecord:
 
         assert record.mol is None
         assert record.smiles == "invalid"
+
+
+class TestRecordCounting:
+    """Test record counting and estimation for progress totals."""
+
+    def test_smi_count(self, tmp_dir):
+        """Test line counting handles a missing final newline."""
+        from rdkit_cli.io.readers import SMIReader
+
+        path = tmp_dir / "count.smi"
+        path.write_text("CCO a\nCC b\nCCC c")
+
+        assert len(SMIReader(path)) == 3
+
+    def test_sdf_count_across_blocks(self, tmp_dir, monkeypatch):
+        """Test $$$$ delimiters split across scan blocks are counted once."""
+        from rdkit_cli.io import readers
+
+        path = tmp_dir / "count.sdf"
+        path.write_text("mol\n  header\n\nM  END\n$$$$\n" * 7)
+        monkeypatch.setattr(readers, "_COUNT_BLOCK_SIZE", 3)
+
+        assert len(readers.SDFReader(path)) == 7
+
+    def test_sdf_count_unterminated_last_entry(self, tmp_dir, monkeypatch):
+        """Test a last entry without a closing $$$$ is counted, as iter_raw yields it."""
+        from rdkit_cli.io import readers
+
+        entry = "mol\n  header\n\nM  END\n"
+        path = tmp_dir / "open.sdf"
+        path.write_text(entry + "$$$$\n" + entry + "$$$$\n" + entry)
+        monkeypatch.setattr(readers, "_COUNT_BLOCK_SIZE", 5)
+
+        reader = readers.SDFReader(path)
+        assert len(reader) == 3
+        assert len(reader) == len(list(reader.iter_raw()))
+
+        # Blank lines after the last $$$$ are not an entry
+        path.write_text((entry + "$$$$\n") * 2 + "\n  \n")
+        assert len(readers.SDFReader(path)) == 2
+
+    def test_estimate_small_file_is_exact(self, sample_csv):
+        """Test estimates are exact when the whole file fits in the sample."""
+        from rdkit_cli.io.readers import create_reader
+
+        assert create_reader(sample_csv).estimate_len() == 5
+
+    def test_estimate_large_file(self, tmp_dir, monkeypatch):
+        """Test estimates extrapolate from the start of the file."""
+        from rdkit_cli.io import readers
+
+        path = tmp_dir / "large.smi"
+        path.write_text("CCO ethanol\n" * 1000)
+        monkeypatch.setattr(readers, "_ESTIMATE_SAMPLE_SIZE", 120)
+
+        assert readers.SMIReader(path).estimate_len() == 1000
+
+    def test_progress_skips_count_when_quiet(self, sample_smi, monkeypatch):
+        """Test quiet progress uses the estimate instead of a full count."""
+        from rdkit_cli.io.readers import create_reader
+        from rdkit_cli.progress import NinjaProgress
+
+        reader = create_reader(sample_smi)
+        monkeypatch.setattr(type(reader), "__len__", lambda self: pytest.fail("counted"))
+
+        progress = NinjaProgress.for_reader(reader, quiet=True)
+
+        assert progress.estimated
+        assert progress.total == 5
+
+    def test_estimated_total_grows(self):
+        """Test an estimated total is raised when exceeded and exact at the end."""
+        import io
+        from rdkit_cli.progress import NinjaProgress
+
+        out = io.StringIO()
+        progress = NinjaProgress(total=2, estimated=True, file=out, update_interval=0)
+        progress.start()
+        progress.update(3)
+
+        assert progress.total == 3
+        assert "/~" in out.getvalue()
+
+        progress.finish()
+
+        assert not progress.estimated
+        assert out.getvalue().rstrip().rsplit("\r", 1)[-1].startswith("[3/3]")
+
+    def test_set_total_keeps_estimate(self):
+        """Test set_total keeps an estimated total estimated unless told it is exact."""
+        from rdkit_cli.progress import NinjaProgress
+
+        progress = NinjaProgress(total=100, quiet=True, estimated=True)
+        progress.set_total(60)
+
+        assert progress.total == 60
+        assert progress.estimated
+
+        progress.set_total(40, exact=True)
+
+        assert progress.total == 40
+        assert not progress.estimated
@@ -77,3 +77,44 @@ class TestMoleculeMerger:
 
         stats = merger.get_stats()
         assert stats["unique_molecules"] == 2
+
+    def _vendor_files(self, tmp_dir):
+        files = []
+        for i, content in enumerate([
+            "smiles,name\nCCO,a\nCCC,b\n",
+            "smiles,name\nOCC,c\nc1ccccc1,d\n",
+            "smiles,name\nCCC,e\nCC(=O)C,f\n",
+        ]):
+            path = tmp_dir / f"vendor{i}.csv"
+            path.write_text(content)
+            files.append(path)
+        return files
+
+    @pytest.mark.parametrize("n_workers", [1, 2])
+    def test_merge_parallel_keeps_file_row_order(self, tmp_dir, n_workers):
+        """Test that parallel merging keeps (file, row) order and first occurrences."""
+        from rdkit_cli.core.merge import MoleculeMerger
+
+        merger = MoleculeMerger(deduplicate=True, n_workers=n_workers)
+        results = list(merger.merge_files(self._vendor_files(tmp_dir)))
+
+        assert [r["name"] for r in results] == ["a", "b", "d", "f"]
+        assert merger.get_stats()["unique_molecules"] == 4
+
+    def test_merge_spill_partitioned(self, tmp_dir):
+        """Test deduplication through hash-partitioned runs."""
+        from rdkit_cli.core.merge import MoleculeMerger
+
+        spill = tmp_dir / "spill"
+        merger = MoleculeMerger(deduplicate=True, n_workers=2, spill_dir=spill, n_partitions=2)
+        results = list(merger.merge_files(self._vendor_files(tmp_dir)))
+
+        assert [r["name"] for r in results] == ["a", "b", "d", "f"]
+        assert list(spill.iterdir()) == []
+
+    def test_invalid_dedupe_key(self):
+        """Test error on unknown dedupe key."""
+        from rdkit_cli.core.merge import MoleculeMerger
+
+        with pytest.raises(ValueError, match="Unknown dedupe_key"):
+            MoleculeMerger(dedupe_key="scaffold")
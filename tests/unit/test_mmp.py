@@ -70,6 +70,84 @@ class TestFindMatchedPairs:
         assert isinstance(pairs, list)
 
 
+class TestMatchedPairFinder:
+    """Test indexed, streamed pair finding."""
+
+    MOLECULES = [
+        (0, "c1ccccc1CCO", "a"),
+        (1, "c1ccccc1CCN", "b"),
+        (2, "c1ccccc1CCC", "c"),
+        (3, "not_a_smiles", "bad"),
+        (4, "Cc1ccccc1CCO", "d"),
+    ]
+
+    def test_core_heavy_atoms(self):
+        """Test heavy atom count excludes attachment points."""
+        from rdkit_cli.core.mmp import core_heavy_atoms
+
+        assert core_heavy_atoms("c1ccc([*:1])cc1") == 6
+        assert core_heavy_atoms("[*:1]CC[*:2]") == 2
+
+    def test_core_index_groups(self, tmp_path):
+        """Test that the index groups members by core in input order."""
+        from rdkit_cli.core.mmp import CoreIndex
+
+        index = CoreIndex(tmp_path, n_partitions=2)
+        index.add("X", 0, "s0", "", "r0")
+        index.add("Y", 1, "s1", "", "r1")
+        index.add("X", 2, "s2", "", "r2")
+        groups = dict(index.groups())
+
+        assert [m[0] for m in groups["X"]] == [0, 2]
+        assert [m[0] for m in groups["Y"]] == [1]
+
+    def test_parallel_matches_serial(self):
+        """Test that worker fragmentation gives the same pairs."""
+        from rdkit_cli.core.mmp import MatchedPairFinder
+
+        def run(n_workers):
+            finder = MatchedPairFinder(max_cuts=2, min_core_size=1, n_workers=n_workers)
+            return sorted(tuple(sorted(p.items())) for p in finder.pairs(self.MOLECULES))
+
+        serial = run(1)
+        assert serial
+        assert run(2) == serial
+
+    def test_transformation_counts_match_pairs(self):
+        """Test aggregation without materializing pairs."""
+        from collections import Counter
+        from rdkit_cli.core.mmp import MatchedPairFinder
+
+        finder = MatchedPairFinder(max_cuts=2, min_core_size=1)
+        from_pairs = Counter(p["transformation"] for p in finder.pairs(self.MOLECULES))
+
+        assert finder.transformation_counts(self.MOLECULES) == from_pairs
+        assert finder.n_molecules == 4
+
+    def test_max_group_size(self):
+        """Test that oversized core groups are skipped."""
+        from rdkit_cli.core.mmp import MatchedPairFinder
+
+        unbounded = MatchedPairFinder(max_cuts=2, min_core_size=1)
+        bounded = MatchedPairFinder(max_cuts=2, min_core_size=1, max_group_size=2)
+        n_all = len(list(unbounded.pairs(self.MOLECULES)))
+        n_bounded = len(list(bounded.pairs(self.MOLECULES)))
+
+        assert bounded.n_skipped_groups > 0
+        assert n_bounded < n_all
+
+    def test_count_group_transformations(self):
+        """Test counting against explicit pair enumeration."""
+        from collections import Counter
+        from rdkit_cli.core.mmp import count_group_transformations, iter_group_pairs
+
+        members = [(i, f"s{i}", "", r) for i, r in enumerate("abab")]
+        counter = Counter()
+        count_group_transformations(members, counter)
+
+        assert counter == Counter(p["transformation"] for p in iter_group_pairs("X", members))
+
+
 class TestMMPFragmenter:
     """Test MMPFragmenter class."""
 
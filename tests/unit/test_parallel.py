@@ -0,0 +1,645 @@
+"""Unit tests for parallel module."""
+
+import pytest
+
+
+class TestParallelExecutor:
+    """Test ParallelExecutor class."""
+
+    def test_map_ordered_sequential(self):
+        """Test ordered map with a single worker."""
+        from rdkit_cli.parallel.executor import ParallelExecutor
+
+        executor = ParallelExecutor(abs, n_workers=1)
+        assert executor.map_ordered([-3, 1, -2]) == [3, 1, 2]
+
+    def test_map_ordered_one_shot_pool(self):
+        """Test ordered map without the context manager."""
+        from rdkit_cli.parallel.executor import ParallelExecutor
+
+        executor = ParallelExecutor(abs, n_workers=2)
+        items = list(range(-50, 50))
+
+        assert executor.map_ordered(items) == [abs(i) for i in items]
+        assert not executor.is_running
+
+    def test_persistent_pool_reused(self):
+        """Test that one pool serves every map call inside the context."""
+        from rdkit_cli.parallel.executor import ParallelExecutor
+
+        executor = ParallelExecutor(abs, n_workers=2)
+        if executor.n_workers < 2:
+            pytest.skip("Requires at least 2 CPUs")
+
+        with executor:
+            assert executor.is_running
+            pool = executor._pool
+
+            first = executor.map_ordered(list(range(-20, 0)))
+            second = executor.map_ordered(list(range(0, 20)))
+
+            assert executor._pool is pool
+
+        assert not executor.is_running
+        assert first == [abs(i) for i in range(-20, 0)]
+        assert second == list(range(0, 20))
+
+    def test_map_unordered_persistent(self):
+        """Test unordered map on the persistent pool."""
+        from rdkit_cli.parallel.executor import ParallelExecutor
+
+        with ParallelExecutor(abs, n_workers=2) as executor:
+            results = list(executor.map_unordered([-1, -2, -3, -4]))
+
+        assert sorted(results) == [1, 2, 3, 4]
+
+
+class _ListWriter:
+    """Minimal writer that collects written rows."""
+
+    def __init__(self):
+        self.rows = []
+
+    def write_batch(self, data):
+        self.rows.extend(data)
+
+
+class TestPlanParallelism:
+    """Test splitting cores between processes and threads."""
+
+    def test_processes_preferred_on_large_inputs(self, monkeypatch):
+        """Test that many items get one thread per worker process."""
+        from rdkit_cli.parallel.executor import plan_parallelism
+
+        monkeypatch.setattr("os.cpu_count", lambda: 8)
+        assert plan_parallelism(-1, 1000, 10) == (8, 1)
+        assert plan_parallelism(4, 1000, 10) == (4, 1)
+
+    def test_leftover_cores_become_threads(self, monkeypatch):
+        """Test that few items share the cores as threads, never oversubscribing."""
+        from rdkit_cli.parallel.executor import plan_parallelism
+
+        monkeypatch.setattr("os.cpu_count", lambda: 8)
+        assert plan_parallelism(-1, 1, 10) == (1, 8)
+        assert plan_parallelism(-1, 3, 10) == (3, 2)
+        assert plan_parallelism(-1, 1, 4) == (1, 4)
+        assert plan_parallelism(1, 1, 10) == (1, 1)
+        for n_items in range(0, 20):
+            n_workers, threads = plan_parallelism(-1, n_items, 10)
+            assert n_workers * threads <= 8
+
+
+class TestMoleculePipeline:
+    """Test pipelined read -> compute -> write."""
+
+    def test_results_written_in_order(self):
+        """Test that results arrive at the writer in input order."""
+        from rdkit_cli.parallel.executor import ParallelExecutor
+        from rdkit_cli.parallel.pipeline import MoleculePipeline
+        from rdkit_cli.progress.ninja import NinjaProgress
+
+        writer = _ListWriter()
+        items = list(range(-300, 300))
+
+        with ParallelExecutor(abs, n_workers=2) as executor:
+            pipeline = MoleculePipeline(
+                executor,
+                writer,
+                NinjaProgress(total=len(items), quiet=True),
+                chunk_size=7,
+                max_in_flight=3,
+                write_buffer_size=50,
+            )
+            successful, failed = pipeline.run(iter(items))
+
+        assert successful == len(items)
+        assert failed == 0
+        assert writer.rows == [abs(i) for i in items]
+
+    def test_worker_error_propagates(self):
+        """Test that an exception in a worker is raised to the caller."""
+        from rdkit_cli.parallel.executor import ParallelExecutor
+        from rdkit_cli.parallel.pipeline import MoleculePipeline
+        from rdkit_cli.progress.ninja import NinjaProgress
+
+        items = ["1", "2", "x"] * 20
+
+        with ParallelExecutor(int, n_workers=2) as executor:
+            pipeline = MoleculePipeline(
+                executor,
+                _ListWriter(),
+                NinjaProgress(total=len(items), quiet=True),
+                chunk_size=4,
+            )
+            with pytest.raises(ValueError):
+                pipeline.run(iter(items))
+
+    def test_sort_key_dispatches_costliest_first(self):
+        """Test that a sort key reorders dispatch per window but not output."""
+        from concurrent.futures import Future
+
+        from rdkit_cli.parallel.pipeline import MoleculePipeline
+        from rdkit_cli.progress.ninja import NinjaProgress
+
+        class RecordingExecutor:
+            n_workers = 2
+
+            def __init__(self):
+                self.dispatched = []
+
+            def submit_chunk(self, tasks):
+                self.dispatched.extend(tasks)
+                future = Future()
+                future.set_result([-task for task in tasks])
+                return future
+
+        executor = RecordingExecutor()
+        writer = _ListWriter()
+        items = [3, 9, 1, 7, 5, 8, 2, 6]
+
+        pipeline = MoleculePipeline(
+            executor,
+            writer,
+            NinjaProgress(total=len(items), quiet=True),
+            chunk_size=100,
+            sort_key=float,
+            sort_window=4,
+        )
+        successful, failed = pipeline.run(iter(items))
+
+        assert (successful, failed) == (len(items), 0)
+        assert executor.dispatched == [9, 7, 3, 1, 8, 6, 5, 2]
+        assert writer.rows == [-i for i in items]
+
+
+class TestProcessMolecules:
+    """Test process_molecules batch driver."""
+
+    def test_parallel_matches_sequential(self, sample_csv, tmp_dir):
+        """Test that parallel and sequential runs give identical output."""
+        from rdkit_cli.core.descriptors import DescriptorCalculator
+        from rdkit_cli.io import create_reader, create_writer
+        from rdkit_cli.parallel.batch import process_molecules
+
+        calculator = DescriptorCalculator(descriptors=["MolWt", "TPSA"])
+        outputs = {}
+
+        for n_workers in (1, 2):
+            output = tmp_dir / f"out_{n_workers}.csv"
+            reader = create_reader(sample_csv)
+            writer = create_writer(output, columns=calculator.get_column_names())
+            with reader, writer:
+                result = process_molecules(
+                    reader=reader,
+                    writer=writer,
+                    processor=calculator.compute,
+                    n_workers=n_workers,
+                    quiet=True,
+                    batch_size=2,
+                )
+            assert result.successful == 5
+            outputs[n_workers] = output.read_text()
+
+        assert outputs[1] == outputs[2]
+
+
+    def test_parallel_join_metadata(self, sample_csv, tmp_dir):
+        """Test that metadata is re-joined in the parent for filters."""
+        from rdkit_cli.core.filters import ElementFilter
+        from rdkit_cli.io import create_reader, create_writer
+        from rdkit_cli.parallel.batch import process_molecules
+
+        filter_obj = ElementFilter(allowed_elements=["C", "O", "N"])
+        output = tmp_dir / "filtered.csv"
+
+        reader = create_reader(sample_csv)
+        writer = create_writer(output)
+        with reader, writer:
+            process_molecules(
+                reader=reader,
+                writer=writer,
+                processor=filter_obj.filter,
+                n_workers=2,
+                quiet=True,
+                batch_size=2,
+                join_metadata=True,
+            )
+
+        header = output.read_text().splitlines()[0]
+        assert header.split(",") == ["smiles", "name"]
+
+    def test_split_record_keeps_metadata_in_parent(self):
+        """Test that parsed records are dispatched without their metadata."""
+        from rdkit import Chem
+        from rdkit_cli.io.readers import MoleculeRecord
+        from rdkit_cli.parallel.batch import _split_record
+
+        mol = Chem.MolFromSmiles("CCO")
+        record = MoleculeRecord(mol, "CCO", "ethanol", {"source": "db"}, row_idx=3)
+
+        task, metadata = _split_record(record)
+
+        assert metadata == {"source": "db"}
+        assert task.metadata == {}
+        assert (task.mol, task.smiles, task.name, task.row_idx) == (mol, "CCO", "ethanol", 3)
+
+
+class TestWorkerState:
+    """Test per-worker processor state handling."""
+
+    def test_pains_filter_pickle_rebuilds_catalog(self):
+        """Test that PAINSFilter rebuilds its catalog after unpickling."""
+        import pickle
+        from rdkit import Chem
+        from rdkit_cli.core.filters import PAINSFilter
+        from rdkit_cli.io.readers import MoleculeRecord
+
+        filter_obj = PAINSFilter(catalog_name="brenk")
+        clone = pickle.loads(pickle.dumps(filter_obj))
+
+        assert clone.catalog_name == "brenk"
+        assert clone.catalog is not None
+
+        mol = Chem.MolFromSmiles("CCO")
+        record = MoleculeRecord(mol=mol, smiles="CCO")
+        assert clone.filter(record) == filter_obj.filter(record)
+
+    def test_fingerprint_generator_cached(self):
+        """Test that fingerprint generators are built once per process."""
+        from rdkit_cli.core.fingerprints import get_fingerprint_generator, FingerprintType
+
+        gen1 = get_fingerprint_generator(FingerprintType.MORGAN, 1024, 2)
+        gen2 = get_fingerprint_generator(FingerprintType.MORGAN, 1024, 2)
+        gen3 = get_fingerprint_generator(FingerprintType.MORGAN, 1024, 3)
+
+        assert gen1 is gen2
+        assert gen1 is not gen3
+        assert get_fingerprint_generator(FingerprintType.MACCS) is None
+
+
+class TestResultCache:
+    """Test the on-disk result cache."""
+
+    def test_hits_skip_processor(self, tmp_dir):
+        """Test that a cached molecule is not recomputed, even written differently."""
+        from rdkit import Chem
+        from rdkit_cli.io.readers import MoleculeRecord
+        from rdkit_cli.parallel.cache import CachedProcessor, ResultCache
+
+        calls = []
+
+        def processor(record):
+            calls.append(record.smiles)
+            return {"smiles": record.smiles, "name": record.name, "value": len(calls)}
+
+        cached = CachedProcessor(processor, ResultCache(tmp_dir, "test"))
+
+        first = cached(MoleculeRecord(mol=Chem.MolFromSmiles("OCC"), smiles="OCC", name="a"))
+        second = cached(MoleculeRecord(mol=Chem.MolFromSmiles("CCO"), smiles="CCO", name="b"))
+
+        assert calls == ["OCC"]
+        assert second == {"smiles": "CCO", "name": "b", "value": first["value"]}
+
+    def test_namespaces_are_separate(self, tmp_dir):
+        """Test that different calculator options do not share entries."""
+        from rdkit_cli.core.descriptors import DescriptorCalculator
+        from rdkit_cli.parallel.cache import cache_namespace
+
+        calc1 = DescriptorCalculator(descriptors=["MolWt"], precision=2)
+        calc2 = DescriptorCalculator(descriptors=["MolWt"], precision=4)
+
+        assert cache_namespace(calc1.compute) != cache_namespace(calc2.compute)
+        assert cache_namespace(lambda record: None) is None
+
+    def test_3d_descriptors_keyed_by_coordinates(self, tmp_dir):
+        """Test that another conformer of a cached molecule is recomputed."""
+        from rdkit import Chem
+        from rdkit.Chem import AllChem
+        from rdkit_cli.core.descriptors import DescriptorCalculator
+        from rdkit_cli.io.readers import MoleculeRecord
+        from rdkit_cli.parallel.cache import CachedProcessor, ResultCache, cache_namespace
+
+        calc = DescriptorCalculator(descriptors=["PMI1"], generate_conformers=False)
+        cached = CachedProcessor(calc.compute, ResultCache(tmp_dir, cache_namespace(calc.compute)))
+
+        records = []
+        for seed in (1, 7):
+            mol = Chem.AddHs(Chem.MolFromSmiles("CCCCCCO"))
+            AllChem.EmbedMolecule(mol, randomSeed=seed)
+            records.append(MoleculeRecord(mol=mol, smiles="CCCCCCO", name=str(seed)))
+
+        first = [cached(record) for record in records]
+        again = [cached(record) for record in records]
+
+        assert first == [calc.compute(record) for record in records]
+        assert again == first
+        assert first[0]["PMI1"] != first[1]["PMI1"]
+
+    def test_puts_written_in_batches(self, tmp_dir):
+        """Test that buffered entries are served locally and written on close."""
+        from rdkit_cli.parallel.cache import PUT_BATCH_SIZE, ResultCache
+
+        cache = ResultCache(tmp_dir, "test")
+        other = ResultCache(tmp_dir, "test")
+        n = PUT_BATCH_SIZE + 3
+        for i in range(n):
+            cache.put(cache.key(str(i)), {"value": i})
+
+        assert cache.get(cache.key(str(n - 1))) == {"value": n - 1}
+        assert other.get(cache.key("0")) == {"value": 0}
+        assert other.get(cache.key(str(n - 1))) is None
+
+        cache.close()
+        assert other.get(cache.key(str(n - 1))) == {"value": n - 1}
+        other.close()
+
+    def test_process_molecules_with_cache(self, sample_csv, tmp_dir):
+        """Test that a cached run gives the same output as an uncached one."""
+        from rdkit_cli.core.descriptors import DescriptorCalculator
+        from rdkit_cli.io import create_reader, create_writer
+        from rdkit_cli.parallel.batch import process_molecules
+        from rdkit_cli.parallel.cache import configure_cache
+
+        calc = DescriptorCalculator(descriptors=["MolWt", "TPSA"])
+        outputs = []
+        try:
+            configure_cache(tmp_dir / "cache")
+            for run in range(2):
+                output = tmp_dir / f"run{run}.csv"
+                with create_reader(sample_csv) as reader, create_writer(output) as writer:
+                    process_molecules(reader, writer, calc.compute, n_workers=1, quiet=True)
+                outputs.append(output.read_text())
+        finally:
+            configure_cache(None)
+
+        assert outputs[0] == outputs[1]
+        assert (tmp_dir / "cache" / "results.sqlite").exists()
+
+
+class TestShardedExecution:
+    """Test --shard row ranges and checkpointed resume."""
+
+    def test_shard_ranges_cover_input(self):
+        """Test that shards are contiguous, disjoint and cover every row."""
+        from rdkit_cli.parallel.shard import Shard, parse_shard
+
+        ranges = [Shard(i, 4).row_range(10) for i in range(1, 5)]
+        assert ranges == [(0, 2), (2, 5), (5, 7), (7, 10)]
+        assert parse_shard("2/4") == Shard(2, 4)
+
+        for bad in ("0/4", "5/4", "2", "a/b"):
+            with pytest.raises(ValueError):
+                parse_shard(bad)
+
+    def test_shard_outputs_concatenate(self, sample_csv, tmp_dir):
+        """Test that shard outputs in order equal the unsharded output."""
+        from rdkit_cli.core.concat import concat_files
+        from rdkit_cli.core.descriptors import DescriptorCalculator
+        from rdkit_cli.io import create_reader, create_writer
+        from rdkit_cli.parallel.batch import process_molecules
+        from rdkit_cli.parallel.shard import Shard, configure_shard
+
+        calc = DescriptorCalculator(descriptors=["MolWt"])
+
+        def run(output, shard=None):
+            try:
+                configure_shard(shard)
+                with create_reader(sample_csv) as reader, create_writer(output) as writer:
+                    return process_molecules(reader, writer, calc.compute, n_workers=1, quiet=True)
+            finally:
+                configure_shard(None)
+
+        run(tmp_dir / "full.csv")
+        shard_outputs = [tmp_dir / f"shard{i}.csv" for i in (1, 2)]
+        results = [run(path, Shard(i, 2)) for i, path in enumerate(shard_outputs, 1)]
+        concat_files(shard_outputs, tmp_dir / "joined.csv")
+
+        assert [r.total_processed for r in results] == [2, 3]
+        assert (tmp_dir / "joined.csv").read_text() == (tmp_dir / "full.csv").read_text()
+
+    def test_shards_cover_unterminated_sdf(self, tmp_dir):
+        """Test that shards of an SDF without a final $$$$ still cover every entry."""
+        from rdkit import Chem
+        from rdkit_cli.core.descriptors import DescriptorCalculator
+        from rdkit_cli.io import create_reader, create_writer
+        from rdkit_cli.parallel.batch import process_molecules
+        from rdkit_cli.parallel.shard import Shard, configure_shard
+
+        blocks = [Chem.MolToMolBlock(Chem.MolFromSmiles(smi)) for smi in ("C", "CC", "CCC", "CCO", "CCN")]
+        path = tmp_dir / "open.sdf"
+        path.write_text("$$$$\n".join(blocks))
+
+        calc = DescriptorCalculator(descriptors=["MolWt"])
+        processed = 0
+        try:
+            for i in (1, 2):
+                configure_shard(Shard(i, 2))
+                with create_reader(path) as reader, create_writer(tmp_dir / f"shard{i}.csv") as writer:
+                    result = process_molecules(reader, writer, calc.compute, n_workers=1, quiet=True)
+                processed += result.total_processed
+        finally:
+            configure_shard(None)
+
+        assert processed == 5
+
+    def test_checkpoint_resumes_after_interruption(self, sample_csv, tmp_dir):
+        """Test that a rerun skips committed segments and completes the output."""
+        from rdkit_cli.core.descriptors import DescriptorCalculator
+        from rdkit_cli.io import create_reader, create_writer
+        from rdkit_cli.parallel.batch import process_molecules
+        from rdkit_cli.parallel.checkpoint import configure_checkpoint
+
+        calc = DescriptorCalculator(descriptors=["MolWt"])
+        seen = []
+        preempt = [True]
+
+        def flaky(record):
+            seen.append(record.row_idx)
+            if record.row_idx == 3 and preempt[0]:
+                raise RuntimeError("preempted")
+            return calc.compute(record)
+
+        with create_reader(sample_csv) as reader, create_writer(tmp_dir / "full.csv") as writer:
+            process_molecules(reader, writer, calc.compute, n_workers=1, quiet=True)
+
+        try:
+            configure_checkpoint(tmp_dir / "ckpt", rows=2)
+            with pytest.raises(RuntimeError):
+                with create_reader(sample_csv) as reader, create_writer(tmp_dir / "out.csv") as writer:
+                    process_molecules(reader, writer, flaky, n_workers=1, quiet=True)
+
+            seen.clear()
+            preempt[0] = False
+            with create_reader(sample_csv) as reader, create_writer(tmp_dir / "out.csv") as writer:
+                result = process_molecules(reader, writer, flaky, n_workers=1, quiet=True)
+        finally:
+            configure_checkpoint(None)
+
+        # The first segment (rows 0-1) was not recomputed
+        assert seen == [2, 3, 4]
+        assert result.total_processed == 5
+        assert (tmp_dir / "out.csv").read_text() == (tmp_dir / "full.csv").read_text()
+
+    def test_checkpoint_rejects_other_run(self, sample_csv, tmp_dir):
+        """Test that a checkpoint of another processor is not resumed."""
+        from rdkit_cli.core.descriptors import DescriptorCalculator
+        from rdkit_cli.io import create_reader, create_writer
+        from rdkit_cli.parallel.batch import process_molecules
+        from rdkit_cli.parallel.checkpoint import configure_checkpoint
+
+        try:
+            configure_checkpoint(tmp_dir / "ckpt", rows=2)
+            for precision, expect_error in ((2, False), (4, True)):
+                calc = DescriptorCalculator(descriptors=["MolWt"], precision=precision)
+                with create_reader(sample_csv) as reader, create_writer(tmp_dir / "out.csv") as writer:
+                    if expect_error:
+                        with pytest.raises(ValueError, match="different run"):
+                            process_molecules(reader, writer, calc.compute, n_workers=1, quiet=True)
+                    else:
+                        process_molecules(reader, writer, calc.compute, n_workers=1, quiet=True)
+        finally:
+            configure_checkpoint(None)
+
+    def test_checkpoint_rejects_other_options(self, sample_csv, tmp_dir):
+        """Test that a processor without a cache key is told apart by the command options."""
+        from rdkit_cli.core.filters import SubstructureFilter
+        from rdkit_cli.io import create_reader, create_writer
+        from rdkit_cli.parallel.batch import process_molecules
+        from rdkit_cli.parallel.checkpoint import configure_checkpoint
+
+        def run(smarts):
+            configure_checkpoint(tmp_dir / "ckpt", rows=2, options={"smarts": smarts, "shape": (1, 2)})
+            filt = SubstructureFilter(smarts=smarts)
+            with create_reader(sample_csv) as reader, create_writer(tmp_dir / "out.csv") as writer:
+                return process_molecules(reader, writer, filt.filter, n_workers=1, quiet=True)
+
+        try:
+            run("c1ccccc1")
+            # Same options (tuples compare as stored in the manifest) resume
+            run("c1ccccc1")
+            with pytest.raises(ValueError, match="different run"):
+                run("C=O")
+        finally:
+            configure_checkpoint(None)
+
+
+class TestProfile:
+    """Test --profile stage timings and reports."""
+
+    def test_report_covers_stages(self, sample_csv, tmp_dir):
+        """Test that a profiled run reports stages, workers and slowest molecules."""
+        import json
+
+        from rdkit_cli.core.filters import ElementFilter
+        from rdkit_cli.io import create_reader, create_writer
+        from rdkit_cli.parallel.batch import process_molecules
+        from rdkit_cli.parallel.profile import STAGES, configure_profile
+
+        filter_obj = ElementFilter(allowed_elements=["C", "O", "N"])
+        outputs = {}
+
+        try:
+            for n_workers in (1, 2):
+                report_path = tmp_dir / f"profile_{n_workers}.json"
+                metrics_path = tmp_dir / f"metrics_{n_workers}.jsonl"
+                configure_profile(report_path, metrics_path=metrics_path)
+
+                output = tmp_dir / f"out_{n_workers}.csv"
+                with create_reader(sample_csv) as reader, create_writer(output) as writer:
+                    result = process_molecules(reader, writer, filter_obj.filter, n_workers=n_workers, quiet=True)
+                outputs[n_workers] = output.read_text()
+
+                report = json.loads(report_path.read_text())
+                assert set(report["stages"]) == set(STAGES)
+                assert report["items"] == result.total_processed == 5
+                assert report["successful"] == result.successful
+                assert report["stages"]["compute"]["count"] == 5
+                assert report["stages"]["write"]["count"] == result.successful
+                assert sum(w["items"] for w in report["workers"]) == 5
+                assert 1 <= len(report["slowest"]) <= 5
+                assert all(entry["smiles"] for entry in report["slowest"])
+
+                # The final snapshot is always written
+                snapshots = [json.loads(line) for line in metrics_path.read_text().splitlines()]
+                assert snapshots[-1]["items"] == 5
+        finally:
+            configure_profile(None)
+
+        # Profiling does not change the output
+        assert outputs[1] == outputs[2]
+
+    def test_profile_interval_validated(self):
+        """Test that a non-positive metrics interval is refused."""
+        from rdkit_cli.parallel.profile import configure_profile
+
+        with pytest.raises(ValueError):
+            configure_profile("report.json", metrics_interval=0)
+
+
+class TestJobServer:
+    """Test the warm job server and its client."""
+
+    @pytest.fixture
+    def server(self, tmp_dir):
+        import threading
+
+        from rdkit_cli.parallel.server import JobServer
+
+        job_server = JobServer(socket_path=tmp_dir / "server.sock", chunk_size=2, quiet=True)
+        job_server.start()
+        thread = threading.Thread(target=job_server.serve_forever, daemon=True)
+        thread.start()
+        yield job_server
+        job_server.shutdown()
+        thread.join(timeout=10)
+
+    def test_descriptors_in_input_order(self, server):
+        """Test a batch is answered row by row, failures as None."""
+        from rdkit_cli.parallel.client import ServerClient
+
+        with ServerClient(server.url) as client:
+            response = client.run(
+                "descriptors", ["CCO", "invalid", "c1ccccc1"], names=["ethanol", "bad", "benzene"],
+                options={"descriptors": "MolWt,TPSA"},
+            )
+        results = response["results"]
+        assert [row and row["name"] for row in results] == ["ethanol", None, "benzene"]
+        assert results[0]["MolWt"] == pytest.approx(46.069, abs=0.01)
+        assert response["successful"] == 2 and response["failed"] == 1
+
+    def test_filter_rejections_and_cached_processors(self, server):
+        """Test filter jobs report rejections and reuse their processor."""
+        from rdkit_cli.parallel import server as server_module
+        from rdkit_cli.parallel.client import ServerClient
+
+        options = {"steps": ["elements allowed=C,H,O"]}
+        with ServerClient(server.url) as client:
+            first = client.run("filter", ["CCO", "CCN"], options=options)
+            second = client.run("filter", ["CCCl"], options=options)
+
+        assert first["results"][0]["smiles"] == "CCO"
+        assert first["results"][1] is None
+        assert first["rejected"] == {"elements": 1} and second["rejected"] == {"elements": 1}
+        key = ("filter", server_module.options_key(options))
+        assert key in server_module._processors
+
+    def test_invalid_jobs_refused(self, server):
+        """Test unknown jobs and options are refused with the reason."""
+        from rdkit_cli.parallel.client import ServerClient, ServerError
+
+        with ServerClient(server.url) as client:
+            with pytest.raises(ServerError, match="Unknown job") as error:
+                client.run("nonexistent", ["CCO"])
+            assert error.value.status == 404
+            with pytest.raises(ServerError, match="Unknown option"):
+                client.run("descriptors", ["CCO"], options={"bogus": 1})
+            assert client.health()["requests"] == {}
+
+    def test_client_does_not_import_rdkit(self):
+        """Test the client module is standard library only."""
+        import subprocess
+        import sys
+
+        probe = "import sys, rdkit_cli.parallel.client; print('rdkit' in sys.modules)"
+        result = subprocess.run([sys.executable, "-c", probe], capture_output=True, text=True, timeout=60)
+        assert result.stdout.strip() == "False"
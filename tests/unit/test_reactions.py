@@ -113,6 +113,79 @@ class TestReactionEnumerator:
         with pytest.raises(ValueError):
             ReactionEnumerator(reaction_smarts="not_valid_smarts")
 
+
+ESTER_SMARTS = "[C:1](=[O:2])[OH].[OH:3][C:4]>>[C:1](=[O:2])[O:3][C:4]"
+
+
+@pytest.fixture
+def ester_reactants():
+    """Acids and alcohols giving some duplicate esters (repeated building blocks)."""
+    acids = [Chem.MolFromSmiles(s) for s in ["CC(=O)O", "CCC(=O)O", "OC(=O)c1ccccc1", "CC(=O)O"]]
+    alcohols = [Chem.MolFromSmiles(s) for s in ["CCO", "CO", "CC(C)O"]]
+    return [acids, alcohols]
+
+
+class TestStreamingEnumeration:
+    """Test ReactionEnumerator.enumerate_stream over the product space."""
+
+    def test_decode_follows_product_order(self):
+        """Test that flat indices decode in itertools.product order."""
+        from itertools import product
+
+        from rdkit_cli.core.reactions import decode_product_index
+
+        sizes = [3, 1, 4]
+        decoded = [decode_product_index(i, sizes) for i in range(12)]
+
+        assert decoded == list(product(range(3), range(1), range(4)))
+
+    def test_stream_matches_enumerate(self, ester_reactants):
+        """Test that sharded streaming gives the serial result, in order."""
+        from rdkit_cli.core.reactions import ReactionEnumerator
+
+        enumerator = ReactionEnumerator(ESTER_SMARTS, max_products=0)
+        expected = ReactionEnumerator(ESTER_SMARTS).enumerate(ester_reactants)
+
+        for n_workers in (1, 2):
+            products = list(enumerator.enumerate_stream(ester_reactants, n_workers=n_workers, task_size=2))
+            assert products == expected
+
+        # Repeated acetic acid must not repeat its esters
+        assert len(expected) == 9
+        assert len({p["smiles"] for p in expected}) == len(expected)
+
+    def test_stream_spill_dir(self, ester_reactants, tmp_dir):
+        """Test that partitioned on-disk deduplication gives the same products."""
+        from rdkit_cli.core.reactions import ReactionEnumerator
+
+        enumerator = ReactionEnumerator(ESTER_SMARTS, max_products=0)
+        expected = list(enumerator.enumerate_stream(ester_reactants))
+        spilled = list(enumerator.enumerate_stream(ester_reactants, spill_dir=tmp_dir, n_partitions=3))
+
+        assert spilled == expected
+
+    def test_stream_max_products(self, ester_reactants):
+        """Test that the product limit stops the stream."""
+        from rdkit_cli.core.reactions import ReactionEnumerator
+
+        enumerator = ReactionEnumerator(ESTER_SMARTS, max_products=4)
+
+        assert len(list(enumerator.enumerate_stream(ester_reactants, task_size=1))) == 4
+
+    def test_sampled_enumeration(self, ester_reactants):
+        """Test that sampling enumerates a seeded subset of combinations."""
+        from rdkit_cli.core.reactions import ReactionEnumerator
+
+        enumerator = ReactionEnumerator(ESTER_SMARTS, max_products=0)
+        full = {p["smiles"] for p in enumerator.enumerate_stream(ester_reactants)}
+
+        first = list(enumerator.enumerate_stream(ester_reactants, sample=5, seed=7))
+        again = list(enumerator.enumerate_stream(ester_reactants, sample=5, seed=7))
+
+        assert first == again
+        assert 1 <= len(first) <= 5
+        assert {p["smiles"] for p in first} <= full
+
     def test_wrong_reactant_count(self):
         """Test wrong number of reactant lists raises error."""
         from rdkit_cli.core.reactions import ReactionEnumerator
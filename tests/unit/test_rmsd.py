@@ -90,6 +90,40 @@ class TestConformerRMSDMatrix:
 
         assert matrix == []
 
+    def test_condensed_matches_pairwise_alignment(self, mol_with_conformers):
+        """Test the condensed matrix against per-pair RDKit alignment."""
+        from rdkit.Chem import rdMolAlign
+        from rdkit_cli.core.rmsd import condensed_index, conformer_rmsd_condensed
+
+        n_conf = mol_with_conformers.GetNumConformers()
+        before = mol_with_conformers.GetConformer(1).GetPositions()
+
+        for symmetry in (True, False):
+            rmsds = conformer_rmsd_condensed(mol_with_conformers, symmetry=symmetry, num_threads=2)
+            assert rmsds.dtype == "float32"
+            assert len(rmsds) == n_conf * (n_conf - 1) // 2
+
+            for i in range(1, n_conf):
+                for j in range(i):
+                    probe = Chem.Mol(mol_with_conformers)
+                    if symmetry:
+                        expected = rdMolAlign.GetBestRMS(probe, mol_with_conformers, prbId=i, refId=j)
+                    else:
+                        expected = rdMolAlign.AlignMol(probe, mol_with_conformers, prbCid=i, refCid=j)
+                    assert rmsds[condensed_index(i, j)] == pytest.approx(expected, abs=1e-3)
+
+        # The input coordinates are not realigned
+        assert (mol_with_conformers.GetConformer(1).GetPositions() == before).all()
+
+    def test_condensed_single_conformer(self):
+        """Test that fewer than two conformers give an empty matrix."""
+        from rdkit_cli.core.rmsd import conformer_rmsd_condensed
+
+        mol = Chem.AddHs(Chem.MolFromSmiles("CCO"))
+        AllChem.EmbedMolecule(mol, randomSeed=42)
+
+        assert len(conformer_rmsd_condensed(mol)) == 0
+
 
 class TestClusterConformers:
     """Test conformer clustering by RMSD."""
@@ -107,6 +141,25 @@ class TestClusterConformers:
             all_indices.extend(cluster)
         assert len(all_indices) == mol_with_conformers.GetNumConformers()
 
+    def test_cluster_threshold_extremes(self, mol_with_conformers):
+        """Test that Butina clustering splits at zero and merges at a large threshold."""
+        from rdkit_cli.core.rmsd import cluster_conformers_by_rmsd
+
+        n_conf = mol_with_conformers.GetNumConformers()
+
+        assert len(cluster_conformers_by_rmsd(mol_with_conformers, threshold=0.0)) == n_conf
+        assert len(cluster_conformers_by_rmsd(mol_with_conformers, threshold=100.0)) == 1
+
+    def test_analyzer_reports_clusters(self, mol_with_conformers):
+        """Test the num_clusters column of ConformerRMSDAnalyzer."""
+        from rdkit_cli.core.rmsd import ConformerRMSDAnalyzer
+
+        stats = ConformerRMSDAnalyzer(cluster_threshold=100.0).analyze(mol_with_conformers)
+
+        assert stats["num_clusters"] == 1
+        assert stats["num_conformers"] == mol_with_conformers.GetNumConformers()
+        assert 0.0 <= stats["min_rmsd"] <= stats["mean_rmsd"] <= stats["max_rmsd"]
+
 
 class TestRMSDCalculator:
     """Test RMSDCalculator class."""
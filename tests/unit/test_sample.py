@@ -153,3 +153,41 @@ class TestReservoirSampler:
         result2 = run_sampling()
 
         assert result1 == result2
+
+    def test_stratified_reservoir_proportions(self):
+        """Test proportional allocation across strata."""
+        from collections import Counter
+        from rdkit_cli.core.sample import StratifiedReservoirSampler
+
+        sampler = StratifiedReservoirSampler(n=50, stratum=lambda item: item[0], seed=1)
+        for i in range(1000):
+            sampler.add(("a" if i % 10 < 7 else "b", i))
+
+        result = sampler.get_sample()
+        assert len(result) == 50
+        assert Counter(key for key, _ in result) == {"a": 35, "b": 15}
+        assert len({i for _, i in result}) == 50
+
+    def test_stratified_reservoir_fewer_than_n(self):
+        """Test stratified reservoir when fewer items than n."""
+        from rdkit_cli.core.sample import StratifiedReservoirSampler
+
+        sampler = StratifiedReservoirSampler(n=10, stratum=lambda item: item % 2, seed=1)
+        for i in range(5):
+            sampler.add(i)
+
+        assert sorted(sampler.get_sample()) == [0, 1, 2, 3, 4]
+
+    def test_stratified_reservoir_raw_rows(self):
+        """Test sampling unparsed rows by a metadata column."""
+        from rdkit_cli.core.sample import StratifiedReservoirSampler
+        from rdkit_cli.io.readers import RawRecord
+
+        sampler = StratifiedReservoirSampler(
+            n=4, stratum=lambda raw: raw.metadata["vendor"], seed=7
+        )
+        for i in range(40):
+            sampler.add(RawRecord(i, "C" * (i + 1), "", {"vendor": "x" if i < 20 else "y"}))
+
+        vendors = sorted(raw.metadata["vendor"] for raw in sampler.get_sample())
+        assert vendors == ["x", "x", "y", "y"]
@@ -157,6 +157,78 @@ class TestComputeSimilarityMatrix:
                 assert matrix[i][j] == matrix[j][i]
 
 
+class TestSimilarityMatrixBlocks:
+    """Test blocked similarity matrix computation."""
+
+    SMILES = ["C", "CC", "CCO", "c1ccccc1", "c1ccccc1O"]
+
+    def _fps(self):
+        from rdkit_cli.core.similarity import get_morgan_fingerprint
+
+        return [get_morgan_fingerprint(Chem.MolFromSmiles(s)) for s in self.SMILES]
+
+    def test_dense_blocks_match_matrix(self):
+        """Test dense row blocks reproduce compute_similarity_matrix."""
+        import numpy as np
+        from rdkit_cli.core.similarity import SimilarityMatrixBlocks, compute_similarity_matrix
+
+        blocks = SimilarityMatrixBlocks(self._fps())
+        dense = np.vstack([blocks((0, 2)), blocks((2, 5))])
+        expected = compute_similarity_matrix([Chem.MolFromSmiles(s) for s in self.SMILES])
+
+        assert np.allclose(dense, expected)
+
+    def test_bulk_matches_pairwise(self):
+        """Test bulk similarity agrees with pairwise similarity for every metric."""
+        from rdkit_cli.core.similarity import SimilarityMetric, bulk_similarity, compute_similarity
+
+        fps = self._fps()
+        for metric in SimilarityMetric:
+            bulk = bulk_similarity(fps[3], fps, metric, tversky_alpha=0.2, tversky_beta=0.8)
+            pairwise = [
+                compute_similarity(fps[3], fp, metric, tversky_alpha=0.2, tversky_beta=0.8)
+                for fp in fps
+            ]
+            assert bulk == pytest.approx(pairwise)
+
+    def test_uint8_quantization(self):
+        """Test uint8 blocks store similarity * 255."""
+        from rdkit_cli.core.similarity import SimilarityMatrixBlocks
+
+        block = SimilarityMatrixBlocks(self._fps(), dtype="uint8")((0, 5))
+
+        assert block.dtype.name == "uint8"
+        assert all(block[i, i] == 255 for i in range(5))
+
+    def test_edges_threshold(self):
+        """Test edge blocks keep pairs above threshold in the upper triangle."""
+        import numpy as np
+        from rdkit_cli.core.similarity import SimilarityMatrixBlocks
+
+        fps = self._fps()
+        dense = SimilarityMatrixBlocks(fps)((0, 5))
+        i, j, values = SimilarityMatrixBlocks(fps, edges=True, threshold=0.2)((0, 5))
+
+        assert np.all(j > i)
+        assert np.all(values >= 0.2)
+        expected = {(a, b) for a in range(5) for b in range(a + 1, 5) if dense[a, b] >= 0.2}
+        assert set(zip(i.tolist(), j.tolist())) == expected
+
+    def test_asymmetric_edges_cover_both_directions(self):
+        """Test Tversky with alpha != beta reports both (i, j) and (j, i)."""
+        from rdkit_cli.core.similarity import SimilarityMatrixBlocks, SimilarityMetric
+
+        i, j, _ = SimilarityMatrixBlocks(
+            self._fps(),
+            metric=SimilarityMetric.TVERSKY,
+            tversky_alpha=0.9,
+            tversky_beta=0.1,
+            edges=True,
+        )((0, 5))
+
+        assert len(i) == 5 * 4
+
+
 class TestClusterMolecules:
     """Test cluster_molecules function."""
 
@@ -193,3 +265,33 @@ class TestClusterMolecules:
 
         assert len(clusters) == 1
         assert 0 in clusters[0]
+
+    def test_sparse_butina_matches_rdkit(self):
+        """Test sparse-graph Butina gives the clusters of RDKit's Butina."""
+        from rdkit import DataStructs
+        from rdkit.ML.Cluster import Butina
+        from rdkit_cli.core.fingerprints import get_morgan_fingerprint
+        from rdkit_cli.core.similarity import cluster_fingerprints
+
+        smiles = [
+            "c1ccccc1", "Cc1ccccc1", "CCc1ccccc1", "Oc1ccccc1", "Nc1ccccc1",
+            "CCCCCC", "CCCCCCC", "CCCCCCCC", "CCO", "CCCO", "C1CCCCC1", "CC(=O)O",
+        ]
+        fps = [get_morgan_fingerprint(Chem.MolFromSmiles(s)) for s in smiles]
+
+        dists = []
+        for i in range(1, len(fps)):
+            dists.extend(1 - s for s in DataStructs.BulkTanimotoSimilarity(fps[i], fps[:i]))
+        expected = [list(c) for c in Butina.ClusterData(dists, len(fps), 0.6, isDistData=True)]
+
+        assert cluster_fingerprints(fps, cutoff=0.6, n_workers=1) == expected
+
+    def test_sphere_exclusion(self):
+        """Test sphere exclusion assigns every molecule exactly once."""
+        from rdkit_cli.core.similarity import cluster_molecules
+
+        mols = [Chem.MolFromSmiles(s) for s in ["c1ccccc1", "Cc1ccccc1", "CCCCCC", "CCCCCCC", "CCO"]]
+        clusters = cluster_molecules(mols, cutoff=0.6, method="sphere")
+
+        members = sorted(i for cluster in clusters for i in cluster)
+        assert members == list(range(len(mols)))
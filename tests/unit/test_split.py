@@ -99,3 +99,37 @@ class TestFileSplitter:
 
         # Should only create 3 chunks (one per record)
         assert len(assignments) == 3
+
+    def test_split_stream_chunk_size(self):
+        """Test streaming assignment by chunk size."""
+        from rdkit_cli.core.split import FileSplitter
+
+        splitter = FileSplitter(chunk_size=4)
+        chunks = [idx for idx, _ in splitter.split_stream(iter(range(10)))]
+
+        assert chunks == [0, 0, 0, 0, 1, 1, 1, 1, 2, 2]
+
+    def test_split_stream_n_chunks(self):
+        """Test streaming assignment matches the precomputed chunks."""
+        from rdkit_cli.core.split import FileSplitter
+
+        splitter = FileSplitter(n_chunks=3)
+        chunks = [idx for idx, _ in splitter.split_stream(iter(range(10)), total_records=10)]
+
+        assert chunks == [0, 0, 0, 0, 1, 1, 1, 2, 2, 2]
+
+    def test_split_stream_overflow_goes_to_last_chunk(self):
+        """Test items beyond the expected total."""
+        from rdkit_cli.core.split import FileSplitter
+
+        splitter = FileSplitter(n_chunks=2)
+        chunks = [idx for idx, _ in splitter.split_stream(iter(range(5)), total_records=4)]
+
+        assert chunks == [0, 0, 1, 1, 1]
+
+    def test_split_stream_requires_total(self):
+        """Test that n_chunks streaming needs the total."""
+        from rdkit_cli.core.split import FileSplitter
+
+        with pytest.raises(ValueError, match="total_records"):
+            list(FileSplitter(n_chunks=2).split_stream(iter(range(3))))